@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Caps on connections, logins in progress and running games
+ *
+ * Keeps a login storm from starving the games already in progress. Every
+ * open socket counts against the connection cap; beyond it new sockets are
+ * shed straight after accept. Only a limited number of logins may load
+ * their profile at once (the expensive, worker-pool part of a login); the
+ * rest wait in a bounded queue, and logins beyond that are refused.
+ * Reconnecting players wait in a separate queue that is always served
+ * first and is never refused. New games start only while the session cap
+ * has room.
+ *
+ * Not thread-safe: owned and driven by the Reactor thread.
+ */
+class AdmissionControl {
+public:
+    using Id = std::uint64_t;
+
+    struct Limits {
+        std::size_t maxConnections = 20000;   // Open sockets, logged in or not
+        std::size_t maxLoginsInFlight = 8;    // Logins loading their profile at the same time
+        std::size_t maxQueuedLogins = 4096;   // New logins allowed to wait for a slot
+        std::size_t maxSessions = 10000;      // Games running at the same time
+    };
+
+    enum class Priority {
+        Reconnect,  // Player returning to a game in progress
+        NewLogin
+    };
+
+    enum class LoginDecision {
+        Admitted,   // Holds a login slot now
+        Queued,     // Waiting; finishLogin() of another login will admit it
+        Rejected    // Queue is full; the caller should turn the client away
+    };
+
+    /**
+     * @brief Counters describing how much load was turned away
+     */
+    struct Stats {
+        std::uint64_t connectionsShed = 0;     // Sockets closed on accept
+        std::uint64_t loginsQueued = 0;        // Logins that had to wait
+        std::uint64_t reconnectsQueued = 0;    // ...of which were reconnects
+        std::uint64_t loginsRejected = 0;      // Logins refused outright
+        std::uint64_t sessionsDeferred = 0;    // Pairings put back because of the session cap
+        std::size_t maxLoginQueue = 0;         // Longest the login queue has been
+    };
+
+    AdmissionControl();
+    explicit AdmissionControl(Limits limits);
+
+    /**
+     * @brief Count a newly accepted socket if the connection cap allows it
+     *
+     * @return false if the socket should be shed
+     */
+    bool tryAdmitConnection();
+
+    /**
+     * @brief Count a socket that must be served regardless of the cap
+     *
+     * Used for connections handed over by another server process.
+     */
+    void connectionOpened();
+
+    /**
+     * @brief Release a connection counted by tryAdmitConnection() or connectionOpened()
+     */
+    void connectionClosed();
+
+    /**
+     * @brief Ask for a login slot
+     *
+     * @param id Connection asking; must not already hold or wait for a slot
+     */
+    LoginDecision requestLogin(Id id, Priority priority);
+
+    /**
+     * @brief Give up a slot, or a place in the queue
+     *
+     * Call once per requestLogin() that was not rejected, whether the login
+     * finished, failed or its connection dropped.
+     *
+     * @return Connections admitted into the freed slots, reconnects first
+     */
+    std::vector<Id> finishLogin(Id id);
+
+    /**
+     * @brief Whether a connection is waiting in the login queue
+     */
+    bool isQueued(Id id) const;
+
+    /**
+     * @brief Logins waiting ahead of and including a queued connection
+     *
+     * @return 1-based queue position, or 0 if it is not queued
+     */
+    std::size_t queuePosition(Id id) const;
+
+    /**
+     * @brief Count a new game if the session cap allows it
+     *
+     * @return false if the game should wait; the refusal is recorded in the stats
+     */
+    bool tryStartSession();
+
+    /**
+     * @brief Release a game counted by tryStartSession()
+     */
+    void sessionEnded();
+
+    std::size_t connections() const { return openConnections; }
+    std::size_t loginsInFlight() const { return inFlight.size(); }
+    std::size_t queuedLogins() const { return queued.size(); }
+    std::size_t sessions() const { return activeSessions; }
+    const Limits& limits() const { return config; }
+    const Stats& stats() const { return counters; }
+
+private:
+    Limits config;
+    std::size_t openConnections;
+    std::size_t activeSessions;
+    std::unordered_map<Id, Priority> inFlight;
+    // Queued logins by priority; entries whose id has left `queued` are stale and skipped
+    std::unordered_map<Id, Priority> queued;
+    std::deque<Id> reconnectQueue;
+    std::deque<Id> loginQueue;
+    std::size_t queuedNewLogins;
+    Stats counters;
+
+    bool popNext(Id& id);
+};
+
+} // namespace BayouBonanza
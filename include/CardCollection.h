@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <map>
 #include "Card.h"
 
@@ -64,6 +65,14 @@ public:
      * @param card The card to add
      */
     void addCard(std::unique_ptr<Card> card);
+
+    /**
+     * @brief Put a card back at an index, e.g. after a failed play removed it
+     *
+     * @param index Where to insert; past the end appends
+     * @param card The card to insert
+     */
+    void insertCardAt(size_t index, std::unique_ptr<Card> card);
     
     /**
      * @brief Remove a card at the specified index
@@ -166,6 +175,28 @@ public:
      * @return true if deserialization was successful, false otherwise
      */
     bool deserialize(const std::string& data);
+
+    /**
+     * @brief Encode the collection compactly for storage
+     *
+     * A format byte, then a little-endian uint16 number of entries and one
+     * (uint16 card ID, uint16 count) pair per distinct card, in ID order.
+     * The order of the cards is not kept.
+     *
+     * @return The packed bytes, or an empty string if a card ID does not fit in 16 bits
+     */
+    std::string pack() const;
+
+    /**
+     * @brief Decode a collection produced by pack()
+     *
+     * Each distinct card is created once and copied for the rest of its
+     * count; there is no text to parse.
+     *
+     * @param data The packed bytes
+     * @return true if decoding was successful, false otherwise
+     */
+    bool unpack(std::string_view data);
     
     /**
      * @brief Save the collection to a file
@@ -192,6 +223,9 @@ public:
 
 protected:
     std::vector<std::unique_ptr<Card>> cards;
+
+    // Hand::getHiddenCount(); kept here so copies and moves through a CardCollection carry it
+    size_t hiddenCount = 0;
     
 private:
     /**
@@ -237,6 +271,15 @@ public:
      * @return Number of slots available
      */
     size_t getAvailableSlots() const;
+
+    /**
+     * @brief Cards the owner holds that this copy of the game cannot see
+     *
+     * Set on clients for the opponent's hand, which the server sends only as
+     * a count; those cards are not in the collection itself.
+     */
+    size_t getHiddenCount() const { return hiddenCount; }
+    void setHiddenCount(size_t count) { hiddenCount = count; }
 };
 
 /**
@@ -316,6 +359,12 @@ public:
     std::string serialize() const;
     bool deserialize(const std::string& data);
 
+    /**
+     * @brief Encode the deck compactly: the main deck as (ID, count) runs in order, then the victory slots
+     */
+    std::string pack() const;
+    bool unpack(std::string_view data);
+
 private:
     std::vector<std::unique_ptr<Card>> victoryCards;
 };
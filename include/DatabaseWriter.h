@@ -0,0 +1,118 @@
+#pragma once
+
+#include "PlayerDatabase.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief A thread that takes every database write off the callers' threads and commits them in batches
+ *
+ * submit() only queues. The writer waits until maxBatch groups are
+ * queued or the oldest has waited maxDelay, then stores up to maxBatch
+ * of them with PlayerDatabase::applyWrites(): one transaction, one
+ * commit. While a batch is being written the next one fills up, so the
+ * busier the server, the more writes share a commit.
+ *
+ * Groups are written in the order submitted. Completions run on the
+ * writer thread once their batch has committed (or failed); they must be
+ * quick and must not submit and wait. whenWritten() waits for everything
+ * submitted so far without writing anything itself.
+ *
+ * Thread-safe.
+ */
+class DatabaseWriter {
+public:
+    using Completion = std::function<void(bool stored)>;
+
+    struct Options {
+        std::size_t maxBatch = 128;            // Groups per transaction
+        std::chrono::milliseconds maxDelay{5}; // Longest a group waits for others to share its commit
+    };
+
+    /**
+     * @brief Counters describing the batching
+     */
+    struct Stats {
+        std::uint64_t groups = 0;  // Written, stored or not
+        std::uint64_t failed = 0;  // ... of which were not stored
+        std::uint64_t batches = 0; // Transactions
+        std::size_t largestBatch = 0;
+        std::size_t pending = 0;   // Queued, not yet written
+    };
+
+    explicit DatabaseWriter(PlayerDatabase& database);
+    DatabaseWriter(PlayerDatabase& database, Options options);
+
+    /**
+     * @brief Write what is queued, then stop the thread
+     */
+    ~DatabaseWriter();
+
+    DatabaseWriter(const DatabaseWriter&) = delete;
+    DatabaseWriter& operator=(const DatabaseWriter&) = delete;
+
+    /**
+     * @brief Queue writes to be stored together, all or none
+     *
+     * @param done Called on the writer thread with the outcome; may be empty
+     */
+    void submit(PlayerDatabase::WriteGroup writes, Completion done = {});
+
+    /**
+     * @brief Call @p done once every group submitted before this call has been written, stored or not
+     *
+     * A barrier for readers that must see those writes: no transaction is
+     * opened for it. @p done runs at once on the caller's thread if nothing
+     * is outstanding, otherwise on the writer thread after the completions
+     * of the batch that finished the wait; it should only hand work on.
+     */
+    void whenWritten(std::function<void()> done);
+
+    /**
+     * @brief Stop taking writes, store the ones queued and join the thread
+     */
+    void shutdown();
+
+    Stats stats() const;
+
+    /**
+     * @brief Print one line: groups written, batches and how full they were
+     */
+    void report(std::ostream& out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void writerLoop();
+
+    struct Waiter {
+        std::uint64_t submitted = 0; // Groups submitted when it began waiting
+        std::function<void()> done;
+    };
+
+    PlayerDatabase& database;
+    Options config;
+
+    mutable std::mutex mutex;
+    std::condition_variable queued;
+    std::vector<PlayerDatabase::WriteGroup> pendingGroups;
+    std::vector<Completion> pendingCompletions; // Parallel to pendingGroups
+    Clock::time_point oldestQueued;
+    std::uint64_t submitted = 0; // Groups ever queued; written once counters.groups reaches it
+    std::vector<Waiter> waiters; // whenWritten() calls, in the order made
+    bool stopping = false;
+    Stats counters; // Guarded by mutex; pending is filled in by stats()
+
+    std::thread thread;
+};
+
+} // namespace BayouBonanza
@@ -0,0 +1,79 @@
+#pragma once
+
+#if !defined(_WIN32)
+
+#include <SFML/Network/Packet.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "Matchmaker.h"
+#include "SessionDirectory.h"
+
+namespace BayouBonanza {
+
+class Reactor;
+class UnixChannel;
+
+/**
+ * @brief Session directory and shared matchmaking queue for a group of server processes
+ *
+ * Run by the supervising process. Each server process connects over a Unix
+ * socket (see RemoteDirectory), claims the users whose games it hosts, and
+ * queues players here. Pairings within one process are sent back as Match;
+ * across processes the later arrival is migrated to its opponent's process,
+ * with the socket relayed through this service.
+ *
+ * Runs entirely on its Reactor's thread.
+ */
+class DirectoryService {
+public:
+    DirectoryService(Reactor& reactor, Matchmaker::Config config = {},
+                     std::chrono::milliseconds tick = std::chrono::milliseconds(250));
+    ~DirectoryService();
+
+    DirectoryService(const DirectoryService&) = delete;
+    DirectoryService& operator=(const DirectoryService&) = delete;
+
+    /**
+     * @brief Accept server processes on the given socket path and start matchmaking
+     */
+    bool listen(const std::string& path);
+
+    /**
+     * @brief Number of server processes currently registered
+     */
+    std::size_t processCount() const { return processes.size(); }
+
+private:
+    struct Connection {
+        std::unique_ptr<UnixChannel> channel;
+        int index = -1;  // Process index, known after Hello
+        std::unordered_map<Matchmaker::TicketId, int> queued;  // Global ticket -> rating
+    };
+
+    Reactor& reactor;
+    Matchmaker matchmaker;
+    std::chrono::milliseconds tick;
+    int listener;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;  // By socket
+    std::map<int, Connection*> processes;                               // By process index
+    std::unordered_map<std::string, int> owners;
+
+    void onAcceptable();
+    void onReadable(int fd);
+    void handleMessage(Connection& connection, sf::Packet& packet);
+    void drop(int fd);
+    void enqueue(Connection& connection, Matchmaker::TicketId global, int rating);
+    void runTick();
+    Connection* process(int index) const;
+
+    static Matchmaker::TicketId globalTicket(int process, Matchmaker::TicketId local);
+    static int processOf(Matchmaker::TicketId global);
+    static Matchmaker::TicketId localTicket(Matchmaker::TicketId global);
+};
+
+} // namespace BayouBonanza
+
+#endif
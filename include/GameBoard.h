@@ -2,6 +2,7 @@
 
 #include <array>
 #include <memory>
+#include <cstdint>
 #include "Square.h" // Includes SFML/Network/Packet.hpp indirectly via Square.h's new includes
 #include "PlayerSide.h"
 // SFML/Network/Packet.hpp is included via Square.h if Square.h was modified correctly.
@@ -25,6 +26,15 @@ public:
      */
     GameBoard();
 
+    /**
+     * @brief Move another board's pieces and control here
+     *
+     * Squares report changes to the hash of the board they were built in,
+     * so the squares themselves stay put and only their contents move.
+     */
+    GameBoard(GameBoard&& other) noexcept;
+    GameBoard& operator=(GameBoard&& other) noexcept;
+
     /**
      * @brief Get a reference to a square at the specified position
      * 
@@ -65,12 +75,25 @@ public:
      */
     void recalculateControlValues();
 
+    /**
+     * @brief Zobrist hash of every piece and every square's control
+     *
+     * Kept up to date by the squares and pieces as they change, so reading
+     * it is O(1). See GameState::hash().
+     */
+    std::uint64_t hash() const { return boardHash; }
+
 private:
     std::array<std::array<Square, BOARD_SIZE>, BOARD_SIZE> board;
+    std::uint64_t boardHash = 0;
+
+    void attachSquares();
 };
 
-// SFML Packet operators for GameBoard
-sf::Packet& operator<<(sf::Packet& packet, const GameBoard& gb);
-sf::Packet& operator>>(sf::Packet& packet, GameBoard& gb);
+// Packet operators for GameBoard, defined for sf::Packet, WireWriter and WireReader
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GameBoard& gb);
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GameBoard& gb);
 
 } // namespace BayouBonanza
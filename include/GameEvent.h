@@ -0,0 +1,126 @@
+#pragma once
+
+#include "GameState.h"
+#include "PieceData.h"
+#include "PlayerSide.h"
+#include "WireFormat.h"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief One player action as the server applied it, for clients to replay
+ *
+ * A client's GameState matches the server's apart from the decks, so
+ * replaying the action through TurnManager on the client reproduces every
+ * change except the cards drawn from the server-only, shuffled decks. The
+ * event carries those draws: by card ID to their owner, as a count to the
+ * opponent. A card played from the opponent's hidden hand is revealed by
+ * its ID.
+ *
+ * GameEvent wire format, following the MessageType::GameEvent byte (see WireWriter):
+ *   varint sequence of the state the event produces (it applies to sequence - 1),
+ *   Uint8 header: the Type, plus HAS_STATE_HASH when a hash follows the draws,
+ *   the Type's operands:
+ *     Move:               Uint8 from square, Uint8 to square (y * 8 + x)
+ *     PlayCard:           Uint8 hand index, Uint16 card ID, Uint8 target square
+ *     NextPhase, EndTurn: none
+ *   Uint8 draw counts: player one's in the low nibble, player two's in the high nibble,
+ *   Uint16 ID of each card the viewer drew,
+ *   fixed 64-bit GameState::hash() of the viewer's projection if HAS_STATE_HASH is set.
+ */
+class GameEvent {
+public:
+    enum class Type : sf::Uint8 {
+        Move,       // TurnManager::processMoveAction
+        PlayCard,   // TurnManager::processPlayCardAction
+        NextPhase,  // TurnManager::nextPhase
+        EndTurn     // TurnManager::endCurrentTurn (the turn clock ran out)
+    };
+
+    static constexpr sf::Uint8 HAS_STATE_HASH = 0x80;
+
+    // The server sends a state hash with every event whose sequence is a multiple of this
+    static constexpr sf::Uint32 STATE_HASH_INTERVAL = 8;
+
+    GameEvent() = default;
+
+    /**
+     * @brief Events for an action about to be applied to @p state
+     *
+     * Each records the hand sizes before the action so recordDraws() can
+     * tell the drawn cards apart once it has been applied.
+     */
+    static GameEvent move(const GameState& state, const Position& from, const Position& to);
+    static GameEvent playCard(const GameState& state, int cardIndex, const Position& target);
+    static GameEvent nextPhase(const GameState& state);
+    static GameEvent endTurn(const GameState& state);
+
+    /**
+     * @brief Note the cards the action drew; call after applying it to the same state
+     *
+     * Drawn cards are the ones appended to a hand beyond what the action left there.
+     */
+    void recordDraws(const GameState& state);
+
+    Type getType() const { return type; }
+    const std::vector<int>& getDrawnCards(PlayerSide side) const;
+
+    /**
+     * @brief Append the event as @p viewer may see it
+     *
+     * @param sequence Sequence of the state the event produces
+     * @param stateHash Hash of @p viewer's projection of that state, if it should be checked
+     */
+    void write(WireWriter& writer, sf::Uint32 sequence, PlayerSide viewer,
+               std::optional<sf::Uint64> stateHash = std::nullopt) const;
+
+    /**
+     * @brief Read an event written for @p viewer; the opponent's draws come back as counts
+     *
+     * @return false if the packet is malformed
+     */
+    static bool read(WireReader& reader, GameEvent& event, sf::Uint32& sequence,
+                     std::optional<sf::Uint64>& stateHash, PlayerSide viewer);
+
+    /**
+     * @brief Replay the event on a client's copy of the state
+     *
+     * @param viewer Side @p state belongs to; only its own hand is visible
+     * @return false if TurnManager refuses the action or the hand does not hold the played card
+     */
+    bool apply(GameState& state, PlayerSide viewer) const;
+
+private:
+    Type type = Type::NextPhase;
+    PlayerSide actor = PlayerSide::NEUTRAL; // Active player when the action was taken
+    Position from;
+    Position to;               // Move target, or the card's target square
+    int cardIndex = -1;
+    int cardId = -1;           // Card played, revealed to the opponent
+    std::array<std::size_t, 2> handSizesBefore{};
+    std::array<std::size_t, 2> drawCounts{};
+    std::array<std::vector<int>, 2> drawnCards; // Empty for a hand the reader cannot see
+
+    explicit GameEvent(Type type, const GameState& state);
+};
+
+/**
+ * @brief Apply a GameEvent body to the state it follows
+ *
+ * The state is left untouched when the event does not follow @p sequence.
+ * Otherwise the event is replayed, its draws added and, if it carries one,
+ * the state hash compared. A false return after replaying means the client
+ * has drifted from the server; either way the caller should ask for a full
+ * snapshot with MessageType::RequestStateResync.
+ *
+ * @param sequence Sequence @p state currently matches; advanced on success
+ * @param viewer Side @p state belongs to
+ * @return false if the event does not apply, does not replay, or the hashes differ
+ */
+bool applyGameEvent(WireReader& reader, GameState& state, sf::Uint32& sequence, PlayerSide viewer);
+
+} // namespace BayouBonanza
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 #include "GameBoard.h" // Includes Square.h, Piece.h, etc.
 #include "PlayerSide.h"
 #include "ResourceSystem.h" // Added ResourceSystem include
@@ -30,9 +31,11 @@ enum class GamePhase {
     GAME_OVER   // Game has ended
 };
 
-// SFML Packet operators for GamePhase
-sf::Packet& operator<<(sf::Packet& packet, const GamePhase& phase);
-sf::Packet& operator>>(sf::Packet& packet, GamePhase& phase);
+// Packet operators for GamePhase, defined for sf::Packet, WireWriter and WireReader
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GamePhase& phase);
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GamePhase& phase);
 
 /**
  * @brief Enum representing the result of the game
@@ -44,9 +47,11 @@ enum class GameResult {
     DRAW            // Game ended in a draw
 };
 
-// SFML Packet operators for GameResult
-sf::Packet& operator<<(sf::Packet& packet, const GameResult& result);
-sf::Packet& operator>>(sf::Packet& packet, GameResult& result);
+// Packet operators for GameResult, defined for sf::Packet, WireWriter and WireReader
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GameResult& result);
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GameResult& result);
 
 /**
  * @brief Manages the state of the game, including board, active player, and game phase
@@ -306,6 +311,21 @@ public:
      */
     void processCardTurnStart();
 
+    /**
+     * @brief 64-bit Zobrist hash of the state as @p viewer sees it
+     *
+     * The board's share is kept up to date as pieces and control change
+     * (GameBoard::hash()); the turn, phase, result, steam and hands are a
+     * handful of keys folded in here, so the call is O(1). A hand the viewer
+     * cannot see counts only by its size, which makes a player's hash of
+     * their projection equal the server's hash for that player. Decks never
+     * leave the server and are not hashed.
+     *
+     * @param viewer Side whose projection to hash, NEUTRAL for the full state,
+     *               or SPECTATOR_VIEWER for both hands hidden
+     */
+    std::uint64_t hash(PlayerSide viewer = PlayerSide::NEUTRAL) const;
+
 private:
     GameBoard board;
     PlayerSide activePlayer;
@@ -325,8 +345,21 @@ private:
     Hand handPlayer2;
 };
 
-// SFML Packet operators for GameState
-sf::Packet& operator<<(sf::Packet& packet, const GameState& gs);
-sf::Packet& operator>>(sf::Packet& packet, GameState& gs);
+/**
+ * @brief Hand wire format: Uint8 card count, bool visible, then the card IDs if visible
+ *
+ * A hidden hand (the opponent's, in a player's projection of the state)
+ * carries only its count; readHand() records it with Hand::setHiddenCount().
+ */
+template <WritablePacket Packet>
+Packet& writeHand(Packet& packet, const Hand& hand, bool visible);
+template <ReadablePacket Packet>
+Packet& readHand(Packet& packet, Hand& hand);
+
+// Packet operators for GameState, defined for sf::Packet, WireWriter and WireReader; operator<< writes both hands in full
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GameState& gs);
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GameState& gs);
 
 } // namespace BayouBonanza
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "GameState.h"
+#include "PlayerSide.h"
+#include "WireFormat.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief A numbered, encoded copy of a GameState that deltas are built against
+ *
+ * The state is encoded once, in the layout `writer << state` writes with a
+ * WireWriter, and split into parts: the 64 squares (row by row), the turn scalars (active
+ * player, phase, result, turn number, steam) and each hand. Each hand is
+ * also encoded as its count alone. Every viewer's projection reuses the
+ * shared board and scalar bytes, plus its own hand in full and only the
+ * count of the opponent's. Comparing two snapshots part by part yields a
+ * delta that carries only the parts whose bytes changed.
+ *
+ * Delta wire format, following the MessageType::GameStateDelta byte (see WireWriter):
+ *   varint base sequence, varint sequence,
+ *   Uint8 changed square count, then per square: Uint8 index (y * 8 + x), square,
+ *   Uint8 part mask (DELTA_SCALARS | DELTA_HAND_ONE | DELTA_HAND_TWO), then those parts,
+ *   each hand as the viewer may see it,
+ *   fixed 64-bit GameState::hash() of the viewer's projection.
+ *
+ * A full state ends with the same hash, after its sequence. Both come last,
+ * so a reader that stops before them still reads the rest.
+ */
+class GameStateSnapshot {
+public:
+    static constexpr int SQUARE_COUNT = GameBoard::BOARD_SIZE * GameBoard::BOARD_SIZE;
+    static constexpr int PART_COUNT = SQUARE_COUNT + 5; // Squares, scalars, two hands in full, two as counts
+
+    static constexpr sf::Uint8 DELTA_SCALARS = 1 << 0;
+    static constexpr sf::Uint8 DELTA_HAND_ONE = 1 << 1;
+    static constexpr sf::Uint8 DELTA_HAND_TWO = 1 << 2;
+
+    /**
+     * @brief Empty snapshot; deltas against it fall back to every part
+     */
+    GameStateSnapshot();
+
+    GameStateSnapshot(const GameState& state, sf::Uint32 sequence);
+
+    sf::Uint32 sequence() const { return number; }
+    bool empty() const { return bytes.empty(); }
+
+    /**
+     * @brief Append the state as @p viewer may see it, followed by its varint sequence and hash
+     *
+     * @param viewer Player the projection is for; PlayerSide::NEUTRAL sees both
+     *               hands, which makes the state's bytes identical to `writer << state`,
+     *               and SPECTATOR_VIEWER neither
+     */
+    void writeFull(WireWriter& writer, PlayerSide viewer = PlayerSide::NEUTRAL) const;
+
+    /**
+     * @brief Bytes writeFull() appends for @p viewer
+     */
+    std::size_t fullSize(PlayerSide viewer = PlayerSide::NEUTRAL) const;
+
+    /**
+     * @brief Append the parts of @p viewer's projection that differ from an older snapshot
+     *
+     * @return Number of changed parts written
+     */
+    int writeDelta(WireWriter& writer, const GameStateSnapshot& base,
+                   PlayerSide viewer = PlayerSide::NEUTRAL) const;
+
+private:
+    sf::Uint32 number;
+    std::vector<char> bytes;
+    std::array<sf::Uint64, 4> hashes{}; // GameState::hash() by viewer: each side, NEUTRAL, SPECTATOR_VIEWER
+    std::array<std::size_t, PART_COUNT + 1> offsets; // Part i spans [offsets[i], offsets[i + 1])
+
+    static int handPart(PlayerSide owner, PlayerSide viewer);
+
+    // Encode into bytes; false if they are too small
+    bool encode(const GameState& state);
+
+    std::size_t partSize(int part) const { return offsets[part + 1] - offsets[part]; }
+    bool partEquals(const GameStateSnapshot& other, int part) const;
+    void appendPart(WireWriter& writer, int part) const;
+};
+
+/**
+ * @brief Apply a GameStateDelta body to the state it was built against
+ *
+ * Reads the delta's sequence header first. The state is left untouched
+ * when the delta's base is not @p sequence. Otherwise the changes are
+ * applied and the result checked against the server's hash; a false
+ * return after applying means the client has drifted. Either way the
+ * caller should ask for a full snapshot with MessageType::RequestStateResync.
+ *
+ * @param sequence Sequence @p state currently matches; advanced on success
+ * @param viewer Side @p state belongs to, as for GameState::hash()
+ * @return false if the delta does not apply, is malformed or leaves the state off the server's
+ */
+bool applyGameStateDelta(WireReader& reader, GameState& state, sf::Uint32& sequence,
+                         PlayerSide viewer = PlayerSide::NEUTRAL);
+
+/**
+ * @brief Read a full state as GameStateSnapshot::writeFull() wrote it and check it against its hash
+ *
+ * @param sequence Set to the state's sequence on success
+ * @param viewer Side @p state belongs to, as for GameState::hash()
+ * @return false if the state is malformed or does not hash as it did on the server
+ */
+bool readFullGameState(WireReader& reader, GameState& state, sf::Uint32& sequence,
+                       PlayerSide viewer = PlayerSide::NEUTRAL);
+
+} // namespace BayouBonanza
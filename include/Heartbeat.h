@@ -0,0 +1,160 @@
+#pragma once
+
+#include "NetworkProtocol.h" // For MessageType and messageBody
+#include "WireFormat.h"
+#include <SFML/Config.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Body of MessageType::Ping (wire body)
+ *
+ * Either side may send one; the other answers with a Pong carrying the
+ * same sequence. The server pings clients that have Capability::Heartbeat.
+ */
+struct PingData {
+    sf::Uint32 sequence = 0;
+    sf::Uint32 roundTripMicros = 0; // From the server: its smoothed round trip to this client, 0 until measured
+};
+
+/**
+ * @brief Body of MessageType::Pong (wire body)
+ */
+struct PongData {
+    sf::Uint32 sequence = 0; // Of the Ping answered
+};
+
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const PingData& ping) {
+    return packet << ping.sequence << ping.roundTripMicros;
+}
+
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, PingData& ping) {
+    return packet >> ping.sequence >> ping.roundTripMicros;
+}
+
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const PongData& pong) {
+    return packet << pong.sequence;
+}
+
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, PongData& pong) {
+    return packet >> pong.sequence;
+}
+
+/**
+ * @brief Build the Pong that answers a received Ping
+ *
+ * @param ping The Ping as received, MessageType byte first
+ * @param[out] data The Ping's fields, for the round trip the server measured
+ * @return The Pong to send, or an empty packet if the Ping is malformed
+ */
+sf::Packet answerPing(const sf::Packet& ping, PingData& data);
+
+/**
+ * @brief One connection's outstanding Pings and measured round trip
+ *
+ * The owner sends ping() every interval and drops the connection once
+ * unanswered() reaches its limit, which catches half-open connections
+ * that would otherwise look merely idle. A Pong for any of the last
+ * TRACKED_PINGS Pings counts, so a slow link is measured rather than
+ * dropped; the round trip is smoothed like TCP's SRTT (1/8 per sample).
+ *
+ * Not thread-safe: owned by the thread that reads the connection.
+ */
+class Heartbeat {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t TRACKED_PINGS = 8;
+
+    /**
+     * @brief Number the next Ping and note when it went out
+     */
+    PingData ping(Clock::time_point now);
+
+    /**
+     * @brief Match a Pong against the Pings sent
+     *
+     * @return true if it answers a Ping newer than any answered before; the round trip is updated
+     */
+    bool pong(sf::Uint32 sequence, Clock::time_point now);
+
+    /**
+     * @brief Pings sent since the newest one answered
+     */
+    sf::Uint32 unanswered() const { return lastSent - lastAnswered; }
+
+    /**
+     * @brief Smoothed round trip; zero until the first Pong
+     */
+    std::chrono::microseconds roundTrip() const { return smoothed; }
+
+    /**
+     * @brief Round trip of the most recent answered Ping
+     */
+    std::chrono::microseconds lastRoundTrip() const { return latest; }
+
+private:
+    sf::Uint32 lastSent = 0;
+    sf::Uint32 lastAnswered = 0;
+    std::array<Clock::time_point, TRACKED_PINGS> sentAt{}; // By sequence % TRACKED_PINGS
+    std::chrono::microseconds smoothed{0};
+    std::chrono::microseconds latest{0};
+};
+
+/**
+ * @brief Heartbeat traffic and the round trips measured, over all connections
+ *
+ * Round trips go into a log-linear histogram (8 buckets per power of two),
+ * so percentiles are within about 12% and recording is O(1).
+ *
+ * Not thread-safe: owned by the thread that drives the heartbeats.
+ */
+class HeartbeatStats {
+public:
+    void pingSent() { ++pings; }
+    void connectionReaped() { ++reaped; }
+
+    /**
+     * @brief Count an answered Ping and its round trip
+     */
+    void recordRoundTrip(std::chrono::microseconds roundTrip);
+
+    /**
+     * @brief Round trip below which @p fraction of the recorded ones fall; zero if none were
+     */
+    std::chrono::microseconds percentile(double fraction) const;
+
+    std::uint64_t pingsSent() const { return pings; }
+    std::uint64_t pongsReceived() const { return pongs; }
+    std::uint64_t connectionsReaped() const { return reaped; }
+
+    /**
+     * @brief Print one line: Pings, Pongs, connections reaped and round trip percentiles
+     */
+    void report(std::ostream& out) const;
+
+private:
+    static constexpr std::size_t SUB_BUCKETS = 8;
+    static constexpr std::size_t BUCKETS = SUB_BUCKETS * 30; // Up to about 2^32 microseconds
+
+    static std::size_t bucketFor(std::uint64_t micros);
+    static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+    std::uint64_t pings = 0;
+    std::uint64_t pongs = 0;
+    std::uint64_t reaped = 0;
+    std::uint64_t maxMicros = 0;
+    std::array<std::uint64_t, BUCKETS> buckets{};
+};
+
+} // namespace BayouBonanza
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "NetworkProtocol.h" // For MessageType and messageBody
+#include "PlayerDatabase.h"
+#include "WireFormat.h"
+#include <SFML/Config.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Body of MessageType::LeaderboardRequest (wire body)
+ */
+struct LeaderboardRequestData {
+    sf::Uint32 top = 10;   // How many of the best players to list; the server caps it
+    sf::Uint32 around = 0; // Players to list on each side of the requester, 0 for none; capped too
+};
+
+/**
+ * @brief One line of the leaderboard
+ *
+ * Ranks are positions: players on the same rating are ordered by
+ * username, so no two share a rank.
+ */
+struct LeaderboardEntry {
+    sf::Uint32 rank = 0; // 1 for the best
+    std::string username;
+    sf::Int32 rating = 0;
+};
+
+/**
+ * @brief Body of MessageType::LeaderboardData (wire body)
+ */
+struct LeaderboardData {
+    sf::Uint32 totalPlayers = 0;
+    std::vector<LeaderboardEntry> top;
+    sf::Uint32 rank = 0;                  // The requester's, 0 if unranked
+    std::vector<LeaderboardEntry> around; // The requester and their neighbours, best first
+};
+
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const LeaderboardRequestData& request) {
+    return packet << request.top << request.around;
+}
+
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, LeaderboardRequestData& request) {
+    return packet >> request.top >> request.around;
+}
+
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const LeaderboardEntry& entry) {
+    return packet << entry.rank << entry.username << entry.rating;
+}
+
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, LeaderboardEntry& entry) {
+    return packet >> entry.rank >> entry.username >> entry.rating;
+}
+
+template <WritablePacket Packet>
+Packet& writeLeaderboardEntries(Packet& packet, const std::vector<LeaderboardEntry>& entries) {
+    packet << static_cast<sf::Uint32>(entries.size());
+    for (const LeaderboardEntry& entry : entries) {
+        packet << entry;
+    }
+    return packet;
+}
+
+template <ReadablePacket Packet>
+Packet& readLeaderboardEntries(Packet& packet, std::vector<LeaderboardEntry>& entries) {
+    sf::Uint32 count = 0;
+    packet >> count;
+    entries.clear();
+    // A count larger than the data fails partway through; nothing is allocated for it up front
+    LeaderboardEntry entry;
+    for (sf::Uint32 i = 0; i < count && packet >> entry; ++i) {
+        entries.push_back(entry);
+    }
+    return packet;
+}
+
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const LeaderboardData& data) {
+    packet << data.totalPlayers;
+    writeLeaderboardEntries(packet, data.top);
+    packet << data.rank;
+    return writeLeaderboardEntries(packet, data.around);
+}
+
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, LeaderboardData& data) {
+    packet >> data.totalPlayers;
+    readLeaderboardEntries(packet, data.top);
+    packet >> data.rank;
+    return readLeaderboardEntries(packet, data.around);
+}
+
+/**
+ * @brief Every known player's rating, ranked
+ *
+ * Players are kept in an order-statistic tree (a treap whose nodes count
+ * their subtree), so a rating change, a player's rank and the player at a
+ * given rank each cost O(log n) rather than a sort or a database scan.
+ * The best topSize players are also kept as an immutable snapshot, shared
+ * by every top() caller; it is rebuilt on the first read after a change
+ * that reached the top, so a burst of games costs one rebuild.
+ *
+ * Thread-safe. Ratings come from this process: what other processes
+ * writing the same database change is seen only after reset(). Each set()
+ * is numbered, so a reset() from a read that began at version() keeps
+ * whatever was set after it rather than the older rating the read saw.
+ */
+class Leaderboard {
+public:
+    /**
+     * @brief The best players at one moment; never changed once built
+     */
+    struct Snapshot {
+        std::vector<LeaderboardEntry> entries; // Best first
+    };
+
+    struct Options {
+        std::size_t topSize = 100; // Players kept in the snapshot
+    };
+
+    /**
+     * @brief Counters describing the board's use
+     */
+    struct Stats {
+        std::uint64_t updates = 0; // Ratings set
+        std::uint64_t snapshotsBuilt = 0;
+        std::uint64_t queries = 0; // rank(), around() and top() calls
+        std::size_t players = 0;
+    };
+
+    Leaderboard();
+    explicit Leaderboard(Options options);
+    ~Leaderboard();
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    /**
+     * @brief Add a player, or move one to a new rating
+     */
+    void set(const std::string& username, int rating);
+
+    /**
+     * @brief set() for each, under one lock
+     */
+    void set(const std::vector<PlayerDatabase::RatingUpdate>& ratings);
+
+    /**
+     * @brief Replace every player with @p ratings, as read from the database
+     *
+     * Players set() since @p since keep their rating, and stay on the board
+     * if the read missed them: the read may have been taken before their
+     * rating was stored.
+     *
+     * @param since version() before the read began
+     */
+    void reset(const std::vector<PlayerDatabase::RatingUpdate>& ratings, std::uint64_t since);
+
+    /**
+     * @brief Count of set() calls so far, to note before a read passed to reset()
+     */
+    std::uint64_t version() const;
+
+    /**
+     * @brief A player's rank, 1 for the best
+     *
+     * @return The rank, or 0 if the player is not on the board
+     */
+    std::size_t rank(const std::string& username);
+
+    /**
+     * @brief A player and up to @p radius players on each side, best first
+     *
+     * @return The entries, or none if the player is not on the board
+     */
+    std::vector<LeaderboardEntry> around(const std::string& username, std::size_t radius);
+
+    /**
+     * @brief The best players, at most Options::topSize of them
+     */
+    std::shared_ptr<const Snapshot> top();
+
+    std::size_t size() const;
+
+    Stats stats() const;
+
+    /**
+     * @brief Print one line: players, updates, queries and snapshots built
+     */
+    void report(std::ostream& out) const;
+
+private:
+    struct Node;
+
+    struct Player {
+        int rating = 0;
+        std::uint64_t changed = 0; // version() of the last set(), 0 if read by reset()
+    };
+
+    // Whether a node ranks above (rating, username): higher rating, or the same and an earlier username
+    static bool ahead(const Node& node, int rating, const std::string& username);
+
+    void insert(const std::string& username, int rating);
+    void erase(const std::string& username, int rating);
+    // Stamps the player with @p changed: a version(), or 0 for a rating read from the database
+    void setLocked(const std::string& username, int rating, std::uint64_t changed);
+
+    // 1-based rank of a player known to be on the board
+    std::size_t rankOf(const std::string& username, int rating) const;
+
+    // The node at a 1-based rank; rank must be within the board
+    const Node* at(std::size_t rank) const;
+
+    // Ranks first..last (inclusive), in order
+    std::vector<LeaderboardEntry> entries(std::size_t first, std::size_t last) const;
+
+    Options config;
+
+    mutable std::mutex mutex;
+    std::unique_ptr<Node> root;
+    std::unordered_map<std::string, Player> players; // By username, which with the rating is the tree's key
+    std::uint64_t changes = 0;                       // version()
+    std::mt19937 priorities;                         // Treap heap order, which keeps the tree balanced
+    std::shared_ptr<const Snapshot> snapshot;
+    bool snapshotStale = true;
+    Stats counters; // players is filled in by stats()
+};
+
+} // namespace BayouBonanza
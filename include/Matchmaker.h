@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Rating-bucketed matchmaking queue
+ *
+ * Queued players are filed in buckets of fixed rating width, each kept in
+ * arrival order, so enqueue and removal are O(log n). pairBatch() walks the
+ * queue oldest first and pairs each player with the longest-waiting
+ * opponent in the nearest non-empty bucket inside their rating window. The
+ * window starts narrow and widens the longer a player has waited, trading
+ * match quality for queue time.
+ *
+ * Not thread-safe: owned and driven by the Reactor thread.
+ */
+class Matchmaker {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TicketId = std::uint64_t;
+
+    struct Config {
+        int bucketWidth = 25;            // Rating points per bucket
+        int initialWindow = 50;          // Allowed rating gap on arrival
+        int windowGrowthPerSecond = 25;  // Extra gap allowed per second waited
+        int maxWindow = 400;             // Gap never widens past this
+    };
+
+    /**
+     * @brief Two queued players chosen to play each other
+     *
+     * first is the player who had waited longer.
+     */
+    struct Pairing {
+        TicketId first;
+        TicketId second;
+        Clock::duration firstWait;
+        Clock::duration secondWait;
+    };
+
+    Matchmaker();
+    explicit Matchmaker(Config config);
+
+    /**
+     * @brief Queue a player
+     *
+     * @return false if the ticket is already queued
+     */
+    bool enqueue(TicketId id, int rating, Clock::time_point now);
+
+    /**
+     * @brief Drop a player from the queue
+     *
+     * @return true if the ticket was queued
+     */
+    bool remove(TicketId id);
+
+    /**
+     * @brief Whether a ticket is waiting in the queue
+     */
+    bool contains(TicketId id) const;
+
+    /**
+     * @brief Pair as many queued players as the current windows allow
+     *
+     * Paired tickets leave the queue; everyone else keeps their place.
+     */
+    std::vector<Pairing> pairBatch(Clock::time_point now);
+
+    /**
+     * @brief Rating gap a player accepts after waiting the given time
+     */
+    int windowFor(Clock::duration waited) const;
+
+    /**
+     * @brief Number of queued players
+     */
+    std::size_t size() const;
+
+private:
+    // Arrival order; the sequence number breaks ties between equal timestamps
+    using QueueKey = std::pair<std::uint64_t, TicketId>;
+
+    struct Ticket {
+        int rating;
+        int bucket;
+        std::uint64_t sequence;
+        Clock::time_point enqueuedAt;
+    };
+
+    Config config;
+    std::uint64_t nextSequence;
+    std::unordered_map<TicketId, Ticket> tickets;
+    std::map<int, std::set<QueueKey>> buckets;  // Only non-empty buckets are kept
+    std::set<QueueKey> arrivalOrder;
+
+    int bucketFor(int rating) const;
+    void unlink(TicketId id, const Ticket& ticket);
+    bool findOpponent(TicketId id, const Ticket& ticket, Clock::time_point now, TicketId& opponent) const;
+};
+
+} // namespace BayouBonanza
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "NetworkProtocol.h" // For MessageType
+#include "WireFormat.h"
+#include <SFML/Network/Packet.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Messages at least this long are compressed for clients with Capability::Compression
+ *
+ * Below it the per-action messages (deltas, events, moves) gain too little
+ * to be worth the CPU.
+ */
+constexpr std::size_t COMPRESSION_THRESHOLD = 192;
+
+/**
+ * @brief Largest message a MessageType::Compressed wrapper may expand to
+ */
+constexpr std::size_t MAX_EXPANDED_BYTES = 1 << 20;
+
+/**
+ * @brief The preset dictionary both ends compress with
+ *
+ * Trained on GameStart, GameStateUpdate, CardCollectionData and DeckData
+ * messages from self-played games, so even a message's first bytes find
+ * matches. Changing it breaks compatibility: a new dictionary needs a new
+ * Capability bit.
+ */
+std::string_view compressionDictionary();
+
+/**
+ * @brief Write a whole message, MessageType byte first, wrapped in MessageType::Compressed
+ *
+ * MessageType::Compressed wire format (see WireWriter):
+ *   varint size of the message it wraps,
+ *   the message as an lzb block compressed against compressionDictionary().
+ * A message that would not get smaller is written as it is instead.
+ *
+ * @return Whether the message was compressed; check @p writer for overflow
+ */
+bool writeCompressed(WireWriter& writer, const char* message, std::size_t size);
+
+/**
+ * @brief Replace a received MessageType::Compressed message with the message it wraps
+ *
+ * Other messages are left alone, so every received packet can go through
+ * here before its MessageType is read.
+ *
+ * @return false if the wrapper is malformed
+ */
+bool expandCompressed(sf::Packet& packet);
+
+/**
+ * @brief The enumerator's name, for reports; "Unknown" past the last one
+ */
+const char* messageTypeName(MessageType type);
+
+/**
+ * @brief Compression ratio and CPU time per message type; thread-safe
+ */
+class CompressionStats {
+public:
+    struct Totals {
+        std::uint64_t messages = 0;   // Over the threshold and offered to the compressor
+        std::uint64_t compressed = 0; // ... of which got smaller and were sent compressed
+        std::uint64_t bytesIn = 0;    // Message bytes offered
+        std::uint64_t bytesOut = 0;   // Bytes sent for them, compressed or not
+        std::uint64_t nanos = 0;      // Spent compressing
+    };
+
+    void record(MessageType type, std::size_t bytesIn, std::size_t bytesOut, bool compressed, std::uint64_t nanos);
+
+    Totals totals(MessageType type) const;
+
+    /**
+     * @brief Print one line per message type seen: count, ratio and time per message
+     */
+    void report(std::ostream& out) const;
+
+private:
+    struct Counters {
+        std::atomic<std::uint64_t> messages{0};
+        std::atomic<std::uint64_t> compressed{0};
+        std::atomic<std::uint64_t> bytesIn{0};
+        std::atomic<std::uint64_t> bytesOut{0};
+        std::atomic<std::uint64_t> nanos{0};
+    };
+
+    static constexpr std::size_t TRACKED_TYPES = 32; // Past the last MessageType, with room to grow
+    std::array<Counters, TRACKED_TYPES> counters;
+};
+
+} // namespace BayouBonanza
@@ -68,9 +68,11 @@ public:
      */
     const std::string& getPromotionType() const;
 
-    // Friend functions for SFML packet operators
-    friend sf::Packet& operator<<(sf::Packet& packet, const Move& mv);
-    friend sf::Packet& operator>>(sf::Packet& packet, Move& mv);
+    // Friend functions for packet operators
+    template <WritablePacket Packet>
+    friend Packet& operator<<(Packet& packet, const Move& mv);
+    template <ReadablePacket Packet>
+    friend Packet& operator>>(Packet& packet, Move& mv);
 
 private:
     std::shared_ptr<Piece> piece_; // The actual piece object, not serialized directly by Move's operators
@@ -80,8 +82,10 @@ private:
     std::string pieceTypePromotedTo_; // Type to promote to by name
 };
 
-// SFML Packet operators for Move
-sf::Packet& operator<<(sf::Packet& packet, const Move& mv);
-sf::Packet& operator>>(sf::Packet& packet, Move& mv);
+// Packet operators for Move, defined for sf::Packet, WireWriter and WireReader
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const Move& mv);
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, Move& mv);
 
 } // namespace BayouBonanza
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/SocketHandle.hpp>
+
+namespace BayouBonanza {
+
+/**
+ * @brief TCP socket that exposes its native handle
+ *
+ * sf::TcpSocket keeps the OS handle protected. The server needs it so the
+ * Reactor can wait on many sockets at once instead of polling each one.
+ */
+class NetSocket : public sf::TcpSocket {
+public:
+    /**
+     * @brief Get the underlying OS socket handle
+     *
+     * @return Native handle, or an invalid handle if the socket is not connected
+     */
+    sf::SocketHandle nativeHandle() const { return getHandle(); }
+
+    /**
+     * @brief Take ownership of an already connected socket
+     *
+     * Used for connections handed over by another server process.
+     */
+    void adopt(sf::SocketHandle handle) {
+        disconnect();
+        create(handle);
+    }
+
+    /**
+     * @brief Outcome of a non-blocking connect() once the socket turns writable
+     *
+     * @return Done if the connection is up, Error if it was refused or failed
+     */
+    sf::Socket::Status finishConnect() const;
+};
+
+/**
+ * @brief TCP listener that exposes its native handle
+ */
+class NetListener : public sf::TcpListener {
+public:
+    /**
+     * @brief Get the underlying OS socket handle
+     *
+     * @return Native handle, or an invalid handle if the listener is not bound
+     */
+    sf::SocketHandle nativeHandle() const { return getHandle(); }
+
+    /**
+     * @brief Listen on a port that other processes may also listen on
+     *
+     * Sets SO_REUSEPORT so several server processes can bind the same port
+     * and let the kernel spread incoming connections between them. Falls
+     * back to a plain listen() where the option does not exist.
+     */
+    sf::Socket::Status listenShared(unsigned short port);
+};
+
+} // namespace BayouBonanza
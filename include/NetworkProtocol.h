@@ -1,29 +1,55 @@
 #pragma once
 #include <SFML/Config.hpp> // For sf::Uint8
 #include <SFML/Network/Packet.hpp> // For sf::Packet, needed for the operators
+#include "WireFormat.h" // For WireWriter and WireReader
 
 enum class MessageType : sf::Uint8 {
-    ConnectionRequest,      // Client to Server: Initial connection (optional, server might just accept)
-    ConnectionAccepted,     // Server to Client: Sent when server accepts the connection
+    ConnectionRequest,      // Client to Server: First message: protocol version, definitions hash, capabilities (see ProtocolHandshake.h)
+    ConnectionAccepted,     // Server to Client: Protocol version and capabilities both sides use from now on
     PlayerAssignment,       // Server to Client: Assigns PlayerSide (PLAYER_ONE or PLAYER_TWO)
     WaitingForOpponent,     // Server to Client: Sent to the first client while waiting for the second
-    GameStart,              // Server to Client: Indicates the game is starting and sends initial GameState
-    MoveToServer,           // Client to Server: Player sends a move
-    CardPlayToServer,       // Client to Server: Player plays a card
+    GameStart,              // Server to Client: Indicates the game is starting: usernames, ratings, initial GameState and its sequence (wire body)
+    MoveToServer,           // Client to Server: Player sends a move (wire body)
+    CardPlayToServer,       // Client to Server: Player plays a card (wire body)
     EndTurn,                // Client to Server: Player ends their turn/advances phase
     MoveRejected,           // Server to Client: Move was invalid (optional, or just send new state)
     CardPlayRejected,       // Server to Client: Card play was invalid (optional)
-    GameStateUpdate,        // Server to Client: Sends the full updated GameState
+    GameStateUpdate,        // Server to Client: Sends the full updated GameState and its sequence (wire body)
     GameOver,               // Server to Client: Announces game over and result (optional for now)
     Error,                  // Server to Client or Client to Server: Generic error message
-    Ping,                   // Client to Server (optional, for keep-alive)
-    Pong,                   // Server to Client (optional, for keep-alive)
-    UserLogin,              // Client to Server: Sends username for login/registration
+    Ping,                   // Either direction: sequence number; answer with a Pong (see Heartbeat.h; wire body)
+    Pong,                   // Either direction: sequence number of the Ping answered (wire body)
+    UserLogin,              // Client to Server: Sends username; without a ConnectionRequest first, also a Uint32 piece definitions hash and optional Uint8 StateUpdateMode
     CardCollectionData,     // Server to Client: Sends player's full card collection
     DeckData,               // Server to Client: Sends the player's deck
     SaveDeck,               // Client to Server: Save deck changes
     DeckSaved,              // Server to Client: Confirmation that deck was saved successfully
-    RequestMatchmaking      // Client to Server: Request to be matched with another player
+    RequestMatchmaking,     // Client to Server: Request to be matched with another player
+    ServerBusy,             // Server to Client: Server is at capacity; Uint32 queue position, 0 if turned away
+    GameStateDelta,         // Server to Client: Changes since a numbered GameState (see GameStateSnapshot; wire body)
+    RequestStateResync,     // Client to Server: A delta or event did not apply; resend the full state
+    GameEvent,              // Server to Client: One action to replay on the last state (see GameEvent; wire body)
+    Compressed,             // Server to Client: Another message, compressed (see MessageCompression.h; wire body)
+    SpectateRequest,        // Client to Server: Watch the game a player (username) is in; GameStart and updates follow
+    LeaderboardRequest,     // Client to Server: How many of the best players, and of the requester's neighbours, to list (see Leaderboard.h; wire body)
+    LeaderboardData         // Server to Client: The best players, and the requester's rank and neighbours (see Leaderboard.h; wire body)
+};
+
+// Messages marked "wire body" above are sent on every action, so past the
+// MessageType byte they are encoded with BayouBonanza::WireWriter rather
+// than sf::Packet. They still travel in sf::Packet framing, so they are
+// sent and received with sf::TcpSocket like the rest.
+
+/**
+ * @brief How the server sends a client the state after each action
+ *
+ * Chosen from the capabilities agreed in the handshake. Clients that log in
+ * without one name the mode in their UserLogin instead.
+ */
+enum class StateUpdateMode : sf::Uint8 {
+    Deltas,     // MessageType::GameStateDelta: the changed squares, scalars and hands
+    Events,     // MessageType::GameEvent: the action to replay, falling back to deltas when there is none
+    FullState   // MessageType::GameStateUpdate: the whole state every time
 };
 
 /**
@@ -39,23 +65,44 @@ struct CardPlayData {
 };
 
 // Packet operators for CardPlayData
-inline sf::Packet& operator<<(sf::Packet& packet, const CardPlayData& data) {
+template <BayouBonanza::WritablePacket Packet>
+Packet& operator<<(Packet& packet, const CardPlayData& data) {
     return packet << data.cardIndex << data.targetX << data.targetY;
 }
 
-inline sf::Packet& operator>>(sf::Packet& packet, CardPlayData& data) {
+template <BayouBonanza::ReadablePacket Packet>
+Packet& operator>>(Packet& packet, CardPlayData& data) {
     return packet >> data.cardIndex >> data.targetX >> data.targetY;
 }
 
-// Operator to stream MessageType into sf::Packet
-inline sf::Packet& operator<<(sf::Packet& packet, MessageType type) {
+// Operator to stream MessageType into a packet
+template <BayouBonanza::WritablePacket Packet>
+Packet& operator<<(Packet& packet, MessageType type) {
     return packet << static_cast<sf::Uint8>(type);
 }
 
-// Operator to stream MessageType from sf::Packet
-inline sf::Packet& operator>>(sf::Packet& packet, MessageType& type) {
+// Operator to stream MessageType from a packet
+template <BayouBonanza::ReadablePacket Packet>
+Packet& operator>>(Packet& packet, MessageType& type) {
     sf::Uint8 val;
     packet >> val;
     type = static_cast<MessageType>(val);
     return packet;
 }
+
+// The body of a wire-body message received as an sf::Packet, past its MessageType byte.
+// Reads straight from the packet, which must outlive the reader.
+inline BayouBonanza::WireReader messageBody(const sf::Packet& packet) {
+    if (packet.getDataSize() < sizeof(sf::Uint8)) {
+        return BayouBonanza::WireReader(nullptr, 0);
+    }
+    return BayouBonanza::WireReader(static_cast<const char*>(packet.getData()) + sizeof(sf::Uint8),
+                                    packet.getDataSize() - sizeof(sf::Uint8));
+}
+
+// Wrap a wire-body message, MessageType byte first, for sf::TcpSocket::send
+inline sf::Packet wirePacket(const BayouBonanza::WireWriter& writer) {
+    sf::Packet packet;
+    packet.append(writer.getData(), writer.getDataSize());
+    return packet;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketHandle.hpp>
+#include "WireFormat.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Allocator whose default construction leaves the element uninitialized
+ *
+ * A vector using it grows without zero-filling the new bytes, which is all a
+ * frame buffer about to be written over needs.
+ */
+template <typename T>
+struct UninitializedAllocator : std::allocator<T> {
+    UninitializedAllocator() noexcept = default;
+    template <typename U>
+    UninitializedAllocator(const UninitializedAllocator<U>&) noexcept {}
+
+    template <typename U>
+    struct rebind {
+        using other = UninitializedAllocator<U>;
+    };
+
+    template <typename U>
+    void construct(U* place) noexcept {
+        ::new (static_cast<void*>(place)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* place, Args&&... args) {
+        ::new (static_cast<void*>(place)) U(std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * @brief Bounded per-connection queue of encoded packets awaiting a write
+ *
+ * Producers (the reactor thread and session strands) push immutable framed
+ * packets; the reactor thread flushes them when the socket is writable.
+ * Everything queued since the last flush goes out in a single scatter/gather
+ * write, so a tick that produces several small messages costs one syscall.
+ * A frame can be shared between many queues, which lets a broadcast be
+ * serialized once.
+ *
+ * If a peer stops reading and the queued bytes would exceed the high-water
+ * mark, push() refuses the frame and the owner is expected to drop the
+ * connection.
+ */
+class OutboundQueue {
+public:
+    /**
+     * @brief Bytes of a frame; resizing them does not clear what the encoder is about to overwrite
+     */
+    using Bytes = std::vector<char, UninitializedAllocator<char>>;
+
+    /**
+     * @brief Wire-ready bytes of one packet (length prefix included)
+     */
+    using Frame = std::shared_ptr<const Bytes>;
+
+    /**
+     * @brief Outcome of queueing a frame
+     */
+    enum class PushResult {
+        Queued,         // Added; a flush is already scheduled
+        ScheduleFlush,  // Added; caller must arrange a flush
+        OverHighWater,  // Refused: peer is too far behind
+        Closed          // Refused: connection is gone
+    };
+
+    /**
+     * @brief Outcome of a flush attempt
+     */
+    enum class FlushResult {
+        Drained,        // Everything was written
+        WouldBlock,     // Socket buffer full; wait for writability
+        Error           // Write failed; connection is unusable
+    };
+
+    /**
+     * @brief Counters describing the queue's activity
+     */
+    struct Stats {
+        std::size_t queuedBytes = 0;      // Bytes waiting right now
+        std::size_t maxQueuedBytes = 0;   // Highest backlog observed
+        std::uint64_t framesQueued = 0;   // Frames accepted
+        std::uint64_t writeCalls = 0;     // Write syscalls issued
+        std::uint64_t bytesWritten = 0;   // Bytes handed to the kernel
+    };
+
+    /**
+     * @param highWaterBytes Largest backlog allowed before push() refuses frames
+     */
+    explicit OutboundQueue(std::size_t highWaterBytes);
+
+    /**
+     * @brief Encode a packet the way sf::TcpSocket would send it
+     */
+    static Frame makeFrame(const sf::Packet& packet);
+
+    /**
+     * @brief Queue a frame; thread-safe
+     */
+    PushResult push(Frame frame);
+
+    /**
+     * @brief Write as much of the backlog as the socket accepts without blocking
+     *
+     * @param handle Non-blocking socket to write to
+     */
+    FlushResult flush(sf::SocketHandle handle);
+
+    /**
+     * @brief Drop the backlog and refuse further frames
+     */
+    void close();
+
+    /**
+     * @brief Snapshot of the counters
+     */
+    Stats stats() const;
+
+private:
+    mutable std::mutex mutex;
+    std::deque<Frame> frames;
+    std::size_t headOffset;     // Bytes of frames.front() already written
+    std::size_t highWater;
+    bool flushScheduled;
+    bool closed;
+    Stats counters;
+
+    // Drop fully written frames after a write of 'written' bytes
+    void consume(std::size_t written);
+};
+
+/**
+ * @brief Recycles frame buffers so encoding a message allocates nothing
+ *
+ * build() hands the message a WireWriter over a pooled buffer, just past
+ * room for the length prefix, and fills in the prefix afterwards. A
+ * buffer goes back on the pool's free list when the last queue holding
+ * its frame drops it, so taking one is O(1) rather than a search. A
+ * message too big for its buffer is written again into a larger one, and
+ * that buffer keeps its allocation in the pool up to maxBufferBytes;
+ * beyond that it is freed on release. Buffers are resized without being
+ * cleared (OutboundQueue::Bytes), so a small frame in a large buffer costs
+ * only the bytes it writes.
+ */
+class FramePool {
+public:
+    /**
+     * @brief Counters describing the pool's activity
+     */
+    struct Stats {
+        std::uint64_t buffersTaken = 0;   // Buffers build() wrote into
+        std::uint64_t buffersReused = 0;  // ... of which were recycled rather than allocated
+        std::size_t pooledBuffers = 0;    // Buffers the pool owns
+    };
+
+    /**
+     * @param frameBytes Starting capacity of each buffer, length prefix included
+     * @param maxBuffers Buffers kept for reuse; beyond that frames are allocated and freed
+     * @param maxBufferBytes Largest allocation a released buffer may keep in the pool
+     */
+    explicit FramePool(std::size_t frameBytes = 1024, std::size_t maxBuffers = 4096,
+                       std::size_t maxBufferBytes = 64 * 1024);
+
+    /**
+     * @brief Encode one frame: @p write appends the payload to the WireWriter it is given
+     *
+     * @p write may be called more than once and must write the same bytes each time.
+     *
+     * @return The frame, or nullptr if the payload does not fit in MAX_FRAME_BYTES
+     */
+    template <typename Write>
+    OutboundQueue::Frame build(Write&& write) {
+        for (std::size_t capacity = frameBytes; capacity <= MAX_FRAME_BYTES; capacity *= 2) {
+            std::shared_ptr<OutboundQueue::Bytes> buffer = acquire(capacity);
+            WireWriter writer(buffer->data() + PREFIX_BYTES, buffer->size() - PREFIX_BYTES);
+            write(writer);
+            if (writer) {
+                finish(*buffer, writer.getDataSize());
+                return buffer;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Snapshot of the counters; thread-safe
+     */
+    Stats stats() const;
+
+    static constexpr std::size_t PREFIX_BYTES = 4;
+    static constexpr std::size_t MAX_FRAME_BYTES = 1 << 20;
+
+private:
+    // Released buffers, and the counters; shared with the frames' deleters, which may outlive the pool
+    struct FreeList {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<OutboundQueue::Bytes>> buffers;
+        Stats counters;
+    };
+
+    std::shared_ptr<FreeList> freeList;
+    std::size_t frameBytes;
+    std::size_t maxBuffers;
+    std::size_t maxBufferBytes;
+
+    // A buffer of at least 'capacity' bytes that no queue holds, sized to it
+    std::shared_ptr<OutboundQueue::Bytes> acquire(std::size_t capacity);
+    // Trim the buffer to its payload and write the length prefix
+    static void finish(OutboundQueue::Bytes& buffer, std::size_t payloadSize);
+};
+
+} // namespace BayouBonanza
@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstdint>
 #include "PlayerSide.h"
 #include <SFML/Config.hpp> // For sf::Uint8
 #include <SFML/Network/Packet.hpp> // For sf::Packet
@@ -17,12 +18,14 @@ class Square;
 
 // Note: Position struct is defined in PieceData.h and imported via include
 
-// SFML Packet operators for Position
-inline sf::Packet& operator<<(sf::Packet& packet, const Position& position) {
+// Packet operators for Position
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const Position& position) {
     return packet << static_cast<sf::Int32>(position.x) << static_cast<sf::Int32>(position.y);
 }
 
-inline sf::Packet& operator>>(sf::Packet& packet, Position& position) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, Position& position) {
     sf::Int32 x, y;
     packet >> x >> y;
     position.x = static_cast<int>(x);
@@ -113,6 +116,7 @@ public:
     virtual std::vector<Position> getInfluenceArea(const GameBoard& board) const; // Kept virtual, implementation will be in .cpp
     virtual std::string getTypeName() const;
     virtual std::string getSymbol() const;
+    PieceTypeId getTypeId() const { return stats.typeId; } // Wire ID; INVALID_PIECE_TYPE_ID if not from PieceDefinitionManager
     bool isVictoryPiece() const;
     bool isRanged() const;
     bool canJump() const;
@@ -124,6 +128,22 @@ public:
     int getCooldown() const;
     int getStunRemaining() const { return stunRemaining; }
 
+    /**
+     * @brief Zobrist key of this piece as it stands on its square (see GameBoard::hash())
+     */
+    std::uint64_t hashKey() const;
+
+    /**
+     * @brief Keep a board hash up to date as this piece changes
+     *
+     * Called by Square when the piece is placed or taken off; every setter
+     * then swaps the piece's old key for its new one in @p sink.
+     *
+     * @param sink Board hash to update, or nullptr to stop
+     * @param slot Index of the square the piece stands on
+     */
+    void attachHash(std::uint64_t* sink, std::uint64_t slot);
+
 protected:
     PlayerSide side;
     int attack; // Will be initialized from stats
@@ -133,15 +153,22 @@ protected:
     PieceStats stats; // Changed from const PieceStats& to PieceStats (store by value)
     int stunRemaining{0};
 
+private:
+    std::uint64_t* hashSink = nullptr; // Hash of the board the piece is on, if any
+    std::uint64_t hashSlot = 0;
+
+    // Swap the key the piece had before a change for its current one
+    void rehash(std::uint64_t keyBefore);
+
 public:
-    void setHasMoved(bool moved) { hasMoved = moved; }
+    void setHasMoved(bool moved);
     bool getHasMoved() const { return hasMoved; }
 };
 
-// SFML Packet operators for Piece (common data)
-// Piece type and player side are handled externally by Square/Factory
-inline sf::Packet& operator<<(sf::Packet& packet, const Piece& piece) {
-    packet << piece.getSymbol(); // Using getSymbol()
+// Packet operators for Piece (common data)
+// Piece type and player side are handled externally by Square/Factory; the symbol comes from the type's stats
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const Piece& piece) {
     packet << piece.getPosition();
     packet << static_cast<sf::Int32>(piece.getHealth());
     packet << static_cast<sf::Int32>(piece.getAttack());
@@ -150,20 +177,17 @@ inline sf::Packet& operator<<(sf::Packet& packet, const Piece& piece) {
     return packet;
 }
 
-inline sf::Packet& operator>>(sf::Packet& packet, Piece& piece) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, Piece& piece) {
     // Assumes 'piece' is an already-created concrete object of the correct type and side.
-    // PlayerSide and piece type name should have been read by the caller (e.g., Square deserialization)
-    // and used with PieceFactory to create 'piece'. The symbol is now derived from stats.
-    std::string receivedSymbol; // Renamed to avoid conflict if symbol is a member or for clarity
+    // PlayerSide and piece type ID should have been read by the caller (e.g., Square deserialization)
+    // and used with PieceFactory to create 'piece'. The symbol is derived from stats.
     Position position;
     sf::Int32 health, attack;
     bool hasMovedFlag;
     sf::Int32 stun;
 
-    packet >> receivedSymbol >> position >> health >> attack >> hasMovedFlag >> stun;
-
-    // Verify symbol if necessary, though it's usually fixed by type.
-    // if (receivedSymbol != piece.getSymbol()) { /* handle error or warning */ }
+    packet >> position >> health >> attack >> hasMovedFlag >> stun;
 
     piece.setPosition(position);
     piece.setHealth(static_cast<int>(health));
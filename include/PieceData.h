@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -32,8 +33,13 @@ struct PieceMovementRule {
     int maxRange{1};
 };
 
+// Compact piece type number used on the wire; assigned by PieceDefinitionManager at load time
+using PieceTypeId = std::uint8_t;
+constexpr PieceTypeId INVALID_PIECE_TYPE_ID = 0xFF;
+
 struct PieceStats {
     std::string typeName;
+    PieceTypeId typeId{INVALID_PIECE_TYPE_ID};
     std::string symbol;
     // Path to static sprite image (optional)
     std::string spritePath;
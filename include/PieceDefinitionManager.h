@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -21,13 +22,44 @@ public:
     // Retrieves stats for a piece type
     const PieceStats* getPieceStats(const std::string& typeName) const;
 
+    /**
+     * @brief Retrieves stats by compact type ID; O(1), used when decoding pieces from the wire
+     *
+     * @return nullptr if no type has this ID
+     */
+    const PieceStats* getPieceStats(PieceTypeId typeId) const;
+
+    /**
+     * @brief Compact ID of a piece type, or INVALID_PIECE_TYPE_ID if it is unknown
+     *
+     * IDs are assigned at load time in type-name order, so two processes that
+     * loaded the same definitions agree on them; compare getDefinitionsHash()
+     * to check that they did.
+     */
+    PieceTypeId getPieceTypeId(const std::string& typeName) const;
+
+    /**
+     * @brief Hash of the loaded definitions, including the ID assignment
+     *
+     * Exchanged at login so clients whose definitions differ from the
+     * server's are turned away instead of misreading piece IDs.
+     */
+    std::uint32_t getDefinitionsHash() const { return definitionsHash; }
+
+    // Number of loaded piece types; valid IDs are 0 .. count - 1
+    std::size_t getPieceTypeCount() const { return statsById.size(); }
+
     // Get all loaded type names (optional, but useful for UI/debugging)
     std::vector<std::string> getAllPieceTypeNames() const;
 
 private:
     std::map<std::string, PieceStats> pieceStatsMap;
+    std::vector<const PieceStats*> statsById; // Indexed by PieceTypeId; points into pieceStatsMap
+    std::uint32_t definitionsHash;
     bool loadedSuccessfully;
 
+    void assignTypeIds();
+
     // If using nlohmann::json, a helper might be useful
     // void parsePieceStats(const nlohmann::json& j, PieceStats& stats);
     // void parseMovementRule(const nlohmann::json& jRule, PieceMovementRule& moveRule);
@@ -17,6 +17,11 @@ public:
     // createPiece takes a type name string allowing for data-driven pieces
     std::unique_ptr<Piece> createPiece(const std::string& typeName, PlayerSide side);
 
+    // Create from a compact type ID (see PieceDefinitionManager::getPieceTypeId); O(1) lookup
+    std::unique_ptr<Piece> createPiece(PieceTypeId typeId, PlayerSide side);
+
+    const PieceDefinitionManager& getDefinitionManager() const { return definitionManager; }
+
 private:
     const PieceDefinitionManager& definitionManager;
 };
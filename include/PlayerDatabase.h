@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief The server's accounts: ratings, card collections and decks in SQLite
+ *
+ * Every query goes through a typed method here. Collections and decks are
+ * stored packed (CardCollection::pack(), Deck::pack()) and handed in and
+ * out that way; the database does not look inside. Connections are opened
+ * once and pooled rather than opened per request: each is put in WAL mode
+ * (readers never wait for the writer, and the server processes sharing
+ * the file do not block each other's reads) with synchronous=NORMAL, and
+ * keeps its compiled statements in a cache keyed by the SQL text, so a
+ * request costs only binding and stepping.
+ *
+ * Thread-safe. A call borrows a connection for its duration; when all of
+ * them are busy it waits for one, so maxConnections bounds the number of
+ * threads inside SQLite at once.
+ */
+class PlayerDatabase {
+public:
+    struct Options {
+        std::string path = "bayou_bonanza.db";
+        std::size_t maxConnections = 4;
+        std::chrono::milliseconds busyTimeout{5000}; // Wait this long for another process's write lock
+    };
+
+    /**
+     * @brief What loadUser() found, or created for a first login
+     */
+    struct UserProfile {
+        int rating = 0;
+        std::string collection; // CardCollection::pack()
+        std::string deck;       // Deck::pack()
+        bool created = false;   // Some of it was missing and was stored from the defaults
+    };
+
+    /**
+     * @brief What a user starts with; fills in whatever loadUser() does not find
+     */
+    struct NewUser {
+        int rating = 0;
+        std::string collection;
+        std::string deck;
+    };
+
+    struct RatingUpdate {
+        std::string username;
+        int rating = 0;
+    };
+
+    /**
+     * @brief One change to a user's rows; built with createUser(), deckSave() or ratingSet()
+     */
+    struct Write {
+        enum class Kind {
+            CreateUser, // Store whichever of the user, collection and deck are missing
+            SaveDeck,
+            SetRating   // Fails if the user does not exist
+        };
+        Kind kind = Kind::SaveDeck;
+        std::string username;
+        int rating = 0;         // CreateUser, SetRating
+        std::string collection; // CreateUser
+        std::string deck;       // CreateUser, SaveDeck
+    };
+
+    /**
+     * @brief Writes stored all or none
+     */
+    using WriteGroup = std::vector<Write>;
+
+    static Write createUser(const std::string& username, const NewUser& user);
+    static Write deckSave(const std::string& username, const std::string& deck);
+    static Write ratingSet(const std::string& username, int rating);
+
+    /**
+     * @brief Counters describing connection and statement reuse
+     */
+    struct Stats {
+        std::uint64_t connectionsOpened = 0;
+        std::uint64_t statementsPrepared = 0; // Compiled; once per distinct SQL per connection
+        std::uint64_t statementsReused = 0;   // Taken from a connection's cache instead
+    };
+
+    /**
+     * @brief The schema initializeSchema() brings a database to, recorded in PRAGMA user_version
+     *
+     * 1: collections and decks as text; 2: packed; 3: users indexed by rating.
+     */
+    static constexpr int SCHEMA_VERSION = 3;
+
+    PlayerDatabase();
+    explicit PlayerDatabase(Options options);
+
+    /**
+     * @brief Close the pooled connections; no call may still be running
+     */
+    ~PlayerDatabase();
+
+    PlayerDatabase(const PlayerDatabase&) = delete;
+    PlayerDatabase& operator=(const PlayerDatabase&) = delete;
+
+    /**
+     * @brief Create the tables, or migrate an older database in place up to SCHEMA_VERSION
+     *
+     * Each version step runs in its own transaction, so an interrupted
+     * migration leaves the database at the last version completed. Packing
+     * needs the card definitions (CardFactory): a stored collection or deck
+     * that does not parse rolls the step back rather than lose it, and the
+     * text tables are kept as collections_v1 and decks_v1.
+     *
+     * @return false if the database cannot be opened or changed
+     */
+    bool initializeSchema();
+
+    /**
+     * @brief Read a user's rating, collection and deck with one statement, taking @p defaults for any that are missing
+     *
+     * Nothing is written; when the profile comes back created, storing it
+     * is up to the caller (see createUser()).
+     *
+     * @return The profile, or nothing if the database failed
+     */
+    std::optional<UserProfile> readUser(const std::string& username, const NewUser& defaults);
+
+    /**
+     * @brief Every user's rating, highest first (ties by username), for seeding a Leaderboard
+     *
+     * @return The ratings, or nothing if the database failed
+     */
+    std::optional<std::vector<RatingUpdate>> readRatings();
+
+    /**
+     * @brief readUser(), then store whatever was missing
+     */
+    std::optional<UserProfile> loadUser(const std::string& username, const NewUser& defaults);
+
+    /**
+     * @brief Replace a user's deck
+     */
+    bool saveDeck(const std::string& username, const std::string& deck);
+
+    /**
+     * @brief Store new ratings, all of them or none
+     */
+    bool updateRatings(const std::vector<RatingUpdate>& ratings);
+
+    /**
+     * @brief Store several groups of writes in one transaction
+     *
+     * Each group gets a savepoint, so one that fails is undone without
+     * taking the others with it. One commit for the lot is what makes
+     * batching cheaper than writing each group on its own.
+     *
+     * @return Whether each group was stored, in order
+     */
+    std::vector<bool> applyWrites(const std::vector<WriteGroup>& groups);
+
+    Stats stats() const;
+
+private:
+    class Connection;
+    class Lease;
+
+    // A pooled connection, or a new one while fewer than maxConnections are open;
+    // nullptr if opening failed
+    std::unique_ptr<Connection> acquire();
+    void release(std::unique_ptr<Connection> connection);
+
+    Options config;
+    std::mutex mutex;
+    std::condition_variable connectionReturned;
+    std::vector<std::unique_ptr<Connection>> idle;
+    std::size_t openConnections = 0; // Idle or borrowed
+    std::atomic<std::uint64_t> connectionsOpened{0};
+    std::atomic<std::uint64_t> statementsPrepared{0};
+    std::atomic<std::uint64_t> statementsReused{0};
+};
+
+} // namespace BayouBonanza
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Config.hpp> // For sf::Uint8
 #include <SFML/Network/Packet.hpp> // For sf::Packet
+#include "WireFormat.h" // For WireWriter and WireReader
 
 namespace BayouBonanza {
 
@@ -13,12 +14,22 @@ enum class PlayerSide {
     NEUTRAL      // Used for squares with equal control or no control
 };
 
-// SFML Packet operators for PlayerSide
-inline sf::Packet& operator<<(sf::Packet& packet, const PlayerSide& side) {
+/**
+ * @brief Viewer of a spectator's projection of the state (see GameStateSnapshot, GameState::hash())
+ *
+ * Seated on neither side, so both hands are hidden. Not a side the game
+ * itself uses, and never sent as a PlayerSide.
+ */
+constexpr PlayerSide SPECTATOR_VIEWER = static_cast<PlayerSide>(3);
+
+// Packet operators for PlayerSide
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const PlayerSide& side) {
     return packet << static_cast<sf::Uint8>(side);
 }
 
-inline sf::Packet& operator>>(sf::Packet& packet, PlayerSide& side) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, PlayerSide& side) {
     sf::Uint8 side_uint8;
     packet >> side_uint8;
     side = static_cast<PlayerSide>(side_uint8);
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CardCollection.h"
+#include "DatabaseWriter.h"
+#include "PlayerDatabase.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Recently used player profiles, parsed and held in memory, written back in the background
+ *
+ * A player who logs in again while their profile is cached costs no
+ * database read and no parsing. Changes (ratings, decks) are made to the
+ * cached profile and marked dirty; flush() hands the dirty ones to the
+ * DatabaseWriter, as does evicting one. Profiles that are not cached are
+ * written through instead.
+ *
+ * The cache holds at most capacity profiles, dropping the least recently
+ * used. A profile is never read back from the database while a write of
+ * it is still queued, so an evicted change cannot be lost to a stale read.
+ *
+ * Thread-safe. Only this process's changes are seen: another process
+ * writing the same database would leave cached profiles stale.
+ */
+class ProfileCache {
+public:
+    /**
+     * @brief A user's rating, collection and deck, parsed
+     */
+    struct Profile {
+        int rating = 0;
+        CardCollection collection;
+        Deck deck;
+    };
+
+    struct Options {
+        std::size_t capacity = 10000; // Profiles; each is a few KB of cards
+    };
+
+    /**
+     * @brief Counters describing how well the cache does
+     */
+    struct Stats {
+        std::uint64_t hits = 0;      // Profiles served from memory
+        std::uint64_t misses = 0;    // ... read from the database instead
+        std::uint64_t evictions = 0;
+        std::uint64_t writes = 0;    // Groups handed to the writer: flushes, evictions and write-throughs
+        std::uint64_t failedWrites = 0;
+        std::size_t size = 0;
+        std::size_t dirty = 0;       // Cached with changes not yet handed to the writer
+    };
+
+    ProfileCache(PlayerDatabase& database, DatabaseWriter& writer);
+    ProfileCache(PlayerDatabase& database, DatabaseWriter& writer, Options options);
+
+    /**
+     * @brief Flush, and wait for the writer to finish with this cache's writes
+     */
+    ~ProfileCache();
+
+    ProfileCache(const ProfileCache&) = delete;
+    ProfileCache& operator=(const ProfileCache&) = delete;
+
+    /**
+     * @brief The cached profile, if there is one; never touches the database
+     */
+    std::optional<Profile> find(const std::string& username);
+
+    /**
+     * @brief The cached profile, or read it from the database and cache it
+     *
+     * A first login gets @p defaults, which are queued to be stored. A
+     * stored collection or deck that does not unpack is replaced by the
+     * default one, and logged. May block on SQLite, so call it from a
+     * worker thread.
+     *
+     * @return The profile, or nothing if the database or the defaults failed
+     */
+    std::optional<Profile> load(const std::string& username, const PlayerDatabase::NewUser& defaults);
+
+    /**
+     * @brief Change users' ratings; those not cached are written through together, all or none
+     */
+    void setRatings(const std::vector<PlayerDatabase::RatingUpdate>& ratings);
+
+    /**
+     * @brief Change a user's deck
+     */
+    void setDeck(const std::string& username, const Deck& deck);
+
+    /**
+     * @brief Hand every dirty profile to the writer
+     *
+     * @return The number of profiles queued
+     */
+    std::size_t flush();
+
+    Stats stats() const;
+
+    /**
+     * @brief Print one line: size, hit rate, evictions and writes
+     */
+    void report(std::ostream& out) const;
+
+private:
+    struct Entry {
+        std::string username;
+        Profile profile;
+        bool ratingDirty = false;
+        bool deckDirty = false;
+    };
+
+    // Move the entry to the front of the LRU list
+    void touch(std::list<Entry>::iterator entry);
+
+    // The dirty parts of an entry as tracked writes, marking it clean
+    PlayerDatabase::WriteGroup takeDirty(Entry& entry);
+
+    // Drop least recently used entries over capacity, collecting their dirty parts
+    void evictOverCapacity(std::vector<PlayerDatabase::WriteGroup>& writes);
+
+    // Count writes as in flight; done under the lock that made them, so no read slips in between
+    void track(const PlayerDatabase::WriteGroup& writes);
+
+    // Hand tracked writes to the writer; called without the lock, since a stopped writer completes at once
+    void submit(std::vector<PlayerDatabase::WriteGroup> writes);
+
+    // Writer completion: stop tracking, mark failed changes dirty again, and drop a profile never stored
+    void landed(const PlayerDatabase::WriteGroup& writes, bool stored);
+
+    PlayerDatabase& database;
+    DatabaseWriter& writer;
+    Options config;
+
+    mutable std::mutex mutex;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::unordered_set<std::string> dirty;
+    std::unordered_map<std::string, int> writesInFlight; // By username; a read waits for these
+    std::condition_variable writeLanded;
+    Stats counters; // size and dirty are filled in by stats()
+};
+
+} // namespace BayouBonanza
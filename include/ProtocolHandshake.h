@@ -0,0 +1,112 @@
+#pragma once
+
+#include "NetworkProtocol.h" // For StateUpdateMode
+#include <SFML/Config.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <string>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Version of the wire protocol this build speaks
+ *
+ * Bumped when a message changes in a way an older peer would misread.
+ * Optional encodings do not need a bump: they get a Capability instead.
+ */
+constexpr sf::Uint16 PROTOCOL_VERSION = 1;
+
+/**
+ * @brief Oldest client protocol version the server still serves
+ */
+constexpr sf::Uint16 MIN_PROTOCOL_VERSION = 1;
+
+/**
+ * @brief Optional encodings a peer understands, one bit each
+ *
+ * Bits are only ever added. A peer ignores bits it does not know, so a new
+ * encoding can ship to clients before servers, or the other way round.
+ */
+enum class Capability : sf::Uint32 {
+    StateDeltas = 1u << 0, // MessageType::GameStateDelta instead of a GameStateUpdate per action
+    GameEvents  = 1u << 1, // MessageType::GameEvent to replay, with deltas where there is no event
+    Compression = 1u << 2, // MessageType::Compressed around large messages, with the built-in dictionary
+    Heartbeat   = 1u << 3  // Answers the server's MessageType::Ping; connections that stop answering are dropped
+};
+
+using CapabilitySet = sf::Uint32;
+
+constexpr CapabilitySet capabilityBit(Capability capability) {
+    return static_cast<CapabilitySet>(capability);
+}
+
+constexpr bool hasCapability(CapabilitySet set, Capability capability) {
+    return (set & capabilityBit(capability)) != 0;
+}
+
+/**
+ * @brief Every capability this build implements
+ */
+constexpr CapabilitySet SUPPORTED_CAPABILITIES =
+    capabilityBit(Capability::StateDeltas) | capabilityBit(Capability::GameEvents) |
+    capabilityBit(Capability::Compression) | capabilityBit(Capability::Heartbeat);
+
+/**
+ * @brief What a client sends in MessageType::ConnectionRequest, before its UserLogin
+ */
+struct ConnectionRequestData {
+    sf::Uint16 protocolVersion = PROTOCOL_VERSION;
+    sf::Uint32 definitionsHash = 0; // PieceDefinitionManager::getDefinitionsHash(); piece type IDs depend on it
+    CapabilitySet capabilities = 0;
+};
+
+/**
+ * @brief What the server answers in MessageType::ConnectionAccepted
+ */
+struct ConnectionAcceptedData {
+    sf::Uint16 protocolVersion = PROTOCOL_VERSION; // Version both sides speak from now on
+    CapabilitySet capabilities = 0;                // Capabilities both sides have; the server uses only these
+};
+
+/**
+ * @brief Outcome of a ConnectionRequest
+ */
+struct HandshakeResult {
+    bool accepted = false;
+    std::string refusal;         // Why not, for the MessageType::Error sent back
+    ConnectionAcceptedData reply;
+};
+
+/**
+ * @brief Decide whether and how to talk to a client
+ *
+ * The client is refused if it is older than MIN_PROTOCOL_VERSION or its
+ * piece definitions differ from the server's. Otherwise both sides use the
+ * lower of the two versions and the capabilities they share.
+ *
+ * @param definitionsHash The server's piece definitions hash
+ * @param serverCapabilities What the server offers; SUPPORTED_CAPABILITIES unless some are turned off
+ */
+HandshakeResult negotiateConnection(const ConnectionRequestData& request, sf::Uint32 definitionsHash,
+                                    CapabilitySet serverCapabilities = SUPPORTED_CAPABILITIES);
+
+/**
+ * @brief Capabilities implied by a UserLogin from a client that skipped the handshake
+ *
+ * Such clients predate it, and all of them understand GameStateDelta.
+ */
+CapabilitySet legacyLoginCapabilities(StateUpdateMode requested);
+
+/**
+ * @brief The cheapest message a client with @p capabilities understands for a state update
+ *
+ * @param haveEvent Whether the update came from an action there is a GameEvent for
+ */
+StateUpdateMode stateUpdateModeFor(CapabilitySet capabilities, bool haveEvent = true);
+
+// Packet operators for the handshake messages. Fields a later version appends are left unread.
+sf::Packet& operator<<(sf::Packet& packet, const ConnectionRequestData& request);
+sf::Packet& operator>>(sf::Packet& packet, ConnectionRequestData& request);
+sf::Packet& operator<<(sf::Packet& packet, const ConnectionAcceptedData& reply);
+sf::Packet& operator>>(sf::Packet& packet, ConnectionAcceptedData& reply);
+
+} // namespace BayouBonanza
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <SFML/Network/SocketHandle.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "TimerWheel.h"
+
+namespace BayouBonanza {
+
+/**
+ * @brief Readiness-based event loop for server sockets
+ *
+ * Callers register native socket handles together with a callback that is
+ * invoked only when the handle becomes readable or writable, so idle
+ * connections cost no CPU and no thread. Uses epoll on Linux and falls back
+ * to poll() (WSAPoll on Windows) on other platforms.
+ *
+ * The Reactor is single-threaded: register/modify/remove and all callbacks
+ * must happen on the thread that calls run(). Other threads hand work back
+ * to the loop with post(). Timeouts are scheduled on timers(), whose next
+ * deadline bounds how long run() sleeps.
+ */
+class Reactor {
+public:
+    /**
+     * @brief Readiness flags passed to handlers and used as interest masks
+     */
+    enum Event : unsigned {
+        Readable = 1u << 0,
+        Writable = 1u << 1,
+        Hangup   = 1u << 2   // Peer closed or socket error; handler should read to find out
+    };
+
+    /**
+     * @brief Callback invoked with the Event flags that are ready
+     */
+    using Handler = std::function<void(unsigned events)>;
+
+    /**
+     * @brief Work queued from another thread to run on the loop thread
+     */
+    using Task = std::function<void()>;
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief Check that the OS polling backend was created
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Start watching a handle
+     *
+     * @param handle Native socket handle
+     * @param interest Combination of Readable/Writable
+     * @param handler Callback invoked when the handle is ready
+     * @return true if the handle was registered
+     */
+    bool add(sf::SocketHandle handle, unsigned interest, Handler handler);
+
+    /**
+     * @brief Change the interest mask of a registered handle
+     */
+    bool modify(sf::SocketHandle handle, unsigned interest);
+
+    /**
+     * @brief Stop watching a handle
+     *
+     * Safe to call from inside the handle's own callback. Must be called
+     * before the socket is closed.
+     */
+    void remove(sf::SocketHandle handle);
+
+    /**
+     * @brief Wait for readiness once and dispatch callbacks
+     *
+     * @param timeoutMs Maximum time to wait; -1 waits indefinitely
+     * @return Number of callbacks dispatched
+     */
+    int runOnce(int timeoutMs);
+
+    /**
+     * @brief Queue a task to run on the loop thread and wake the loop
+     *
+     * Thread-safe. Tasks run in posting order after the current batch of
+     * readiness callbacks.
+     */
+    void post(Task task);
+
+    /**
+     * @brief Dispatch events until stop() is called
+     */
+    void run();
+
+    /**
+     * @brief Make run() return after the current iteration; thread-safe
+     */
+    void stop();
+
+    /**
+     * @brief Number of registered handles
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Timer wheel advanced by the loop; only use from the loop thread
+     */
+    TimerWheel& timers();
+
+private:
+    struct Entry {
+        sf::SocketHandle handle;
+        unsigned interest;
+        Handler handler;
+    };
+
+    std::unordered_map<sf::SocketHandle, std::shared_ptr<Entry>> entries;
+    std::atomic<bool> running;
+
+    std::mutex postMutex;
+    std::vector<Task> posted;
+
+    TimerWheel timerWheel;
+
+    // Run queued tasks and due timers; returns how many ran
+    int runPosted();
+
+    // Interrupt a blocking wait so posted tasks are picked up
+    void wake();
+
+#if defined(__linux__)
+    int epollFd;
+    int wakeFd;        // eventfd signalled by post()
+#elif defined(_WIN32)
+    sf::SocketHandle wakeSockets[2]; // Connected loopback pair signalled by post(); WSAPoll only watches sockets
+#else
+    int wakePipe[2];   // Self-pipe signalled by post()
+#endif
+};
+
+} // namespace BayouBonanza
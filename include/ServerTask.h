@@ -0,0 +1,92 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "Reactor.h"
+#include "WorkerPool.h"
+
+namespace BayouBonanza {
+
+/**
+ * @brief Fire-and-forget coroutine for server connection flows
+ *
+ * Starts running as soon as it is called and frees its own frame when it
+ * returns, so callers do not hold on to it. Every awaitable used with it
+ * resumes on the reactor thread, which means the code between two co_awaits
+ * never races with reactor callbacks.
+ */
+class ServerTask {
+public:
+    struct promise_type {
+        ServerTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            try {
+                throw;
+            } catch (const std::exception& e) {
+                std::cerr << "ServerTask: unhandled exception: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "ServerTask: unhandled unknown exception" << std::endl;
+            }
+        }
+    };
+};
+
+/**
+ * @brief Awaitable that runs a callable on the WorkerPool, then resumes on the reactor
+ *
+ * Use it for blocking work such as database access so that the reactor
+ * thread keeps accepting and serving other connections meanwhile.
+ */
+template <typename Fn>
+class OffloadAwaiter {
+public:
+    using Result = std::invoke_result_t<Fn&>;
+    static_assert(!std::is_void_v<Result>, "Offloaded work must return a value");
+
+    OffloadAwaiter(WorkerPool& pool, Reactor& reactor, Fn fn)
+        : pool(pool), reactor(reactor), fn(std::move(fn)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        pool.submit([this, handle]() {
+            try {
+                result.emplace(fn());
+            } catch (...) {
+                error = std::current_exception();
+            }
+            reactor.post([handle]() { handle.resume(); });
+        });
+    }
+
+    Result await_resume() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*result);
+    }
+
+private:
+    WorkerPool& pool;
+    Reactor& reactor;
+    Fn fn;
+    std::optional<Result> result;
+    std::exception_ptr error;
+};
+
+/**
+ * @brief Run fn on the pool and co_await its result from a ServerTask
+ */
+template <typename Fn>
+OffloadAwaiter<Fn> offload(WorkerPool& pool, Reactor& reactor, Fn fn) {
+    return OffloadAwaiter<Fn>(pool, reactor, std::move(fn));
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <SFML/Config.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "Matchmaker.h"
+
+namespace BayouBonanza {
+
+class Reactor;
+class UnixChannel;
+
+/**
+ * @brief Where game sessions live and who is waiting for a match
+ *
+ * A server process asks the directory which process owns a user's game
+ * (so a reconnect lands back in the right process) and queues players for
+ * matchmaking through it, so players connected to different processes can
+ * be paired. Tickets are the process-local connection ids.
+ *
+ * All calls and handlers run on the Reactor thread.
+ */
+class SessionDirectory {
+public:
+    using TicketId = Matchmaker::TicketId;
+    using OwnerCallback = std::function<void(int owner)>;
+
+    /**
+     * @brief Events the directory delivers to the server process
+     */
+    struct Handlers {
+        // Two players in this process were paired; first waited longer
+        std::function<void(TicketId first, TicketId second)> match;
+        // A player here was paired with one in process `target`; hand the connection over
+        std::function<void(TicketId ticket, int target, TicketId peer, int peerRating)> migrate;
+        // A connection was handed over from another process; `peer` is its opponent here, or 0,
+        // and `capabilities` what the client agreed in its handshake
+        std::function<void(int fd, const std::string& username, TicketId peer, sf::Uint32 capabilities)> adopt;
+    };
+
+    virtual ~SessionDirectory() = default;
+
+    /**
+     * @brief Index of this process among the server processes
+     */
+    virtual int self() const = 0;
+
+    /**
+     * @brief Record that this process now hosts the user's game
+     */
+    virtual void claim(const std::string& username) = 0;
+
+    /**
+     * @brief Forget this process's claim on the user's game
+     */
+    virtual void release(const std::string& username) = 0;
+
+    /**
+     * @brief Find the process that hosts the user's game
+     *
+     * The callback receives the owning process index, or -1 if no process has
+     * claimed the user. It may run before lookupOwner() returns.
+     */
+    virtual void lookupOwner(const std::string& username, OwnerCallback callback) = 0;
+
+    /**
+     * @brief Queue a player for matchmaking
+     */
+    virtual void enqueue(TicketId ticket, int rating) = 0;
+
+    /**
+     * @brief Withdraw a player from matchmaking
+     */
+    virtual void dequeue(TicketId ticket) = 0;
+
+    /**
+     * @brief Pass a client socket to another process
+     *
+     * @param fd Socket to pass; the caller still closes its own copy
+     * @param target Process that should serve the connection
+     * @param peer Opponent waiting in the target process, or 0 for a reconnect
+     * @param peerRating The peer's rating, so the directory can queue them again if the socket does not arrive
+     * @param capabilities CapabilitySet agreed with the client, which will not repeat its handshake
+     * @return false if the connection could not be passed on
+     */
+    virtual bool handoff(int fd, int target, const std::string& username, TicketId peer, int peerRating,
+                         sf::Uint32 capabilities) = 0;
+
+    /**
+     * @brief Report that a migrate request could not be carried out
+     *
+     * The peer that was waiting in the target process goes back in the queue.
+     */
+    virtual void migrationFailed(int target, TicketId peer, int peerRating) = 0;
+
+    void setHandlers(Handlers handlers) { this->handlers = std::move(handlers); }
+
+protected:
+    Handlers handlers;
+};
+
+/**
+ * @brief Single-process directory: every game is local and matchmaking runs in-process
+ *
+ * The stand-in used when the server runs as one process. Pairs players in
+ * batches on a Reactor timer.
+ */
+class LocalDirectory : public SessionDirectory {
+public:
+    LocalDirectory(Reactor& reactor, Matchmaker::Config config = {},
+                   std::chrono::milliseconds tick = std::chrono::milliseconds(250));
+
+    int self() const override { return 0; }
+    void claim(const std::string&) override {}
+    void release(const std::string&) override {}
+    void lookupOwner(const std::string& username, OwnerCallback callback) override;
+    void enqueue(TicketId ticket, int rating) override;
+    void dequeue(TicketId ticket) override;
+    bool handoff(int, int, const std::string&, TicketId, int, sf::Uint32) override { return false; }
+    void migrationFailed(int, TicketId, int) override {}
+
+    /**
+     * @brief Start pairing queued players every tick
+     */
+    void start();
+
+private:
+    Reactor& reactor;
+    Matchmaker matchmaker;
+    std::chrono::milliseconds tick;
+
+    void runTick();
+};
+
+#if !defined(_WIN32)
+
+/**
+ * @brief Messages exchanged with the DirectoryService over its Unix socket
+ */
+enum class DirectoryMessage : sf::Uint8 {
+    // Server process -> directory
+    Hello,           // Int32 process index
+    Claim,           // username
+    Release,         // username
+    Lookup,          // Uint32 request id, username
+    Enqueue,         // Uint64 ticket, Int32 rating
+    Dequeue,         // Uint64 ticket
+    Handoff,         // Int32 target, username, Uint64 peer, Int32 peer rating, Uint32 capabilities; carries the socket
+    MigrationFailed, // Int32 target, Uint64 peer, Int32 peer rating
+
+    // Directory -> server process
+    LookupResult,    // Uint32 request id, Int32 owner
+    Match,           // Uint64 first, Uint64 second
+    Migrate,         // Uint64 ticket, Int32 target, Uint64 peer, Int32 peer rating
+    Adopt            // username, Uint64 peer, Uint32 capabilities; carries the socket
+};
+
+/**
+ * @brief Directory client for one of several server processes
+ *
+ * Talks to the DirectoryService run by the supervising process.
+ */
+class RemoteDirectory : public SessionDirectory {
+public:
+    ~RemoteDirectory() override;
+
+    /**
+     * @brief Connect to the directory and register as process `index`
+     *
+     * @param onClosed Called if the directory goes away
+     * @return The directory, or nullptr if the service is unreachable
+     */
+    static std::unique_ptr<RemoteDirectory> connect(Reactor& reactor, const std::string& path, int index,
+                                                    std::function<void()> onClosed);
+
+    int self() const override { return index; }
+    void claim(const std::string& username) override;
+    void release(const std::string& username) override;
+    void lookupOwner(const std::string& username, OwnerCallback callback) override;
+    void enqueue(TicketId ticket, int rating) override;
+    void dequeue(TicketId ticket) override;
+    bool handoff(int fd, int target, const std::string& username, TicketId peer, int peerRating,
+                 sf::Uint32 capabilities) override;
+    void migrationFailed(int target, TicketId peer, int peerRating) override;
+
+private:
+    RemoteDirectory(Reactor& reactor, std::unique_ptr<UnixChannel> channel, int index, std::function<void()> onClosed);
+
+    Reactor& reactor;
+    std::unique_ptr<UnixChannel> channel;
+    int index;
+    std::function<void()> onClosed;
+    sf::Uint32 nextRequest;
+    std::unordered_map<sf::Uint32, OwnerCallback> pendingLookups;
+
+    void onReadable();
+    void close();
+};
+
+#endif
+
+} // namespace BayouBonanza
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "WorkerPool.h"
+
+namespace BayouBonanza {
+
+/**
+ * @brief Serialized mailbox for one game session
+ *
+ * Tasks posted to a strand run one at a time, in posting order, on the
+ * shared WorkerPool. Different strands run in parallel, so every session's
+ * GameState/TurnManager is only ever touched by one thread at a time without
+ * any per-action locking.
+ */
+class SessionStrand : public std::enable_shared_from_this<SessionStrand> {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Per-session scheduling counters
+     */
+    struct Stats {
+        std::size_t queueDepth = 0;        // Tasks waiting right now
+        std::size_t maxQueueDepth = 0;     // Highest depth observed
+        std::uint64_t tasksRun = 0;        // Tasks completed
+        std::uint64_t totalRunNanos = 0;   // Time spent executing tasks
+        std::uint64_t maxRunNanos = 0;     // Slowest single task
+    };
+
+    /**
+     * @brief Create a strand; must be owned by a std::shared_ptr
+     *
+     * @param pool Pool that executes the strand's tasks
+     */
+    static std::shared_ptr<SessionStrand> create(WorkerPool& pool);
+
+    /**
+     * @brief Queue a task behind every task already posted to this strand
+     */
+    void post(Task task);
+
+    /**
+     * @brief Check whether the calling thread is currently running this strand
+     */
+    bool isCurrent() const;
+
+    /**
+     * @brief Snapshot of the scheduling counters
+     */
+    Stats stats() const;
+
+private:
+    explicit SessionStrand(WorkerPool& pool);
+
+    // Run a bounded batch of tasks, then yield the worker back to the pool
+    void drain();
+
+    static constexpr std::size_t MAX_TASKS_PER_DRAIN = 16;
+
+    WorkerPool& pool;
+    mutable std::mutex mutex;
+    std::deque<Task> mailbox;
+    bool scheduled;
+    Stats counters;
+};
+
+} // namespace BayouBonanza
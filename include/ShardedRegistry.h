@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Thread-safe hash map split into independently locked shards
+ *
+ * A key's hash picks its shard, so lookups, inserts and removals are O(1)
+ * and only contend with other operations on the same shard. Used by the
+ * server to index connections and game sessions without a global lock.
+ *
+ * Values are returned by copy, which suits shared_ptr handles.
+ */
+template <typename Key, typename Value, std::size_t ShardCount = 16, typename Hash = std::hash<Key>>
+class ShardedRegistry {
+    static_assert(ShardCount > 0, "ShardedRegistry needs at least one shard");
+
+public:
+    ShardedRegistry() : count(0) {}
+
+    ShardedRegistry(const ShardedRegistry&) = delete;
+    ShardedRegistry& operator=(const ShardedRegistry&) = delete;
+
+    /**
+     * @brief Insert or replace the value stored under a key
+     *
+     * @return true if the key was new
+     */
+    bool insert(const Key& key, Value value) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto result = shard.map.insert_or_assign(key, std::move(value));
+        if (result.second) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result.second;
+    }
+
+    /**
+     * @brief Look up a key
+     *
+     * @return The stored value, or a default-constructed Value if absent
+     */
+    Value find(const Key& key) const {
+        const Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        return it != shard.map.end() ? it->second : Value{};
+    }
+
+    /**
+     * @brief Remove a key
+     *
+     * @return true if the key was present
+     */
+    bool erase(const Key& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.map.erase(key) > 0) {
+            count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Remove a key only while it still maps to the given value
+     *
+     * Lets an owner unregister itself without clobbering a newer entry that
+     * replaced it under the same key (e.g. a user who logged in again).
+     */
+    bool eraseIfEqual(const Key& key, const Value& expected) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it != shard.map.end() && it->second == expected) {
+            shard.map.erase(it);
+            count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Visit entries shard by shard until the visitor returns false
+     *
+     * Only one shard is locked at a time, so the walk is not a consistent
+     * snapshot of the whole registry. The visitor must not call back into
+     * this registry.
+     */
+    void forEach(const std::function<bool(const Key&, const Value&)>& visitor) const {
+        for (const Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& entry : shard.map) {
+                if (!visitor(entry.first, entry.second)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Number of entries across all shards
+     */
+    std::size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, Value, Hash> map;
+    };
+
+    std::array<Shard, ShardCount> shards;
+    std::atomic<std::size_t> count;
+
+    Shard& shardFor(const Key& key) {
+        return shards[Hash{}(key) % ShardCount];
+    }
+
+    const Shard& shardFor(const Key& key) const {
+        return shards[Hash{}(key) % ShardCount];
+    }
+};
+
+} // namespace BayouBonanza
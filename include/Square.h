@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 #include "PlayerSide.h" // PlayerSide enum
 #include "Piece.h"      // Piece class
 #include "PieceFactory.h" // For PieceFactory
@@ -25,6 +26,15 @@ public:
      * @brief Default constructor, initializes an empty square with no control
      */
     Square();
+
+    /**
+     * @brief Move another square's piece and control here
+     *
+     * The board hash this square feeds (see attachHash()) stays with the
+     * square and is updated; it does not follow the contents.
+     */
+    Square(Square&& other) noexcept;
+    Square& operator=(Square&& other) noexcept;
     
     /**
      * @brief Check if the square is empty (has no piece)
@@ -99,6 +109,14 @@ public:
      */
     static void setGlobalPieceFactory(PieceFactory* factory);
 
+    /**
+     * @brief Keep a board hash up to date with this square's piece and control
+     *
+     * @param sink Board hash to update, or nullptr to stop
+     * @param slot Index of this square on the board
+     */
+    void attachHash(std::uint64_t* sink, std::uint64_t slot);
+
     // PieceFactory needs to be accessible for deserialization.
     // This is a design challenge. For now, we assume it can be accessed.
     // One common way is to pass it to the deserialization operator,
@@ -113,11 +131,18 @@ private:
     int controlValuePlayer1;      // Current influence value for player 1 (reset each turn)
     int controlValuePlayer2;      // Current influence value for player 2 (reset each turn)
     PlayerSide currentController; // Persistent control - who actually controls this square
+    std::uint64_t* hashSink = nullptr; // Hash of the board the square belongs to, if any
+    std::uint64_t hashSlot = 0;
+
+    std::uint64_t controlKey() const;
+    void rehashControl(std::uint64_t keyBefore);
 };
 
-// SFML Packet operators for Square
-sf::Packet& operator<<(sf::Packet& packet, const Square& sq);
-sf::Packet& operator>>(sf::Packet& packet, Square& sq);
+// Packet operators for Square, defined for sf::Packet, WireWriter and WireReader
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const Square& sq);
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, Square& sq);
 
 
 } // namespace BayouBonanza
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Hierarchical timing wheel for server timeouts
+ *
+ * Four levels of slots (256, 64, 64, 64) cover about 2^26 ticks, roughly
+ * 7.5 days at the default 10 ms tick. A timer is filed in the coarsest level
+ * that still resolves its expiry and is moved down a level ("cascaded") as
+ * the wheel turns, so schedule() and cancel() are O(1) no matter how many
+ * timers are pending. Timer nodes live in a
+ * slab and are linked by index, which keeps callbacks free to schedule or
+ * cancel other timers while the wheel is advancing.
+ *
+ * Not thread-safe: owned and driven by the Reactor thread.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief Handle returned by schedule(); 0 is never a valid timer
+     */
+    using TimerId = std::uint64_t;
+
+    /**
+     * @param tick Resolution of the wheel; timers fire on tick boundaries
+     * @param start Time corresponding to tick 0
+     */
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10),
+                        Clock::time_point start = Clock::now());
+
+    /**
+     * @brief Run a callback once after a delay
+     *
+     * Delays beyond the wheel's range are clamped to the longest delay it can hold.
+     *
+     * @return Handle that can be passed to cancel()
+     */
+    TimerId schedule(std::chrono::milliseconds delay, Callback callback);
+
+    /**
+     * @brief Stop a pending timer
+     *
+     * @return true if the timer was pending; false if it already fired or was cancelled
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Fire every timer that is due at the given time
+     *
+     * @return Number of callbacks run
+     */
+    int advance(Clock::time_point now);
+
+    /**
+     * @brief Upper bound on how long the owner may sleep before calling advance()
+     *
+     * @return Milliseconds to wait, or -1 if no timers are pending
+     */
+    int millisecondsUntilNextEvent(Clock::time_point now) const;
+
+    /**
+     * @brief Number of pending timers
+     */
+    std::size_t size() const;
+
+private:
+    static constexpr unsigned ROOT_BITS = 8;
+    static constexpr unsigned LEVEL_BITS = 6;
+    static constexpr unsigned LEVELS = 4;
+    static constexpr std::uint32_t ROOT_SLOTS = 1u << ROOT_BITS;
+    static constexpr std::uint32_t LEVEL_SLOTS = 1u << LEVEL_BITS;
+    static constexpr std::uint32_t SLOT_COUNT = ROOT_SLOTS + (LEVELS - 1) * LEVEL_SLOTS;
+    // One top-level slot short of a full rotation, so a cascade never refiles into the slot it is emptying
+    static constexpr std::uint64_t MAX_TICKS = (1ull << (ROOT_BITS + (LEVELS - 1) * LEVEL_BITS))
+                                             - (1ull << (ROOT_BITS + (LEVELS - 2) * LEVEL_BITS));
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    // Slab entry; the first SLOT_COUNT + 1 entries are list sentinels
+    struct Node {
+        std::uint32_t prev = NONE;
+        std::uint32_t next = NONE;
+        std::uint32_t generation = 1;
+        bool pending = false;
+        std::uint64_t expires = 0;
+        Callback callback;
+    };
+
+    std::vector<Node> nodes;
+    std::uint32_t freeList;
+    std::uint64_t currentTick;
+    std::size_t pendingCount;
+    std::chrono::milliseconds tick;
+    Clock::time_point start;
+
+    std::uint32_t allocate();
+    void release(std::uint32_t index);
+    void link(std::uint32_t sentinel, std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void file(std::uint32_t index);
+    void cascade(unsigned level);
+    int runTick();
+    std::uint32_t firingSentinel() const { return SLOT_COUNT; }
+    static std::uint32_t slotSentinel(unsigned level, std::uint32_t slot);
+};
+
+} // namespace BayouBonanza
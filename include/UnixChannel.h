@@ -0,0 +1,95 @@
+#pragma once
+
+#if !defined(_WIN32)
+
+#include <SFML/Network/Packet.hpp>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Framed message stream over a local Unix-domain socket
+ *
+ * Carries sf::Packet payloads with the same 4-byte length prefix the game
+ * protocol uses, and can attach an open file descriptor to a message so a
+ * client connection can be passed to another server process.
+ *
+ * Sends block until the frame is written; messages are small and the peer
+ * is a local process. Receives never block, so the channel can be driven by
+ * the Reactor.
+ */
+class UnixChannel {
+public:
+    enum class ReadResult {
+        Message,     // A complete frame was returned
+        WouldBlock,  // Nothing more to read right now
+        Closed       // Peer hung up or the socket failed
+    };
+
+    /**
+     * @brief Wrap a connected Unix stream socket; the channel owns it
+     */
+    explicit UnixChannel(int fd);
+    ~UnixChannel();
+
+    UnixChannel(const UnixChannel&) = delete;
+    UnixChannel& operator=(const UnixChannel&) = delete;
+
+    /**
+     * @brief Connect to a listening socket at the given path
+     *
+     * @return The channel, or nullptr if nobody is listening there
+     */
+    static std::unique_ptr<UnixChannel> connect(const std::string& path);
+
+    /**
+     * @brief Create a non-blocking listening Unix stream socket, replacing any stale socket file
+     *
+     * @return Listening descriptor, or -1 on failure
+     */
+    static int listen(const std::string& path);
+
+    /**
+     * @brief Native descriptor, for registering with the Reactor
+     */
+    int handle() const { return fd; }
+
+    /**
+     * @brief Write one frame, optionally passing a descriptor along with it
+     *
+     * The caller keeps its own copy of attachedFd and may close it afterwards.
+     *
+     * @return false if the peer is gone
+     */
+    bool send(const sf::Packet& packet, int attachedFd = -1);
+
+    /**
+     * @brief Read the next complete frame without blocking
+     */
+    ReadResult receive(sf::Packet& packet);
+
+    /**
+     * @brief Take the oldest descriptor received alongside a frame
+     *
+     * Descriptors arrive no later than the frame they were sent with, so a
+     * message that is known to carry one can claim it right after receive().
+     *
+     * @return The descriptor (now owned by the caller), or -1 if none arrived
+     */
+    int takeDescriptor();
+
+private:
+    int fd;
+    std::vector<char> readBuffer;
+    std::deque<int> descriptors;
+    bool closed;
+
+    bool fill();
+};
+
+} // namespace BayouBonanza
+
+#endif
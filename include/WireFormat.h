@@ -0,0 +1,148 @@
+#pragma once
+
+#include <SFML/Config.hpp> // For sf::Uint8 and friends
+#include <SFML/Network/Packet.hpp> // For sf::Packet, the other stream the serializers accept
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Appends binary fields to a fixed-capacity buffer it does not own
+ *
+ * The streaming operators take the same types as sf::Packet's, so one
+ * serializer body (see WritablePacket) writes either. The encoding is
+ * more compact than sf::Packet's:
+ *   bool, Int8, Uint8:        one byte
+ *   Int16, Uint16:            two bytes, little-endian
+ *   Uint32, Uint64:           LEB128 varint (7 bits per byte, low bits first)
+ *   Int32, Int64:             zigzag, then varint, so small negatives stay short
+ *   float, double:            IEEE bits, little-endian
+ *   strings:                  varint byte count, then the bytes
+ * writeFixed32()/writeFixed64() write little-endian words for values such
+ * as hashes that would not shrink as varints.
+ *
+ * Nothing is allocated. A write that does not fit sets the writer to its
+ * failed state, like a read past the end of an sf::Packet, and every later
+ * write is ignored; the caller retries with a larger buffer.
+ */
+class WireWriter {
+public:
+    WireWriter(char* data, std::size_t capacity);
+
+    WireWriter& operator<<(bool value);
+    WireWriter& operator<<(sf::Int8 value);
+    WireWriter& operator<<(sf::Uint8 value);
+    WireWriter& operator<<(sf::Int16 value);
+    WireWriter& operator<<(sf::Uint16 value);
+    WireWriter& operator<<(sf::Int32 value);
+    WireWriter& operator<<(sf::Uint32 value);
+    WireWriter& operator<<(sf::Int64 value);
+    WireWriter& operator<<(sf::Uint64 value);
+    WireWriter& operator<<(float value);
+    WireWriter& operator<<(double value);
+    WireWriter& operator<<(const char* value);
+    WireWriter& operator<<(const std::string& value);
+    WireWriter& operator<<(std::string_view value);
+
+    void writeVarUint(std::uint64_t value);
+    void writeVarInt(std::int64_t value);
+    void writeFixed32(std::uint32_t value);
+    void writeFixed64(std::uint64_t value);
+
+    /**
+     * @brief Copy raw bytes, e.g. ones encoded earlier by another WireWriter
+     */
+    void append(const void* data, std::size_t size);
+
+    const char* getData() const { return buffer; }
+    std::size_t getDataSize() const { return used; }
+    std::size_t capacity() const { return limit; }
+
+    /**
+     * @brief Start over at the beginning of the buffer, clearing a failure
+     */
+    void clear();
+
+    explicit operator bool() const { return valid; }
+
+    /**
+     * @brief Bytes writeVarUint() uses for @p value
+     */
+    static std::size_t varUintSize(std::uint64_t value);
+
+private:
+    char* buffer;
+    std::size_t limit;
+    std::size_t used;
+    bool valid;
+
+    char* reserve(std::size_t size);
+};
+
+/**
+ * @brief Reads what a WireWriter wrote, straight from the received bytes
+ *
+ * Every read is checked against the end of the data. A read that would
+ * pass it, or a varint longer than ten bytes, puts the reader in its
+ * failed state and every later read fails too, so a chain of reads can be
+ * checked once, as with sf::Packet. Strings can be read as views into the
+ * buffer, which must then outlive them.
+ */
+class WireReader {
+public:
+    WireReader(const void* data, std::size_t size);
+
+    WireReader& operator>>(bool& value);
+    WireReader& operator>>(sf::Int8& value);
+    WireReader& operator>>(sf::Uint8& value);
+    WireReader& operator>>(sf::Int16& value);
+    WireReader& operator>>(sf::Uint16& value);
+    WireReader& operator>>(sf::Int32& value);
+    WireReader& operator>>(sf::Uint32& value);
+    WireReader& operator>>(sf::Int64& value);
+    WireReader& operator>>(sf::Uint64& value);
+    WireReader& operator>>(float& value);
+    WireReader& operator>>(double& value);
+    WireReader& operator>>(std::string& value);
+    WireReader& operator>>(std::string_view& value);
+
+    bool readVarUint(std::uint64_t& value);
+    bool readVarInt(std::int64_t& value);
+    bool readFixed32(std::uint32_t& value);
+    bool readFixed64(std::uint64_t& value);
+
+    /**
+     * @brief Take the next @p size bytes without copying them
+     *
+     * @return Start of the bytes, or nullptr if fewer remain
+     */
+    const char* read(std::size_t size);
+
+    std::size_t remaining() const { return valid ? end - position : 0; }
+    bool endOfData() const { return remaining() == 0; }
+
+    explicit operator bool() const { return valid; }
+
+private:
+    const char* position;
+    const char* end;
+    bool valid;
+};
+
+/**
+ * @brief Streams the type serializers write to: sf::Packet or WireWriter
+ */
+template <typename T>
+concept WritablePacket = std::same_as<T, sf::Packet> || std::same_as<T, WireWriter>;
+
+/**
+ * @brief Streams the type serializers read from: sf::Packet or WireReader
+ */
+template <typename T>
+concept ReadablePacket = std::same_as<T, sf::Packet> || std::same_as<T, WireReader>;
+
+} // namespace BayouBonanza
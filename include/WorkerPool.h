@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Fixed-size work-stealing thread pool
+ *
+ * Each worker owns a task deque. Tasks submitted from a worker thread go to
+ * that worker's own deque; tasks submitted from outside the pool are spread
+ * round-robin. An idle worker pops from the back of its own deque and, when
+ * that is empty, steals from the front of the other workers' deques.
+ */
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Counters describing pool activity
+     */
+    struct Stats {
+        std::size_t threadCount = 0;
+        std::size_t pending = 0;       // Tasks queued but not yet started
+        std::uint64_t executed = 0;    // Tasks completed since start
+        std::uint64_t stolen = 0;      // Tasks taken from another worker's deque
+    };
+
+    /**
+     * @brief Start the worker threads
+     *
+     * @param threadCount Number of workers; 0 uses the hardware concurrency
+     */
+    explicit WorkerPool(std::size_t threadCount = 0);
+
+    /**
+     * @brief Finish queued tasks and join the workers
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Queue a task for execution on some worker
+     *
+     * @param task Work to run
+     * @param preferLocal When called from a worker, keep the task on that
+     *        worker's deque; pass false to spread it round-robin instead
+     */
+    void submit(Task task, bool preferLocal = true);
+
+    /**
+     * @brief Stop accepting work, run what is queued and join all workers
+     */
+    void shutdown();
+
+    /**
+     * @brief Number of worker threads
+     */
+    std::size_t threadCount() const;
+
+    /**
+     * @brief Snapshot of the pool counters
+     */
+    Stats stats() const;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    std::atomic<std::size_t> pending;
+    std::atomic<std::size_t> nextQueue;
+    std::atomic<std::uint64_t> executed;
+    std::atomic<std::uint64_t> stolen;
+    std::atomic<bool> stopping;
+
+    bool popLocal(std::size_t index, Task& out);
+    bool steal(std::size_t thief, Task& out);
+    void workerLoop(std::size_t index);
+};
+
+} // namespace BayouBonanza
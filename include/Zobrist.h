@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+namespace BayouBonanza {
+
+/**
+ * @brief Keys for the Zobrist-style GameState hash
+ *
+ * Rather than tables of random numbers, each (feature, slot, value) triple
+ * is mixed with the SplitMix64 finalizer into a well-spread 64-bit key, so
+ * unbounded values such as health or steam need no table. A state's hash
+ * is the XOR of the keys of everything in it: changing one field removes
+ * its old key and adds the new one.
+ */
+namespace Zobrist {
+
+enum class Feature : std::uint64_t {
+    PieceType = 1,
+    PieceSide,
+    PiecePosition,
+    PieceHealth,
+    PieceAttack,
+    PieceMoved,
+    PieceStun,
+    ControlOne,
+    ControlTwo,
+    Controller,
+    ActivePlayer,
+    Phase,
+    Result,
+    TurnNumber,
+    SteamOne,
+    SteamTwo,
+    HandCard,
+    HandCount
+};
+
+inline std::uint64_t mix(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Key for @p feature holding @p value at @p slot (a square index, hand slot or 0)
+ */
+inline std::uint64_t key(Feature feature, std::uint64_t slot, std::int64_t value) {
+    return mix((static_cast<std::uint64_t>(feature) << 56) ^ (slot << 40) ^ mix(static_cast<std::uint64_t>(value)));
+}
+
+} // namespace Zobrist
+
+} // namespace BayouBonanza
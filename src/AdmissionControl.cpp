@@ -0,0 +1,136 @@
+#include "AdmissionControl.h"
+#include <algorithm>
+
+namespace BayouBonanza {
+
+AdmissionControl::AdmissionControl() : AdmissionControl(Limits{}) {}
+
+AdmissionControl::AdmissionControl(Limits limits)
+    : config(limits), openConnections(0), activeSessions(0), queuedNewLogins(0) {
+    config.maxLoginsInFlight = std::max<std::size_t>(1, config.maxLoginsInFlight);
+}
+
+bool AdmissionControl::tryAdmitConnection() {
+    if (openConnections >= config.maxConnections) {
+        counters.connectionsShed++;
+        return false;
+    }
+    openConnections++;
+    return true;
+}
+
+void AdmissionControl::connectionOpened() {
+    openConnections++;
+}
+
+void AdmissionControl::connectionClosed() {
+    if (openConnections > 0) {
+        openConnections--;
+    }
+}
+
+AdmissionControl::LoginDecision AdmissionControl::requestLogin(Id id, Priority priority) {
+    // Reconnects only ever wait behind other reconnects
+    bool waitingAhead = priority == Priority::Reconnect ? queued.size() > queuedNewLogins : !queued.empty();
+    if (inFlight.size() < config.maxLoginsInFlight && !waitingAhead) {
+        inFlight.emplace(id, priority);
+        return LoginDecision::Admitted;
+    }
+
+    if (priority == Priority::Reconnect) {
+        reconnectQueue.push_back(id);
+        counters.reconnectsQueued++;
+    } else {
+        if (queuedNewLogins >= config.maxQueuedLogins) {
+            counters.loginsRejected++;
+            return LoginDecision::Rejected;
+        }
+        loginQueue.push_back(id);
+        queuedNewLogins++;
+    }
+    queued.emplace(id, priority);
+    counters.loginsQueued++;
+    counters.maxLoginQueue = std::max(counters.maxLoginQueue, queued.size());
+    return LoginDecision::Queued;
+}
+
+std::vector<AdmissionControl::Id> AdmissionControl::finishLogin(Id id) {
+    auto waiting = queued.find(id);
+    if (waiting != queued.end()) {
+        // Left the queue; its deque entry goes stale and is skipped later
+        if (waiting->second == Priority::NewLogin) {
+            queuedNewLogins--;
+        }
+        queued.erase(waiting);
+    } else {
+        inFlight.erase(id);
+    }
+
+    std::vector<Id> admitted;
+    Id next;
+    while (inFlight.size() < config.maxLoginsInFlight && popNext(next)) {
+        admitted.push_back(next);
+    }
+    return admitted;
+}
+
+bool AdmissionControl::popNext(Id& id) {
+    for (std::deque<Id>* queue : {&reconnectQueue, &loginQueue}) {
+        while (!queue->empty()) {
+            Id candidate = queue->front();
+            queue->pop_front();
+            auto waiting = queued.find(candidate);
+            if (waiting == queued.end()) {
+                continue; // Stale: gave up while queued
+            }
+            if (waiting->second == Priority::NewLogin) {
+                queuedNewLogins--;
+            }
+            inFlight.emplace(candidate, waiting->second);
+            queued.erase(waiting);
+            id = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AdmissionControl::isQueued(Id id) const {
+    return queued.count(id) > 0;
+}
+
+std::size_t AdmissionControl::queuePosition(Id id) const {
+    auto waiting = queued.find(id);
+    if (waiting == queued.end()) {
+        return 0;
+    }
+    std::size_t position = 0;
+    for (const std::deque<Id>* queue : {&reconnectQueue, &loginQueue}) {
+        for (Id candidate : *queue) {
+            if (queued.count(candidate)) {
+                position++;
+            }
+            if (candidate == id) {
+                return position;
+            }
+        }
+    }
+    return position;
+}
+
+bool AdmissionControl::tryStartSession() {
+    if (activeSessions >= config.maxSessions) {
+        counters.sessionsDeferred++;
+        return false;
+    }
+    activeSessions++;
+    return true;
+}
+
+void AdmissionControl::sessionEnded() {
+    if (activeSessions > 0) {
+        activeSessions--;
+    }
+}
+
+} // namespace BayouBonanza
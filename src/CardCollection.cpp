@@ -6,9 +6,118 @@
 #include <sstream>
 #include <set>
 #include <iostream>
+#include <cstdint>
+#include <utility>
 
 namespace BayouBonanza {
 
+namespace {
+
+// Leads every packed collection and deck, so the layout can change later
+const std::uint8_t PACK_FORMAT = 1;
+const unsigned UINT16_LIMIT = 0xFFFF;
+
+void putUint16(std::string& out, unsigned value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+// Append a uint16 number of runs, then each (ID, count); long runs are split.
+// Returns false if an ID or the number of runs does not fit in 16 bits.
+bool putRuns(std::string& out, const std::vector<std::pair<int, int>>& runs) {
+    std::size_t countAt = out.size();
+    putUint16(out, 0);
+    unsigned written = 0;
+    for (const auto& [id, count] : runs) {
+        if (id < 0 || static_cast<unsigned>(id) > UINT16_LIMIT) {
+            return false;
+        }
+        for (int left = count; left > 0; left -= static_cast<int>(UINT16_LIMIT)) {
+            if (written == UINT16_LIMIT) {
+                return false;
+            }
+            putUint16(out, static_cast<unsigned>(id));
+            putUint16(out, static_cast<unsigned>(std::min(left, static_cast<int>(UINT16_LIMIT))));
+            ++written;
+        }
+    }
+    out[countAt] = static_cast<char>(written & 0xFF);
+    out[countAt + 1] = static_cast<char>(written >> 8);
+    return true;
+}
+
+// Reads the little-endian fields of a packed collection; fails rather than read past the end
+class PackReader {
+public:
+    explicit PackReader(std::string_view data) : data(data) {}
+
+    bool byte(unsigned& value) {
+        if (position + 1 > data.size()) {
+            return false;
+        }
+        value = static_cast<std::uint8_t>(data[position++]);
+        return true;
+    }
+
+    bool uint16(unsigned& value) {
+        if (position + 2 > data.size()) {
+            return false;
+        }
+        value = static_cast<std::uint8_t>(data[position]) | (static_cast<std::uint8_t>(data[position + 1]) << 8);
+        position += 2;
+        return true;
+    }
+
+    bool atEnd() const { return position == data.size(); }
+
+private:
+    std::string_view data;
+    std::size_t position = 0;
+};
+
+// Decode a number of runs and the runs into @p cards, creating each ID once and copying it for the rest
+bool takeRuns(PackReader& reader, std::vector<std::unique_ptr<Card>>& cards) {
+    unsigned runs = 0;
+    if (!reader.uint16(runs)) {
+        return false;
+    }
+    for (unsigned i = 0; i < runs; ++i) {
+        unsigned id = 0;
+        unsigned count = 0;
+        if (!reader.uint16(id) || !reader.uint16(count)) {
+            return false;
+        }
+        if (count == 0) {
+            continue;
+        }
+        auto card = CardFactory::createCard(static_cast<int>(id));
+        if (!card) {
+            return false;
+        }
+        for (unsigned copy = 1; copy < count; ++copy) {
+            cards.push_back(card->clone());
+        }
+        cards.push_back(std::move(card));
+    }
+    return true;
+}
+
+// Runs of equal consecutive IDs, keeping the order of @p cards
+std::vector<std::pair<int, int>> runsOf(const std::vector<std::unique_ptr<Card>>& cards) {
+    std::vector<std::pair<int, int>> runs;
+    for (const auto& card : cards) {
+        int id = card->getId();
+        if (!runs.empty() && runs.back().first == id) {
+            ++runs.back().second;
+        } else {
+            runs.emplace_back(id, 1);
+        }
+    }
+    return runs;
+}
+
+} // namespace
+
 // CardCollection implementation
 CardCollection::CardCollection() = default;
 
@@ -28,12 +137,13 @@ CardCollection& CardCollection::operator=(const CardCollection& other) {
 }
 
 CardCollection::CardCollection(CardCollection&& other) noexcept 
-    : cards(std::move(other.cards)) {
+    : cards(std::move(other.cards)), hiddenCount(std::exchange(other.hiddenCount, 0)) {
 }
 
 CardCollection& CardCollection::operator=(CardCollection&& other) noexcept {
     if (this != &other) {
         cards = std::move(other.cards);
+        hiddenCount = std::exchange(other.hiddenCount, 0);
     }
     return *this;
 }
@@ -44,6 +154,12 @@ void CardCollection::addCard(std::unique_ptr<Card> card) {
     }
 }
 
+void CardCollection::insertCardAt(size_t index, std::unique_ptr<Card> card) {
+    if (card) {
+        cards.insert(cards.begin() + std::min(index, cards.size()), std::move(card));
+    }
+}
+
 std::unique_ptr<Card> CardCollection::removeCardAt(size_t index) {
     if (index >= cards.size()) {
         return nullptr;
@@ -191,6 +307,28 @@ bool CardCollection::deserialize(const std::string& data) {
     return true;
 }
 
+std::string CardCollection::pack() const {
+    std::map<int, int> counts = getCardCounts();
+    std::string out;
+    out.reserve(3 + counts.size() * 4);
+    out.push_back(static_cast<char>(PACK_FORMAT));
+    if (!putRuns(out, std::vector<std::pair<int, int>>(counts.begin(), counts.end()))) {
+        return std::string();
+    }
+    return out;
+}
+
+bool CardCollection::unpack(std::string_view data) {
+    cards.clear();
+    PackReader reader(data);
+    unsigned format = 0;
+    if (!reader.byte(format) || format != PACK_FORMAT || !takeRuns(reader, cards) || !reader.atEnd()) {
+        cards.clear();
+        return false;
+    }
+    return true;
+}
+
 bool CardCollection::saveToFile(const std::string& filename) const {
     std::ofstream file(filename);
     if (!file.is_open()) {
@@ -231,6 +369,7 @@ void CardCollection::copyFrom(const CardCollection& other) {
     for (const auto& card : other.cards) {
         cards.push_back(card->clone());
     }
+    hiddenCount = other.hiddenCount;
 }
 
 // Hand implementation
@@ -483,4 +622,48 @@ bool Deck::deserialize(const std::string& data) {
     return true;
 }
 
+std::string Deck::pack() const {
+    std::string out;
+    out.reserve(4 + cards.size() * 4 + victoryCards.size() * 2);
+    out.push_back(static_cast<char>(PACK_FORMAT));
+    if (!putRuns(out, runsOf(cards)) || victoryCards.size() > 0xFF) {
+        return std::string();
+    }
+    out.push_back(static_cast<char>(victoryCards.size()));
+    for (const auto& card : victoryCards) {
+        int id = card ? card->getId() : 0; // 0 is an empty slot
+        if (id < 0 || static_cast<unsigned>(id) > UINT16_LIMIT) {
+            return std::string();
+        }
+        putUint16(out, static_cast<unsigned>(id));
+    }
+    return out;
+}
+
+bool Deck::unpack(std::string_view data) {
+    cards.clear();
+    victoryCards.clear();
+    PackReader reader(data);
+    unsigned format = 0;
+    unsigned victorySlots = 0;
+    bool valid = reader.byte(format) && format == PACK_FORMAT && takeRuns(reader, cards) && reader.byte(victorySlots);
+    for (unsigned i = 0; valid && i < victorySlots; ++i) {
+        unsigned id = 0;
+        valid = reader.uint16(id);
+        if (valid && id == 0) {
+            victoryCards.push_back(nullptr);
+        } else if (valid) {
+            auto card = CardFactory::createCard(static_cast<int>(id));
+            valid = card != nullptr;
+            victoryCards.push_back(std::move(card));
+        }
+    }
+    if (!valid || !reader.atEnd()) {
+        cards.clear();
+        victoryCards.clear();
+        return false;
+    }
+    return true;
+}
+
 } // namespace BayouBonanza 
\ No newline at end of file
@@ -165,7 +165,7 @@ PlayResult CardPlayValidator::executeCardPlay(GameState& gameState, PlayerSide p
     // Deduct steam cost
     if (!gameState.spendSteam(player, steamCost)) {
         // Rollback: return card to hand
-        hand.addCard(std::move(cardToPlay));
+        hand.insertCardAt(handIndex, std::move(cardToPlay));
         return PlayResult(false, ValidationError::INSUFFICIENT_STEAM,
                          "Failed to spend steam", false, false);
     }
@@ -176,7 +176,7 @@ PlayResult CardPlayValidator::executeCardPlay(GameState& gameState, PlayerSide p
     if (!playSuccess) {
         // Rollback: refund steam and return card to hand
         gameState.addSteam(player, steamCost);
-        hand.addCard(std::move(cardToPlay));
+        hand.insertCardAt(handIndex, std::move(cardToPlay));
         return PlayResult(false, ValidationError::CARD_CANNOT_BE_PLAYED,
                          "Card play execution failed", false, false);
     }
@@ -208,7 +208,7 @@ PlayResult CardPlayValidator::executeTargetedCardPlay(GameState& gameState, Play
     // Deduct steam cost
     if (!gameState.spendSteam(player, steamCost)) {
         // Rollback: return card to hand
-        hand.addCard(std::move(cardToPlay));
+        hand.insertCardAt(handIndex, std::move(cardToPlay));
         return PlayResult(false, ValidationError::INSUFFICIENT_STEAM,
                          "Failed to spend steam", false, false);
     }
@@ -240,7 +240,7 @@ PlayResult CardPlayValidator::executeTargetedCardPlay(GameState& gameState, Play
     if (!playSuccess) {
         // Rollback: refund steam and return card to hand
         gameState.addSteam(player, steamCost);
-        hand.addCard(std::move(cardToPlay));
+        hand.insertCardAt(handIndex, std::move(cardToPlay));
         return PlayResult(false, ValidationError::CARD_CANNOT_BE_PLAYED,
                          "Targeted card play execution failed", false, false);
     }
@@ -310,10 +310,7 @@ void CardPlayValidator::rollbackCardPlay(GameState& gameState, PlayerSide player
     
     // Return card to hand
     Hand& hand = gameState.getHand(player);
-    hand.addCard(std::move(card));
-    
-    // Note: We can't restore the exact hand index since the hand structure may have changed
-    // The card will be added to the end of the hand
+    hand.insertCardAt(handIndex, std::move(card));
 }
 
 } // namespace BayouBonanza 
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "MessageCompression.h"
+
+namespace BayouBonanza {
+
+namespace {
+
+// Trained on 40 self-played games (seeds 1-40) by the hidden
+// "Train the compression dictionary" test: BayouBonanzaTests "[dictionary]",
+// run at commit 96fcd29 built with GCC 12.2.0 and its libstdc++ (Debian 12).
+// The test draws through std::uniform_int_distribution and friends, whose
+// output differs between standard libraries, so another toolchain trains a
+// different table. Client and server must carry these exact bytes.
+const unsigned char DICTIONARY[] = {
+    0x00, 0x01, 0x01, 0x05, 0x0a, 0x0c, 0x14, 0x08, 0x01, 0x00, 0x06, 0xce, 0x0f, 0x01, 0x00, 0x04,
+    0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00, 0x0e, 0x04, 0x02, 0x00, 0x00, 0xd0,
+    0x0f, 0x00, 0x00, 0x01, 0x00, 0x02, 0x02, 0x0e, 0x12, 0x08, 0x00, 0x00, 0xd0, 0x0f, 0x00, 0x00,
+    0x0c, 0x06, 0x06, 0x01, 0x00, 0x0a, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x02, 0x06, 0x0c, 0x10, 0x08,
+    0x01, 0x00, 0x06, 0xd0, 0x0f, 0x01, 0x00, 0x06, 0x06, 0x00, 0x00, 0x04, 0x06, 0x01, 0x00, 0x02,
+    0x04, 0x01, 0x00, 0x00, 0x02, 0x01, 0x01, 0x00, 0x00, 0x00, 0x0e, 0x06, 0x06, 0x00, 0x00, 0xd0,
+    0x00, 0x02, 0x06, 0x01, 0x00, 0x02, 0x02, 0x01, 0x01, 0x00, 0x01, 0x00, 0x0a, 0x06, 0x04, 0x01,
+    0x00, 0xd0, 0x0f, 0x04, 0x00, 0x01, 0x00, 0x05, 0x02, 0x0a, 0x0c, 0x08, 0x01, 0x00, 0xce, 0x0f,
+    0x04, 0x00, 0x00, 0x02, 0x04, 0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00, 0x0c, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00,
+    0x08, 0x01, 0x01, 0x01, 0x00, 0x0a, 0x02, 0x06, 0x06, 0x01, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x00,
+    0x02, 0x0c, 0x01, 0x01, 0x01, 0x01, 0x0e, 0x02, 0x06, 0x04, 0x00, 0x00, 0x02, 0xd0, 0x0f, 0x01,
+    0x00, 0x00, 0x01, 0x00, 0x00, 0x06, 0x00, 0x06, 0x06, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x0c, 0x00, 0x06, 0x04, 0x01, 0x00,
+    0x00, 0xd0, 0x0f, 0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x06, 0x02,
+    0x00, 0x0e, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x04, 0x00, 0x01, 0x01, 0x03, 0x0a, 0x00, 0x04, 0x02,
+    0x00, 0x00, 0x02, 0xd4, 0x0f, 0x01, 0x01, 0x01, 0x06, 0x0c, 0x00, 0x0e, 0x06, 0x01, 0x00, 0x00,
+    0xd2, 0x0f, 0x01, 0x00, 0x00, 0x04, 0x01, 0x01, 0x00, 0x01, 0x00, 0x02, 0x06, 0x04, 0x00, 0x00,
+    0x02, 0x02, 0x00, 0x01, 0x00, 0x05, 0x0c, 0x00, 0x14, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x06, 0x00,
+    0x01, 0x01, 0x00, 0x0e, 0x00, 0x06, 0x06, 0x01, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x01, 0x00, 0x04,
+    0x00, 0x02, 0x06, 0x06, 0x00, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x02, 0x06,
+    0x00, 0x08, 0x01, 0x01, 0x01, 0x00, 0x0c, 0x06, 0x06, 0x06, 0x00, 0x00, 0x00, 0xd0, 0x0f, 0x01,
+    0x00, 0x00, 0x06, 0x01, 0x01, 0x00, 0x01, 0x00, 0x08, 0x06, 0x04, 0x01, 0x00, 0xce, 0x0f, 0x00,
+    0x00, 0x00, 0x02, 0x02, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x04, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x06, 0x00, 0x08, 0x14, 0x06, 0x01, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00,
+    0x01, 0x01, 0x04, 0x04, 0x08, 0x02, 0x06, 0x01, 0x00, 0x02, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x02,
+    0x00, 0x00, 0x00, 0x04, 0x01, 0x01, 0x01, 0x05, 0x0a, 0x08, 0x14, 0x08, 0x01, 0x00, 0x00, 0xce,
+    0x0a, 0x08, 0x14, 0x06, 0x01, 0x00, 0x00, 0xd4, 0x0f, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x08, 0x04,
+    0x02, 0x01, 0x00, 0x00, 0xd0, 0x0f, 0x01, 0x00, 0x00, 0x02, 0x01, 0x01, 0x00, 0x05, 0x00, 0x0a,
+    0x14, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x04, 0x00, 0x01, 0x01, 0x04, 0x02, 0x0a, 0x06, 0x06, 0x01,
+    0x02, 0xd2, 0x0f, 0x04, 0x00, 0x01, 0x00, 0x03, 0x0c, 0x02, 0x04, 0x02, 0x00, 0x00, 0xce, 0x0f,
+    0x02, 0x00, 0x00, 0x04, 0x02, 0x00, 0x01, 0x00, 0x05, 0x00, 0x04, 0x14, 0x08, 0x01, 0x00, 0xd0,
+    0x0f, 0x00, 0x00, 0x00, 0x0a, 0x02, 0x00, 0x01, 0x01, 0x01, 0x04, 0x04, 0x06, 0x04, 0x01, 0x00,
+    0x02, 0x0a, 0x0a, 0x12, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x02, 0x00, 0x01, 0x01, 0x00, 0x0c, 0x0a,
+    0x06, 0x06, 0x00, 0x00, 0x02, 0xd2, 0x0f, 0x01, 0x01, 0x01, 0x02, 0x0e, 0x0a, 0x12, 0x08, 0x01,
+    0x00, 0x00, 0xd0, 0x0f, 0x01, 0x01, 0x00, 0x01, 0x00, 0x0c, 0x06, 0x04, 0x01, 0x00, 0xce, 0x0f,
+    0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x06, 0x02, 0x00, 0x01, 0x00, 0x05,
+    0x04, 0x0a, 0x14, 0x08, 0x01, 0x00, 0xd2, 0x0f, 0x02, 0x00, 0x01, 0x00, 0x06, 0x06, 0x0a, 0x14,
+    0x06, 0x01, 0x00, 0xd0, 0x0f, 0x02, 0x00, 0x00, 0x06, 0x00, 0x00, 0x01, 0x00, 0x01, 0x0a, 0x0a,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x01, 0x06, 0x0e, 0x06, 0x04, 0x00, 0x00, 0xd0, 0x0f,
+    0x00, 0x00, 0x01, 0x00, 0x05, 0x08, 0x0e, 0x14, 0x08, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x01, 0x04, 0x00, 0x98, 0x01,
+    0xd0, 0x0f, 0x01, 0x00, 0x06, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x01,
+    0x00, 0x05, 0x06, 0x04, 0x14, 0x08, 0x01, 0x00, 0xd0, 0x0f, 0x02, 0x00, 0x00, 0x02, 0x04, 0x01,
+    0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x05, 0x0c, 0x04, 0x14, 0x08, 0x01, 0x00, 0x00, 0xd2, 0x0f,
+    0xce, 0x0f, 0x01, 0x01, 0x00, 0x04, 0x0a, 0x0e, 0x06, 0x06, 0x01, 0x00, 0xd0, 0x0f, 0x02, 0x00,
+    0x01, 0x00, 0x04, 0x0c, 0x0e, 0x06, 0x06, 0x01, 0x00, 0xce, 0x0f, 0x02, 0x00, 0x01, 0x01, 0x03,
+    0x0e, 0x0e, 0x04, 0x02, 0x00, 0x00, 0x02, 0xce, 0x0f, 0x01, 0x00, 0x04, 0x00, 0xae, 0x02, 0xec,
+    0x00, 0x01, 0x00, 0x03, 0x06, 0x04, 0x04, 0x02, 0x00, 0x00, 0xd2, 0x0f, 0x02, 0x00, 0x01, 0x01,
+    0x01, 0x08, 0x04, 0x06, 0x04, 0x01, 0x00, 0x06, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x06, 0x01, 0x01,
+    0x01, 0x04, 0x0c, 0x04, 0x06, 0x06, 0x01, 0x00, 0x02, 0xd2, 0x0f, 0x01, 0x01, 0x01, 0x05, 0x0e,
+    0x01, 0x03, 0x0c, 0x06, 0x04, 0x02, 0x00, 0x00, 0x02, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x04, 0x01,
+    0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x08, 0x06, 0x06, 0x01, 0x00, 0xd2, 0x0f, 0x00,
+    0x00, 0x01, 0x00, 0x03, 0x04, 0x08, 0x04, 0x02, 0x00, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0xce, 0x0f, 0x01, 0x00, 0x04, 0x04, 0x00, 0x01, 0x00, 0x06, 0x0c, 0x02, 0x14, 0x06, 0x01,
+    0x00, 0xd0, 0x0f, 0x06, 0x00, 0x01, 0x01, 0x05, 0x0e, 0x02, 0x14, 0x08, 0x01, 0x00, 0x04, 0xd0,
+    0x0f, 0x01, 0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x06, 0x02, 0x04, 0x14, 0x06, 0x01, 0x00, 0xd0,
+    0x0a, 0x01, 0x00, 0x06, 0x00, 0x00, 0x14, 0x06, 0x01, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x00, 0x06,
+    0x02, 0x00, 0x01, 0x01, 0x03, 0x04, 0x00, 0x04, 0x02, 0x00, 0x00, 0x04, 0xd0, 0x0f, 0x01, 0x01,
+    0x01, 0x03, 0x06, 0x00, 0x04, 0x02, 0x00, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x00, 0x02, 0x04, 0x01,
+    0x0c, 0x14, 0x06, 0x01, 0x00, 0x04, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x04, 0x08, 0x0c, 0x06, 0x06,
+    0x00, 0x00, 0x02, 0xce, 0x0f, 0x01, 0x00, 0x06, 0x04, 0x00, 0x01, 0x00, 0x02, 0x0c, 0x0c, 0x12,
+    0x08, 0x01, 0x00, 0xd4, 0x0f, 0x02, 0x00, 0x01, 0x00, 0x03, 0x0e, 0x0c, 0x04, 0x02, 0x00, 0x00,
+    0x03, 0x02, 0x08, 0x04, 0x02, 0x01, 0x00, 0x02, 0xd2, 0x0f, 0x01, 0x01, 0x01, 0x04, 0x04, 0x08,
+    0x06, 0x06, 0x01, 0x00, 0x02, 0xd2, 0x0f, 0x01, 0x00, 0x04, 0x04, 0x01, 0x00, 0x06, 0x02, 0x00,
+    0x00, 0x08, 0x04, 0x00, 0x01, 0x00, 0x01, 0x0c, 0x08, 0x06, 0x04, 0x01, 0x00, 0xd2, 0x0f, 0x04,
+    0x00, 0x02, 0x08, 0x01, 0x01, 0x01, 0x05, 0x0e, 0x0c, 0x14, 0x08, 0x01, 0x00, 0x02, 0xd2, 0x0f,
+    0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x04, 0x01, 0x01, 0x01, 0x03, 0x04, 0x0e, 0x04, 0x02,
+    0x01, 0x00, 0x00, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x05, 0x06, 0x0e, 0x14, 0x08, 0x01, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x03, 0x02, 0x0c, 0x04, 0x02, 0x00, 0x00, 0xd4, 0x0f, 0x04, 0x00, 0x01, 0x01,
+    0x04, 0x04, 0x0c, 0x06, 0x06, 0x01, 0x00, 0x08, 0xd0, 0x0f, 0x01, 0x00, 0x04, 0x06, 0x01, 0x00,
+    0x04, 0x06, 0x01, 0x00, 0x02, 0x06, 0x01, 0x01, 0x01, 0x01, 0x0c, 0x0c, 0x06, 0x04, 0x01, 0x00,
+    0x0c, 0x04, 0x02, 0x00, 0x00, 0x00, 0xd0, 0x0f, 0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00, 0x04,
+    0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x06, 0x0c, 0x0c, 0x14, 0x06, 0x01, 0x00, 0x02, 0xd0,
+    0x0f, 0x01, 0x00, 0x02, 0x02, 0x00, 0x01, 0x00, 0x01, 0x00, 0x0e, 0x06, 0x04, 0x01, 0x00, 0xce,
+    0x06, 0x01, 0x00, 0x00, 0xd0, 0x0f, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x0a, 0x02, 0x00, 0x01, 0x00, 0x05, 0x08, 0x06, 0x14, 0x08, 0x01, 0x00,
+    0xd0, 0x0f, 0x04, 0x00, 0x01, 0x01, 0x06, 0x0a, 0x06, 0x14, 0x06, 0x01, 0x00, 0x02, 0xce, 0x0f,
+    0x02, 0x06, 0x01, 0x00, 0x00, 0x08, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x08, 0x04, 0x02, 0x01, 0x00,
+    0x00, 0xd2, 0x0f, 0x01, 0x00, 0x06, 0x00, 0x00, 0x01, 0x00, 0x01, 0x02, 0x0a, 0x06, 0x04, 0x01,
+    0x00, 0xd4, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x04, 0x04, 0x0a, 0x06, 0x06, 0x01, 0x00, 0xd0, 0x0f,
+    0xd0, 0x0f, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x04, 0x00, 0x08, 0x06, 0x06, 0x01, 0x00,
+    0x04, 0xce, 0x0f, 0x01, 0x00, 0x06, 0x02, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x01, 0x0a, 0x08, 0x06, 0x04, 0x01, 0x00, 0xd0, 0x0f, 0x02,
+    0x01, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x00, 0x0e, 0x02, 0x06, 0x06, 0x00, 0x00, 0x00,
+    0xce, 0x0f, 0x01, 0x00, 0x08, 0x00, 0x00, 0x01, 0x00, 0x02, 0x02, 0x04, 0x12, 0x08, 0x01, 0x00,
+    0xd2, 0x0f, 0x00, 0x00, 0x00, 0x08, 0x02, 0x00, 0x00, 0x06, 0x04, 0x00, 0x00, 0x02, 0x04, 0x01,
+    0x01, 0x00, 0x05, 0x06, 0x0c, 0x14, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x02, 0x04,
+    0x01, 0x01, 0x01, 0x01, 0x0a, 0x0c, 0x06, 0x04, 0x00, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x00, 0x00,
+    0x08, 0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04,
+    0x00, 0x00, 0x01, 0x00, 0x03, 0x02, 0x00, 0x04, 0x02, 0x00, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x01,
+    0x00, 0x06, 0x04, 0x00, 0x14, 0x06, 0x01, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x02, 0x06, 0x01, 0x01, 0x01, 0x00, 0x0a, 0x00, 0x06, 0x06, 0x00, 0x00, 0x00, 0xd2, 0x0f,
+    0x00, 0x04, 0x01, 0x01, 0x00, 0x01, 0x00, 0x04, 0x06, 0x04, 0x00, 0x00, 0xd0, 0x0f, 0x00, 0x00,
+    0x00, 0x0c, 0x00, 0x00, 0x01, 0x00, 0x00, 0x04, 0x04, 0x06, 0x06, 0x01, 0x00, 0xd2, 0x0f, 0x02,
+    0x00, 0x00, 0x08, 0x02, 0x00, 0x01, 0x00, 0x06, 0x08, 0x04, 0x14, 0x06, 0x01, 0x00, 0xce, 0x0f,
+    0x02, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x06, 0x14, 0x08, 0x00, 0x00,
+    0xd0, 0x0f, 0x02, 0x00, 0x01, 0x01, 0x01, 0x02, 0x06, 0x06, 0x04, 0x01, 0x00, 0x06, 0xd0, 0x0f,
+    0x01, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x01, 0x00, 0x04, 0x08, 0x06, 0x06, 0x06,
+    0x00, 0x03, 0x08, 0x0e, 0x04, 0x02, 0x00, 0x00, 0xce, 0x0f, 0x04, 0x00, 0x00, 0x04, 0x04, 0x01,
+    0x01, 0x01, 0x03, 0x0c, 0x0e, 0x04, 0x02, 0x00, 0x00, 0x00, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x02,
+    0x0e, 0x0e, 0x12, 0x08, 0x01, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x01, 0x04, 0x00, 0xe0, 0x02, 0xd0,
+    0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x02, 0x02, 0x00, 0x00, 0x04, 0x02, 0x00, 0x01, 0x00, 0x01,
+    0x04, 0x0a, 0x06, 0x04, 0x01, 0x00, 0xce, 0x0f, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02,
+    0x02, 0x01, 0x00, 0x02, 0x06, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x0a, 0x04, 0x02, 0x01, 0x00, 0x00,
+    0x08, 0x06, 0x04, 0x00, 0x00, 0x00, 0xd4, 0x0f, 0x01, 0x01, 0x01, 0x04, 0x0c, 0x08, 0x06, 0x06,
+    0x01, 0x00, 0x00, 0xd4, 0x0f, 0x01, 0x01, 0x01, 0x06, 0x0e, 0x08, 0x14, 0x06, 0x01, 0x00, 0x00,
+    0xd0, 0x0f, 0x01, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x06, 0x06, 0x00, 0x00, 0xd2, 0x0f, 0x00, 0x00,
+    0x01, 0x01, 0x04, 0x08, 0x0c, 0x06, 0x06, 0x01, 0x00, 0x04, 0xd2, 0x0f, 0x01, 0x01, 0x01, 0x03,
+    0x0a, 0x0c, 0x04, 0x02, 0x00, 0x00, 0x02, 0xd2, 0x0f, 0x01, 0x00, 0x00, 0x0a, 0x01, 0x00, 0x00,
+    0x06, 0x01, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x0e, 0x06, 0x06, 0x01, 0x00, 0xd0,
+    0x00, 0x00, 0x02, 0x01, 0x00, 0x06, 0x02, 0x00, 0x01, 0x00, 0x03, 0x06, 0x06, 0x04, 0x02, 0x00,
+    0x00, 0xd0, 0x0f, 0x02, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04,
+    0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+    0x00, 0x01, 0x00, 0x06, 0x06, 0x08, 0x14, 0x06, 0x01, 0x00, 0xce, 0x0f, 0x02, 0x00, 0x01, 0x01,
+    0x01, 0x08, 0x08, 0x06, 0x04, 0x01, 0x00, 0x04, 0xce, 0x0f, 0x01, 0x00, 0x04, 0x06, 0x01, 0x01,
+    0x00, 0x05, 0x0c, 0x08, 0x14, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x08, 0x00, 0x01, 0x01, 0x02, 0x0e,
+    0x02, 0x06, 0x01, 0x01, 0x01, 0x06, 0x0c, 0x04, 0x14, 0x06, 0x01, 0x00, 0x02, 0xd2, 0x0f, 0x01,
+    0x00, 0x02, 0x04, 0x01, 0x00, 0x04, 0x02, 0x00, 0x01, 0x00, 0x03, 0x02, 0x06, 0x04, 0x02, 0x01,
+    0x00, 0xd0, 0x0f, 0x04, 0x00, 0x00, 0x06, 0x02, 0x00, 0x00, 0x02, 0x02, 0x00, 0x00, 0x02, 0x04,
+    0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x05, 0x02, 0x02, 0x14, 0x08,
+    0x01, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x01, 0x04, 0x02, 0x06, 0x04, 0x01, 0x00, 0xce,
+    0x0f, 0x02, 0x00, 0x00, 0x02, 0x04, 0x01, 0x01, 0x01, 0x06, 0x08, 0x02, 0x14, 0x06, 0x01, 0x00,
+    0x06, 0x04, 0x02, 0x00, 0x00, 0xd2, 0x0f, 0x02, 0x00, 0x01, 0x00, 0x06, 0x02, 0x06, 0x14, 0x06,
+    0x01, 0x00, 0xd2, 0x0f, 0x04, 0x00, 0x00, 0x06, 0x04, 0x00, 0x01, 0x00, 0x00, 0x06, 0x06, 0x06,
+    0x06, 0x01, 0x00, 0xd0, 0x0f, 0x04, 0x00, 0x00, 0x02, 0x06, 0x01, 0x01, 0x01, 0x04, 0x0a, 0x06,
+    0x00, 0x00, 0x01, 0x00, 0x03, 0x06, 0x00, 0x04, 0x02, 0x01, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x01,
+    0x00, 0x03, 0x08, 0x00, 0x04, 0x02, 0x01, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x02, 0x01, 0x01, 0x00, 0x06, 0x00, 0x02, 0x14, 0x06, 0x00,
+    0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x01, 0x06, 0x00, 0x06, 0x04,
+    0x01, 0x00, 0x00, 0xd2, 0x0f, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x00, 0x0a, 0x00, 0x06,
+    0x06, 0x01, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x04, 0x08, 0x70, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x31, 0x32, 0xe8, 0x0f, 0x0a, 0x62, 0x61, 0x79,
+    0x6f, 0x75, 0x5f, 0x35, 0x30, 0x32, 0x38, 0xc8, 0x12, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x02, 0x02, 0x01, 0x00, 0x02, 0x04, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x0c, 0x04, 0x02, 0x01, 0x00,
+    0x00, 0xce, 0x0f, 0x01, 0x00, 0x00, 0x02, 0x01, 0x01, 0x01, 0x05, 0x02, 0x0e, 0x14, 0x08, 0x01,
+    0x00, 0x00, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x01, 0x04, 0x0e, 0x06, 0x04, 0x01, 0x00, 0x00, 0xce,
+    0x08, 0x14, 0x08, 0x01, 0x00, 0x04, 0xce, 0x0f, 0x01, 0x01, 0x00, 0x01, 0x0c, 0x08, 0x04, 0x04,
+    0x01, 0x00, 0xce, 0x0f, 0x06, 0x00, 0x01, 0x01, 0x05, 0x0e, 0x08, 0x14, 0x08, 0x01, 0x00, 0x02,
+    0xd0, 0x0f, 0x01, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x00, 0x02, 0x0a, 0x06, 0x06, 0x01, 0x00,
+    0x03, 0x02, 0x04, 0x04, 0x02, 0x00, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x01, 0x00, 0x03, 0x04, 0x04,
+    0x04, 0x02, 0x00, 0x00, 0xce, 0x0f, 0x06, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x04, 0x04, 0x01,
+    0x01, 0x01, 0x03, 0x0a, 0x04, 0x04, 0x02, 0x01, 0x00, 0x04, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x06,
+    0x08, 0x01, 0x00, 0x04, 0x04, 0x01, 0x00, 0x04, 0x02, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x06,
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x05, 0x02, 0x0c, 0x14, 0x08, 0x01, 0x00, 0xd0,
+    0x0f, 0x02, 0x00, 0x00, 0x04, 0x06, 0x01, 0x01, 0x01, 0x03, 0x06, 0x0c, 0x04, 0x02, 0x00, 0x00,
+    0x00, 0x04, 0x01, 0x01, 0x01, 0x06, 0x0c, 0x00, 0x14, 0x06, 0x01, 0x00, 0x00, 0xd0, 0x0f, 0x01,
+    0x01, 0x01, 0x03, 0x0e, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x01, 0x00, 0x02,
+    0x00, 0x02, 0x12, 0x08, 0x01, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x08, 0x02, 0x00, 0x01, 0x01,
+    0x00, 0xd2, 0x0f, 0x02, 0x00, 0x00, 0x04, 0x04, 0x00, 0x01, 0x01, 0x04, 0x0a, 0x06, 0x06, 0x06,
+    0x01, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x00,
+    0x03, 0x00, 0x08, 0x04, 0x02, 0x00, 0x00, 0xd4, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x06, 0x02, 0x08,
+    0x00, 0x06, 0x02, 0x00, 0x00, 0x06, 0x04, 0x00, 0x01, 0x01, 0x03, 0x08, 0x06, 0x04, 0x02, 0x01,
+    0x00, 0x04, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x03, 0x0a, 0x06, 0x04, 0x02, 0x00, 0x00, 0x04, 0xce,
+    0x0f, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x06, 0x04, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x04, 0x01, 0x10, 0x10, 0x0a,
+    0x06, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x02, 0x02, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x06,
+    0x04, 0x02, 0x01, 0x00, 0x00, 0xd2, 0x0f, 0x01, 0x01, 0x01, 0x01, 0x0e, 0x06, 0x06, 0x04, 0x01,
+    0x00, 0x00, 0xd0, 0x0f, 0x01, 0x00, 0x06, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x02,
+    0x0a, 0x01, 0x00, 0x03, 0x00, 0x00, 0x04, 0x02, 0x01, 0x00, 0xce, 0x0f, 0x02, 0x00, 0x01, 0x01,
+    0x05, 0x02, 0x00, 0x14, 0x08, 0x01, 0x00, 0x02, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x02, 0x01, 0x00,
+    0x02, 0x02, 0x01, 0x00, 0x02, 0x06, 0x01, 0x01, 0x01, 0x06, 0x0a, 0x00, 0x14, 0x06, 0x01, 0x00,
+    0x01, 0x05, 0x0c, 0x00, 0x14, 0x08, 0x00, 0x00, 0x00, 0xd2, 0x0f, 0x01, 0x00, 0x00, 0x04, 0x01,
+    0x01, 0x00, 0x03, 0x00, 0x02, 0x04, 0x02, 0x00, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x0a, 0x00,
+    0x00, 0x01, 0x00, 0x03, 0x04, 0x02, 0x04, 0x02, 0x00, 0x00, 0xd0, 0x0f, 0x04, 0x00, 0x01, 0x01,
+    0x08, 0x01, 0x00, 0x06, 0xce, 0x0f, 0x01, 0x01, 0x00, 0x05, 0x06, 0x0a, 0x14, 0x08, 0x01, 0x00,
+    0xd2, 0x0f, 0x04, 0x00, 0x00, 0x04, 0x06, 0x01, 0x01, 0x01, 0x03, 0x0a, 0x0a, 0x04, 0x02, 0x00,
+    0x00, 0x04, 0xd0, 0x0f, 0x01, 0x00, 0x02, 0x08, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x0a, 0x04, 0x02,
+    0x00, 0x06, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x04, 0x04, 0x02, 0x01, 0x00,
+    0x00, 0xd0, 0x0f, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0x02, 0x02, 0x00, 0x01, 0x01, 0x01, 0x06, 0x06, 0x06, 0x04, 0x01, 0x00, 0x00, 0xce, 0x0f,
+    0x0a, 0x01, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0x00, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x08,
+    0x00, 0x00, 0x01, 0x00, 0x03, 0x04, 0x00, 0x04, 0x02, 0x00, 0x00, 0xd0, 0x0f, 0x02, 0x00, 0x00,
+    0x04, 0x02, 0x00, 0x00, 0x02, 0x02, 0x00, 0x01, 0x00, 0x03, 0x0a, 0x00, 0x04, 0x02, 0x01, 0x00,
+    0x06, 0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x02, 0x04,
+    0x02, 0x00, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x01, 0x00, 0x06, 0x00, 0x04, 0x14, 0x06, 0x01, 0x00,
+    0xd2, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x03, 0x02, 0x04, 0x04, 0x02, 0x01, 0x00, 0xd2, 0x0f, 0x00,
+    0x0f, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x04, 0x04, 0x02, 0x00, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x01,
+    0x00, 0x01, 0x00, 0x06, 0x06, 0x04, 0x01, 0x00, 0xce, 0x0f, 0x02, 0x00, 0x00, 0x06, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x04, 0x06, 0x06, 0x06, 0x01, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x02, 0x02,
+    0x00, 0x02, 0x01, 0x00, 0x02, 0x04, 0x01, 0x01, 0x00, 0x00, 0x04, 0x0a, 0x06, 0x06, 0x01, 0x00,
+    0xce, 0x0f, 0x06, 0x00, 0x00, 0x02, 0x06, 0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x02, 0x04, 0x01,
+    0x00, 0x02, 0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x01, 0x01, 0x01, 0x01, 0x02,
+    0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x04,
+    0x01, 0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x06, 0x02, 0x02, 0x14, 0x06, 0x01, 0x00, 0xd2, 0x0f,
+    0x02, 0x00, 0x01, 0x01, 0x04, 0x04, 0x02, 0x06, 0x06, 0x01, 0x00, 0x06, 0xce, 0x0f, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0x04, 0x01, 0x01, 0x01, 0x03, 0x0a, 0x06, 0x04, 0x02, 0x01, 0x00, 0x02,
+    0xd0, 0x0f, 0x01, 0x00, 0x00, 0x0a, 0x01, 0x01, 0x01, 0x06, 0x0e, 0x06, 0x14, 0x06, 0x01, 0x00,
+    0x00, 0xd0, 0x0f, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x01, 0x00, 0x06, 0x04,
+    0x14, 0x08, 0x00, 0x00, 0x00, 0xd4, 0x0f, 0x01, 0x01, 0x01, 0x03, 0x0a, 0x08, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0xd4, 0x0f, 0x01, 0x00, 0x02, 0x0a, 0x01, 0x01, 0x01, 0x03, 0x0e, 0x08, 0x04, 0x02,
+    0x00, 0x00, 0x02, 0xd2, 0x0f, 0x01, 0x01, 0x01, 0x03, 0x00, 0x0a, 0x04, 0x02, 0x00, 0x00, 0x00,
+    0x05, 0x08, 0x04, 0x14, 0x08, 0x01, 0x00, 0xd0, 0x0f, 0x04, 0x00, 0x00, 0x04, 0x04, 0x01, 0x00,
+    0x02, 0x06, 0x01, 0x01, 0x01, 0x01, 0x0e, 0x04, 0x06, 0x04, 0x01, 0x00, 0x02, 0xce, 0x0f, 0x01,
+    0x01, 0x00, 0x03, 0x00, 0x06, 0x04, 0x02, 0x00, 0x00, 0xd2, 0x0f, 0x04, 0x00, 0x01, 0x01, 0x05,
+    0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x03, 0x00, 0x02, 0x04, 0x02, 0x01, 0x00,
+    0xd0, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x03, 0x02, 0x02, 0x04, 0x02, 0x01, 0x00, 0xce, 0x0f, 0x00,
+    0x00, 0x00, 0x06, 0x02, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x02, 0x02, 0x01, 0x00, 0x00, 0x02,
+    0x01, 0x00, 0x02, 0x04, 0x01, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x01, 0x02, 0x0e, 0x06, 0x04,
+    0x01, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x05, 0x04, 0x0e, 0x14, 0x08, 0x01, 0x00, 0xce,
+    0x0f, 0x02, 0x00, 0x01, 0x01, 0x04, 0x06, 0x0e, 0x06, 0x06, 0x01, 0x00, 0x02, 0xd0, 0x0f, 0x01,
+    0x00, 0x06, 0x00, 0x04, 0x14, 0x06, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x00, 0x02, 0x01, 0x01, 0x01, 0x06, 0x0e, 0x04, 0x14, 0x06, 0x00, 0x00, 0x00, 0xce, 0x0f,
+    0x08, 0x02, 0x06, 0x06, 0x01, 0x00, 0x04, 0xd0, 0x0f, 0x01, 0x00, 0x02, 0x06, 0x01, 0x00, 0x00,
+    0x08, 0x01, 0x01, 0x01, 0x06, 0x0e, 0x02, 0x14, 0x06, 0x01, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x01,
+    0x00, 0x01, 0x00, 0x04, 0x06, 0x04, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0xce, 0x0f, 0x01, 0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x03, 0x02, 0x0a, 0x04, 0x02, 0x00,
+    0x00, 0xd0, 0x0f, 0x02, 0x00, 0x01, 0x00, 0x01, 0x04, 0x0a, 0x02, 0x04, 0x01, 0x00, 0xce, 0x0f,
+    0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x02, 0x02, 0x00, 0x00, 0x02, 0x02, 0x01, 0x00, 0x00,
+    0x2c, 0x36, 0x2c, 0x36, 0x2c, 0x36, 0x2c, 0x37, 0x2c, 0x37, 0x2c, 0x37, 0x2c, 0x33, 0x2c, 0x33,
+    0x2c, 0x35, 0x2c, 0x35, 0x2c, 0x34, 0x2c, 0x34, 0x2c, 0x32, 0x2c, 0x31, 0x2c, 0x38, 0x2c, 0x38,
+    0x2c, 0x38, 0x2c, 0x37, 0x2c, 0x31, 0x31, 0x2c, 0x31, 0x30, 0x2c, 0x32, 0x2c, 0x31, 0x30, 0x2c,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00,
+    0x00, 0x04, 0x04, 0x01, 0x01, 0x01, 0x06, 0x0a, 0x02, 0x14, 0x06, 0x01, 0x00, 0x02, 0xd2, 0x0f,
+    0x01, 0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x02, 0x02, 0x01, 0x00, 0x04, 0x02,
+    0x00, 0x00, 0x02, 0x01, 0x00, 0x04, 0x02, 0x00, 0x01, 0x00, 0x03, 0x04, 0x0e, 0x04, 0x02, 0x00,
+    0x00, 0xce, 0x0f, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x01, 0x00, 0x04,
+    0x0a, 0x0e, 0x06, 0x06, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x01, 0x00,
+    0x02, 0x04, 0x01, 0x00, 0x02, 0x04, 0x01, 0x00, 0x02, 0x06, 0x01, 0x01, 0x01, 0x03, 0x08, 0x04,
+    0x04, 0x02, 0x00, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x00, 0x02, 0x06, 0x01, 0x00, 0x02, 0x06, 0x01,
+    0x01, 0x01, 0x06, 0x0e, 0x04, 0x14, 0x06, 0x01, 0x00, 0x00, 0xd2, 0x0f, 0x01, 0x00, 0x02, 0x00,
+    0x04, 0x01, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+    0x00, 0x02, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x01,
+    0x00, 0x03, 0x04, 0x0c, 0x04, 0x02, 0x00, 0x00, 0xd2, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x06, 0x06,
+    0x00, 0xce, 0x0f, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x02, 0x02, 0x01,
+    0x01, 0x00, 0x02, 0x08, 0x00, 0x12, 0x08, 0x01, 0x00, 0xce, 0x0f, 0x04, 0x00, 0x00, 0x02, 0x04,
+    0x01, 0x01, 0x01, 0x03, 0x0c, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0xd2, 0x0f, 0x01, 0x01, 0x01,
+    0x02, 0x00, 0x00, 0x00, 0x02, 0x02, 0x01, 0x01, 0x01, 0x03, 0x0a, 0x02, 0x04, 0x02, 0x00, 0x00,
+    0x02, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x02, 0x04, 0x02, 0x01, 0x00, 0x02, 0xce, 0x0f,
+    0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x01, 0x00, 0x03,
+    0xce, 0x0f, 0x00, 0x00, 0x00, 0x06, 0x02, 0x00, 0x01, 0x00, 0x00, 0x02, 0x06, 0x06, 0x06, 0x01,
+    0x00, 0xd0, 0x0f, 0x02, 0x00, 0x00, 0x02, 0x02, 0x00, 0x00, 0x00, 0x02, 0x01, 0x01, 0x01, 0x00,
+    0x08, 0x06, 0x06, 0x06, 0x01, 0x00, 0x00, 0xd0, 0x0f, 0x01, 0x01, 0x01, 0x06, 0x0a, 0x06, 0x14,
+    0x06, 0x06, 0x01, 0x00, 0x02, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x04, 0x01, 0x01, 0x00, 0x00, 0x06,
+    0x0a, 0x06, 0x06, 0x01, 0x00, 0xce, 0x0f, 0x04, 0x00, 0x01, 0x01, 0x01, 0x08, 0x0a, 0x06, 0x04,
+    0x01, 0x00, 0x02, 0xd0, 0x0f, 0x01, 0x00, 0x00, 0x04, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x0a, 0x04,
+    0x00, 0x06, 0x04, 0x01, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00, 0x01, 0x01, 0x06,
+    0x04, 0x02, 0x14, 0x06, 0x01, 0x00, 0x04, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x02, 0x00, 0x00, 0x02,
+    0x08, 0x01, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x02, 0x01, 0x01, 0x01, 0x03, 0x06, 0x0e, 0x04, 0x02, 0x00, 0x00, 0x02, 0xce, 0x0f, 0x01,
+    0x00, 0x04, 0x02, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x02, 0x04, 0x01, 0x00, 0x00, 0x04, 0x01,
+    0x01, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x03, 0x0a, 0x02, 0x04, 0x02, 0x00, 0x00, 0x00, 0xd0,
+    0x0f, 0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00, 0x02, 0x01, 0x01, 0x00, 0x03, 0x00, 0x04, 0x04,
+    0x02, 0x00, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00, 0x01,
+    0x14, 0x06, 0x01, 0x00, 0xd0, 0x0f, 0x00, 0x00, 0x01, 0x00, 0x06, 0x0c, 0x06, 0x14, 0x06, 0x01,
+    0x00, 0xce, 0x0f, 0x02, 0x00, 0x00, 0x02, 0x02, 0x01, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x03,
+    0x02, 0x08, 0x04, 0x02, 0x00, 0x00, 0xce, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x01, 0x00,
+    0x04, 0x02, 0x00, 0x00, 0x00, 0xce, 0x0f, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x02, 0x01,
+    0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+};
+
+} // namespace
+
+std::string_view compressionDictionary() {
+    return std::string_view(reinterpret_cast<const char*>(DICTIONARY), sizeof(DICTIONARY));
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,135 @@
+#include "DatabaseWriter.h"
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+
+namespace BayouBonanza {
+
+DatabaseWriter::DatabaseWriter(PlayerDatabase& database) : DatabaseWriter(database, Options{}) {}
+
+DatabaseWriter::DatabaseWriter(PlayerDatabase& database, Options options)
+    : database(database), config(options) {
+    if (config.maxBatch == 0) {
+        config.maxBatch = 1;
+    }
+    thread = std::thread(&DatabaseWriter::writerLoop, this);
+}
+
+DatabaseWriter::~DatabaseWriter() {
+    shutdown();
+}
+
+void DatabaseWriter::submit(PlayerDatabase::WriteGroup writes, Completion done) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping) {
+            // Nothing would write it; say so rather than drop it silently
+            lock.unlock();
+            if (done) {
+                done(false);
+            }
+            return;
+        }
+        if (pendingGroups.empty()) {
+            oldestQueued = Clock::now();
+        }
+        pendingGroups.push_back(std::move(writes));
+        pendingCompletions.push_back(std::move(done));
+        submitted++;
+    }
+    queued.notify_one();
+}
+
+void DatabaseWriter::whenWritten(std::function<void()> done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (counters.groups < submitted) {
+            waiters.push_back({submitted, std::move(done)});
+            return;
+        }
+    }
+    done();
+}
+
+void DatabaseWriter::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queued.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+DatabaseWriter::Stats DatabaseWriter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = counters;
+    result.pending = pendingGroups.size();
+    return result;
+}
+
+void DatabaseWriter::report(std::ostream& out) const {
+    Stats s = stats();
+    out << "Database writer: " << s.groups << " writes in " << s.batches << " transactions";
+    if (s.batches > 0) {
+        out << " (" << std::fixed << std::setprecision(1) << static_cast<double>(s.groups) / s.batches
+            << " per commit, largest " << s.largestBatch << ")" << std::defaultfloat;
+    }
+    out << ", " << s.failed << " failed, " << s.pending << " queued" << std::endl;
+}
+
+void DatabaseWriter::writerLoop() {
+    std::vector<PlayerDatabase::WriteGroup> groups;
+    std::vector<Completion> completions;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queued.wait(lock, [this]() { return stopping || !pendingGroups.empty(); });
+            if (pendingGroups.empty()) {
+                return; // Stopping with nothing left to write
+            }
+            // Give the batch until the oldest write's deadline to fill; stopping writes at once
+            queued.wait_until(lock, oldestQueued + config.maxDelay, [this]() {
+                return stopping || pendingGroups.size() >= config.maxBatch;
+            });
+
+            std::size_t take = std::min(pendingGroups.size(), config.maxBatch);
+            groups.assign(std::make_move_iterator(pendingGroups.begin()),
+                          std::make_move_iterator(pendingGroups.begin() + take));
+            completions.assign(std::make_move_iterator(pendingCompletions.begin()),
+                               std::make_move_iterator(pendingCompletions.begin() + take));
+            pendingGroups.erase(pendingGroups.begin(), pendingGroups.begin() + take);
+            pendingCompletions.erase(pendingCompletions.begin(), pendingCompletions.begin() + take);
+            // What is left has already waited; it goes out with the next commit
+            oldestQueued = Clock::now() - config.maxDelay;
+        }
+
+        std::vector<bool> stored = database.applyWrites(groups);
+
+        std::size_t failed = static_cast<std::size_t>(std::count(stored.begin(), stored.end(), false));
+        std::vector<Waiter> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            counters.groups += groups.size();
+            counters.failed += failed;
+            counters.batches++;
+            counters.largestBatch = std::max(counters.largestBatch, groups.size());
+            // Waiters are in order, so the finished ones are at the front
+            auto waiting = std::find_if(waiters.begin(), waiters.end(),
+                                        [this](const Waiter& waiter) { return waiter.submitted > counters.groups; });
+            finished.assign(std::make_move_iterator(waiters.begin()), std::make_move_iterator(waiting));
+            waiters.erase(waiters.begin(), waiting);
+        }
+        for (std::size_t i = 0; i < completions.size(); ++i) {
+            if (completions[i]) {
+                completions[i](stored[i]);
+            }
+        }
+        for (Waiter& waiter : finished) {
+            waiter.done();
+        }
+    }
+}
+
+} // namespace BayouBonanza
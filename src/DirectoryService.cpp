@@ -0,0 +1,271 @@
+#include "DirectoryService.h"
+
+#if !defined(_WIN32)
+
+#include "Reactor.h"
+#include "UnixChannel.h"
+#include <SFML/Network/Packet.hpp>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <iostream>
+#include <iterator>
+
+namespace BayouBonanza {
+
+namespace {
+
+const unsigned TICKET_BITS = 48;
+const Matchmaker::TicketId LOCAL_TICKET_MASK = (Matchmaker::TicketId(1) << TICKET_BITS) - 1;
+
+sf::Packet makeMessage(DirectoryMessage type) {
+    sf::Packet packet;
+    packet << static_cast<sf::Uint8>(type);
+    return packet;
+}
+
+} // namespace
+
+DirectoryService::DirectoryService(Reactor& reactor, Matchmaker::Config config, std::chrono::milliseconds tick)
+    : reactor(reactor), matchmaker(config), tick(tick), listener(-1) {}
+
+DirectoryService::~DirectoryService() {
+    for (auto& entry : connections) {
+        reactor.remove(entry.first);
+    }
+    if (listener >= 0) {
+        reactor.remove(listener);
+        ::close(listener);
+    }
+}
+
+bool DirectoryService::listen(const std::string& path) {
+    listener = UnixChannel::listen(path);
+    if (listener < 0) {
+        return false;
+    }
+    if (!reactor.add(listener, Reactor::Readable, [this](unsigned) { onAcceptable(); })) {
+        ::close(listener);
+        listener = -1;
+        return false;
+    }
+    reactor.timers().schedule(tick, [this]() { runTick(); });
+    return true;
+}
+
+Matchmaker::TicketId DirectoryService::globalTicket(int process, Matchmaker::TicketId local) {
+    return (static_cast<Matchmaker::TicketId>(process) << TICKET_BITS) | (local & LOCAL_TICKET_MASK);
+}
+
+int DirectoryService::processOf(Matchmaker::TicketId global) {
+    return static_cast<int>(global >> TICKET_BITS);
+}
+
+Matchmaker::TicketId DirectoryService::localTicket(Matchmaker::TicketId global) {
+    return global & LOCAL_TICKET_MASK;
+}
+
+DirectoryService::Connection* DirectoryService::process(int index) const {
+    auto it = processes.find(index);
+    return it != processes.end() ? it->second : nullptr;
+}
+
+void DirectoryService::onAcceptable() {
+    while (true) {
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->channel = std::make_unique<UnixChannel>(fd);
+        if (!reactor.add(fd, Reactor::Readable, [this, fd](unsigned) { onReadable(fd); })) {
+            continue; // The channel closes the socket
+        }
+        connections.emplace(fd, std::move(connection));
+    }
+}
+
+void DirectoryService::onReadable(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) {
+        return;
+    }
+    Connection& connection = *it->second;
+
+    sf::Packet packet;
+    UnixChannel::ReadResult result;
+    while ((result = connection.channel->receive(packet)) == UnixChannel::ReadResult::Message) {
+        handleMessage(connection, packet);
+    }
+    if (result == UnixChannel::ReadResult::Closed) {
+        drop(fd);
+    }
+}
+
+void DirectoryService::handleMessage(Connection& connection, sf::Packet& packet) {
+    sf::Uint8 rawType;
+    if (!(packet >> rawType)) {
+        return;
+    }
+    DirectoryMessage type = static_cast<DirectoryMessage>(rawType);
+
+    if (type == DirectoryMessage::Hello) {
+        sf::Int32 index;
+        if ((packet >> index) && index >= 0 && connection.index < 0 && !process(index)) {
+            connection.index = index;
+            processes[index] = &connection;
+            std::cout << "Directory: server process " << index << " registered" << std::endl;
+        }
+        return;
+    }
+    if (connection.index < 0) {
+        std::cerr << "Directory: message before Hello; ignoring" << std::endl;
+        return;
+    }
+
+    switch (type) {
+        case DirectoryMessage::Claim: {
+            std::string username;
+            if (packet >> username) {
+                owners[username] = connection.index;
+            }
+            break;
+        }
+        case DirectoryMessage::Release: {
+            std::string username;
+            if (packet >> username) {
+                auto owner = owners.find(username);
+                // A later claim by another process wins
+                if (owner != owners.end() && owner->second == connection.index) {
+                    owners.erase(owner);
+                }
+            }
+            break;
+        }
+        case DirectoryMessage::Lookup: {
+            sf::Uint32 request;
+            std::string username;
+            if (packet >> request >> username) {
+                auto owner = owners.find(username);
+                sf::Packet reply = makeMessage(DirectoryMessage::LookupResult);
+                reply << request << sf::Int32(owner != owners.end() ? owner->second : -1);
+                connection.channel->send(reply);
+            }
+            break;
+        }
+        case DirectoryMessage::Enqueue: {
+            sf::Uint64 ticket;
+            sf::Int32 rating;
+            if (packet >> ticket >> rating) {
+                enqueue(connection, globalTicket(connection.index, ticket), rating);
+            }
+            break;
+        }
+        case DirectoryMessage::Dequeue: {
+            sf::Uint64 ticket;
+            if (packet >> ticket) {
+                Matchmaker::TicketId global = globalTicket(connection.index, ticket);
+                matchmaker.remove(global);
+                connection.queued.erase(global);
+            }
+            break;
+        }
+        case DirectoryMessage::Handoff: {
+            int fd = connection.channel->takeDescriptor();
+            sf::Int32 target, peerRating;
+            std::string username;
+            sf::Uint64 peer;
+            sf::Uint32 capabilities;
+            if (packet >> target >> username >> peer >> peerRating >> capabilities) {
+                Connection* destination = process(target);
+                sf::Packet adopt = makeMessage(DirectoryMessage::Adopt);
+                adopt << username << peer << capabilities;
+                if (fd < 0 || !destination || !destination->channel->send(adopt, fd)) {
+                    std::cerr << "Directory: could not hand " << username << " to process " << target << std::endl;
+                    // The source already closed its copy of the socket; the opponent waiting for it goes back in the queue
+                    if (peer != 0 && destination) {
+                        enqueue(*destination, globalTicket(target, peer), peerRating);
+                    }
+                }
+            }
+            if (fd >= 0) {
+                ::close(fd); // The destination holds its own copy now
+            }
+            break;
+        }
+        case DirectoryMessage::MigrationFailed: {
+            sf::Int32 target, peerRating;
+            sf::Uint64 peer;
+            if (packet >> target >> peer >> peerRating) {
+                if (Connection* destination = process(target)) {
+                    enqueue(*destination, globalTicket(target, peer), peerRating);
+                }
+            }
+            break;
+        }
+        default:
+            std::cerr << "Directory: unexpected message type " << static_cast<int>(rawType) << std::endl;
+            break;
+    }
+}
+
+void DirectoryService::enqueue(Connection& connection, Matchmaker::TicketId global, int rating) {
+    if (matchmaker.enqueue(global, rating, Matchmaker::Clock::now())) {
+        connection.queued[global] = rating;
+    }
+}
+
+void DirectoryService::drop(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) {
+        return;
+    }
+    Connection& connection = *it->second;
+    if (connection.index >= 0) {
+        std::cout << "Directory: server process " << connection.index << " disconnected" << std::endl;
+        for (auto owner = owners.begin(); owner != owners.end();) {
+            owner = owner->second == connection.index ? owners.erase(owner) : std::next(owner);
+        }
+        for (const auto& ticket : connection.queued) {
+            matchmaker.remove(ticket.first);
+        }
+        processes.erase(connection.index);
+    }
+    reactor.remove(fd);
+    connections.erase(it);
+}
+
+void DirectoryService::runTick() {
+    for (const Matchmaker::Pairing& pairing : matchmaker.pairBatch(Matchmaker::Clock::now())) {
+        Connection* first = process(processOf(pairing.first));
+        Connection* second = process(processOf(pairing.second));
+        if (!first || !second) {
+            // Dropped processes take their tickets with them; the other side waits for the next tick
+            if (first) {
+                enqueue(*first, pairing.first, first->queued[pairing.first]);
+            } else if (second) {
+                enqueue(*second, pairing.second, second->queued[pairing.second]);
+            }
+            continue;
+        }
+        int firstRating = first->queued[pairing.first];
+        first->queued.erase(pairing.first);
+        second->queued.erase(pairing.second);
+
+        if (first == second) {
+            sf::Packet match = makeMessage(DirectoryMessage::Match);
+            match << sf::Uint64(localTicket(pairing.first)) << sf::Uint64(localTicket(pairing.second));
+            first->channel->send(match);
+        } else {
+            // The later arrival moves to the process where its opponent is already waiting
+            sf::Packet migrate = makeMessage(DirectoryMessage::Migrate);
+            migrate << sf::Uint64(localTicket(pairing.second)) << sf::Int32(first->index)
+                    << sf::Uint64(localTicket(pairing.first)) << sf::Int32(firstRating);
+            second->channel->send(migrate);
+        }
+    }
+    reactor.timers().schedule(tick, [this]() { runTick(); });
+}
+
+} // namespace BayouBonanza
+
+#endif
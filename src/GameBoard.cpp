@@ -9,9 +9,34 @@
 namespace BayouBonanza {
 
 GameBoard::GameBoard() {
+    attachSquares();
     resetBoard();
 }
 
+GameBoard::GameBoard(GameBoard&& other) noexcept {
+    attachSquares();
+    *this = std::move(other);
+}
+
+GameBoard& GameBoard::operator=(GameBoard&& other) noexcept {
+    if (this != &other) {
+        for (int y = 0; y < BOARD_SIZE; y++) {
+            for (int x = 0; x < BOARD_SIZE; x++) {
+                board[y][x] = std::move(other.board[y][x]);
+            }
+        }
+    }
+    return *this;
+}
+
+void GameBoard::attachSquares() {
+    for (int y = 0; y < BOARD_SIZE; y++) {
+        for (int x = 0; x < BOARD_SIZE; x++) {
+            board[y][x].attachHash(&boardHash, static_cast<std::uint64_t>(y * BOARD_SIZE + x));
+        }
+    }
+}
+
 Square& GameBoard::getSquare(int x, int y) {
     return board[y][x];
 }
@@ -38,8 +63,9 @@ void GameBoard::recalculateControlValues() {
     InfluenceSystem::calculateBoardInfluence(*this);
 }
 
-// SFML Packet operators for GameBoard
-sf::Packet& operator<<(sf::Packet& packet, const GameBoard& gb) {
+// Packet operators for GameBoard
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GameBoard& gb) {
     for (int y = 0; y < GameBoard::BOARD_SIZE; ++y) {
         for (int x = 0; x < GameBoard::BOARD_SIZE; ++x) {
             packet << gb.getSquare(x, y); // Square::operator<< does not need factory
@@ -49,7 +75,8 @@ sf::Packet& operator<<(sf::Packet& packet, const GameBoard& gb) {
 }
 
 // Updated to match signature without PieceFactory
-sf::Packet& operator>>(sf::Packet& packet, GameBoard& gb) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GameBoard& gb) {
     for (int y = 0; y < GameBoard::BOARD_SIZE; ++y) {
         for (int x = 0; x < GameBoard::BOARD_SIZE; ++x) {
             // GameBoard::getSquare(x,y) returns a Square&.
@@ -59,4 +86,10 @@ sf::Packet& operator>>(sf::Packet& packet, GameBoard& gb) {
     return packet;
 }
 
+// The serializers are only used with these streams
+template sf::Packet& operator<<(sf::Packet& packet, const GameBoard& value);
+template sf::Packet& operator>>(sf::Packet& packet, GameBoard& value);
+template WireWriter& operator<<(WireWriter& packet, const GameBoard& value);
+template WireReader& operator>>(WireReader& packet, GameBoard& value);
+
 } // namespace BayouBonanza
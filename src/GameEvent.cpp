@@ -0,0 +1,255 @@
+#include "GameEvent.h"
+#include "GameStateDelta.h"
+#include "GameRules.h"
+#include "TurnManager.h"
+#include "Move.h"
+#include "CardFactory.h"
+#include <memory>
+
+namespace BayouBonanza {
+
+namespace {
+
+const sf::Uint8 TYPE_MASK = 0x0F;
+
+int seat(PlayerSide side) {
+    return side == PlayerSide::PLAYER_ONE ? 0 : 1;
+}
+
+sf::Uint8 squareIndex(const Position& position) {
+    return static_cast<sf::Uint8>(position.y * GameBoard::BOARD_SIZE + position.x);
+}
+
+bool readSquare(WireReader& reader, Position& position) {
+    sf::Uint8 index;
+    if (!(reader >> index) || index >= GameStateSnapshot::SQUARE_COUNT) {
+        return false;
+    }
+    position = Position(index % GameBoard::BOARD_SIZE, index / GameBoard::BOARD_SIZE);
+    return true;
+}
+
+} // namespace
+
+GameEvent::GameEvent(Type type, const GameState& state) : type(type), actor(state.getActivePlayer()) {
+    handSizesBefore[0] = state.getHand(PlayerSide::PLAYER_ONE).size();
+    handSizesBefore[1] = state.getHand(PlayerSide::PLAYER_TWO).size();
+}
+
+GameEvent GameEvent::move(const GameState& state, const Position& from, const Position& to) {
+    GameEvent event(Type::Move, state);
+    event.from = from;
+    event.to = to;
+    return event;
+}
+
+GameEvent GameEvent::playCard(const GameState& state, int cardIndex, const Position& target) {
+    GameEvent event(Type::PlayCard, state);
+    event.cardIndex = cardIndex;
+    event.to = target;
+    const Hand& hand = state.getHand(state.getActivePlayer());
+    if (cardIndex >= 0 && static_cast<std::size_t>(cardIndex) < hand.size() && hand.getCard(cardIndex)) {
+        event.cardId = hand.getCard(cardIndex)->getId();
+    }
+    return event;
+}
+
+GameEvent GameEvent::nextPhase(const GameState& state) {
+    return GameEvent(Type::NextPhase, state);
+}
+
+GameEvent GameEvent::endTurn(const GameState& state) {
+    return GameEvent(Type::EndTurn, state);
+}
+
+void GameEvent::recordDraws(const GameState& state) {
+    for (PlayerSide side : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+        const Hand& hand = state.getHand(side);
+        std::size_t kept = handSizesBefore[seat(side)];
+        // The played card left its owner's hand before anything was drawn
+        if (type == Type::PlayCard && side == actor && kept > 0) {
+            kept--;
+        }
+        std::vector<int>& drawn = drawnCards[seat(side)];
+        drawn.clear();
+        for (std::size_t i = kept; i < hand.size(); ++i) {
+            const Card* card = hand.getCard(i);
+            drawn.push_back(card ? card->getId() : -1);
+        }
+        drawCounts[seat(side)] = drawn.size();
+    }
+}
+
+const std::vector<int>& GameEvent::getDrawnCards(PlayerSide side) const {
+    return drawnCards[seat(side)];
+}
+
+void GameEvent::write(WireWriter& writer, sf::Uint32 sequence, PlayerSide viewer,
+                      std::optional<sf::Uint64> stateHash) const {
+    sf::Uint8 header = static_cast<sf::Uint8>(type);
+    if (stateHash) {
+        header |= HAS_STATE_HASH;
+    }
+    writer << sequence << header;
+
+    switch (type) {
+        case Type::Move:
+            writer << squareIndex(from) << squareIndex(to);
+            break;
+        case Type::PlayCard:
+            writer << static_cast<sf::Uint8>(cardIndex) << static_cast<sf::Uint16>(cardId) << squareIndex(to);
+            break;
+        case Type::NextPhase:
+        case Type::EndTurn:
+            break;
+    }
+
+    writer << static_cast<sf::Uint8>(drawCounts[0] | (drawCounts[1] << 4));
+    for (int cardIdDrawn : drawnCards[seat(viewer)]) {
+        writer << static_cast<sf::Uint16>(cardIdDrawn);
+    }
+
+    if (stateHash) {
+        writer.writeFixed64(*stateHash);
+    }
+}
+
+bool GameEvent::read(WireReader& reader, GameEvent& event, sf::Uint32& sequence,
+                     std::optional<sf::Uint64>& stateHash, PlayerSide viewer) {
+    sf::Uint8 header;
+    if (!(reader >> sequence >> header) || (header & TYPE_MASK) > static_cast<sf::Uint8>(Type::EndTurn)) {
+        return false;
+    }
+    event.type = static_cast<Type>(header & TYPE_MASK);
+
+    switch (event.type) {
+        case Type::Move:
+            if (!readSquare(reader, event.from) || !readSquare(reader, event.to)) {
+                return false;
+            }
+            break;
+        case Type::PlayCard: {
+            sf::Uint8 index;
+            sf::Uint16 id;
+            if (!(reader >> index >> id) || !readSquare(reader, event.to)) {
+                return false;
+            }
+            event.cardIndex = index;
+            event.cardId = id;
+            break;
+        }
+        case Type::NextPhase:
+        case Type::EndTurn:
+            break;
+    }
+
+    sf::Uint8 counts;
+    if (!(reader >> counts)) {
+        return false;
+    }
+    event.drawCounts[0] = counts & 0x0F;
+    event.drawCounts[1] = counts >> 4;
+    for (std::vector<int>& drawn : event.drawnCards) {
+        drawn.clear();
+    }
+    if (viewer == PlayerSide::PLAYER_ONE || viewer == PlayerSide::PLAYER_TWO) {
+        for (std::size_t i = 0; i < event.drawCounts[seat(viewer)]; ++i) {
+            sf::Uint16 id;
+            if (!(reader >> id)) {
+                return false;
+            }
+            event.drawnCards[seat(viewer)].push_back(id);
+        }
+    }
+
+    stateHash.reset();
+    if (header & HAS_STATE_HASH) {
+        std::uint64_t hash;
+        if (!reader.readFixed64(hash)) {
+            return false;
+        }
+        stateHash = hash;
+    }
+    return true;
+}
+
+bool GameEvent::apply(GameState& state, PlayerSide viewer) const {
+    // The client holds no decks, so replaying draws nothing; the server's draws are added below
+    GameRules rules;
+    TurnManager turns(state, rules);
+    bool replayed = false;
+    auto recordResult = [&replayed](const ActionResult& result) { replayed = result.success; };
+
+    switch (type) {
+        case Type::Move: {
+            if (!state.getBoard().isValidPosition(from.x, from.y) ||
+                state.getBoard().getSquare(from.x, from.y).isEmpty()) {
+                return false;
+            }
+            // The square keeps ownership of the piece
+            std::shared_ptr<Piece> piece(state.getBoard().getSquare(from.x, from.y).getPiece(), [](Piece*) {});
+            turns.processMoveAction(Move(piece, from, to), recordResult);
+            break;
+        }
+        case Type::PlayCard: {
+            PlayerSide owner = state.getActivePlayer();
+            Hand& hand = state.getHand(owner);
+            int index = cardIndex;
+            if (owner != viewer) {
+                // Reveal the card from the opponent's hidden hand; the rest stay hidden
+                auto card = CardFactory::createCard(cardId);
+                if (!card || hand.getHiddenCount() == 0 || !hand.addCard(std::move(card))) {
+                    return false;
+                }
+                hand.setHiddenCount(hand.getHiddenCount() - 1);
+                index = static_cast<int>(hand.size()) - 1;
+            } else if (index < 0 || static_cast<std::size_t>(index) >= hand.size() ||
+                       !hand.getCard(index) || hand.getCard(index)->getId() != cardId) {
+                return false;
+            }
+            turns.processPlayCardAction(index, to, recordResult);
+            break;
+        }
+        case Type::NextPhase:
+            turns.nextPhase(recordResult);
+            break;
+        case Type::EndTurn:
+            turns.endCurrentTurn(recordResult);
+            break;
+    }
+    if (!replayed) {
+        return false;
+    }
+
+    for (PlayerSide side : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+        Hand& hand = state.getHand(side);
+        if (side != viewer) {
+            hand.setHiddenCount(hand.getHiddenCount() + drawCounts[seat(side)]);
+            continue;
+        }
+        for (int id : drawnCards[seat(side)]) {
+            auto card = CardFactory::createCard(id);
+            if (!card || !hand.addCard(std::move(card))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool applyGameEvent(WireReader& reader, GameState& state, sf::Uint32& sequence, PlayerSide viewer) {
+    GameEvent event;
+    sf::Uint32 eventSequence;
+    std::optional<sf::Uint64> stateHash;
+    if (!GameEvent::read(reader, event, eventSequence, stateHash, viewer) || eventSequence != sequence + 1) {
+        return false;
+    }
+    if (!event.apply(state, viewer) ||
+        (stateHash && state.hash(viewer) != *stateHash)) {
+        return false;
+    }
+    sequence = eventSequence;
+    return true;
+}
+
+} // namespace BayouBonanza
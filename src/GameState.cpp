@@ -4,6 +4,7 @@
 #include "CardFactory.h" // For card system initialization
 #include "CardPlayValidator.h" // For comprehensive card validation
 #include "TurnManager.h" // For ActionType enum
+#include "Zobrist.h"
 #include <SFML/Network/Packet.hpp> // For sf::Packet
 #include <iostream> // For std::cout
 
@@ -356,32 +357,104 @@ void GameState::processCardTurnStart() {
     // This would be implemented when we have a status effect system
 }
 
-// SFML Packet operators for GamePhase enum
-sf::Packet& operator<<(sf::Packet& packet, const GamePhase& phase) {
+std::uint64_t GameState::hash(PlayerSide viewer) const {
+    using Zobrist::Feature;
+    std::uint64_t result = board.hash();
+    result ^= Zobrist::key(Feature::ActivePlayer, 0, static_cast<int>(activePlayer));
+    result ^= Zobrist::key(Feature::Phase, 0, static_cast<int>(phase));
+    result ^= Zobrist::key(Feature::Result, 0, static_cast<int>(this->result));
+    result ^= Zobrist::key(Feature::TurnNumber, 0, turnNumber);
+    result ^= Zobrist::key(Feature::SteamOne, 0, getSteam(PlayerSide::PLAYER_ONE));
+    result ^= Zobrist::key(Feature::SteamTwo, 0, getSteam(PlayerSide::PLAYER_TWO));
+
+    // At most Hand::MAX_HAND_SIZE cards per hand
+    for (PlayerSide side : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+        const Hand& hand = getHand(side);
+        std::uint64_t seat = side == PlayerSide::PLAYER_ONE ? 0 : 1;
+        result ^= Zobrist::key(Feature::HandCount, seat, static_cast<std::int64_t>(hand.size() + hand.getHiddenCount()));
+        bool visible = viewer == PlayerSide::NEUTRAL || viewer == side;
+        if (!visible || hand.getHiddenCount() > 0) {
+            continue;
+        }
+        for (std::size_t i = 0; i < hand.size(); ++i) {
+            const Card* card = hand.getCard(i);
+            result ^= Zobrist::key(Feature::HandCard, seat * Hand::MAX_HAND_SIZE + i, card ? card->getId() : -1);
+        }
+    }
+    return result;
+}
+
+// Packet operators for GamePhase enum
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GamePhase& phase) {
     return packet << static_cast<int>(phase);
 }
 
-sf::Packet& operator>>(sf::Packet& packet, GamePhase& phase) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GamePhase& phase) {
     int value;
     packet >> value;
     phase = static_cast<GamePhase>(value);
     return packet;
 }
 
-// SFML Packet operators for GameResult enum
-sf::Packet& operator<<(sf::Packet& packet, const GameResult& result) {
+// Packet operators for GameResult enum
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GameResult& result) {
     return packet << static_cast<int>(result);
 }
 
-sf::Packet& operator>>(sf::Packet& packet, GameResult& result) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GameResult& result) {
     int value;
     packet >> value;
     result = static_cast<GameResult>(value);
     return packet;
 }
 
-// SFML Packet operators for GameState
-sf::Packet& operator<<(sf::Packet& packet, const GameState& gs) {
+template <WritablePacket Packet>
+Packet& writeHand(Packet& packet, const Hand& hand, bool visible) {
+    if (!visible) {
+        return packet << static_cast<sf::Uint8>(hand.size() + hand.getHiddenCount()) << false;
+    }
+    packet << static_cast<sf::Uint8>(hand.size()) << true;
+    for (size_t i = 0; i < hand.size(); ++i) {
+        const Card* card = hand.getCard(i);
+        packet << (card ? card->getId() : static_cast<int>(-1)); // -1: invalid card ID
+    }
+    return packet;
+}
+
+template <ReadablePacket Packet>
+Packet& readHand(Packet& packet, Hand& hand) {
+    sf::Uint8 count;
+    bool visible;
+    if (!(packet >> count >> visible)) {
+        return packet;
+    }
+    hand.clear();
+    hand.setHiddenCount(visible ? 0 : count);
+    if (!visible) {
+        return packet;
+    }
+    for (sf::Uint8 i = 0; i < count; ++i) {
+        int cardId;
+        if (!(packet >> cardId)) {
+            return packet;
+        }
+        if (cardId != -1) {
+            auto card = CardFactory::createCard(cardId);
+            if (card) {
+                hand.addCard(std::move(card));
+            }
+        }
+    }
+    return packet;
+}
+
+// Packet operators for GameState
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const GameState& gs) {
     packet << gs.getBoard();
     packet << gs.getActivePlayer();
     packet << gs.getGamePhase();
@@ -391,35 +464,14 @@ sf::Packet& operator<<(sf::Packet& packet, const GameState& gs) {
     packet << gs.getSteam(PlayerSide::PLAYER_TWO);
     
     // Serialize card system - hands only (decks are not synchronized)
-    const Hand& hand1 = gs.getHand(PlayerSide::PLAYER_ONE);
-    const Hand& hand2 = gs.getHand(PlayerSide::PLAYER_TWO);
-    
-    // Serialize Player 1 hand
-    packet << static_cast<sf::Uint32>(hand1.size());
-    for (size_t i = 0; i < hand1.size(); ++i) {
-        const Card* card = hand1.getCard(i);
-        if (card) {
-            packet << card->getId();
-        } else {
-            packet << static_cast<int>(-1); // Invalid card ID
-        }
-    }
-    
-    // Serialize Player 2 hand
-    packet << static_cast<sf::Uint32>(hand2.size());
-    for (size_t i = 0; i < hand2.size(); ++i) {
-        const Card* card = hand2.getCard(i);
-        if (card) {
-            packet << card->getId();
-        } else {
-            packet << static_cast<int>(-1); // Invalid card ID
-        }
-    }
+    writeHand(packet, gs.getHand(PlayerSide::PLAYER_ONE), true);
+    writeHand(packet, gs.getHand(PlayerSide::PLAYER_TWO), true);
     
     return packet;
 }
 
-sf::Packet& operator>>(sf::Packet& packet, GameState& gs) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, GameState& gs) {
     PlayerSide activePlayer;
     GamePhase phase;
     GameResult result;
@@ -444,43 +496,29 @@ sf::Packet& operator>>(sf::Packet& packet, GameState& gs) {
     gs.setSteam(PlayerSide::PLAYER_ONE, steamPlayer1);
     gs.setSteam(PlayerSide::PLAYER_TWO, steamPlayer2);
     
-    // Deserialize card system - hands only
-    Hand& hand1 = gs.getHand(PlayerSide::PLAYER_ONE);
-    Hand& hand2 = gs.getHand(PlayerSide::PLAYER_TWO);
-    
-    // Clear existing hands
-    hand1.clear();
-    hand2.clear();
-    
-    // Deserialize Player 1 hand
-    sf::Uint32 hand1Size;
-    packet >> hand1Size;
-    for (sf::Uint32 i = 0; i < hand1Size; ++i) {
-        int cardId;
-        packet >> cardId;
-        if (cardId != -1) {
-            auto card = CardFactory::createCard(cardId);
-            if (card) {
-                hand1.addCard(std::move(card));
-            }
-        }
-    }
-    
-    // Deserialize Player 2 hand
-    sf::Uint32 hand2Size;
-    packet >> hand2Size;
-    for (sf::Uint32 i = 0; i < hand2Size; ++i) {
-        int cardId;
-        packet >> cardId;
-        if (cardId != -1) {
-            auto card = CardFactory::createCard(cardId);
-            if (card) {
-                hand2.addCard(std::move(card));
-            }
-        }
-    }
+    // Deserialize card system - hands only; either may arrive as a count if it is not ours to see
+    readHand(packet, gs.getHand(PlayerSide::PLAYER_ONE));
+    readHand(packet, gs.getHand(PlayerSide::PLAYER_TWO));
     
     return packet;
 }
 
+// The serializers are only used with these streams
+template sf::Packet& operator<<(sf::Packet& packet, const GamePhase& value);
+template sf::Packet& operator>>(sf::Packet& packet, GamePhase& value);
+template WireWriter& operator<<(WireWriter& packet, const GamePhase& value);
+template WireReader& operator>>(WireReader& packet, GamePhase& value);
+template sf::Packet& operator<<(sf::Packet& packet, const GameResult& value);
+template sf::Packet& operator>>(sf::Packet& packet, GameResult& value);
+template WireWriter& operator<<(WireWriter& packet, const GameResult& value);
+template WireReader& operator>>(WireReader& packet, GameResult& value);
+template sf::Packet& operator<<(sf::Packet& packet, const GameState& value);
+template sf::Packet& operator>>(sf::Packet& packet, GameState& value);
+template WireWriter& operator<<(WireWriter& packet, const GameState& value);
+template WireReader& operator>>(WireReader& packet, GameState& value);
+template sf::Packet& writeHand(sf::Packet& packet, const Hand& hand, bool visible);
+template sf::Packet& readHand(sf::Packet& packet, Hand& hand);
+template WireWriter& writeHand(WireWriter& packet, const Hand& hand, bool visible);
+template WireReader& readHand(WireReader& packet, Hand& hand);
+
 } // namespace BayouBonanza
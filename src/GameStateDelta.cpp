@@ -0,0 +1,213 @@
+#include "GameStateDelta.h"
+#include <cstring>
+
+namespace BayouBonanza {
+
+namespace {
+
+const int SCALARS_PART = GameStateSnapshot::SQUARE_COUNT;
+const int HAND_ONE_PART = SCALARS_PART + 1;
+const int HAND_TWO_PART = SCALARS_PART + 2;
+const int HIDDEN_HAND_ONE_PART = SCALARS_PART + 3;
+const int HIDDEN_HAND_TWO_PART = SCALARS_PART + 4;
+
+// Room for a full board of pieces; encode() doubles it for anything larger
+const std::size_t INITIAL_SNAPSHOT_BYTES = 2048;
+
+const std::size_t HASH_BYTES = sizeof(sf::Uint64);
+
+std::size_t viewerIndex(PlayerSide viewer) {
+    return static_cast<std::size_t>(viewer);
+}
+
+} // namespace
+
+GameStateSnapshot::GameStateSnapshot() : number(0) {
+    offsets.fill(0);
+}
+
+GameStateSnapshot::GameStateSnapshot(const GameState& state, sf::Uint32 sequence) : number(sequence) {
+    bytes.resize(INITIAL_SNAPSHOT_BYTES);
+    while (!encode(state)) {
+        bytes.resize(bytes.size() * 2);
+    }
+    bytes.resize(offsets[PART_COUNT]);
+    for (PlayerSide viewer : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO, PlayerSide::NEUTRAL, SPECTATOR_VIEWER}) {
+        hashes[viewerIndex(viewer)] = state.hash(viewer);
+    }
+}
+
+bool GameStateSnapshot::encode(const GameState& state) {
+    WireWriter writer(bytes.data(), bytes.size());
+    int part = 0;
+    offsets[part++] = 0;
+
+    const GameBoard& board = state.getBoard();
+    for (int y = 0; y < GameBoard::BOARD_SIZE; ++y) {
+        for (int x = 0; x < GameBoard::BOARD_SIZE; ++x) {
+            writer << board.getSquare(x, y);
+            offsets[part++] = writer.getDataSize();
+        }
+    }
+
+    writer << state.getActivePlayer()
+           << state.getGamePhase()
+           << state.getGameResult()
+           << state.getTurnNumber()
+           << state.getSteam(PlayerSide::PLAYER_ONE)
+           << state.getSteam(PlayerSide::PLAYER_TWO);
+    offsets[part++] = writer.getDataSize();
+
+    for (bool visible : {true, false}) {
+        writeHand(writer, state.getHand(PlayerSide::PLAYER_ONE), visible);
+        offsets[part++] = writer.getDataSize();
+        writeHand(writer, state.getHand(PlayerSide::PLAYER_TWO), visible);
+        offsets[part++] = writer.getDataSize();
+    }
+    return static_cast<bool>(writer);
+}
+
+int GameStateSnapshot::handPart(PlayerSide owner, PlayerSide viewer) {
+    bool visible = viewer == PlayerSide::NEUTRAL || viewer == owner;
+    if (owner == PlayerSide::PLAYER_ONE) {
+        return visible ? HAND_ONE_PART : HIDDEN_HAND_ONE_PART;
+    }
+    return visible ? HAND_TWO_PART : HIDDEN_HAND_TWO_PART;
+}
+
+void GameStateSnapshot::writeFull(WireWriter& writer, PlayerSide viewer) const {
+    if (!bytes.empty()) {
+        // Board and scalars are shared by every viewer; only the hands differ
+        writer.append(bytes.data(), offsets[HAND_ONE_PART]);
+        appendPart(writer, handPart(PlayerSide::PLAYER_ONE, viewer));
+        appendPart(writer, handPart(PlayerSide::PLAYER_TWO, viewer));
+    }
+    writer << number;
+    writer.writeFixed64(hashes[viewerIndex(viewer)]);
+}
+
+std::size_t GameStateSnapshot::fullSize(PlayerSide viewer) const {
+    return offsets[HAND_ONE_PART] + partSize(handPart(PlayerSide::PLAYER_ONE, viewer)) +
+           partSize(handPart(PlayerSide::PLAYER_TWO, viewer)) + WireWriter::varUintSize(number) + HASH_BYTES;
+}
+
+int GameStateSnapshot::writeDelta(WireWriter& writer, const GameStateSnapshot& base, PlayerSide viewer) const {
+    writer << base.number << number;
+
+    std::array<sf::Uint8, SQUARE_COUNT> changedSquares;
+    std::size_t changedCount = 0;
+    for (int square = 0; square < SQUARE_COUNT; ++square) {
+        if (!partEquals(base, square)) {
+            changedSquares[changedCount++] = static_cast<sf::Uint8>(square);
+        }
+    }
+    writer << static_cast<sf::Uint8>(changedCount);
+    for (std::size_t i = 0; i < changedCount; ++i) {
+        writer << changedSquares[i];
+        appendPart(writer, changedSquares[i]);
+    }
+
+    int handOne = handPart(PlayerSide::PLAYER_ONE, viewer);
+    int handTwo = handPart(PlayerSide::PLAYER_TWO, viewer);
+    sf::Uint8 mask = 0;
+    if (!partEquals(base, SCALARS_PART)) mask |= DELTA_SCALARS;
+    if (!partEquals(base, handOne)) mask |= DELTA_HAND_ONE;
+    if (!partEquals(base, handTwo)) mask |= DELTA_HAND_TWO;
+    writer << mask;
+    if (mask & DELTA_SCALARS) appendPart(writer, SCALARS_PART);
+    if (mask & DELTA_HAND_ONE) appendPart(writer, handOne);
+    if (mask & DELTA_HAND_TWO) appendPart(writer, handTwo);
+    writer.writeFixed64(hashes[viewerIndex(viewer)]);
+
+    int changedParts = static_cast<int>(changedCount);
+    for (sf::Uint8 bit : {DELTA_SCALARS, DELTA_HAND_ONE, DELTA_HAND_TWO}) {
+        changedParts += (mask & bit) ? 1 : 0;
+    }
+    return changedParts;
+}
+
+bool GameStateSnapshot::partEquals(const GameStateSnapshot& other, int part) const {
+    if (other.bytes.empty()) {
+        return false;
+    }
+    std::size_t size = partSize(part);
+    if (size != other.partSize(part)) {
+        return false;
+    }
+    return std::memcmp(bytes.data() + offsets[part], other.bytes.data() + other.offsets[part], size) == 0;
+}
+
+void GameStateSnapshot::appendPart(WireWriter& writer, int part) const {
+    writer.append(bytes.data() + offsets[part], partSize(part));
+}
+
+bool applyGameStateDelta(WireReader& reader, GameState& state, sf::Uint32& sequence, PlayerSide viewer) {
+    sf::Uint32 baseSequence;
+    sf::Uint32 newSequence;
+    if (!(reader >> baseSequence >> newSequence) || baseSequence != sequence) {
+        return false;
+    }
+
+    sf::Uint8 squareCount;
+    if (!(reader >> squareCount)) {
+        return false;
+    }
+    for (sf::Uint8 i = 0; i < squareCount; ++i) {
+        sf::Uint8 index;
+        if (!(reader >> index) || index >= GameStateSnapshot::SQUARE_COUNT) {
+            return false;
+        }
+        int x = index % GameBoard::BOARD_SIZE;
+        int y = index / GameBoard::BOARD_SIZE;
+        if (!(reader >> state.getBoard().getSquare(x, y))) {
+            return false;
+        }
+    }
+
+    sf::Uint8 mask;
+    if (!(reader >> mask)) {
+        return false;
+    }
+    if (mask & GameStateSnapshot::DELTA_SCALARS) {
+        PlayerSide activePlayer;
+        GamePhase phase;
+        GameResult result;
+        int turnNumber;
+        int steamPlayer1;
+        int steamPlayer2;
+        if (!(reader >> activePlayer >> phase >> result >> turnNumber >> steamPlayer1 >> steamPlayer2)) {
+            return false;
+        }
+        state.setActivePlayer(activePlayer);
+        state.setGamePhase(phase);
+        state.setGameResult(result);
+        state.setTurnNumber(turnNumber);
+        state.setSteam(PlayerSide::PLAYER_ONE, steamPlayer1);
+        state.setSteam(PlayerSide::PLAYER_TWO, steamPlayer2);
+    }
+    if ((mask & GameStateSnapshot::DELTA_HAND_ONE) && !readHand(reader, state.getHand(PlayerSide::PLAYER_ONE))) {
+        return false;
+    }
+    if ((mask & GameStateSnapshot::DELTA_HAND_TWO) && !readHand(reader, state.getHand(PlayerSide::PLAYER_TWO))) {
+        return false;
+    }
+
+    std::uint64_t hash;
+    if (!reader.readFixed64(hash) || state.hash(viewer) != hash) {
+        return false;
+    }
+    sequence = newSequence;
+    return true;
+}
+
+bool readFullGameState(WireReader& reader, GameState& state, sf::Uint32& sequence, PlayerSide viewer) {
+    sf::Uint32 newSequence;
+    std::uint64_t hash;
+    if (!(reader >> state >> newSequence) || !reader.readFixed64(hash) || state.hash(viewer) != hash) {
+        return false;
+    }
+    sequence = newSequence;
+    return true;
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,91 @@
+#include "Heartbeat.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+
+namespace BayouBonanza {
+
+sf::Packet answerPing(const sf::Packet& ping, PingData& data) {
+    WireReader body = messageBody(ping);
+    if (!(body >> data)) {
+        return sf::Packet();
+    }
+    std::array<char, 16> buffer;
+    WireWriter writer(buffer.data(), buffer.size());
+    writer << MessageType::Pong << PongData{data.sequence};
+    return wirePacket(writer);
+}
+
+PingData Heartbeat::ping(Clock::time_point now) {
+    ++lastSent;
+    sentAt[lastSent % TRACKED_PINGS] = now;
+    PingData data;
+    data.sequence = lastSent;
+    data.roundTripMicros = static_cast<sf::Uint32>(std::min<long long>(smoothed.count(), UINT32_MAX));
+    return data;
+}
+
+bool Heartbeat::pong(sf::Uint32 sequence, Clock::time_point now) {
+    if (sequence <= lastAnswered || sequence > lastSent || lastSent - sequence >= TRACKED_PINGS) {
+        return false; // Late, repeated, or for a Ping never sent
+    }
+    lastAnswered = sequence;
+    latest = std::max(std::chrono::microseconds(0),
+                      std::chrono::duration_cast<std::chrono::microseconds>(now - sentAt[sequence % TRACKED_PINGS]));
+    smoothed = smoothed.count() == 0 ? latest : smoothed + (latest - smoothed) / 8;
+    return true;
+}
+
+std::size_t HeartbeatStats::bucketFor(std::uint64_t micros) {
+    if (micros < SUB_BUCKETS) {
+        return static_cast<std::size_t>(micros);
+    }
+    // The top three bits pick the sub-bucket within the power of two
+    std::size_t exponent = static_cast<std::size_t>(std::bit_width(micros)) - 1;
+    std::size_t sub = static_cast<std::size_t>(micros >> (exponent - 3)) - SUB_BUCKETS;
+    return std::min(BUCKETS - 1, (exponent - 2) * SUB_BUCKETS + sub);
+}
+
+std::uint64_t HeartbeatStats::bucketUpperBound(std::size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    std::size_t exponent = bucket / SUB_BUCKETS + 2;
+    std::uint64_t sub = bucket % SUB_BUCKETS;
+    return ((SUB_BUCKETS + sub + 1) << (exponent - 3)) - 1;
+}
+
+void HeartbeatStats::recordRoundTrip(std::chrono::microseconds roundTrip) {
+    std::uint64_t micros = static_cast<std::uint64_t>(std::max<long long>(0, roundTrip.count()));
+    ++pongs;
+    ++buckets[bucketFor(micros)];
+    maxMicros = std::max(maxMicros, micros);
+}
+
+std::chrono::microseconds HeartbeatStats::percentile(double fraction) const {
+    if (pongs == 0) {
+        return std::chrono::microseconds(0);
+    }
+    std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(fraction * pongs)));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            return std::chrono::microseconds(std::min(bucketUpperBound(bucket), maxMicros));
+        }
+    }
+    return std::chrono::microseconds(maxMicros);
+}
+
+void HeartbeatStats::report(std::ostream& out) const {
+    out << "Heartbeat: " << pings << " pings, " << pongs << " pongs, " << reaped << " connections reaped";
+    if (pongs > 0) {
+        out << "; round trip p50 " << std::fixed << std::setprecision(2) << percentile(0.50).count() / 1000.0
+            << " ms, p99 " << percentile(0.99).count() / 1000.0 << " ms, max " << maxMicros / 1000.0 << " ms"
+            << std::defaultfloat;
+    }
+    out << std::endl;
+}
+
+} // namespace BayouBonanza
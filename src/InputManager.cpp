@@ -1,6 +1,7 @@
 #include "InputManager.h"
 #include "GraphicsManager.h"
 #include "GameBoard.h"
+#include <array>
 #include <iostream>
 
 namespace BayouBonanza {
@@ -206,10 +207,12 @@ void InputManager::attemptMove(int targetX, int targetY) {
 }
 
 void InputManager::sendMoveToServer(const Move& move) {
-    sf::Packet movePacket;
-    movePacket << MessageType::MoveToServer << move;
+    std::array<char, 256> buffer;
+    WireWriter writer(buffer.data(), buffer.size());
+    writer << MessageType::MoveToServer << move;
+    sf::Packet movePacket = wirePacket(writer);
     
-    if (socket.send(movePacket) == sf::Socket::Done) {
+    if (writer && socket.send(movePacket) == sf::Socket::Done) {
         std::cout << "Move sent to server: " 
                   << move.getFrom().x << "," << move.getFrom().y << " -> " 
                   << move.getTo().x << "," << move.getTo().y << std::endl;
@@ -331,10 +334,12 @@ void InputManager::attemptCardPlay(int targetX, int targetY) {
 
 void InputManager::sendCardPlayToServer(int cardIndex, const Position& targetPosition) {
     CardPlayData cardPlayData(cardIndex, targetPosition.x, targetPosition.y);
-    sf::Packet cardPlayPacket;
-    cardPlayPacket << MessageType::CardPlayToServer << cardPlayData;
+    std::array<char, 64> buffer;
+    WireWriter writer(buffer.data(), buffer.size());
+    writer << MessageType::CardPlayToServer << cardPlayData;
+    sf::Packet cardPlayPacket = wirePacket(writer);
     
-    if (socket.send(cardPlayPacket) == sf::Socket::Done) {
+    if (writer && socket.send(cardPlayPacket) == sf::Socket::Done) {
         std::cout << "Card play sent to server: card " << cardIndex 
                   << " at (" << targetPosition.x << ", " << targetPosition.y << ")" << std::endl;
     } else {
@@ -0,0 +1,244 @@
+#include "Leaderboard.h"
+#include <algorithm>
+#include <iostream>
+
+namespace BayouBonanza {
+
+// A treap node: a binary search tree by rank, and a heap by priority, which keeps it balanced
+// whatever order players arrive in. size counts the subtree, which is what ranks are read from.
+struct Leaderboard::Node {
+    std::string username;
+    int rating = 0;
+    std::uint32_t priority = 0;
+    std::size_t size = 1;
+    std::unique_ptr<Node> left;  // Ranked above
+    std::unique_ptr<Node> right; // Ranked below
+
+    static std::size_t sizeOf(const std::unique_ptr<Node>& node) { return node ? node->size : 0; }
+
+    void resize() { size = 1 + sizeOf(left) + sizeOf(right); }
+
+    // Split a tree into the nodes ranked above (rating, username) and the rest
+    static void split(std::unique_ptr<Node> tree, int rating, const std::string& username,
+                      std::unique_ptr<Node>& above, std::unique_ptr<Node>& rest) {
+        if (!tree) {
+            above.reset();
+            rest.reset();
+        } else if (ahead(*tree, rating, username)) {
+            split(std::move(tree->right), rating, username, tree->right, rest);
+            tree->resize();
+            above = std::move(tree);
+        } else {
+            split(std::move(tree->left), rating, username, above, tree->left);
+            tree->resize();
+            rest = std::move(tree);
+        }
+    }
+
+    // Join two trees, every node of @p above ranked above every node of @p below
+    static std::unique_ptr<Node> merge(std::unique_ptr<Node> above, std::unique_ptr<Node> below) {
+        if (!above || !below) {
+            return above ? std::move(above) : std::move(below);
+        }
+        if (above->priority > below->priority) {
+            above->right = merge(std::move(above->right), std::move(below));
+            above->resize();
+            return above;
+        }
+        below->left = merge(std::move(above), std::move(below->left));
+        below->resize();
+        return below;
+    }
+
+    // The tree without its best ranked node
+    static std::unique_ptr<Node> dropFirst(std::unique_ptr<Node> tree) {
+        if (!tree->left) {
+            return std::move(tree->right);
+        }
+        tree->left = dropFirst(std::move(tree->left));
+        tree->resize();
+        return tree;
+    }
+};
+
+Leaderboard::Leaderboard() : Leaderboard(Options{}) {}
+
+Leaderboard::Leaderboard(Options options) : config(options), priorities(std::random_device{}()) {}
+
+Leaderboard::~Leaderboard() = default;
+
+bool Leaderboard::ahead(const Node& node, int rating, const std::string& username) {
+    return node.rating != rating ? node.rating > rating : node.username < username;
+}
+
+void Leaderboard::set(const std::string& username, int rating) {
+    std::lock_guard<std::mutex> lock(mutex);
+    setLocked(username, rating, ++changes);
+}
+
+void Leaderboard::set(const std::vector<PlayerDatabase::RatingUpdate>& ratings) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const PlayerDatabase::RatingUpdate& update : ratings) {
+        setLocked(update.username, update.rating, ++changes);
+    }
+}
+
+void Leaderboard::reset(const std::vector<PlayerDatabase::RatingUpdate>& ratings, std::uint64_t since) {
+    // Built aside, so queries wait only for the swap; the old tree is freed after the lock is let go
+    // Nothing else sees fresh, so it needs no lock
+    Leaderboard fresh(config);
+    for (const PlayerDatabase::RatingUpdate& update : ratings) {
+        fresh.setLocked(update.username, update.rating, 0); // Older than any since
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (changes > since) {
+        // Set while the read was in flight: newer than, or missing from, what it saw
+        for (const auto& [username, player] : players) {
+            if (player.changed > since) {
+                fresh.setLocked(username, player.rating, player.changed);
+            }
+        }
+    }
+    std::swap(root, fresh.root);
+    std::swap(players, fresh.players);
+    counters.updates += ratings.size();
+    snapshotStale = true;
+}
+
+std::uint64_t Leaderboard::version() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return changes;
+}
+
+std::size_t Leaderboard::rank(const std::string& username) {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.queries++;
+    auto found = players.find(username);
+    return found == players.end() ? 0 : rankOf(username, found->second.rating);
+}
+
+std::vector<LeaderboardEntry> Leaderboard::around(const std::string& username, std::size_t radius) {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.queries++;
+    auto found = players.find(username);
+    if (found == players.end()) {
+        return {};
+    }
+    std::size_t rank = rankOf(username, found->second.rating);
+    return entries(rank > radius ? rank - radius : 1, std::min(rank + radius, players.size()));
+}
+
+std::shared_ptr<const Leaderboard::Snapshot> Leaderboard::top() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.queries++;
+    if (snapshotStale) {
+        // Readers still holding the last snapshot keep it; it is only replaced, never changed
+        auto rebuilt = std::make_shared<Snapshot>();
+        rebuilt->entries = entries(1, std::min(config.topSize, players.size()));
+        snapshot = std::move(rebuilt);
+        snapshotStale = false;
+        counters.snapshotsBuilt++;
+    }
+    return snapshot;
+}
+
+std::size_t Leaderboard::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return players.size();
+}
+
+Leaderboard::Stats Leaderboard::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = counters;
+    result.players = players.size();
+    return result;
+}
+
+void Leaderboard::report(std::ostream& out) const {
+    Stats s = stats();
+    out << "Leaderboard: " << s.players << " players, " << s.updates << " rating updates, " << s.queries
+        << " queries, " << s.snapshotsBuilt << " top snapshots built" << std::endl;
+}
+
+void Leaderboard::insert(const std::string& username, int rating) {
+    auto node = std::make_unique<Node>();
+    node->username = username;
+    node->rating = rating;
+    node->priority = priorities();
+    std::unique_ptr<Node> above;
+    std::unique_ptr<Node> below;
+    Node::split(std::move(root), rating, username, above, below);
+    root = Node::merge(Node::merge(std::move(above), std::move(node)), std::move(below));
+}
+
+void Leaderboard::erase(const std::string& username, int rating) {
+    std::unique_ptr<Node> above;
+    std::unique_ptr<Node> rest; // Starts with the node erased
+    Node::split(std::move(root), rating, username, above, rest);
+    root = Node::merge(std::move(above), Node::dropFirst(std::move(rest)));
+}
+
+void Leaderboard::setLocked(const std::string& username, int rating, std::uint64_t changed) {
+    counters.updates++;
+    auto found = players.find(username);
+    bool wasTop = false;
+    if (found != players.end()) {
+        found->second.changed = changed;
+        if (found->second.rating == rating) {
+            return;
+        }
+        wasTop = rankOf(username, found->second.rating) <= config.topSize;
+        erase(username, found->second.rating);
+        found->second.rating = rating;
+    } else {
+        players.emplace(username, Player{rating, changed});
+    }
+    insert(username, rating);
+    // Changes below the top leave the snapshot as it is
+    if (wasTop || rankOf(username, rating) <= config.topSize) {
+        snapshotStale = true;
+    }
+}
+
+std::size_t Leaderboard::rankOf(const std::string& username, int rating) const {
+    std::size_t rank = 0;
+    const Node* node = root.get();
+    while (node) {
+        if (ahead(*node, rating, username)) {
+            rank += Node::sizeOf(node->left) + 1;
+            node = node->right.get();
+        } else if (node->username == username) {
+            return rank + Node::sizeOf(node->left) + 1;
+        } else {
+            node = node->left.get();
+        }
+    }
+    return rank + 1; // Not reached for a player on the board
+}
+
+const Leaderboard::Node* Leaderboard::at(std::size_t rank) const {
+    const Node* node = root.get();
+    while (node) {
+        std::size_t leftSize = Node::sizeOf(node->left);
+        if (rank <= leftSize) {
+            node = node->left.get();
+        } else if (rank == leftSize + 1) {
+            return node;
+        } else {
+            rank -= leftSize + 1;
+            node = node->right.get();
+        }
+    }
+    return nullptr;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::entries(std::size_t first, std::size_t last) const {
+    std::vector<LeaderboardEntry> result;
+    for (std::size_t rank = first; rank <= last; ++rank) {
+        const Node* node = at(rank);
+        result.push_back({static_cast<sf::Uint32>(rank), node->username, node->rating});
+    }
+    return result;
+}
+
+} // namespace BayouBonanza
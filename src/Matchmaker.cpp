@@ -0,0 +1,144 @@
+#include "Matchmaker.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace BayouBonanza {
+
+Matchmaker::Matchmaker() : Matchmaker(Config{}) {}
+
+Matchmaker::Matchmaker(Config config) : config(config), nextSequence(0) {
+    this->config.bucketWidth = std::max(1, this->config.bucketWidth);
+    this->config.initialWindow = std::max(0, this->config.initialWindow);
+    this->config.maxWindow = std::max(this->config.initialWindow, this->config.maxWindow);
+}
+
+bool Matchmaker::enqueue(TicketId id, int rating, Clock::time_point now) {
+    Ticket ticket{rating, bucketFor(rating), nextSequence, now};
+    if (!tickets.emplace(id, ticket).second) {
+        return false;
+    }
+    ++nextSequence;
+    QueueKey key(ticket.sequence, id);
+    buckets[ticket.bucket].insert(key);
+    arrivalOrder.insert(key);
+    return true;
+}
+
+bool Matchmaker::remove(TicketId id) {
+    auto it = tickets.find(id);
+    if (it == tickets.end()) {
+        return false;
+    }
+    unlink(id, it->second);
+    tickets.erase(it);
+    return true;
+}
+
+bool Matchmaker::contains(TicketId id) const {
+    return tickets.count(id) > 0;
+}
+
+std::size_t Matchmaker::size() const {
+    return tickets.size();
+}
+
+int Matchmaker::windowFor(Clock::duration waited) const {
+    auto waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(waited).count();
+    if (waitedMs <= 0) {
+        return config.initialWindow;
+    }
+    long long widened = config.initialWindow + waitedMs * config.windowGrowthPerSecond / 1000;
+    return static_cast<int>(std::min<long long>(widened, config.maxWindow));
+}
+
+std::vector<Matchmaker::Pairing> Matchmaker::pairBatch(Clock::time_point now) {
+    std::vector<Pairing> pairings;
+
+    // Oldest first, so the players who have waited longest get the first pick
+    auto it = arrivalOrder.begin();
+    while (it != arrivalOrder.end()) {
+        TicketId id = it->second;
+        auto self = tickets.find(id);
+        TicketId opponentId = 0;
+        if (!findOpponent(id, self->second, now, opponentId)) {
+            ++it;
+            continue;
+        }
+
+        auto opponent = tickets.find(opponentId);
+        Pairing pairing{id, opponentId, now - self->second.enqueuedAt, now - opponent->second.enqueuedAt};
+        if (opponent->second.sequence < self->second.sequence) {
+            // An older player that found nobody earlier this batch can still be picked
+            std::swap(pairing.first, pairing.second);
+            std::swap(pairing.firstWait, pairing.secondWait);
+        }
+        pairings.push_back(pairing);
+
+        // Erasing the opponent never invalidates this iterator, but it may be the next one
+        unlink(opponentId, opponent->second);
+        tickets.erase(opponent);
+        auto next = std::next(it);
+        unlink(id, self->second);
+        tickets.erase(self);
+        it = next;
+    }
+    return pairings;
+}
+
+int Matchmaker::bucketFor(int rating) const {
+    // Floor division so negative ratings still land in distinct buckets
+    int bucket = rating / config.bucketWidth;
+    if (rating < 0 && rating % config.bucketWidth != 0) {
+        --bucket;
+    }
+    return bucket;
+}
+
+void Matchmaker::unlink(TicketId id, const Ticket& ticket) {
+    QueueKey key(ticket.sequence, id);
+    auto bucket = buckets.find(ticket.bucket);
+    if (bucket != buckets.end()) {
+        bucket->second.erase(key);
+        if (bucket->second.empty()) {
+            buckets.erase(bucket);
+        }
+    }
+    arrivalOrder.erase(key);
+}
+
+bool Matchmaker::findOpponent(TicketId id, const Ticket& ticket, Clock::time_point now, TicketId& opponent) const {
+    int window = windowFor(now - ticket.enqueuedAt);
+    int lastBucket = bucketFor(ticket.rating + window);
+
+    // Nearest bucket wins; between equally near buckets the longer-waiting front does
+    bool found = false;
+    int bestDistance = 0;
+    std::uint64_t bestSequence = 0;
+    for (auto bucket = buckets.lower_bound(bucketFor(ticket.rating - window));
+         bucket != buckets.end() && bucket->first <= lastBucket; ++bucket) {
+        auto candidate = bucket->second.begin();
+        if (candidate->second == id) {
+            ++candidate;
+        }
+        if (candidate == bucket->second.end()) {
+            continue;
+        }
+
+        // Only the front is checked; an edge bucket whose front is out of range is skipped this tick
+        const Ticket& other = tickets.at(candidate->second);
+        if (std::abs(other.rating - ticket.rating) > window) {
+            continue;
+        }
+        int distance = std::abs(bucket->first - ticket.bucket);
+        if (!found || distance < bestDistance || (distance == bestDistance && candidate->first < bestSequence)) {
+            found = true;
+            bestDistance = distance;
+            bestSequence = candidate->first;
+            opponent = candidate->second;
+        }
+    }
+    return found;
+}
+
+} // namespace BayouBonanza
@@ -1,5 +1,7 @@
 #include "Menu.h"
 #include "NetworkProtocol.h"
+#include "MessageCompression.h"
+#include "Heartbeat.h"
 #include "GameState.h"
 #include <iostream>
 
@@ -156,7 +158,7 @@ MainMenuOption runMainMenu(sf::RenderWindow& window,
         sf::Socket::Status status = socket.receive(receivedPacket);
         if (status == sf::Socket::Done) {
             MessageType messageType;
-            if (receivedPacket >> messageType) {
+            if (expandCompressed(receivedPacket) && receivedPacket >> messageType) {
                 switch (messageType) {
                     case MessageType::PlayerAssignment: {
                         uint8_t side_uint8;
@@ -187,15 +189,24 @@ MainMenuOption runMainMenu(sf::RenderWindow& window,
                     case MessageType::WaitingForOpponent:
                         std::cout << "Waiting for opponent..." << std::endl;
                         break;
+                    case MessageType::Ping: {
+                        // The server drops connections that stop answering
+                        PingData ping;
+                        sf::Packet pong = answerPing(receivedPacket, ping);
+                        if (pong.getDataSize() > 0) {
+                            socket.send(pong);
+                        }
+                        break;
+                    }
                     case MessageType::GameStart: {
                         std::cout << "Game start received in main menu - storing packet data and transitioning to game!" << std::endl;
-                        gameStartPacketData.clear();
-                        gameStartPacketData << MessageType::GameStart;
                         std::string p1_username, p2_username;
                         int p1_rating, p2_rating;
                         GameState tempGameState;
-                        if (receivedPacket >> p1_username >> p1_rating >> p2_username >> p2_rating >> tempGameState) {
-                            gameStartPacketData << p1_username << p1_rating << p2_username << p2_rating << tempGameState;
+                        sf::Uint32 sequence = 0;
+                        WireReader body = messageBody(receivedPacket);
+                        if (body >> p1_username >> p1_rating >> p2_username >> p2_rating >> tempGameState >> sequence) {
+                            gameStartPacketData = receivedPacket;
                             gameStartReceived = true;
                             return MainMenuOption::PLAY_HUMAN;
                         } else {
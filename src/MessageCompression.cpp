@@ -0,0 +1,138 @@
+#include "MessageCompression.h"
+#include <lzb/lzb.hpp>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+namespace BayouBonanza {
+
+namespace {
+
+// Per thread: the dictionary, followed by the message being compressed or expanded
+struct CompressionScratch {
+    std::vector<char> window;
+    std::vector<char> block;
+
+    CompressionScratch() {
+        std::string_view dictionary = compressionDictionary();
+        window.assign(dictionary.begin(), dictionary.end());
+    }
+
+    char* message(std::size_t size) {
+        window.resize(compressionDictionary().size() + size);
+        return window.data() + compressionDictionary().size();
+    }
+};
+
+CompressionScratch& scratch() {
+    thread_local CompressionScratch buffers;
+    return buffers;
+}
+
+// Built once: indexing 4 KiB of dictionary cost more than compressing a snapshot
+const lzb::Dictionary& preparedDictionary() {
+    static const lzb::Dictionary dictionary(compressionDictionary().data(), compressionDictionary().size());
+    return dictionary;
+}
+
+} // namespace
+
+const char* messageTypeName(MessageType type) {
+    static const char* const NAMES[] = {
+        "ConnectionRequest", "ConnectionAccepted", "PlayerAssignment", "WaitingForOpponent", "GameStart",
+        "MoveToServer", "CardPlayToServer", "EndTurn", "MoveRejected", "CardPlayRejected",
+        "GameStateUpdate", "GameOver", "Error", "Ping", "Pong",
+        "UserLogin", "CardCollectionData", "DeckData", "SaveDeck", "DeckSaved",
+        "RequestMatchmaking", "ServerBusy", "GameStateDelta", "RequestStateResync", "GameEvent",
+        "Compressed", "SpectateRequest", "LeaderboardRequest", "LeaderboardData"};
+    std::size_t index = static_cast<std::size_t>(type);
+    return index < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[index] : "Unknown";
+}
+
+bool writeCompressed(WireWriter& writer, const char* message, std::size_t size) {
+    CompressionScratch& buffers = scratch();
+    std::memcpy(buffers.message(size), message, size);
+    buffers.block.resize(lzb::compressBound(size));
+    std::size_t blockSize = lzb::compress(buffers.window.data(), preparedDictionary(), size,
+                                          buffers.block.data(), buffers.block.size());
+
+    std::size_t wrappedSize = sizeof(sf::Uint8) + WireWriter::varUintSize(size) + blockSize;
+    if (blockSize == 0 || wrappedSize >= size) {
+        writer.append(message, size);
+        return false;
+    }
+    writer << MessageType::Compressed;
+    writer.writeVarUint(size);
+    writer.append(buffers.block.data(), blockSize);
+    return true;
+}
+
+bool expandCompressed(sf::Packet& packet) {
+    if (packet.getDataSize() == 0 ||
+        *static_cast<const char*>(packet.getData()) != static_cast<char>(MessageType::Compressed)) {
+        return true;
+    }
+    WireReader body = messageBody(packet);
+    std::uint64_t size = 0;
+    if (!body.readVarUint(size) || size == 0 || size > MAX_EXPANDED_BYTES) {
+        return false;
+    }
+    std::size_t blockSize = body.remaining();
+    const char* block = body.read(blockSize);
+
+    CompressionScratch& buffers = scratch();
+    char* message = buffers.message(static_cast<std::size_t>(size));
+    if (!lzb::decompress(block, blockSize, buffers.window.data(), compressionDictionary().size(),
+                         static_cast<std::size_t>(size)) ||
+        *message == static_cast<char>(MessageType::Compressed)) {
+        return false;
+    }
+    packet.clear();
+    packet.append(message, static_cast<std::size_t>(size));
+    return true;
+}
+
+void CompressionStats::record(MessageType type, std::size_t bytesIn, std::size_t bytesOut, bool compressed,
+                              std::uint64_t nanos) {
+    std::size_t index = static_cast<std::size_t>(type);
+    if (index >= TRACKED_TYPES) {
+        return;
+    }
+    Counters& entry = counters[index];
+    entry.messages.fetch_add(1, std::memory_order_relaxed);
+    entry.compressed.fetch_add(compressed ? 1 : 0, std::memory_order_relaxed);
+    entry.bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+    entry.bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+    entry.nanos.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+CompressionStats::Totals CompressionStats::totals(MessageType type) const {
+    Totals result;
+    std::size_t index = static_cast<std::size_t>(type);
+    if (index >= TRACKED_TYPES) {
+        return result;
+    }
+    const Counters& entry = counters[index];
+    result.messages = entry.messages.load(std::memory_order_relaxed);
+    result.compressed = entry.compressed.load(std::memory_order_relaxed);
+    result.bytesIn = entry.bytesIn.load(std::memory_order_relaxed);
+    result.bytesOut = entry.bytesOut.load(std::memory_order_relaxed);
+    result.nanos = entry.nanos.load(std::memory_order_relaxed);
+    return result;
+}
+
+void CompressionStats::report(std::ostream& out) const {
+    for (std::size_t index = 0; index < TRACKED_TYPES; ++index) {
+        Totals entry = totals(static_cast<MessageType>(index));
+        if (entry.messages == 0) {
+            continue;
+        }
+        out << "Compression " << messageTypeName(static_cast<MessageType>(index)) << ": " << entry.messages << " messages ("
+            << entry.compressed << " compressed), " << entry.bytesIn << " -> " << entry.bytesOut << " bytes, ratio "
+            << std::fixed << std::setprecision(2) << static_cast<double>(entry.bytesIn) / entry.bytesOut << ", "
+            << std::setprecision(1) << entry.nanos / 1000.0 / entry.messages << " us each" << std::defaultfloat
+            << std::endl;
+    }
+}
+
+} // namespace BayouBonanza
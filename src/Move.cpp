@@ -50,8 +50,9 @@ const std::string& Move::getPromotionType() const {
     return pieceTypePromotedTo_;
 }
 
-// SFML Packet operators for Move
-sf::Packet& operator<<(sf::Packet& packet, const Move& mv) {
+// Packet operators for Move
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const Move& mv) {
     packet << mv.getFrom(); // Uses Position's operator<<
     packet << mv.getTo();   // Uses Position's operator<<
     packet << mv.isPromotion();
@@ -61,7 +62,8 @@ sf::Packet& operator<<(sf::Packet& packet, const Move& mv) {
     return packet;
 }
 
-sf::Packet& operator>>(sf::Packet& packet, Move& mv) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, Move& mv) {
     Position from, to;
     bool isPromotion;
     std::string promotionType;
@@ -84,4 +86,10 @@ sf::Packet& operator>>(sf::Packet& packet, Move& mv) {
     return packet;
 }
 
+// The serializers are only used with these streams
+template sf::Packet& operator<<(sf::Packet& packet, const Move& value);
+template sf::Packet& operator>>(sf::Packet& packet, Move& value);
+template WireWriter& operator<<(WireWriter& packet, const Move& value);
+template WireReader& operator>>(WireReader& packet, Move& value);
+
 } // namespace BayouBonanza
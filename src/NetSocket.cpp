@@ -0,0 +1,59 @@
+#include "NetSocket.h"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace BayouBonanza {
+
+sf::Socket::Status NetSocket::finishConnect() const {
+    int error = 0;
+#if defined(_WIN32)
+    int length = sizeof(error);
+    int result = ::getsockopt(nativeHandle(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length);
+#else
+    socklen_t length = sizeof(error);
+    int result = ::getsockopt(nativeHandle(), SOL_SOCKET, SO_ERROR, &error, &length);
+#endif
+    return result == 0 && error == 0 ? sf::Socket::Done : sf::Socket::Error;
+}
+
+sf::Socket::Status NetListener::listenShared(unsigned short port) {
+#if !defined(_WIN32) && defined(SO_REUSEPORT)
+    close();
+
+    int handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (handle < 0) {
+        return sf::Socket::Error;
+    }
+    int enable = 1;
+    ::setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    if (::setsockopt(handle, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0) {
+        ::close(handle);
+        return sf::Socket::Error;
+    }
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (::bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(handle, SOMAXCONN) != 0) {
+        ::close(handle);
+        return sf::Socket::Error;
+    }
+
+    create(handle);
+    return sf::Socket::Done;
+#else
+    return listen(port);
+#endif
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,201 @@
+#include "OutboundQueue.h"
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#endif
+
+namespace BayouBonanza {
+
+namespace {
+    // Upper bound on frames gathered into a single write call
+    constexpr std::size_t MAX_FRAMES_PER_WRITE = 64;
+}
+
+OutboundQueue::OutboundQueue(std::size_t highWaterBytes)
+    : headOffset(0), highWater(highWaterBytes), flushScheduled(false), closed(false) {}
+
+namespace {
+
+// Same layout as sf::TcpSocket::send(Packet): 32-bit big-endian size, then the payload
+void writeLengthPrefix(char* out, std::size_t size) {
+    out[0] = static_cast<char>((size >> 24) & 0xFF);
+    out[1] = static_cast<char>((size >> 16) & 0xFF);
+    out[2] = static_cast<char>((size >> 8) & 0xFF);
+    out[3] = static_cast<char>(size & 0xFF);
+}
+
+} // namespace
+
+OutboundQueue::Frame OutboundQueue::makeFrame(const sf::Packet& packet) {
+    const std::size_t size = packet.getDataSize();
+    auto frame = std::make_shared<Bytes>(4 + size);
+    writeLengthPrefix(frame->data(), size);
+    if (size > 0) {
+        std::copy_n(static_cast<const char*>(packet.getData()), size, frame->data() + 4);
+    }
+    return frame;
+}
+
+OutboundQueue::PushResult OutboundQueue::push(Frame frame) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closed) {
+        return PushResult::Closed;
+    }
+    if (counters.queuedBytes + frame->size() > highWater) {
+        return PushResult::OverHighWater;
+    }
+
+    counters.queuedBytes += frame->size();
+    counters.maxQueuedBytes = std::max(counters.maxQueuedBytes, counters.queuedBytes);
+    counters.framesQueued++;
+    frames.push_back(std::move(frame));
+
+    if (flushScheduled) {
+        return PushResult::Queued;
+    }
+    flushScheduled = true;
+    return PushResult::ScheduleFlush;
+}
+
+OutboundQueue::FlushResult OutboundQueue::flush(sf::SocketHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    flushScheduled = false;
+
+    while (!frames.empty()) {
+        std::size_t count = std::min(frames.size(), MAX_FRAMES_PER_WRITE);
+
+#if defined(_WIN32)
+        WSABUF buffers[MAX_FRAMES_PER_WRITE];
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t offset = (i == 0) ? headOffset : 0;
+            buffers[i].buf = const_cast<char*>(frames[i]->data()) + offset;
+            buffers[i].len = static_cast<ULONG>(frames[i]->size() - offset);
+        }
+        DWORD sent = 0;
+        counters.writeCalls++;
+        if (WSASend(handle, buffers, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) == SOCKET_ERROR) {
+            if (WSAGetLastError() == WSAEWOULDBLOCK) {
+                flushScheduled = true; // Writability notification will flush
+                return FlushResult::WouldBlock;
+            }
+            return FlushResult::Error;
+        }
+        std::size_t written = sent;
+#else
+        iovec buffers[MAX_FRAMES_PER_WRITE];
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t offset = (i == 0) ? headOffset : 0;
+            buffers[i].iov_base = const_cast<char*>(frames[i]->data()) + offset;
+            buffers[i].iov_len = frames[i]->size() - offset;
+        }
+        msghdr message{};
+        message.msg_iov = buffers;
+        message.msg_iovlen = count;
+        int flags = 0;
+#ifdef MSG_NOSIGNAL
+        flags |= MSG_NOSIGNAL; // A closed peer must not raise SIGPIPE
+#endif
+        counters.writeCalls++;
+        ssize_t result = ::sendmsg(handle, &message, flags);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                flushScheduled = true; // Writability notification will flush
+                return FlushResult::WouldBlock;
+            }
+            return FlushResult::Error;
+        }
+        std::size_t written = static_cast<std::size_t>(result);
+#endif
+        counters.bytesWritten += written;
+        consume(written);
+    }
+    return FlushResult::Drained;
+}
+
+void OutboundQueue::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    frames.clear();
+    headOffset = 0;
+    counters.queuedBytes = 0;
+}
+
+OutboundQueue::Stats OutboundQueue::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void OutboundQueue::consume(std::size_t written) {
+    counters.queuedBytes -= written;
+    while (written > 0) {
+        std::size_t remaining = frames.front()->size() - headOffset;
+        if (written < remaining) {
+            headOffset += written;
+            return;
+        }
+        written -= remaining;
+        frames.pop_front();
+        headOffset = 0;
+    }
+}
+
+FramePool::FramePool(std::size_t frameBytes, std::size_t maxBuffers, std::size_t maxBufferBytes)
+    : freeList(std::make_shared<FreeList>()), frameBytes(std::max(frameBytes, PREFIX_BYTES + 1)),
+      maxBuffers(maxBuffers), maxBufferBytes(std::max(maxBufferBytes, this->frameBytes)) {}
+
+std::shared_ptr<OutboundQueue::Bytes> FramePool::acquire(std::size_t capacity) {
+    std::unique_ptr<OutboundQueue::Bytes> buffer;
+    {
+        std::lock_guard<std::mutex> lock(freeList->mutex);
+        freeList->counters.buffersTaken++;
+        if (!freeList->buffers.empty()) {
+            buffer = std::move(freeList->buffers.back()); // Most recently released, likeliest still in cache
+            freeList->buffers.pop_back();
+            freeList->counters.buffersReused++;
+        } else if (freeList->counters.pooledBuffers >= maxBuffers) {
+            return std::make_shared<OutboundQueue::Bytes>(capacity); // Pool full: allocated and freed
+        } else {
+            freeList->counters.pooledBuffers++;
+        }
+    }
+    if (!buffer) {
+        buffer = std::make_unique<OutboundQueue::Bytes>();
+    }
+    // finish() shrank it to its last frame and kept the allocation, so this only reallocates to grow,
+    // and the bytes it adds back are left as they were rather than cleared
+    buffer->resize(capacity);
+
+    // When the last queue drops the frame the buffer goes back on the free list; the lock there
+    // also orders that queue's reads of it before the next writer's. One that grew past
+    // maxBufferBytes for a rare large message is freed instead of holding that memory for good.
+    return std::shared_ptr<OutboundQueue::Bytes>(
+        buffer.release(), [list = freeList, limit = maxBufferBytes](OutboundQueue::Bytes* released) {
+            std::unique_ptr<OutboundQueue::Bytes> owned(released);
+            std::lock_guard<std::mutex> lock(list->mutex);
+            if (owned->capacity() > limit) {
+                list->counters.pooledBuffers--;
+                return; // Freed once the lock is released
+            }
+            list->buffers.push_back(std::move(owned));
+        });
+}
+
+void FramePool::finish(OutboundQueue::Bytes& buffer, std::size_t payloadSize) {
+    buffer.resize(PREFIX_BYTES + payloadSize);
+    writeLengthPrefix(buffer.data(), payloadSize);
+}
+
+FramePool::Stats FramePool::stats() const {
+    std::lock_guard<std::mutex> lock(freeList->mutex);
+    return freeList->counters;
+}
+
+} // namespace BayouBonanza
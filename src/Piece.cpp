@@ -2,6 +2,7 @@
 #include "GameBoard.h"
 #include "PieceData.h" // Added
 #include "Square.h"    // Added
+#include "Zobrist.h"
 
 namespace BayouBonanza {
 
@@ -32,11 +33,15 @@ int Piece::getMaxHealth() const {
 }
 
 void Piece::setHealth(int health) {
+    std::uint64_t keyBefore = hashKey();
     this->health = health;
+    rehash(keyBefore);
 }
 
 bool Piece::takeDamage(int damage) {
+    std::uint64_t keyBefore = hashKey();
     health -= damage;
+    rehash(keyBefore);
     return health <= 0;
 }
 
@@ -45,7 +50,43 @@ Position Piece::getPosition() const {
 }
 
 void Piece::setPosition(const Position& pos) {
+    std::uint64_t keyBefore = hashKey();
     position = pos;
+    rehash(keyBefore);
+}
+
+void Piece::setHasMoved(bool moved) {
+    std::uint64_t keyBefore = hashKey();
+    hasMoved = moved;
+    rehash(keyBefore);
+}
+
+std::uint64_t Piece::hashKey() const {
+    using Zobrist::Feature;
+    return Zobrist::key(Feature::PieceType, hashSlot, stats.typeId) ^
+           Zobrist::key(Feature::PieceSide, hashSlot, static_cast<int>(side)) ^
+           Zobrist::key(Feature::PiecePosition, hashSlot, position.y * 256 + position.x) ^
+           Zobrist::key(Feature::PieceHealth, hashSlot, health) ^
+           Zobrist::key(Feature::PieceAttack, hashSlot, attack) ^
+           Zobrist::key(Feature::PieceMoved, hashSlot, hasMoved) ^
+           Zobrist::key(Feature::PieceStun, hashSlot, stunRemaining);
+}
+
+void Piece::attachHash(std::uint64_t* sink, std::uint64_t slot) {
+    if (hashSink) {
+        *hashSink ^= hashKey();
+    }
+    hashSink = sink;
+    hashSlot = slot;
+    if (hashSink) {
+        *hashSink ^= hashKey();
+    }
+}
+
+void Piece::rehash(std::uint64_t keyBefore) {
+    if (hashSink) {
+        *hashSink ^= keyBefore ^ hashKey();
+    }
 }
 
 // New implementations using PieceStats
@@ -226,13 +267,17 @@ bool Piece::isStunned() const {
 
 void Piece::applyStun(int turns) {
     if (turns > stunRemaining) {
+        std::uint64_t keyBefore = hashKey();
         stunRemaining = turns;
+        rehash(keyBefore);
     }
 }
 
 void Piece::decrementStun() {
     if (stunRemaining > 0) {
+        std::uint64_t keyBefore = hashKey();
         --stunRemaining;
+        rehash(keyBefore);
     }
 }
 
@@ -9,7 +9,53 @@
 
 namespace BayouBonanza {
 
-PieceDefinitionManager::PieceDefinitionManager() : loadedSuccessfully(false) {}
+namespace {
+
+// FNV-1a, fed field by field so the hash does not depend on struct layout
+class DefinitionsHasher {
+public:
+    void add(const std::string& text) {
+        for (char c : text) {
+            addByte(static_cast<std::uint8_t>(c));
+        }
+        addByte(0);
+    }
+
+    void add(int value) {
+        std::uint32_t bits = static_cast<std::uint32_t>(value);
+        for (int shift = 0; shift < 32; shift += 8) {
+            addByte(static_cast<std::uint8_t>(bits >> shift));
+        }
+    }
+
+    void add(const std::vector<PieceMovementRule>& rules) {
+        add(static_cast<int>(rules.size()));
+        for (const PieceMovementRule& rule : rules) {
+            add(static_cast<int>(rule.isPawnForward) | static_cast<int>(rule.isPawnCapture) << 1 |
+                static_cast<int>(rule.canJump) << 2);
+            add(rule.maxRange);
+            add(static_cast<int>(rule.relativeMoves.size()));
+            for (const Position& move : rule.relativeMoves) {
+                add(move.x);
+                add(move.y);
+            }
+        }
+    }
+
+    std::uint32_t value() const { return hash; }
+
+private:
+    std::uint32_t hash = 2166136261u;
+
+    void addByte(std::uint8_t byte) {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+};
+
+} // namespace
+
+PieceDefinitionManager::PieceDefinitionManager() : definitionsHash(0), loadedSuccessfully(false) {}
 
 bool PieceDefinitionManager::loadDefinitions(const std::string& filePath) {
     std::ifstream file(filePath);
@@ -115,13 +161,43 @@ bool PieceDefinitionManager::loadDefinitions(const std::string& filePath) {
         // Keep loadedSuccessfully as false if the map is empty.
         loadedSuccessfully = false;
     }
+    else if (pieceStatsMap.size() >= INVALID_PIECE_TYPE_ID) {
+        std::cerr << "Error: " << pieceStatsMap.size() << " piece types defined; at most "
+                  << static_cast<int>(INVALID_PIECE_TYPE_ID) << " fit the one-byte wire ID." << std::endl;
+        loadedSuccessfully = false;
+    }
     else {
         loadedSuccessfully = true;
     }
-    
+
+    assignTypeIds();
     return loadedSuccessfully;
 }
 
+void PieceDefinitionManager::assignTypeIds() {
+    statsById.clear();
+    DefinitionsHasher hasher;
+    if (loadedSuccessfully) {
+        // std::map iterates in type-name order, so every process assigns the same IDs
+        for (auto& entry : pieceStatsMap) {
+            PieceStats& stats = entry.second;
+            stats.typeId = static_cast<PieceTypeId>(statsById.size());
+            statsById.push_back(&stats);
+
+            hasher.add(stats.typeName);
+            hasher.add(static_cast<int>(stats.typeId));
+            hasher.add(stats.symbol);
+            hasher.add(stats.attack);
+            hasher.add(stats.health);
+            hasher.add(stats.cooldown);
+            hasher.add(static_cast<int>(stats.isRanged) | static_cast<int>(stats.isVictoryPiece) << 1);
+            hasher.add(stats.movementRules);
+            hasher.add(stats.influenceRules);
+        }
+    }
+    definitionsHash = statsById.empty() ? 0 : hasher.value();
+}
+
 const PieceStats* PieceDefinitionManager::getPieceStats(const std::string& typeName) const {
     if (!loadedSuccessfully) {
         // It might be too noisy to print this every time if loading intentionally failed or file was empty.
@@ -139,6 +215,15 @@ const PieceStats* PieceDefinitionManager::getPieceStats(const std::string& typeN
     return nullptr;
 }
 
+const PieceStats* PieceDefinitionManager::getPieceStats(PieceTypeId typeId) const {
+    return typeId < statsById.size() ? statsById[typeId] : nullptr;
+}
+
+PieceTypeId PieceDefinitionManager::getPieceTypeId(const std::string& typeName) const {
+    const PieceStats* stats = getPieceStats(typeName);
+    return stats ? stats->typeId : INVALID_PIECE_TYPE_ID;
+}
+
 std::vector<std::string> PieceDefinitionManager::getAllPieceTypeNames() const {
     if (!loadedSuccessfully) {
          // std::cerr << "Warning: Attempting to get piece type names, but definitions were not loaded successfully." << std::endl;
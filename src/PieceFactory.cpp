@@ -25,4 +25,14 @@ std::unique_ptr<Piece> PieceFactory::createPiece(const std::string& typeName, Pl
     return newPiece;
 }
 
+std::unique_ptr<Piece> PieceFactory::createPiece(PieceTypeId typeId, PlayerSide side) {
+    const PieceStats* stats = definitionManager.getPieceStats(typeId);
+    if (!stats) {
+        std::cerr << "Error: PieceFactory could not create piece with type ID " << static_cast<int>(typeId)
+                  << ". Stats not found." << std::endl;
+        return nullptr;
+    }
+    return std::make_unique<Piece>(side, *stats);
+}
+
 } // namespace BayouBonanza
@@ -0,0 +1,522 @@
+#include "PlayerDatabase.h"
+#include "CardCollection.h"
+#include <sqlite3.h>
+#include <iostream>
+#include <unordered_map>
+
+namespace BayouBonanza {
+
+namespace {
+
+// Version 1: collections and decks as the comma-separated text of CardCollection::serialize()
+const char* const CREATE_TEXT_TABLES =
+    "CREATE TABLE IF NOT EXISTS users (username TEXT PRIMARY KEY NOT NULL, rating INTEGER NOT NULL DEFAULT 0);"
+    "CREATE TABLE IF NOT EXISTS collections (username TEXT PRIMARY KEY NOT NULL, cards TEXT);"
+    "CREATE TABLE IF NOT EXISTS decks (username TEXT PRIMARY KEY NOT NULL, deck TEXT);";
+
+// Version 2: the same, packed (CardCollection::pack(), Deck::pack()); the text tables are kept under a _v1 name
+const char* const CREATE_PACKED_TABLES =
+    "CREATE TABLE card_collections (username TEXT PRIMARY KEY NOT NULL, cards BLOB);"
+    "CREATE TABLE card_decks (username TEXT PRIMARY KEY NOT NULL, deck BLOB);";
+const char* const SELECT_TEXT_COLLECTIONS = "SELECT username, cards FROM collections;";
+const char* const SELECT_TEXT_DECKS = "SELECT username, deck FROM decks;";
+const char* const INSERT_PACKED_COLLECTION = "INSERT INTO card_collections (username, cards) VALUES (?, ?);";
+const char* const INSERT_PACKED_DECK = "INSERT INTO card_decks (username, deck) VALUES (?, ?);";
+const char* const RETIRE_TEXT_TABLES =
+    "ALTER TABLE collections RENAME TO collections_v1; ALTER TABLE decks RENAME TO decks_v1;";
+
+// Version 3: users in leaderboard order, so ranking reads walk the index instead of sorting every user
+const char* const CREATE_RATING_INDEX = "CREATE INDEX users_by_rating ON users (rating DESC, username);";
+
+const char* const SELECT_VERSION = "PRAGMA user_version;";
+
+const char* const SELECT_USER =
+    "SELECT (SELECT rating FROM users WHERE username = ?1),"
+    " (SELECT cards FROM card_collections WHERE username = ?1),"
+    " (SELECT deck FROM card_decks WHERE username = ?1);";
+const char* const INSERT_USER = "INSERT OR IGNORE INTO users (username, rating) VALUES (?, ?);";
+// A row left with an empty collection or deck gets the defaults too, as a missing one would
+const char* const INSERT_COLLECTION =
+    "INSERT INTO card_collections (username, cards) VALUES (?, ?) ON CONFLICT (username) DO UPDATE"
+    " SET cards = excluded.cards WHERE cards IS NULL OR length(cards) = 0;";
+const char* const INSERT_DECK =
+    "INSERT INTO card_decks (username, deck) VALUES (?, ?) ON CONFLICT (username) DO UPDATE"
+    " SET deck = excluded.deck WHERE deck IS NULL OR length(deck) = 0;";
+const char* const REPLACE_DECK = "REPLACE INTO card_decks (username, deck) VALUES (?, ?);";
+const char* const UPDATE_RATING = "UPDATE users SET rating = ?2 WHERE username = ?1;";
+const char* const SELECT_RATINGS = "SELECT username, rating FROM users ORDER BY rating DESC, username;";
+
+const char* const BEGIN = "BEGIN IMMEDIATE;"; // Take the write lock up front rather than fail to upgrade later
+const char* const COMMIT = "COMMIT;";
+const char* const ROLLBACK = "ROLLBACK;";
+const char* const SAVEPOINT = "SAVEPOINT write_group;";
+const char* const RELEASE = "RELEASE write_group;";
+const char* const ROLLBACK_TO = "ROLLBACK TO write_group;";
+
+std::string columnText(sqlite3_stmt* statement, int column) {
+    const unsigned char* text = sqlite3_column_text(statement, column);
+    return text ? reinterpret_cast<const char*>(text) : std::string();
+}
+
+std::string columnBlob(sqlite3_stmt* statement, int column) {
+    const void* bytes = sqlite3_column_blob(statement, column);
+    return bytes ? std::string(static_cast<const char*>(bytes), sqlite3_column_bytes(statement, column)) : std::string();
+}
+
+// Marks a string to be bound as a BLOB rather than as text
+struct Blob {
+    const std::string& bytes;
+};
+
+} // namespace
+
+// One open database handle and the statements compiled on it; used by one thread at a time
+class PlayerDatabase::Connection {
+public:
+    // Resets its statement when it goes out of scope, so the cached statement is ready for the next use
+    class Statement {
+    public:
+        explicit Statement(sqlite3_stmt* statement) : statement(statement) {}
+        ~Statement() {
+            if (statement) {
+                sqlite3_reset(statement);
+                sqlite3_clear_bindings(statement);
+            }
+        }
+        Statement(const Statement&) = delete;
+        Statement& operator=(const Statement&) = delete;
+
+        explicit operator bool() const { return statement != nullptr; }
+        sqlite3_stmt* get() const { return statement; }
+
+        void bind(int index, const std::string& text) {
+            sqlite3_bind_text(statement, index, text.c_str(), static_cast<int>(text.size()), SQLITE_STATIC);
+        }
+        void bind(int index, int value) { sqlite3_bind_int(statement, index, value); }
+        void bind(int index, Blob blob) {
+            if (blob.bytes.empty()) {
+                sqlite3_bind_null(statement, index); // Missing, as far as loading is concerned
+            } else {
+                sqlite3_bind_blob(statement, index, blob.bytes.data(), static_cast<int>(blob.bytes.size()),
+                                  SQLITE_STATIC);
+            }
+        }
+
+        int step() { return sqlite3_step(statement); }
+
+    private:
+        sqlite3_stmt* statement;
+    };
+
+    Connection(sqlite3* db, PlayerDatabase& owner) : db(db), owner(owner) {}
+
+    ~Connection() {
+        for (auto& entry : statements) {
+            sqlite3_finalize(entry.second);
+        }
+        sqlite3_close(db);
+    }
+
+    // The compiled statement for @p sql, from the cache when this connection has run it before
+    Statement prepare(const char* sql) {
+        auto found = statements.find(sql);
+        if (found != statements.end()) {
+            owner.statementsReused.fetch_add(1, std::memory_order_relaxed);
+            return Statement(found->second);
+        }
+        sqlite3_stmt* statement = nullptr;
+        if (sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &statement, nullptr) != SQLITE_OK) {
+            std::cerr << "Failed to prepare \"" << sql << "\": " << sqlite3_errmsg(db) << std::endl;
+            return Statement(nullptr);
+        }
+        statements.emplace(sql, statement);
+        owner.statementsPrepared.fetch_add(1, std::memory_order_relaxed);
+        return Statement(statement);
+    }
+
+    // Run a statement that returns no rows
+    bool run(const char* sql) {
+        Statement statement = prepare(sql);
+        return statement && statement.step() == SQLITE_DONE;
+    }
+
+    bool exec(const char* sql) {
+        char* error = nullptr;
+        if (sqlite3_exec(db, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+            std::cerr << "SQL error: " << (error ? error : sqlite3_errmsg(db)) << std::endl;
+            sqlite3_free(error);
+            return false;
+        }
+        return true;
+    }
+
+    const char* lastError() const { return sqlite3_errmsg(db); }
+
+    // Run one write inside the caller's transaction
+    bool apply(const Write& write) {
+        bool applied = true;
+        switch (write.kind) {
+            case Write::Kind::CreateUser:
+                applied = step(INSERT_USER, write.username, write.rating) &&
+                          step(INSERT_COLLECTION, write.username, Blob{write.collection}) &&
+                          step(INSERT_DECK, write.username, Blob{write.deck});
+                break;
+            case Write::Kind::SaveDeck:
+                applied = step(REPLACE_DECK, write.username, Blob{write.deck});
+                break;
+            case Write::Kind::SetRating:
+                applied = step(UPDATE_RATING, write.username, write.rating);
+                if (applied && sqlite3_changes(db) == 0) {
+                    std::cerr << "No user " << write.username << " to rate" << std::endl;
+                    return false;
+                }
+                break;
+        }
+        if (!applied) {
+            std::cerr << "SQL error writing user " << write.username << ": " << lastError() << std::endl;
+        }
+        return applied;
+    }
+
+    // Bring the schema up to SCHEMA_VERSION, one version per transaction
+    bool migrate() {
+        int version = 0;
+        if (!userVersion(version)) {
+            return false;
+        }
+        while (version < SCHEMA_VERSION) {
+            if (!run(BEGIN)) {
+                std::cerr << "Failed to start a migration: " << lastError() << std::endl;
+                return false;
+            }
+            // Another process may have migrated meanwhile; with the write lock held the version is settled
+            if (!userVersion(version) || version >= SCHEMA_VERSION) {
+                run(ROLLBACK);
+                return version >= SCHEMA_VERSION;
+            }
+            bool migrated = migrateFrom(version);
+            std::string setVersion = "PRAGMA user_version = " + std::to_string(version + 1) + ";";
+            if (!migrated || !exec(setVersion.c_str()) || !run(COMMIT)) {
+                std::cerr << "Failed to migrate the database to version " << version + 1 << ": " << lastError()
+                          << std::endl;
+                run(ROLLBACK);
+                return false;
+            }
+            ++version;
+            std::cout << "Database schema now at version " << version << std::endl;
+        }
+        return true;
+    }
+
+private:
+    // One version step, inside the migration's transaction
+    bool migrateFrom(int version) {
+        switch (version) {
+            case 0:
+                return exec(CREATE_TEXT_TABLES);
+            case 1:
+                return packCardTables();
+            default:
+                return exec(CREATE_RATING_INDEX);
+        }
+    }
+
+    bool userVersion(int& version) {
+        Statement select = prepare(SELECT_VERSION);
+        if (!select || select.step() != SQLITE_ROW) {
+            return false;
+        }
+        version = sqlite3_column_int(select.get(), 0);
+        return true;
+    }
+
+    // Version 1 to 2: rewrite every collection and deck in packed form, then set the text tables aside
+    bool packCardTables() {
+        if (!exec(CREATE_PACKED_TABLES) || !packRows<CardCollection>("collections", SELECT_TEXT_COLLECTIONS, INSERT_PACKED_COLLECTION) ||
+            !packRows<Deck>("decks", SELECT_TEXT_DECKS, INSERT_PACKED_DECK)) {
+            return false;
+        }
+        return exec(RETIRE_TEXT_TABLES);
+    }
+
+    // Copy (username, text) rows into (username, packed) rows. Text that does not parse fails the step:
+    // the card definitions may be missing or stale, and packing without them would lose the user's cards.
+    template <typename Cards>
+    bool packRows(const char* what, const char* selectSql, const char* insertSql) {
+        Statement select = prepare(selectSql);
+        if (!select) {
+            return false;
+        }
+        std::size_t rows = 0;
+        int result;
+        while ((result = select.step()) == SQLITE_ROW) {
+            std::string username = columnText(select.get(), 0);
+            std::string text = columnText(select.get(), 1);
+            Cards cards;
+            std::string packed;
+            if (!text.empty()) {
+                if (!cards.deserialize(text)) {
+                    std::cerr << "The " << what << " of " << username
+                              << " do not parse with the loaded card definitions; not migrating" << std::endl;
+                    return false;
+                }
+                packed = cards.pack();
+            }
+            if (!step(insertSql, username, Blob{packed})) {
+                return false;
+            }
+            ++rows;
+        }
+        if (result != SQLITE_DONE) {
+            return false;
+        }
+        std::cout << "Packed " << rows << " " << what << std::endl;
+        return true;
+    }
+
+    // Run a statement that binds the username first, then one value
+    template <typename Value>
+    bool step(const char* sql, const std::string& username, const Value& value) {
+        Statement statement = prepare(sql);
+        if (!statement) {
+            return false;
+        }
+        statement.bind(1, username);
+        statement.bind(2, value);
+        return statement.step() == SQLITE_DONE;
+    }
+
+    sqlite3* db;
+    std::unordered_map<std::string, sqlite3_stmt*> statements; // Keyed by SQL text
+    PlayerDatabase& owner;
+};
+
+// A borrowed connection, given back to the pool when the call is done
+class PlayerDatabase::Lease {
+public:
+    explicit Lease(PlayerDatabase& database) : database(database), connection(database.acquire()) {}
+    ~Lease() {
+        if (connection) {
+            database.release(std::move(connection));
+        }
+    }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    explicit operator bool() const { return connection != nullptr; }
+    Connection* operator->() const { return connection.get(); }
+
+private:
+    PlayerDatabase& database;
+    std::unique_ptr<Connection> connection;
+};
+
+PlayerDatabase::PlayerDatabase() : PlayerDatabase(Options{}) {}
+
+PlayerDatabase::PlayerDatabase(Options options) : config(std::move(options)) {
+    if (config.maxConnections == 0) {
+        config.maxConnections = 1;
+    }
+}
+
+PlayerDatabase::~PlayerDatabase() = default;
+
+std::unique_ptr<PlayerDatabase::Connection> PlayerDatabase::acquire() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        connectionReturned.wait(lock, [this]() { return !idle.empty() || openConnections < config.maxConnections; });
+        if (!idle.empty()) {
+            std::unique_ptr<Connection> connection = std::move(idle.back());
+            idle.pop_back();
+            return connection;
+        }
+        openConnections++; // Reserve the slot; opening happens outside the lock
+    }
+
+    // Each connection is only ever used by one thread at a time, so SQLite's own mutexes can go
+    sqlite3* db = nullptr;
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    if (sqlite3_open_v2(config.path.c_str(), &db, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open database " << config.path << ": " << (db ? sqlite3_errmsg(db) : "out of memory")
+                  << std::endl;
+        sqlite3_close(db);
+        std::lock_guard<std::mutex> lock(mutex);
+        openConnections--;
+        connectionReturned.notify_one();
+        return nullptr;
+    }
+    sqlite3_busy_timeout(db, static_cast<int>(config.busyTimeout.count()));
+    auto connection = std::make_unique<Connection>(db, *this);
+
+    // WAL lets readers run alongside the one writer; NORMAL syncs at checkpoints instead of every commit,
+    // which WAL keeps safe against corruption (a power cut may only lose the last commits)
+    connection->exec("PRAGMA journal_mode=WAL;"
+                     "PRAGMA synchronous=NORMAL;"
+                     "PRAGMA temp_store=MEMORY;"
+                     "PRAGMA cache_size=-8192;"); // KiB
+    connectionsOpened.fetch_add(1, std::memory_order_relaxed);
+    return connection;
+}
+
+void PlayerDatabase::release(std::unique_ptr<Connection> connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.push_back(std::move(connection));
+    }
+    connectionReturned.notify_one();
+}
+
+bool PlayerDatabase::initializeSchema() {
+    Lease connection(*this);
+    return connection && connection->migrate();
+}
+
+PlayerDatabase::Write PlayerDatabase::createUser(const std::string& username, const NewUser& user) {
+    Write write;
+    write.kind = Write::Kind::CreateUser;
+    write.username = username;
+    write.rating = user.rating;
+    write.collection = user.collection;
+    write.deck = user.deck;
+    return write;
+}
+
+PlayerDatabase::Write PlayerDatabase::deckSave(const std::string& username, const std::string& deck) {
+    Write write;
+    write.kind = Write::Kind::SaveDeck;
+    write.username = username;
+    write.deck = deck;
+    return write;
+}
+
+PlayerDatabase::Write PlayerDatabase::ratingSet(const std::string& username, int rating) {
+    Write write;
+    write.kind = Write::Kind::SetRating;
+    write.username = username;
+    write.rating = rating;
+    return write;
+}
+
+std::optional<PlayerDatabase::UserProfile> PlayerDatabase::readUser(const std::string& username,
+                                                                    const NewUser& defaults) {
+    Lease connection(*this);
+    if (!connection) {
+        return std::nullopt;
+    }
+    Connection::Statement select = connection->prepare(SELECT_USER);
+    if (!select) {
+        return std::nullopt;
+    }
+    select.bind(1, username);
+    if (select.step() != SQLITE_ROW) {
+        std::cerr << "SQL error selecting user " << username << ": " << connection->lastError() << std::endl;
+        return std::nullopt;
+    }
+
+    UserProfile profile;
+    bool haveUser = sqlite3_column_type(select.get(), 0) != SQLITE_NULL;
+    profile.rating = haveUser ? sqlite3_column_int(select.get(), 0) : defaults.rating;
+    profile.collection = columnBlob(select.get(), 1);
+    profile.deck = columnBlob(select.get(), 2);
+    // A first login, or an account missing pieces: the defaults stand in for what is missing
+    profile.created = !haveUser || profile.collection.empty() || profile.deck.empty();
+    if (profile.collection.empty()) {
+        profile.collection = defaults.collection;
+    }
+    if (profile.deck.empty()) {
+        profile.deck = defaults.deck;
+    }
+    return profile;
+}
+
+std::optional<std::vector<PlayerDatabase::RatingUpdate>> PlayerDatabase::readRatings() {
+    Lease connection(*this);
+    if (!connection) {
+        return std::nullopt;
+    }
+    Connection::Statement select = connection->prepare(SELECT_RATINGS);
+    if (!select) {
+        return std::nullopt;
+    }
+    std::vector<RatingUpdate> ratings;
+    int result;
+    while ((result = select.step()) == SQLITE_ROW) {
+        ratings.push_back({columnText(select.get(), 0), sqlite3_column_int(select.get(), 1)});
+    }
+    if (result != SQLITE_DONE) {
+        std::cerr << "SQL error reading ratings: " << connection->lastError() << std::endl;
+        return std::nullopt;
+    }
+    return ratings;
+}
+
+std::optional<PlayerDatabase::UserProfile> PlayerDatabase::loadUser(const std::string& username,
+                                                                    const NewUser& defaults) {
+    std::optional<UserProfile> profile = readUser(username, defaults);
+    if (profile && profile->created) {
+        NewUser stored{profile->rating, profile->collection, profile->deck};
+        if (!applyWrites({{createUser(username, stored)}}).front()) {
+            return std::nullopt;
+        }
+    }
+    return profile;
+}
+
+bool PlayerDatabase::saveDeck(const std::string& username, const std::string& deck) {
+    return applyWrites({{deckSave(username, deck)}}).front();
+}
+
+bool PlayerDatabase::updateRatings(const std::vector<RatingUpdate>& ratings) {
+    WriteGroup group;
+    for (const RatingUpdate& update : ratings) {
+        group.push_back(ratingSet(update.username, update.rating));
+    }
+    return applyWrites({group}).front();
+}
+
+std::vector<bool> PlayerDatabase::applyWrites(const std::vector<WriteGroup>& groups) {
+    std::vector<bool> stored(groups.size(), false);
+    Lease connection(*this);
+    if (!connection) {
+        return stored;
+    }
+    if (!connection->run(BEGIN)) {
+        std::cerr << "Failed to start a transaction: " << connection->lastError() << std::endl;
+        return stored;
+    }
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (!connection->run(SAVEPOINT)) {
+            std::cerr << "Failed to set a savepoint: " << connection->lastError() << std::endl;
+            continue;
+        }
+        bool applied = true;
+        for (const Write& write : groups[i]) {
+            if (!connection->apply(write)) {
+                applied = false;
+                break;
+            }
+        }
+        if (applied) {
+            stored[i] = connection->run(RELEASE);
+        } else {
+            connection->run(ROLLBACK_TO);
+            connection->run(RELEASE);
+        }
+    }
+    if (!connection->run(COMMIT)) {
+        std::cerr << "Failed to commit " << groups.size() << " writes: " << connection->lastError() << std::endl;
+        connection->run(ROLLBACK);
+        stored.assign(groups.size(), false);
+    }
+    return stored;
+}
+
+PlayerDatabase::Stats PlayerDatabase::stats() const {
+    Stats result;
+    result.connectionsOpened = connectionsOpened.load(std::memory_order_relaxed);
+    result.statementsPrepared = statementsPrepared.load(std::memory_order_relaxed);
+    result.statementsReused = statementsReused.load(std::memory_order_relaxed);
+    return result;
+}
+
+} // namespace BayouBonanza
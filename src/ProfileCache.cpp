@@ -0,0 +1,268 @@
+#include "ProfileCache.h"
+#include <iomanip>
+#include <iostream>
+
+namespace BayouBonanza {
+
+namespace {
+
+// Unpack stored cards, or the defaults if the stored blob is unreadable, as readUser() does for missing ones.
+// Loading a corrupt row as empty would have the next save store the empty deck for good.
+template <typename Cards>
+bool unpackOrDefault(Cards& cards, const std::string& stored, const std::string& fallback, const char* what,
+                     const std::string& username) {
+    if (cards.unpack(stored)) {
+        return true;
+    }
+    std::cerr << "The stored " << what << " of " << username << " is unreadable; using the defaults" << std::endl;
+    if (!cards.unpack(fallback)) {
+        std::cerr << "The default " << what << " is unreadable too" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+ProfileCache::ProfileCache(PlayerDatabase& database, DatabaseWriter& writer)
+    : ProfileCache(database, writer, Options{}) {}
+
+ProfileCache::ProfileCache(PlayerDatabase& database, DatabaseWriter& writer, Options options)
+    : database(database), writer(writer), config(options) {}
+
+ProfileCache::~ProfileCache() {
+    flush();
+    // Completions still to come refer to this cache
+    std::unique_lock<std::mutex> lock(mutex);
+    writeLanded.wait(lock, [this]() { return writesInFlight.empty(); });
+}
+
+std::optional<ProfileCache::Profile> ProfileCache::find(const std::string& username) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(username);
+    if (found == index.end()) {
+        return std::nullopt;
+    }
+    counters.hits++;
+    touch(found->second);
+    return found->second->profile;
+}
+
+std::optional<ProfileCache::Profile> ProfileCache::load(const std::string& username,
+                                                        const PlayerDatabase::NewUser& defaults) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto found = index.find(username);
+        if (found == index.end()) {
+            // A change still on its way to the database would be missing from what is read
+            writeLanded.wait(lock, [this, &username]() { return writesInFlight.count(username) == 0; });
+            found = index.find(username);
+        }
+        if (found != index.end()) {
+            counters.hits++;
+            touch(found->second);
+            return found->second->profile;
+        }
+        counters.misses++;
+    }
+
+    std::optional<PlayerDatabase::UserProfile> user = database.readUser(username, defaults);
+    if (!user) {
+        return std::nullopt;
+    }
+    // Decode outside the lock; this and the read are what a cache hit saves
+    Profile profile;
+    profile.rating = user->rating;
+    if (!unpackOrDefault(profile.collection, user->collection, defaults.collection, "collection", username) ||
+        !unpackOrDefault(profile.deck, user->deck, defaults.deck, "deck", username)) {
+        return std::nullopt;
+    }
+
+    std::vector<PlayerDatabase::WriteGroup> writes;
+    std::optional<Profile> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(username);
+        if (found != index.end()) {
+            // Loaded by another login meanwhile, and maybe changed since; that copy wins
+            touch(found->second);
+            result = found->second->profile;
+        } else {
+            result = profile;
+            entries.push_front(Entry{username, std::move(profile)});
+            index.emplace(username, entries.begin());
+            if (user->created) {
+                PlayerDatabase::NewUser stored{user->rating, user->collection, user->deck};
+                writes.push_back({PlayerDatabase::createUser(username, stored)});
+                track(writes.back());
+            }
+            evictOverCapacity(writes);
+        }
+    }
+    submit(std::move(writes));
+    return result;
+}
+
+void ProfileCache::setRatings(const std::vector<PlayerDatabase::RatingUpdate>& ratings) {
+    std::vector<PlayerDatabase::WriteGroup> writes;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        PlayerDatabase::WriteGroup writeThrough;
+        for (const PlayerDatabase::RatingUpdate& update : ratings) {
+            auto found = index.find(update.username);
+            if (found == index.end()) {
+                writeThrough.push_back(PlayerDatabase::ratingSet(update.username, update.rating));
+                continue;
+            }
+            found->second->profile.rating = update.rating;
+            found->second->ratingDirty = true;
+            dirty.insert(update.username);
+            touch(found->second);
+        }
+        if (!writeThrough.empty()) {
+            track(writeThrough);
+            writes.push_back(std::move(writeThrough));
+        }
+    }
+    submit(std::move(writes));
+}
+
+void ProfileCache::setDeck(const std::string& username, const Deck& deck) {
+    std::vector<PlayerDatabase::WriteGroup> writes;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(username);
+        if (found == index.end()) {
+            writes.push_back({PlayerDatabase::deckSave(username, deck.pack())});
+            track(writes.back());
+        } else {
+            found->second->profile.deck = deck;
+            found->second->deckDirty = true;
+            dirty.insert(username);
+            touch(found->second);
+        }
+    }
+    submit(std::move(writes));
+}
+
+std::size_t ProfileCache::flush() {
+    std::vector<PlayerDatabase::WriteGroup> writes;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::string& username : dirty) {
+            writes.push_back(takeDirty(*index.at(username)));
+        }
+        dirty.clear();
+    }
+    std::size_t flushed = writes.size();
+    submit(std::move(writes));
+    return flushed;
+}
+
+ProfileCache::Stats ProfileCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = counters;
+    result.size = entries.size();
+    result.dirty = dirty.size();
+    return result;
+}
+
+void ProfileCache::report(std::ostream& out) const {
+    Stats s = stats();
+    out << "Profile cache: " << s.size << " cached (" << s.dirty << " dirty), " << s.hits << " hits, " << s.misses
+        << " misses";
+    if (s.hits + s.misses > 0) {
+        out << " (" << std::fixed << std::setprecision(1) << 100.0 * s.hits / (s.hits + s.misses) << "% hit)"
+            << std::defaultfloat;
+    }
+    out << ", " << s.evictions << " evicted, " << s.writes << " writes queued, " << s.failedWrites << " failed"
+        << std::endl;
+}
+
+void ProfileCache::touch(std::list<Entry>::iterator entry) {
+    entries.splice(entries.begin(), entries, entry);
+}
+
+PlayerDatabase::WriteGroup ProfileCache::takeDirty(Entry& entry) {
+    PlayerDatabase::WriteGroup writes;
+    if (entry.ratingDirty) {
+        writes.push_back(PlayerDatabase::ratingSet(entry.username, entry.profile.rating));
+    }
+    if (entry.deckDirty) {
+        writes.push_back(PlayerDatabase::deckSave(entry.username, entry.profile.deck.pack()));
+    }
+    entry.ratingDirty = false;
+    entry.deckDirty = false;
+    track(writes);
+    return writes;
+}
+
+void ProfileCache::evictOverCapacity(std::vector<PlayerDatabase::WriteGroup>& writes) {
+    while (entries.size() > config.capacity) {
+        Entry& oldest = entries.back();
+        if (oldest.ratingDirty || oldest.deckDirty) {
+            writes.push_back(takeDirty(oldest));
+            dirty.erase(oldest.username);
+        }
+        index.erase(oldest.username);
+        entries.pop_back();
+        counters.evictions++;
+    }
+}
+
+void ProfileCache::track(const PlayerDatabase::WriteGroup& writes) {
+    for (const PlayerDatabase::Write& write : writes) {
+        writesInFlight[write.username]++;
+    }
+    counters.writes++;
+}
+
+void ProfileCache::submit(std::vector<PlayerDatabase::WriteGroup> writes) {
+    for (PlayerDatabase::WriteGroup& group : writes) {
+        PlayerDatabase::WriteGroup submitted = group;
+        writer.submit(std::move(submitted), [this, group = std::move(group)](bool stored) {
+            landed(group, stored);
+        });
+    }
+}
+
+void ProfileCache::landed(const PlayerDatabase::WriteGroup& writes, bool stored) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!stored) {
+        counters.failedWrites++;
+    }
+    for (const PlayerDatabase::Write& write : writes) {
+        auto inFlight = writesInFlight.find(write.username);
+        if (inFlight != writesInFlight.end() && --inFlight->second == 0) {
+            writesInFlight.erase(inFlight);
+        }
+        if (stored) {
+            continue;
+        }
+        auto found = index.find(write.username);
+        if (write.kind == PlayerDatabase::Write::Kind::CreateUser) {
+            // With no row, every later write of this profile would fail too; the next login reads it afresh
+            std::cerr << "Could not store the new profile of " << write.username << "; dropping it" << std::endl;
+            if (found != index.end()) {
+                dirty.erase(write.username);
+                entries.erase(found->second);
+                index.erase(found);
+            }
+            continue;
+        }
+        if (found == index.end()) {
+            std::cerr << "Lost a change to the profile of " << write.username << std::endl;
+            continue;
+        }
+        // Still cached: mark it dirty again so the next flush retries it
+        if (write.kind == PlayerDatabase::Write::Kind::SetRating) {
+            found->second->ratingDirty = true;
+        } else {
+            found->second->deckDirty = true;
+        }
+        dirty.insert(write.username);
+    }
+    writeLanded.notify_all();
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,58 @@
+#include "ProtocolHandshake.h"
+#include <algorithm>
+
+namespace BayouBonanza {
+
+HandshakeResult negotiateConnection(const ConnectionRequestData& request, sf::Uint32 definitionsHash,
+                                    CapabilitySet serverCapabilities) {
+    HandshakeResult result;
+    if (request.protocolVersion < MIN_PROTOCOL_VERSION) {
+        result.refusal = "This game version is too old for the server; please update the game";
+        return result;
+    }
+    // Pieces travel as one-byte type IDs; both ends must have assigned them from the same definitions
+    if (request.definitionsHash != definitionsHash) {
+        result.refusal = "Piece definitions differ from the server's; please update the game";
+        return result;
+    }
+    result.accepted = true;
+    result.reply.protocolVersion = std::min(request.protocolVersion, PROTOCOL_VERSION);
+    result.reply.capabilities = request.capabilities & serverCapabilities & SUPPORTED_CAPABILITIES;
+    return result;
+}
+
+CapabilitySet legacyLoginCapabilities(StateUpdateMode requested) {
+    CapabilitySet capabilities = capabilityBit(Capability::StateDeltas);
+    if (requested == StateUpdateMode::Events) {
+        capabilities |= capabilityBit(Capability::GameEvents);
+    }
+    return capabilities;
+}
+
+StateUpdateMode stateUpdateModeFor(CapabilitySet capabilities, bool haveEvent) {
+    if (haveEvent && hasCapability(capabilities, Capability::GameEvents)) {
+        return StateUpdateMode::Events;
+    }
+    if (hasCapability(capabilities, Capability::StateDeltas)) {
+        return StateUpdateMode::Deltas;
+    }
+    return StateUpdateMode::FullState;
+}
+
+sf::Packet& operator<<(sf::Packet& packet, const ConnectionRequestData& request) {
+    return packet << request.protocolVersion << request.definitionsHash << request.capabilities;
+}
+
+sf::Packet& operator>>(sf::Packet& packet, ConnectionRequestData& request) {
+    return packet >> request.protocolVersion >> request.definitionsHash >> request.capabilities;
+}
+
+sf::Packet& operator<<(sf::Packet& packet, const ConnectionAcceptedData& reply) {
+    return packet << reply.protocolVersion << reply.capabilities;
+}
+
+sf::Packet& operator>>(sf::Packet& packet, ConnectionAcceptedData& reply) {
+    return packet >> reply.protocolVersion >> reply.capabilities;
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,378 @@
+#include "Reactor.h"
+#include <iostream>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#elif defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace BayouBonanza {
+
+namespace {
+    // Upper bound on readiness notifications handled per wait call
+    constexpr int MAX_EVENTS_PER_WAIT = 256;
+}
+
+#if defined(__linux__)
+
+namespace {
+    unsigned toEpoll(unsigned interest) {
+        unsigned ev = 0;
+        if (interest & Reactor::Readable) ev |= EPOLLIN | EPOLLRDHUP;
+        if (interest & Reactor::Writable) ev |= EPOLLOUT;
+        return ev;
+    }
+
+    unsigned fromEpoll(unsigned ev) {
+        unsigned out = 0;
+        if (ev & EPOLLIN) out |= Reactor::Readable;
+        if (ev & EPOLLOUT) out |= Reactor::Writable;
+        if (ev & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) out |= Reactor::Hangup | Reactor::Readable;
+        return out;
+    }
+}
+
+Reactor::Reactor()
+    : running(false),
+      epollFd(epoll_create1(EPOLL_CLOEXEC)),
+      wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (epollFd < 0) {
+        std::cerr << "Reactor: epoll_create1 failed (errno " << errno << ")" << std::endl;
+        return;
+    }
+    if (wakeFd < 0) {
+        std::cerr << "Reactor: eventfd failed (errno " << errno << ")" << std::endl;
+        return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+}
+
+Reactor::~Reactor() {
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+    if (epollFd >= 0) {
+        ::close(epollFd);
+    }
+}
+
+bool Reactor::isValid() const {
+    return epollFd >= 0 && wakeFd >= 0;
+}
+
+void Reactor::wake() {
+    std::uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written; // Counter saturation still leaves the fd readable
+}
+
+bool Reactor::add(sf::SocketHandle handle, unsigned interest, Handler handler) {
+    epoll_event ev{};
+    ev.events = toEpoll(interest);
+    ev.data.fd = handle;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, handle, &ev) != 0) {
+        std::cerr << "Reactor: failed to add handle " << handle << " (errno " << errno << ")" << std::endl;
+        return false;
+    }
+    entries[handle] = std::make_shared<Entry>(Entry{handle, interest, std::move(handler)});
+    return true;
+}
+
+bool Reactor::modify(sf::SocketHandle handle, unsigned interest) {
+    auto it = entries.find(handle);
+    if (it == entries.end()) {
+        return false;
+    }
+    if (it->second->interest == interest) {
+        return true;
+    }
+    epoll_event ev{};
+    ev.events = toEpoll(interest);
+    ev.data.fd = handle;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, handle, &ev) != 0) {
+        return false;
+    }
+    it->second->interest = interest;
+    return true;
+}
+
+void Reactor::remove(sf::SocketHandle handle) {
+    if (entries.erase(handle) > 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, handle, nullptr);
+    }
+}
+
+int Reactor::runOnce(int timeoutMs) {
+    epoll_event events[MAX_EVENTS_PER_WAIT];
+    int ready = epoll_wait(epollFd, events, MAX_EVENTS_PER_WAIT, timeoutMs);
+    if (ready < 0) {
+        if (errno != EINTR) {
+            std::cerr << "Reactor: epoll_wait failed (errno " << errno << ")" << std::endl;
+        }
+        return runPosted();
+    }
+
+    int dispatched = 0;
+    for (int i = 0; i < ready; ++i) {
+        if (events[i].data.fd == wakeFd) {
+            std::uint64_t count;
+            while (::read(wakeFd, &count, sizeof(count)) > 0) {}
+            continue; // Posted tasks run below
+        }
+        auto it = entries.find(events[i].data.fd);
+        if (it == entries.end()) {
+            continue; // Removed by an earlier callback in this batch
+        }
+        // Hold a reference so the handler survives remove() from inside itself
+        std::shared_ptr<Entry> entry = it->second;
+        entry->handler(fromEpoll(events[i].events));
+        ++dispatched;
+    }
+    return dispatched + runPosted();
+}
+
+#else // poll()/WSAPoll fallback
+
+#if defined(_WIN32)
+    #define BAYOU_POLL WSAPoll
+    using PollFd = WSAPOLLFD;
+#else
+    #define BAYOU_POLL ::poll
+    using PollFd = pollfd;
+#endif
+
+#if defined(_WIN32)
+namespace {
+    // Connect a pair of loopback TCP sockets: [0] to read, [1] to write. There is no pipe or
+    // eventfd WSAPoll can wait on, so a byte sent over this pair is what interrupts a wait.
+    bool makeWakePair(SOCKET pair[2]) {
+        SOCKET listener = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listener == INVALID_SOCKET) {
+            return false;
+        }
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0; // Any free port
+        int length = sizeof(address);
+        bool listening = ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                         ::listen(listener, 1) == 0 &&
+                         ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0;
+
+        SOCKET writer = listening ? ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP) : INVALID_SOCKET;
+        bool connected = writer != INVALID_SOCKET &&
+                         ::connect(writer, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        SOCKET reader = connected ? ::accept(listener, nullptr, nullptr) : INVALID_SOCKET;
+        ::closesocket(listener);
+        if (reader == INVALID_SOCKET) {
+            if (writer != INVALID_SOCKET) {
+                ::closesocket(writer);
+            }
+            return false;
+        }
+
+        u_long nonBlocking = 1;
+        ::ioctlsocket(reader, FIONBIO, &nonBlocking);
+        ::ioctlsocket(writer, FIONBIO, &nonBlocking);
+        BOOL noDelay = TRUE; // A one-byte wake must not sit in Nagle's buffer
+        ::setsockopt(writer, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        pair[0] = reader;
+        pair[1] = writer;
+        return true;
+    }
+}
+
+Reactor::Reactor() : running(false) {
+    wakeSockets[0] = wakeSockets[1] = INVALID_SOCKET;
+    WSADATA data;
+    if (::WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        std::cerr << "Reactor: WSAStartup failed" << std::endl;
+        return;
+    }
+    if (!makeWakePair(wakeSockets)) {
+        std::cerr << "Reactor: could not create wake sockets (error " << ::WSAGetLastError() << ")" << std::endl;
+    }
+}
+
+Reactor::~Reactor() {
+    for (sf::SocketHandle socket : wakeSockets) {
+        if (socket != INVALID_SOCKET) {
+            ::closesocket(socket);
+        }
+    }
+    ::WSACleanup();
+}
+
+bool Reactor::isValid() const {
+    return wakeSockets[0] != INVALID_SOCKET;
+}
+
+void Reactor::wake() {
+    char byte = 0;
+    ::send(wakeSockets[1], &byte, 1, 0); // WSAEWOULDBLOCK means unread wakes are already queued
+}
+#else
+Reactor::Reactor() : running(false) {
+    if (::pipe(wakePipe) != 0) {
+        wakePipe[0] = wakePipe[1] = -1;
+        std::cerr << "Reactor: pipe failed (errno " << errno << ")" << std::endl;
+        return;
+    }
+    for (int fd : wakePipe) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+Reactor::~Reactor() {
+    for (int fd : wakePipe) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool Reactor::isValid() const {
+    return wakePipe[0] >= 0;
+}
+
+void Reactor::wake() {
+    char byte = 0;
+    ssize_t written = ::write(wakePipe[1], &byte, 1);
+    (void)written; // A full pipe is already readable
+}
+#endif
+
+bool Reactor::add(sf::SocketHandle handle, unsigned interest, Handler handler) {
+    entries[handle] = std::make_shared<Entry>(Entry{handle, interest, std::move(handler)});
+    return true;
+}
+
+bool Reactor::modify(sf::SocketHandle handle, unsigned interest) {
+    auto it = entries.find(handle);
+    if (it == entries.end()) {
+        return false;
+    }
+    it->second->interest = interest;
+    return true;
+}
+
+void Reactor::remove(sf::SocketHandle handle) {
+    entries.erase(handle);
+}
+
+int Reactor::runOnce(int timeoutMs) {
+    std::vector<PollFd> fds;
+    fds.reserve(entries.size() + 1);
+#if defined(_WIN32)
+    const sf::SocketHandle wakeHandle = wakeSockets[0];
+#else
+    const int wakeHandle = wakePipe[0];
+#endif
+    {
+        PollFd pfd{};
+        pfd.fd = wakeHandle;
+        pfd.events = POLLIN;
+        fds.push_back(pfd);
+    }
+    for (const auto& pair : entries) {
+        PollFd pfd{};
+        pfd.fd = pair.first;
+        if (pair.second->interest & Readable) pfd.events |= POLLIN;
+        if (pair.second->interest & Writable) pfd.events |= POLLOUT;
+        fds.push_back(pfd);
+    }
+
+    int ready = BAYOU_POLL(fds.data(), static_cast<unsigned long>(fds.size()), timeoutMs);
+    if (ready <= 0) {
+        return runPosted();
+    }
+
+    int dispatched = 0;
+    for (const auto& pfd : fds) {
+        if (pfd.revents == 0) {
+            continue;
+        }
+        if (pfd.fd == wakeHandle) {
+            char buffer[64];
+#if defined(_WIN32)
+            while (::recv(wakeHandle, buffer, static_cast<int>(sizeof(buffer)), 0) > 0) {}
+#else
+            while (::read(wakeHandle, buffer, sizeof(buffer)) > 0) {}
+#endif
+            continue; // Posted tasks run below
+        }
+        auto it = entries.find(pfd.fd);
+        if (it == entries.end()) {
+            continue;
+        }
+        unsigned events = 0;
+        if (pfd.revents & POLLIN) events |= Readable;
+        if (pfd.revents & POLLOUT) events |= Writable;
+        if (pfd.revents & (POLLHUP | POLLERR)) events |= Hangup | Readable;
+        std::shared_ptr<Entry> entry = it->second;
+        entry->handler(events);
+        if (++dispatched >= MAX_EVENTS_PER_WAIT) {
+            break;
+        }
+    }
+    return dispatched + runPosted();
+}
+
+#endif
+
+void Reactor::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(postMutex);
+        posted.push_back(std::move(task));
+    }
+    wake();
+}
+
+int Reactor::runPosted() {
+    std::vector<Task> batch;
+    {
+        std::lock_guard<std::mutex> lock(postMutex);
+        batch.swap(posted);
+    }
+    for (auto& task : batch) {
+        task();
+    }
+    return static_cast<int>(batch.size()) + timerWheel.advance(TimerWheel::Clock::now());
+}
+
+void Reactor::run() {
+    running = true;
+    while (running) {
+        runOnce(timerWheel.millisecondsUntilNextEvent(TimerWheel::Clock::now()));
+    }
+}
+
+void Reactor::stop() {
+    running = false;
+    wake();
+}
+
+std::size_t Reactor::size() const {
+    return entries.size();
+}
+
+TimerWheel& Reactor::timers() {
+    return timerWheel;
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,215 @@
+#include "SessionDirectory.h"
+#include "Reactor.h"
+#include "UnixChannel.h"
+#include <SFML/Network/Packet.hpp>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace BayouBonanza {
+
+LocalDirectory::LocalDirectory(Reactor& reactor, Matchmaker::Config config, std::chrono::milliseconds tick)
+    : reactor(reactor), matchmaker(config), tick(tick) {}
+
+void LocalDirectory::lookupOwner(const std::string&, OwnerCallback callback) {
+    // Nothing is ever claimed: every game is hosted here
+    callback(-1);
+}
+
+void LocalDirectory::enqueue(TicketId ticket, int rating) {
+    matchmaker.enqueue(ticket, rating, Matchmaker::Clock::now());
+}
+
+void LocalDirectory::dequeue(TicketId ticket) {
+    matchmaker.remove(ticket);
+}
+
+void LocalDirectory::start() {
+    reactor.timers().schedule(tick, [this]() { runTick(); });
+}
+
+void LocalDirectory::runTick() {
+    for (const Matchmaker::Pairing& pairing : matchmaker.pairBatch(Matchmaker::Clock::now())) {
+        if (handlers.match) {
+            handlers.match(pairing.first, pairing.second);
+        }
+    }
+    reactor.timers().schedule(tick, [this]() { runTick(); });
+}
+
+#if !defined(_WIN32)
+
+namespace {
+
+sf::Packet makeMessage(DirectoryMessage type) {
+    sf::Packet packet;
+    packet << static_cast<sf::Uint8>(type);
+    return packet;
+}
+
+} // namespace
+
+RemoteDirectory::RemoteDirectory(Reactor& reactor, std::unique_ptr<UnixChannel> channel, int index,
+                                 std::function<void()> onClosed)
+    : reactor(reactor), channel(std::move(channel)), index(index), onClosed(std::move(onClosed)), nextRequest(1) {}
+
+RemoteDirectory::~RemoteDirectory() {
+    if (channel) {
+        reactor.remove(channel->handle());
+    }
+}
+
+std::unique_ptr<RemoteDirectory> RemoteDirectory::connect(Reactor& reactor, const std::string& path, int index,
+                                                          std::function<void()> onClosed) {
+    std::unique_ptr<UnixChannel> channel = UnixChannel::connect(path);
+    if (!channel) {
+        return nullptr;
+    }
+    std::unique_ptr<RemoteDirectory> directory(
+        new RemoteDirectory(reactor, std::move(channel), index, std::move(onClosed)));
+
+    sf::Packet hello = makeMessage(DirectoryMessage::Hello);
+    hello << sf::Int32(index);
+    RemoteDirectory* raw = directory.get();
+    if (!directory->channel->send(hello) ||
+        !reactor.add(directory->channel->handle(), Reactor::Readable, [raw](unsigned) { raw->onReadable(); })) {
+        return nullptr;
+    }
+    return directory;
+}
+
+void RemoteDirectory::claim(const std::string& username) {
+    if (!channel) return;
+    sf::Packet packet = makeMessage(DirectoryMessage::Claim);
+    packet << username;
+    channel->send(packet);
+}
+
+void RemoteDirectory::release(const std::string& username) {
+    if (!channel) return;
+    sf::Packet packet = makeMessage(DirectoryMessage::Release);
+    packet << username;
+    channel->send(packet);
+}
+
+void RemoteDirectory::lookupOwner(const std::string& username, OwnerCallback callback) {
+    if (!channel) {
+        callback(-1);
+        return;
+    }
+    sf::Uint32 request = nextRequest++;
+    sf::Packet packet = makeMessage(DirectoryMessage::Lookup);
+    packet << request << username;
+    pendingLookups.emplace(request, std::move(callback));
+    channel->send(packet);
+}
+
+void RemoteDirectory::enqueue(TicketId ticket, int rating) {
+    if (!channel) return;
+    sf::Packet packet = makeMessage(DirectoryMessage::Enqueue);
+    packet << sf::Uint64(ticket) << sf::Int32(rating);
+    channel->send(packet);
+}
+
+void RemoteDirectory::dequeue(TicketId ticket) {
+    if (!channel) return;
+    sf::Packet packet = makeMessage(DirectoryMessage::Dequeue);
+    packet << sf::Uint64(ticket);
+    channel->send(packet);
+}
+
+bool RemoteDirectory::handoff(int fd, int target, const std::string& username, TicketId peer, int peerRating,
+                              sf::Uint32 capabilities) {
+    if (!channel) return false;
+    sf::Packet packet = makeMessage(DirectoryMessage::Handoff);
+    packet << sf::Int32(target) << username << sf::Uint64(peer) << sf::Int32(peerRating) << capabilities;
+    return channel->send(packet, fd);
+}
+
+void RemoteDirectory::migrationFailed(int target, TicketId peer, int peerRating) {
+    if (!channel) return;
+    sf::Packet packet = makeMessage(DirectoryMessage::MigrationFailed);
+    packet << sf::Int32(target) << sf::Uint64(peer) << sf::Int32(peerRating);
+    channel->send(packet);
+}
+
+void RemoteDirectory::onReadable() {
+    sf::Packet packet;
+    UnixChannel::ReadResult result = UnixChannel::ReadResult::WouldBlock;
+    while (channel && (result = channel->receive(packet)) == UnixChannel::ReadResult::Message) {
+        sf::Uint8 rawType;
+        if (!(packet >> rawType)) {
+            continue;
+        }
+        switch (static_cast<DirectoryMessage>(rawType)) {
+            case DirectoryMessage::LookupResult: {
+                sf::Uint32 request;
+                sf::Int32 owner;
+                if (packet >> request >> owner) {
+                    auto it = pendingLookups.find(request);
+                    if (it != pendingLookups.end()) {
+                        OwnerCallback callback = std::move(it->second);
+                        pendingLookups.erase(it);
+                        callback(owner);
+                    }
+                }
+                break;
+            }
+            case DirectoryMessage::Match: {
+                sf::Uint64 first, second;
+                if ((packet >> first >> second) && handlers.match) {
+                    handlers.match(first, second);
+                }
+                break;
+            }
+            case DirectoryMessage::Migrate: {
+                sf::Uint64 ticket, peer;
+                sf::Int32 target, peerRating;
+                if ((packet >> ticket >> target >> peer >> peerRating) && handlers.migrate) {
+                    handlers.migrate(ticket, target, peer, peerRating);
+                }
+                break;
+            }
+            case DirectoryMessage::Adopt: {
+                int fd = channel->takeDescriptor();
+                std::string username;
+                sf::Uint64 peer;
+                sf::Uint32 capabilities;
+                if (fd >= 0 && (packet >> username >> peer >> capabilities) && handlers.adopt) {
+                    handlers.adopt(fd, username, peer, capabilities);
+                } else if (fd >= 0) {
+                    ::close(fd);
+                }
+                break;
+            }
+            default:
+                std::cerr << "Directory: unexpected message type " << static_cast<int>(rawType) << std::endl;
+                break;
+        }
+    }
+    if (channel && result == UnixChannel::ReadResult::Closed) {
+        close();
+    }
+}
+
+void RemoteDirectory::close() {
+    std::cerr << "Directory connection lost" << std::endl;
+    reactor.remove(channel->handle());
+    channel.reset();
+
+    // Nobody will answer these any more; treat the users as having no remote game
+    auto lookups = std::move(pendingLookups);
+    pendingLookups.clear();
+    for (auto& entry : lookups) {
+        entry.second(-1);
+    }
+    if (onClosed) {
+        onClosed();
+    }
+}
+
+#endif
+
+} // namespace BayouBonanza
@@ -0,0 +1,89 @@
+#include "SessionStrand.h"
+#include <algorithm>
+#include <chrono>
+
+namespace BayouBonanza {
+
+namespace {
+    // Strand whose task is running on the current thread, if any
+    thread_local const SessionStrand* currentStrand = nullptr;
+}
+
+std::shared_ptr<SessionStrand> SessionStrand::create(WorkerPool& pool) {
+    return std::shared_ptr<SessionStrand>(new SessionStrand(pool));
+}
+
+SessionStrand::SessionStrand(WorkerPool& pool) : pool(pool), scheduled(false) {}
+
+void SessionStrand::post(Task task) {
+    bool needsSchedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        mailbox.push_back(std::move(task));
+        counters.maxQueueDepth = std::max(counters.maxQueueDepth, mailbox.size());
+        if (!scheduled) {
+            scheduled = true;
+            needsSchedule = true;
+        }
+    }
+    if (needsSchedule) {
+        auto self = shared_from_this();
+        pool.submit([self] { self->drain(); });
+    }
+}
+
+bool SessionStrand::isCurrent() const {
+    return currentStrand == this;
+}
+
+SessionStrand::Stats SessionStrand::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats s = counters;
+    s.queueDepth = mailbox.size();
+    return s;
+}
+
+void SessionStrand::drain() {
+    const SessionStrand* previous = currentStrand;
+    currentStrand = this;
+
+    for (std::size_t i = 0; i < MAX_TASKS_PER_DRAIN; ++i) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (mailbox.empty()) {
+                scheduled = false;
+                currentStrand = previous;
+                return;
+            }
+            task = std::move(mailbox.front());
+            mailbox.pop_front();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        task();
+        auto elapsed = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.tasksRun++;
+        counters.totalRunNanos += elapsed;
+        counters.maxRunNanos = std::max(counters.maxRunNanos, elapsed);
+    }
+
+    currentStrand = previous;
+
+    // Batch exhausted: requeue behind other sessions instead of hogging the worker
+    bool more;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        more = !mailbox.empty();
+        scheduled = more;
+    }
+    if (more) {
+        auto self = shared_from_this();
+        pool.submit([self] { self->drain(); }, false);
+    }
+}
+
+} // namespace BayouBonanza
@@ -2,6 +2,7 @@
 #include "PlayerSide.h"   // Explicitly include for packet operators
 #include "Piece.h"        // For std::unique_ptr<Piece>, PlayerSide
 #include "PieceFactory.h" // For PieceFactory
+#include "Zobrist.h"
 #include <SFML/Network/Packet.hpp> // For sf::Packet
 #include <iostream> // For std::cerr
 
@@ -17,6 +18,21 @@ Square::Square() :
     currentController(PlayerSide::NEUTRAL) {
 }
 
+Square::Square(Square&& other) noexcept : Square() {
+    *this = std::move(other);
+}
+
+Square& Square::operator=(Square&& other) noexcept {
+    if (this != &other) {
+        // Through the setters, so both squares' board hashes stay current
+        setPiece(other.extractPiece());
+        setControlValue(PlayerSide::PLAYER_ONE, other.controlValuePlayer1);
+        setControlValue(PlayerSide::PLAYER_TWO, other.controlValuePlayer2);
+        setControlledBy(other.currentController);
+    }
+    return *this;
+}
+
 bool Square::isEmpty() const {
     return piece == nullptr;
 }
@@ -26,10 +42,19 @@ Piece* Square::getPiece() const { // Changed return type
 }
 
 void Square::setPiece(std::unique_ptr<Piece> p) { // Changed parameter type
+    if (piece) {
+        piece->attachHash(nullptr, 0);
+    }
     this->piece = std::move(p);
+    if (piece) {
+        piece->attachHash(hashSink, hashSlot);
+    }
 }
 
 std::unique_ptr<Piece> Square::extractPiece() {
+    if (piece) {
+        piece->attachHash(nullptr, 0);
+    }
     return std::move(piece); // Transfers ownership, automatically sets piece to nullptr
 }
 
@@ -43,12 +68,14 @@ int Square::getControlValue(PlayerSide side) const {
 }
 
 void Square::setControlValue(PlayerSide side, int value) {
+    std::uint64_t keyBefore = controlKey();
     if (side == PlayerSide::PLAYER_ONE) {
         controlValuePlayer1 = value;
     } else if (side == PlayerSide::PLAYER_TWO) {
         controlValuePlayer2 = value;
     }
     // NEUTRAL side is ignored for setting control
+    rehashControl(keyBefore);
 }
 
 PlayerSide Square::getControlledBy() const {
@@ -56,7 +83,9 @@ PlayerSide Square::getControlledBy() const {
 }
 
 void Square::setControlledBy(PlayerSide controller) {
+    std::uint64_t keyBefore = controlKey();
     currentController = controller;
+    rehashControl(keyBefore);
 }
 
 void Square::updateControlFromInfluence() {
@@ -64,6 +93,7 @@ void Square::updateControlFromInfluence() {
     // 1. If no one has ever controlled this square, highest influence wins
     // 2. If someone controls it, they keep it unless another player has MORE influence
     // 3. Ties go to the current controller
+    std::uint64_t keyBefore = controlKey();
     
     if (currentController == PlayerSide::NEUTRAL) {
         // No one has ever controlled this square - highest influence wins
@@ -88,14 +118,43 @@ void Square::updateControlFromInfluence() {
         }
         // Player Two retains control in all other cases (including ties)
     }
+    rehashControl(keyBefore);
 }
 
 void Square::setGlobalPieceFactory(PieceFactory* factory) {
     globalPieceFactory = factory;
 }
 
-// SFML Packet operators for Square
-sf::Packet& operator<<(sf::Packet& packet, const Square& sq) {
+void Square::attachHash(std::uint64_t* sink, std::uint64_t slot) {
+    if (hashSink) {
+        *hashSink ^= controlKey();
+    }
+    hashSink = sink;
+    hashSlot = slot;
+    if (hashSink) {
+        *hashSink ^= controlKey();
+    }
+    if (piece) {
+        piece->attachHash(hashSink, hashSlot);
+    }
+}
+
+std::uint64_t Square::controlKey() const {
+    using Zobrist::Feature;
+    return Zobrist::key(Feature::ControlOne, hashSlot, controlValuePlayer1) ^
+           Zobrist::key(Feature::ControlTwo, hashSlot, controlValuePlayer2) ^
+           Zobrist::key(Feature::Controller, hashSlot, static_cast<int>(currentController));
+}
+
+void Square::rehashControl(std::uint64_t keyBefore) {
+    if (hashSink) {
+        *hashSink ^= keyBefore ^ controlKey();
+    }
+}
+
+// Packet operators for Square
+template <WritablePacket Packet>
+Packet& operator<<(Packet& packet, const Square& sq) {
     bool hasPiece = (sq.getPiece() != nullptr);
     packet << hasPiece;
 
@@ -105,7 +164,7 @@ sf::Packet& operator<<(sf::Packet& packet, const Square& sq) {
         // It's crucial that PlayerSide is already handled for sf::Packet
         // and that Piece::operator<< only handles common data (excluding side and typeName).
         packet << currentPiece->getSide();           // Serialize PlayerSide enum
-        packet << currentPiece->getTypeName();     // Serialize typeName string
+        packet << currentPiece->getTypeId();       // Serialize one-byte piece type ID
         packet << (*currentPiece);                 // Serialize common Piece data
     }
 
@@ -116,42 +175,35 @@ sf::Packet& operator<<(sf::Packet& packet, const Square& sq) {
 }
 
 // Updated operator>> 
-sf::Packet& operator>>(sf::Packet& packet, Square& sq) {
+template <ReadablePacket Packet>
+Packet& operator>>(Packet& packet, Square& sq) {
     bool hasPiece;
     packet >> hasPiece;
 
     if (hasPiece) {
         PlayerSide side;
-        std::string typeName; 
+        PieceTypeId typeId;
         packet >> side;      // Deserialize PlayerSide enum
-        packet >> typeName;  // Deserialize typeName string
+        packet >> typeId;    // Deserialize one-byte piece type ID
 
         // Use static globalPieceFactory to recreate the piece
+        std::unique_ptr<Piece> piece;
         if (Square::globalPieceFactory) {
-            std::unique_ptr<Piece> piece = Square::globalPieceFactory->createPiece(typeName, side);
-            if (piece) {
-                // Deserialize the piece data
-                packet >> (*piece);
-                sq.setPiece(std::move(piece));
-            } else {
-                std::cerr << "Error: Failed to create piece of type '" << typeName << "'" << std::endl;
-                sq.setPiece(nullptr);
-                // Skip the piece data in the packet to avoid misalignment
-                std::string dummySymbol;
-                Position dummyPosition;
-                sf::Int32 dummyHealth, dummyAttack;
-                bool dummyHasMoved;
-                packet >> dummySymbol >> dummyPosition >> dummyHealth >> dummyAttack >> dummyHasMoved;
-            }
+            piece = Square::globalPieceFactory->createPiece(typeId, side);
         } else {
             std::cerr << "Error: Global PieceFactory not available for deserialization" << std::endl;
+        }
+        if (piece) {
+            // Deserialize the piece data
+            packet >> (*piece);
+            sq.setPiece(std::move(piece));
+        } else {
             sq.setPiece(nullptr);
             // Skip the piece data in the packet to avoid misalignment
-            std::string dummySymbol;
             Position dummyPosition;
-            sf::Int32 dummyHealth, dummyAttack;
+            sf::Int32 dummyHealth, dummyAttack, dummyStun;
             bool dummyHasMoved;
-            packet >> dummySymbol >> dummyPosition >> dummyHealth >> dummyAttack >> dummyHasMoved;
+            packet >> dummyPosition >> dummyHealth >> dummyAttack >> dummyHasMoved >> dummyStun;
         }
     } else {
         sq.setPiece(nullptr);
@@ -170,4 +222,10 @@ sf::Packet& operator>>(sf::Packet& packet, Square& sq) {
     return packet;
 }
 
+// The serializers are only used with these streams
+template sf::Packet& operator<<(sf::Packet& packet, const Square& value);
+template sf::Packet& operator>>(sf::Packet& packet, Square& value);
+template WireWriter& operator<<(WireWriter& packet, const Square& value);
+template WireReader& operator>>(WireReader& packet, Square& value);
+
 } // namespace BayouBonanza
@@ -0,0 +1,209 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+namespace BayouBonanza {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, Clock::time_point start)
+    : freeList(NONE), currentTick(0), pendingCount(0),
+      tick(std::max(tick, std::chrono::milliseconds(1))), start(start) {
+    // Sentinels for every slot plus the list of timers being fired
+    nodes.resize(SLOT_COUNT + 1);
+    for (std::uint32_t i = 0; i <= SLOT_COUNT; ++i) {
+        nodes[i].prev = i;
+        nodes[i].next = i;
+    }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::milliseconds delay, Callback callback) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    std::uint64_t nowTick = static_cast<std::uint64_t>(std::max<std::int64_t>(0, elapsed.count() / tick.count()));
+    std::uint64_t delayTicks = static_cast<std::uint64_t>(
+        std::max<std::int64_t>(0, (delay.count() + tick.count() - 1) / tick.count()));
+
+    std::uint32_t index = allocate();
+    Node& node = nodes[index];
+    node.expires = std::max(nowTick, currentTick) + std::min(delayTicks, MAX_TICKS);
+    node.callback = std::move(callback);
+    node.pending = true;
+    file(index);
+    ++pendingCount;
+    return (static_cast<TimerId>(node.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::uint32_t index = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+    if (index <= SLOT_COUNT || index >= nodes.size()) {
+        return false;
+    }
+    Node& node = nodes[index];
+    if (!node.pending || node.generation != generation) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    --pendingCount;
+    return true;
+}
+
+int TimerWheel::advance(Clock::time_point now) {
+    if (now < start) {
+        return 0;
+    }
+    std::uint64_t nowTick = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() / tick.count());
+
+    int fired = 0;
+    while (currentTick <= nowTick) {
+        if (pendingCount == 0) {
+            currentTick = nowTick + 1; // Nothing filed anywhere; skip the idle ticks
+            break;
+        }
+        fired += runTick();
+    }
+    return fired;
+}
+
+int TimerWheel::millisecondsUntilNextEvent(Clock::time_point now) const {
+    if (pendingCount == 0) {
+        return -1;
+    }
+
+    // The next tick worth waking for is either a populated root slot or the
+    // next cascade, whichever comes first in the current root rotation
+    std::uint64_t next = currentTick;
+    if ((next & (ROOT_SLOTS - 1)) != 0) {
+        do {
+            std::uint32_t sentinel = slotSentinel(0, static_cast<std::uint32_t>(next & (ROOT_SLOTS - 1)));
+            if (nodes[sentinel].next != sentinel) {
+                break;
+            }
+            ++next;
+        } while ((next & (ROOT_SLOTS - 1)) != 0);
+    }
+
+    auto deadline = start + tick * static_cast<std::int64_t>(next);
+    if (deadline <= now) {
+        return 0;
+    }
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+    if (wait < deadline - now) {
+        wait += std::chrono::milliseconds(1); // Round up so we never wake just before the tick
+    }
+    return static_cast<int>(std::min<std::int64_t>(wait.count(), 0x7FFFFFFF));
+}
+
+std::size_t TimerWheel::size() const {
+    return pendingCount;
+}
+
+std::uint32_t TimerWheel::slotSentinel(unsigned level, std::uint32_t slot) {
+    return level == 0 ? slot : ROOT_SLOTS + (level - 1) * LEVEL_SLOTS + slot;
+}
+
+std::uint32_t TimerWheel::allocate() {
+    if (freeList != NONE) {
+        std::uint32_t index = freeList;
+        freeList = nodes[index].next;
+        return index;
+    }
+    nodes.emplace_back();
+    return static_cast<std::uint32_t>(nodes.size() - 1);
+}
+
+void TimerWheel::release(std::uint32_t index) {
+    Node& node = nodes[index];
+    node.pending = false;
+    node.callback = nullptr;
+    if (++node.generation == 0) {
+        node.generation = 1; // Keep ids non-zero after wrap-around
+    }
+    node.prev = NONE;
+    node.next = freeList;
+    freeList = index;
+}
+
+void TimerWheel::link(std::uint32_t sentinel, std::uint32_t index) {
+    std::uint32_t last = nodes[sentinel].prev;
+    nodes[index].prev = last;
+    nodes[index].next = sentinel;
+    nodes[last].next = index;
+    nodes[sentinel].prev = index;
+}
+
+void TimerWheel::unlink(std::uint32_t index) {
+    std::uint32_t prev = nodes[index].prev;
+    std::uint32_t next = nodes[index].next;
+    nodes[prev].next = next;
+    nodes[next].prev = prev;
+}
+
+void TimerWheel::file(std::uint32_t index) {
+    std::uint64_t expires = std::max(nodes[index].expires, currentTick);
+    std::uint64_t delta = expires - currentTick;
+
+    std::uint32_t sentinel;
+    if (delta < (1ull << ROOT_BITS)) {
+        sentinel = slotSentinel(0, static_cast<std::uint32_t>(expires & (ROOT_SLOTS - 1)));
+    } else {
+        unsigned level = 1;
+        while (level < LEVELS - 1 && delta >= (1ull << (ROOT_BITS + level * LEVEL_BITS))) {
+            ++level;
+        }
+        unsigned shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+        sentinel = slotSentinel(level, static_cast<std::uint32_t>((expires >> shift) & (LEVEL_SLOTS - 1)));
+    }
+    link(sentinel, index);
+}
+
+void TimerWheel::cascade(unsigned level) {
+    unsigned shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+    std::uint32_t sentinel = slotSentinel(level, static_cast<std::uint32_t>((currentTick >> shift) & (LEVEL_SLOTS - 1)));
+    while (nodes[sentinel].next != sentinel) {
+        std::uint32_t index = nodes[sentinel].next;
+        unlink(index);
+        file(index); // Lands in a finer level now that its expiry is closer
+    }
+}
+
+int TimerWheel::runTick() {
+    std::uint32_t rootIndex = static_cast<std::uint32_t>(currentTick & (ROOT_SLOTS - 1));
+    if (rootIndex == 0) {
+        for (unsigned level = 1; level < LEVELS; ++level) {
+            cascade(level);
+            unsigned shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+            if (((currentTick >> shift) & (LEVEL_SLOTS - 1)) != 0) {
+                break;
+            }
+        }
+    }
+
+    // Move the due slot onto the firing list so callbacks can freely schedule and cancel
+    std::uint32_t slot = slotSentinel(0, rootIndex);
+    std::uint32_t firing = firingSentinel();
+    if (nodes[slot].next != slot) {
+        std::uint32_t first = nodes[slot].next;
+        std::uint32_t last = nodes[slot].prev;
+        nodes[firing].next = first;
+        nodes[first].prev = firing;
+        nodes[firing].prev = last;
+        nodes[last].next = firing;
+        nodes[slot].next = slot;
+        nodes[slot].prev = slot;
+    }
+    ++currentTick;
+
+    int fired = 0;
+    while (nodes[firing].next != firing) {
+        std::uint32_t index = nodes[firing].next;
+        unlink(index);
+        Callback callback = std::move(nodes[index].callback);
+        release(index);
+        --pendingCount;
+        callback();
+        ++fired;
+    }
+    return fired;
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,222 @@
+#include "UnixChannel.h"
+
+#if !defined(_WIN32)
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace BayouBonanza {
+
+namespace {
+
+const std::size_t HEADER_SIZE = 4;
+const std::size_t MAX_FRAME_SIZE = 1 << 20;
+const std::size_t READ_CHUNK = 4096;
+
+bool fillAddress(const std::string& path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+} // namespace
+
+UnixChannel::UnixChannel(int fd) : fd(fd), closed(false) {}
+
+UnixChannel::~UnixChannel() {
+    for (int descriptor : descriptors) {
+        ::close(descriptor);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+std::unique_ptr<UnixChannel> UnixChannel::connect(const std::string& path) {
+    sockaddr_un address;
+    if (!fillAddress(path, address)) {
+        return nullptr;
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    return std::make_unique<UnixChannel>(fd);
+}
+
+int UnixChannel::listen(const std::string& path) {
+    sockaddr_un address;
+    if (!fillAddress(path, address)) {
+        return -1;
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    ::unlink(path.c_str()); // Left behind by a previous run
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK); // Accepts are driven by readiness
+    return fd;
+}
+
+bool UnixChannel::send(const sf::Packet& packet, int attachedFd) {
+    if (closed) {
+        return false;
+    }
+
+    std::size_t size = packet.getDataSize();
+    std::vector<char> frame(HEADER_SIZE + size);
+    frame[0] = static_cast<char>((size >> 24) & 0xFF);
+    frame[1] = static_cast<char>((size >> 16) & 0xFF);
+    frame[2] = static_cast<char>((size >> 8) & 0xFF);
+    frame[3] = static_cast<char>(size & 0xFF);
+    if (size > 0) {
+        std::memcpy(frame.data() + HEADER_SIZE, packet.getData(), size);
+    }
+
+    std::size_t sent = 0;
+    while (sent < frame.size()) {
+        iovec chunk;
+        chunk.iov_base = frame.data() + sent;
+        chunk.iov_len = frame.size() - sent;
+
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = &chunk;
+        message.msg_iovlen = 1;
+
+        // The descriptor rides on the first byte of the frame
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+        if (sent == 0 && attachedFd >= 0) {
+            std::memset(control, 0, sizeof(control));
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            cmsghdr* header = CMSG_FIRSTHDR(&message);
+            header->cmsg_level = SOL_SOCKET;
+            header->cmsg_type = SCM_RIGHTS;
+            header->cmsg_len = CMSG_LEN(sizeof(int));
+            std::memcpy(CMSG_DATA(header), &attachedFd, sizeof(int));
+        }
+
+#if defined(MSG_NOSIGNAL)
+        ssize_t written = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+#else
+        ssize_t written = ::sendmsg(fd, &message, 0);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            closed = true;
+            return false;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+UnixChannel::ReadResult UnixChannel::receive(sf::Packet& packet) {
+    while (true) {
+        if (readBuffer.size() >= HEADER_SIZE) {
+            std::size_t size = (static_cast<std::size_t>(static_cast<unsigned char>(readBuffer[0])) << 24) |
+                               (static_cast<std::size_t>(static_cast<unsigned char>(readBuffer[1])) << 16) |
+                               (static_cast<std::size_t>(static_cast<unsigned char>(readBuffer[2])) << 8) |
+                               static_cast<std::size_t>(static_cast<unsigned char>(readBuffer[3]));
+            if (size > MAX_FRAME_SIZE) {
+                closed = true;
+                return ReadResult::Closed;
+            }
+            if (readBuffer.size() >= HEADER_SIZE + size) {
+                packet.clear();
+                if (size > 0) {
+                    packet.append(readBuffer.data() + HEADER_SIZE, size);
+                }
+                readBuffer.erase(readBuffer.begin(), readBuffer.begin() + static_cast<std::ptrdiff_t>(HEADER_SIZE + size));
+                return ReadResult::Message;
+            }
+        }
+        if (closed) {
+            return ReadResult::Closed;
+        }
+        if (!fill()) {
+            return closed ? ReadResult::Closed : ReadResult::WouldBlock;
+        }
+    }
+}
+
+int UnixChannel::takeDescriptor() {
+    if (descriptors.empty()) {
+        return -1;
+    }
+    int descriptor = descriptors.front();
+    descriptors.pop_front();
+    return descriptor;
+}
+
+bool UnixChannel::fill() {
+    char data[READ_CHUNK];
+    iovec chunk;
+    chunk.iov_base = data;
+    chunk.iov_len = sizeof(data);
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 8)];
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = &chunk;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+#if defined(MSG_CMSG_CLOEXEC)
+        received = ::recvmsg(fd, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+#else
+        received = ::recvmsg(fd, &message, MSG_DONTWAIT);
+#endif
+    } while (received < 0 && errno == EINTR);
+
+    if (received < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            closed = true;
+        }
+        return false;
+    }
+
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+            std::size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (std::size_t i = 0; i < count; ++i) {
+                int descriptor;
+                std::memcpy(&descriptor, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+                descriptors.push_back(descriptor);
+            }
+        }
+    }
+
+    if (received == 0) {
+        closed = true;
+        return false;
+    }
+    readBuffer.insert(readBuffer.end(), data, data + received);
+    return true;
+}
+
+} // namespace BayouBonanza
+
+#endif
@@ -0,0 +1,334 @@
+#include "WireFormat.h"
+#include <cstring>
+
+namespace BayouBonanza {
+
+namespace {
+
+// A 64-bit value needs at most ten 7-bit groups
+const int MAX_VARINT_BYTES = 10;
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace
+
+WireWriter::WireWriter(char* data, std::size_t capacity)
+    : buffer(data), limit(data ? capacity : 0), used(0), valid(true) {}
+
+char* WireWriter::reserve(std::size_t size) {
+    if (!valid || limit - used < size) {
+        valid = false;
+        return nullptr;
+    }
+    char* out = buffer + used;
+    used += size;
+    return out;
+}
+
+void WireWriter::clear() {
+    used = 0;
+    valid = true;
+}
+
+std::size_t WireWriter::varUintSize(std::uint64_t value) {
+    std::size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+void WireWriter::writeVarUint(std::uint64_t value) {
+    char* out = reserve(varUintSize(value));
+    if (!out) {
+        return;
+    }
+    while (value >= 0x80) {
+        *out++ = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    *out = static_cast<char>(value);
+}
+
+void WireWriter::writeVarInt(std::int64_t value) {
+    writeVarUint(zigzag(value));
+}
+
+void WireWriter::writeFixed32(std::uint32_t value) {
+    if (char* out = reserve(4)) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<char>(value >> (8 * i));
+        }
+    }
+}
+
+void WireWriter::writeFixed64(std::uint64_t value) {
+    if (char* out = reserve(8)) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<char>(value >> (8 * i));
+        }
+    }
+}
+
+void WireWriter::append(const void* data, std::size_t size) {
+    if (size == 0) {
+        return;
+    }
+    if (char* out = reserve(size)) {
+        std::memcpy(out, data, size);
+    }
+}
+
+WireWriter& WireWriter::operator<<(bool value) {
+    return *this << static_cast<sf::Uint8>(value ? 1 : 0);
+}
+
+WireWriter& WireWriter::operator<<(sf::Int8 value) {
+    return *this << static_cast<sf::Uint8>(value);
+}
+
+WireWriter& WireWriter::operator<<(sf::Uint8 value) {
+    if (char* out = reserve(1)) {
+        *out = static_cast<char>(value);
+    }
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(sf::Int16 value) {
+    return *this << static_cast<sf::Uint16>(value);
+}
+
+WireWriter& WireWriter::operator<<(sf::Uint16 value) {
+    if (char* out = reserve(2)) {
+        out[0] = static_cast<char>(value);
+        out[1] = static_cast<char>(value >> 8);
+    }
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(sf::Int32 value) {
+    writeVarInt(value);
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(sf::Uint32 value) {
+    writeVarUint(value);
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(sf::Int64 value) {
+    writeVarInt(value);
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(sf::Uint64 value) {
+    writeVarUint(value);
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeFixed32(bits);
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeFixed64(bits);
+    return *this;
+}
+
+WireWriter& WireWriter::operator<<(const char* value) {
+    return *this << std::string_view(value ? value : "");
+}
+
+WireWriter& WireWriter::operator<<(const std::string& value) {
+    return *this << std::string_view(value);
+}
+
+WireWriter& WireWriter::operator<<(std::string_view value) {
+    writeVarUint(value.size());
+    append(value.data(), value.size());
+    return *this;
+}
+
+WireReader::WireReader(const void* data, std::size_t size)
+    : position(static_cast<const char*>(data)), end(static_cast<const char*>(data) + (data ? size : 0)), valid(true) {}
+
+const char* WireReader::read(std::size_t size) {
+    if (!valid || static_cast<std::size_t>(end - position) < size) {
+        valid = false;
+        return nullptr;
+    }
+    const char* in = position;
+    position += size;
+    return in;
+}
+
+bool WireReader::readVarUint(std::uint64_t& value) {
+    std::uint64_t result = 0;
+    for (int i = 0; i < MAX_VARINT_BYTES; ++i) {
+        const char* in = read(1);
+        if (!in) {
+            return false;
+        }
+        auto byte = static_cast<unsigned char>(*in);
+        result |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            value = result;
+            return true;
+        }
+    }
+    valid = false;
+    return false;
+}
+
+bool WireReader::readVarInt(std::int64_t& value) {
+    std::uint64_t encoded;
+    if (!readVarUint(encoded)) {
+        return false;
+    }
+    value = unzigzag(encoded);
+    return true;
+}
+
+bool WireReader::readFixed32(std::uint32_t& value) {
+    const char* in = read(4);
+    if (!in) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return true;
+}
+
+bool WireReader::readFixed64(std::uint64_t& value) {
+    const char* in = read(8);
+    if (!in) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return true;
+}
+
+WireReader& WireReader::operator>>(bool& value) {
+    sf::Uint8 byte;
+    if (*this >> byte) {
+        value = byte != 0;
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Int8& value) {
+    sf::Uint8 byte;
+    if (*this >> byte) {
+        value = static_cast<sf::Int8>(byte);
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Uint8& value) {
+    if (const char* in = read(1)) {
+        value = static_cast<sf::Uint8>(*in);
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Int16& value) {
+    sf::Uint16 word;
+    if (*this >> word) {
+        value = static_cast<sf::Int16>(word);
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Uint16& value) {
+    if (const char* in = read(2)) {
+        value = static_cast<sf::Uint16>(static_cast<unsigned char>(in[0]) |
+                                        (static_cast<unsigned char>(in[1]) << 8));
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Int32& value) {
+    std::int64_t wide;
+    if (readVarInt(wide)) {
+        value = static_cast<sf::Int32>(wide);
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Uint32& value) {
+    std::uint64_t wide;
+    if (readVarUint(wide)) {
+        value = static_cast<sf::Uint32>(wide);
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Int64& value) {
+    std::int64_t wide;
+    if (readVarInt(wide)) {
+        value = wide;
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(sf::Uint64& value) {
+    std::uint64_t wide;
+    if (readVarUint(wide)) {
+        value = wide;
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(float& value) {
+    std::uint32_t bits;
+    if (readFixed32(bits)) {
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(double& value) {
+    std::uint64_t bits;
+    if (readFixed64(bits)) {
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(std::string& value) {
+    std::string_view view;
+    if (*this >> view) {
+        value.assign(view.data(), view.size());
+    }
+    return *this;
+}
+
+WireReader& WireReader::operator>>(std::string_view& value) {
+    std::uint64_t size;
+    if (!readVarUint(size) || size > remaining()) {
+        valid = false;
+        return *this;
+    }
+    const char* in = read(static_cast<std::size_t>(size));
+    value = std::string_view(in, static_cast<std::size_t>(size));
+    return *this;
+}
+
+} // namespace BayouBonanza
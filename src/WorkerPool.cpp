@@ -0,0 +1,134 @@
+#include "WorkerPool.h"
+
+namespace BayouBonanza {
+
+namespace {
+    // Identifies the pool and deque index of the current thread, if it is a worker
+    thread_local const WorkerPool* currentPool = nullptr;
+    thread_local std::size_t currentIndex = 0;
+}
+
+WorkerPool::WorkerPool(std::size_t threadCount)
+    : pending(0), nextQueue(0), executed(0), stolen(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            threadCount = 2;
+        }
+    }
+
+    queues.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+void WorkerPool::submit(Task task, bool preferLocal) {
+    std::size_t index;
+    if (preferLocal && currentPool == this) {
+        index = currentIndex; // Keep follow-up work local to the submitting worker
+    } else {
+        index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    // Count before publishing so pending never underflows when a worker pops immediately
+    pending.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders this notify after a sleeper's predicate check
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+}
+
+void WorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        if (stopping.exchange(true)) {
+            return;
+        }
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+std::size_t WorkerPool::threadCount() const {
+    return threads.size();
+}
+
+WorkerPool::Stats WorkerPool::stats() const {
+    Stats s;
+    s.threadCount = threads.size();
+    s.pending = pending.load(std::memory_order_relaxed);
+    s.executed = executed.load(std::memory_order_relaxed);
+    s.stolen = stolen.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool WorkerPool::popLocal(std::size_t index, Task& out) {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    auto& tasks = queues[index]->tasks;
+    if (tasks.empty()) {
+        return false;
+    }
+    out = std::move(tasks.back());
+    tasks.pop_back();
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool WorkerPool::steal(std::size_t thief, Task& out) {
+    for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+        std::size_t victim = (thief + offset) % queues.size();
+        std::lock_guard<std::mutex> lock(queues[victim]->mutex);
+        auto& tasks = queues[victim]->tasks;
+        if (!tasks.empty()) {
+            out = std::move(tasks.front());
+            tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+            stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkerPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            task();
+            executed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] {
+            return pending.load(std::memory_order_acquire) > 0 || stopping.load();
+        });
+        if (stopping.load() && pending.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+    }
+
+    currentPool = nullptr;
+}
+
+} // namespace BayouBonanza
@@ -0,0 +1,948 @@
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/resource.h> // For raising the open file limit
+#include <unistd.h>       // For getpid
+#endif
+
+#include "GameState.h"       // For GameState and its sf::Packet operators
+#include "GameStateDelta.h"  // For applying GameStateDelta messages
+#include "GameEvent.h"       // For replaying GameEvent messages
+#include "Move.h"            // For Move and its sf::Packet operators
+#include "NetworkProtocol.h" // For MessageType enum and CardPlayData
+#include "ProtocolHandshake.h" // For the ConnectionRequest sent before logging in
+#include "MessageCompression.h" // For expanding compressed messages
+#include "Heartbeat.h"       // For answering the server's Pings
+#include "Leaderboard.h"     // For the LeaderboardRequest and LeaderboardData wire bodies
+#include "PlayerSide.h"      // For PlayerSide and its sf::Packet operators
+#include "GameRules.h"       // For picking legal moves
+#include "CardPlayValidator.h" // For picking legal card plays
+#include "PieceCard.h"
+#include "EffectCard.h"
+#include "Square.h"          // For Square::setGlobalPieceFactory
+#include "PieceFactory.h"
+#include "PieceDefinitionManager.h"
+#include "CardFactory.h"
+#include "CardCollection.h"   // For checking and replacing the account deck
+#include "NetSocket.h"       // For sockets exposing their native handle
+#include "Reactor.h"         // For the readiness-based event loop
+#include "OutboundQueue.h"   // For buffered socket writes
+
+// Headless load generator: drives many simulated players through the real
+// protocol (login, matchmaking, legal moves/card plays/end turns) and reports
+// connection rate, action throughput and action-to-update latency.
+
+using namespace BayouBonanza;
+
+using Clock = std::chrono::steady_clock;
+
+// Unsent bytes a simulated player may queue before it is considered stuck
+const std::size_t OUTBOUND_HIGH_WATER_BYTES = 64 * 1024;
+
+// Interval at which each worker opens its next batch of connections
+const std::chrono::milliseconds CONNECT_TICK(10);
+
+// How long a connection may take to be accepted before it counts as failed
+const std::chrono::milliseconds CONNECT_TIMEOUT(5000);
+
+// Delay before a player whose game ended queues for the next one; the server tears the old session down first
+const std::chrono::milliseconds REQUEUE_DELAY(1000);
+
+// Interval between progress lines
+const std::chrono::seconds REPORT_INTERVAL(5);
+
+struct LoadOptions {
+    std::string host = "127.0.0.1";   // --host
+    unsigned short port = 50000;      // --port
+    int players = 1000;               // --players: simulated players in total
+    int threads = 0;                  // --threads: event loops; 0 picks from the core count
+    double connectRate = 500.0;       // --connect-rate: new connections per second, all threads together
+    int duration = 60;                // --duration: seconds to run
+    std::string prefix;               // --prefix: username prefix; defaults to one unique to this run
+    double cardPlayChance = 0.3;      // --card-chance: how often a turn tries a card before a move
+    unsigned seed = 0;                // --seed: 0 seeds from the clock
+    sf::Uint32 definitionsHash = 0;   // Of the loaded piece definitions; sent in the handshake
+    // Offered in the handshake: deltas, compression and heartbeats by default, --events adds GameEvents,
+    // --full-state drops deltas and events, --no-compression drops compression, --no-heartbeat drops heartbeats
+    CapabilitySet capabilities = capabilityBit(Capability::StateDeltas) | capabilityBit(Capability::Compression) |
+                                 capabilityBit(Capability::Heartbeat);
+    bool ignorePings = false;         // --ignore-pings: offer heartbeats but never answer, like a dead peer
+    bool legacyLogin = false;         // --legacy-login: skip the handshake, as clients before it did
+    int spectators = 0;               // --spectators: extra connections that watch games instead of playing
+    int watchTargets = 1;             // --watch-targets: spectators spread over the games of this many players
+    bool leaderboard = false;         // --leaderboard: players look up the leaderboard after each game
+};
+
+// Counters one worker publishes; read by the main thread for progress lines
+struct LoadCounters {
+    std::atomic<std::uint64_t> connectAttempts{0};
+    std::atomic<std::uint64_t> connected{0};
+    std::atomic<std::uint64_t> connectFailures{0};
+    std::atomic<std::uint64_t> disconnects{0};
+    std::atomic<std::uint64_t> logins{0};
+    std::atomic<std::uint64_t> gamesStarted{0};
+    std::atomic<std::uint64_t> gamesFinished{0};
+    std::atomic<std::uint64_t> actions{0};
+    std::atomic<std::uint64_t> moves{0};
+    std::atomic<std::uint64_t> cardPlays{0};
+    std::atomic<std::uint64_t> endTurns{0};
+    std::atomic<std::uint64_t> rejections{0};
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<std::uint64_t> loginsQueued{0};   // ServerBusy with a queue position
+    std::atomic<std::uint64_t> turnedAway{0};     // ServerBusy refusals
+    std::atomic<std::uint64_t> stateDeltas{0};    // GameStateDelta messages applied
+    std::atomic<std::uint64_t> stateEvents{0};    // GameEvent messages replayed
+    std::atomic<std::uint64_t> resyncs{0};        // Deltas or events that did not apply; full state requested
+    std::atomic<std::uint64_t> spectating{0};     // Spectators' GameStart messages
+    std::atomic<std::uint64_t> spectatorUpdates{0}; // Updates spectators applied
+    std::atomic<std::uint64_t> spectateRetries{0};  // Watched player not in a game yet
+    std::atomic<std::uint64_t> pings{0};          // Server Pings received
+    std::atomic<std::uint64_t> leaderboards{0};   // LeaderboardData replies
+    std::atomic<std::uint64_t> bytesReceived{0};
+};
+
+enum class PlayerStage {
+    Idle,        // Not connected yet, or dropped
+    Connecting,  // connect() started; waiting for the socket to turn writable
+    LoggingIn,   // UserLogin sent; waiting for the lobby data
+    SavingDeck,  // SaveDeck sent; waiting for DeckSaved
+    Queued,      // RequestMatchmaking sent; waiting for GameStart
+    InGame,      // Playing
+    BetweenGames, // Game over; will queue again shortly
+    Watching      // Spectator: SpectateRequest sent, or following a game
+};
+
+struct SimPlayer {
+    std::string username;
+    std::string watchTarget;          // Spectators only: player whose games it watches
+    NetSocket socket;
+    std::unique_ptr<OutboundQueue> outbound;
+    PlayerStage stage = PlayerStage::Idle;
+    PlayerSide side = PlayerSide::NEUTRAL;
+    GameState gameState;
+    sf::Uint32 stateSequence = 0;     // Snapshot gameState matches; deltas must build on it
+    bool awaitingResync = false;      // RequestStateResync sent; deltas are dropped until it arrives
+    bool awaitingUpdate = false;      // An action is in flight
+    Clock::time_point actionSentAt;
+    Clock::time_point leaderboardSentAt;
+};
+
+class LoadWorker {
+public:
+    LoadWorker(const LoadOptions& options, int firstPlayer, int playerCount, int firstSpectator, int spectatorCount,
+               unsigned seed)
+        : options(options), firstPlayer(firstPlayer), playerCount(playerCount), firstSpectator(firstSpectator),
+          spectatorCount(spectatorCount), nextToConnect(0),
+          connectBudget(0.0), random(seed),
+          starterDeck(buildStarterDeck()) {}
+
+    void run() {
+        if (!reactor.isValid()) {
+            std::cerr << "Error: Could not create event loop" << std::endl;
+            return;
+        }
+        players.reserve(playerCount + spectatorCount);
+        for (int i = 0; i < playerCount; ++i) {
+            auto player = std::make_unique<SimPlayer>();
+            player->username = options.prefix + std::to_string(firstPlayer + i);
+            players.push_back(std::move(player));
+        }
+        // Spectators connect after this worker's players
+        for (int i = 0; i < spectatorCount; ++i) {
+            auto spectator = std::make_unique<SimPlayer>();
+            spectator->username = options.prefix + "watch" + std::to_string(firstSpectator + i);
+            spectator->watchTarget = options.prefix + std::to_string((firstSpectator + i) % options.watchTargets);
+            players.push_back(std::move(spectator));
+        }
+        reactor.timers().schedule(CONNECT_TICK, [this]() { connectBatch(); });
+        reactor.run();
+
+        for (auto& player : players) {
+            if (player->stage != PlayerStage::Idle) {
+                reactor.remove(player->socket.nativeHandle());
+                player->socket.disconnect();
+            }
+        }
+    }
+
+    void stop() { reactor.stop(); }
+
+    const LoadCounters& counters() const { return stats; }
+
+    // Only read after run() has returned
+    const std::vector<std::uint32_t>& latencySamples() const { return latencyMicros; }
+    const std::vector<std::uint32_t>& roundTripSamples() const { return roundTripMicros; }
+    const std::vector<std::uint32_t>& leaderboardSamples() const { return leaderboardMicros; }
+    Clock::time_point firstConnectAt() const { return connectStart; }
+    Clock::time_point lastConnectAt() const { return connectEnd; }
+
+private:
+    const LoadOptions& options;
+    int firstPlayer;
+    int playerCount;
+    int firstSpectator;
+    int spectatorCount;
+    int nextToConnect;
+    double connectBudget;
+    Clock::time_point lastConnectBatch;
+    std::mt19937 random;
+    std::string starterDeck; // Sent for accounts whose deck has no victory pieces to start a game with
+    Reactor reactor;
+    GameRules gameRules;
+    LoadCounters stats;
+    std::vector<std::unique_ptr<SimPlayer>> players;
+    std::vector<std::uint32_t> latencyMicros;
+    std::vector<std::uint32_t> roundTripMicros; // As the server measured them, from its Pings
+    std::vector<std::uint32_t> leaderboardMicros; // LeaderboardRequest to LeaderboardData
+    Clock::time_point connectStart;
+    Clock::time_point connectEnd;
+
+    // Open this tick's share of the connection ramp
+    void connectBatch() {
+        // Budget by the time that actually passed; timers can fire late
+        Clock::time_point now = Clock::now();
+        double elapsed = lastConnectBatch == Clock::time_point() ? std::chrono::duration<double>(CONNECT_TICK).count()
+                                                                 : std::chrono::duration<double>(now - lastConnectBatch).count();
+        lastConnectBatch = now;
+        connectBudget += options.connectRate / options.threads * elapsed;
+        int connections = static_cast<int>(players.size());
+        while (connectBudget >= 1.0 && nextToConnect < connections) {
+            connectBudget -= 1.0;
+            connectPlayer(*players[nextToConnect++]);
+        }
+        if (nextToConnect < connections) {
+            reactor.timers().schedule(CONNECT_TICK, [this]() { connectBatch(); });
+        }
+    }
+
+    // Start a non-blocking connect; the reactor reports the socket writable once it is accepted or refused,
+    // so a slow server never stalls the other players on this worker
+    void connectPlayer(SimPlayer& player) {
+        if (stats.connectAttempts++ == 0) {
+            connectStart = Clock::now();
+        }
+        player.socket.setBlocking(false);
+        sf::Socket::Status status = player.socket.connect(sf::IpAddress(options.host), options.port);
+        if (status != sf::Socket::Done && status != sf::Socket::NotReady) {
+            player.socket.disconnect();
+            stats.connectFailures++;
+            return;
+        }
+
+        player.outbound = std::make_unique<OutboundQueue>(OUTBOUND_HIGH_WATER_BYTES);
+        SimPlayer* target = &player;
+        if (!reactor.add(player.socket.nativeHandle(), Reactor::Writable,
+                         [this, target](unsigned events) { onSocketEvent(*target, events); })) {
+            player.socket.disconnect();
+            stats.connectFailures++;
+            return;
+        }
+        player.stage = PlayerStage::Connecting;
+        if (status == sf::Socket::Done) {
+            loginPlayer(player);
+            return;
+        }
+        reactor.timers().schedule(CONNECT_TIMEOUT, [this, target]() {
+            if (target->stage == PlayerStage::Connecting) {
+                failConnect(*target);
+            }
+        });
+    }
+
+    void failConnect(SimPlayer& player) {
+        stats.connectFailures++;
+        reactor.remove(player.socket.nativeHandle());
+        player.outbound->close();
+        player.socket.disconnect();
+        player.stage = PlayerStage::Idle;
+    }
+
+    // Connected: log in
+    void loginPlayer(SimPlayer& player) {
+        connectEnd = Clock::now();
+        stats.connected++;
+        reactor.modify(player.socket.nativeHandle(), Reactor::Readable);
+
+        player.stage = PlayerStage::LoggingIn;
+        sf::Packet login;
+        login << MessageType::UserLogin << player.username;
+        if (options.legacyLogin) {
+            StateUpdateMode mode = stateUpdateModeFor(options.capabilities);
+            login << options.definitionsHash
+                  << static_cast<sf::Uint8>(mode == StateUpdateMode::Events ? mode : StateUpdateMode::Deltas);
+        } else {
+            // The login follows without waiting; the server reads them in order
+            ConnectionRequestData request;
+            request.definitionsHash = options.definitionsHash;
+            request.capabilities = options.capabilities;
+            sf::Packet requestPacket;
+            requestPacket << MessageType::ConnectionRequest << request;
+            send(player, requestPacket);
+        }
+        send(player, login);
+    }
+
+    void send(SimPlayer& player, const sf::Packet& packet) {
+        OutboundQueue::PushResult result = player.outbound->push(OutboundQueue::makeFrame(packet));
+        if (result == OutboundQueue::PushResult::ScheduleFlush) {
+            flush(player);
+        } else if (result == OutboundQueue::PushResult::OverHighWater) {
+            drop(player);
+        }
+    }
+
+    void flush(SimPlayer& player) {
+        switch (player.outbound->flush(player.socket.nativeHandle())) {
+            case OutboundQueue::FlushResult::Drained:
+                reactor.modify(player.socket.nativeHandle(), Reactor::Readable);
+                break;
+            case OutboundQueue::FlushResult::WouldBlock:
+                reactor.modify(player.socket.nativeHandle(), Reactor::Readable | Reactor::Writable);
+                break;
+            case OutboundQueue::FlushResult::Error:
+                drop(player);
+                break;
+        }
+    }
+
+    void drop(SimPlayer& player) {
+        if (player.stage == PlayerStage::Idle) {
+            return;
+        }
+        stats.disconnects++;
+        reactor.remove(player.socket.nativeHandle());
+        player.outbound->close();
+        player.socket.disconnect();
+        player.stage = PlayerStage::Idle;
+        player.awaitingUpdate = false;
+    }
+
+    void onSocketEvent(SimPlayer& player, unsigned events) {
+        if (player.stage == PlayerStage::Connecting) {
+            if (player.socket.finishConnect() == sf::Socket::Done) {
+                loginPlayer(player);
+            } else {
+                failConnect(player);
+            }
+            return;
+        }
+        if (events & Reactor::Writable) {
+            flush(player);
+        }
+        if (player.stage == PlayerStage::Idle) {
+            return;
+        }
+
+        sf::Packet packet;
+        while (true) {
+            sf::Socket::Status status = player.socket.receive(packet);
+            if (status == sf::Socket::Done) {
+                stats.bytesReceived += packet.getDataSize();
+                handleMessage(player, packet);
+                if (player.stage == PlayerStage::Idle) {
+                    return;
+                }
+            } else if (status == sf::Socket::NotReady) {
+                return;
+            } else {
+                drop(player);
+                return;
+            }
+        }
+    }
+
+    void handleMessage(SimPlayer& player, sf::Packet& packet) {
+        MessageType type;
+        if (!expandCompressed(packet) || !(packet >> type)) {
+            stats.errors++;
+            return;
+        }
+
+        switch (type) {
+            case MessageType::ConnectionAccepted: {
+                ConnectionAcceptedData accepted;
+                if (!(packet >> accepted) || accepted.capabilities != options.capabilities) {
+                    stats.errors++; // The server should have agreed to everything we offered
+                }
+                break;
+            }
+
+            case MessageType::PlayerAssignment:
+                packet >> player.side;
+                break;
+
+            case MessageType::DeckData: {
+                // Last piece of the lobby data; the login is complete
+                std::string deckData;
+                if (player.stage != PlayerStage::LoggingIn || !(packet >> deckData)) {
+                    break;
+                }
+                stats.logins++;
+                if (!player.watchTarget.empty()) {
+                    requestSpectate(player);
+                } else if (hasVictoryPieces(deckData)) {
+                    requestMatch(player);
+                } else {
+                    // New accounts start without victory pieces, which leaves the board empty; set a deck up like a player would
+                    sf::Packet save;
+                    save << MessageType::SaveDeck << starterDeck;
+                    player.stage = PlayerStage::SavingDeck;
+                    send(player, save);
+                }
+                break;
+            }
+
+            case MessageType::DeckSaved:
+                if (player.stage == PlayerStage::SavingDeck) {
+                    requestMatch(player);
+                }
+                break;
+
+            case MessageType::GameStart: {
+                std::string firstName, secondName;
+                int firstRating, secondRating;
+                WireReader body = messageBody(packet);
+                if (!(body >> firstName >> firstRating >> secondName >> secondRating) ||
+                    !readFullGameState(body, player.gameState, player.stateSequence, viewerOf(player))) {
+                    stats.errors++;
+                    break;
+                }
+                player.awaitingResync = false;
+                if (player.stage == PlayerStage::Watching) {
+                    stats.spectating++;
+                    break;
+                }
+                stats.gamesStarted++;
+                player.stage = PlayerStage::InGame;
+                player.awaitingUpdate = false;
+                takeTurn(player);
+                break;
+            }
+
+            case MessageType::GameStateUpdate:
+            case MessageType::GameStateDelta:
+            case MessageType::GameEvent: {
+                WireReader body = messageBody(packet);
+                if (type == MessageType::GameStateUpdate) {
+                    if (!readFullGameState(body, player.gameState, player.stateSequence, viewerOf(player))) {
+                        stats.errors++;
+                        break;
+                    }
+                    player.awaitingResync = false;
+                } else if (type == MessageType::GameStateDelta &&
+                           applyGameStateDelta(body, player.gameState, player.stateSequence, viewerOf(player))) {
+                    stats.stateDeltas++;
+                } else if (type == MessageType::GameEvent && !player.awaitingResync &&
+                           applyGameEvent(body, player.gameState, player.stateSequence, player.side)) {
+                    stats.stateEvents++;
+                } else {
+                    if (!player.awaitingResync) {
+                        stats.resyncs++;
+                        player.awaitingResync = true;
+                        sf::Packet resyncPacket;
+                        resyncPacket << MessageType::RequestStateResync;
+                        send(player, resyncPacket);
+                    }
+                    break;
+                }
+                if (player.awaitingUpdate) {
+                    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - player.actionSentAt);
+                    latencyMicros.push_back(static_cast<std::uint32_t>(std::min<long long>(elapsed.count(), UINT32_MAX)));
+                    player.awaitingUpdate = false;
+                }
+                if (player.stage == PlayerStage::Watching) {
+                    stats.spectatorUpdates++;
+                    if (player.gameState.getGamePhase() == GamePhase::GAME_OVER) {
+                        watchAgainLater(player); // The watched player queues for another game
+                    }
+                } else if (player.stage == PlayerStage::InGame &&
+                           player.gameState.getGamePhase() == GamePhase::GAME_OVER) {
+                    stats.gamesFinished++;
+                    player.stage = PlayerStage::BetweenGames;
+                    if (options.leaderboard) {
+                        requestLeaderboard(player);
+                    }
+                    SimPlayer* target = &player;
+                    reactor.timers().schedule(REQUEUE_DELAY, [this, target]() {
+                        if (target->stage == PlayerStage::BetweenGames) {
+                            requestMatch(*target);
+                        }
+                    });
+                } else {
+                    takeTurn(player);
+                }
+                break;
+            }
+
+            case MessageType::MoveRejected:
+            case MessageType::CardPlayRejected:
+                // Our copy of the state disagreed with the server's; give the turn back
+                stats.rejections++;
+                player.awaitingUpdate = false;
+                sendAction(player, MessageType::EndTurn, [](WireWriter&) {});
+                stats.endTurns++;
+                break;
+
+            case MessageType::Ping: {
+                stats.pings++;
+                PingData ping;
+                sf::Packet pong = answerPing(packet, ping);
+                if (pong.getDataSize() == 0) {
+                    stats.errors++;
+                } else if (!options.ignorePings) {
+                    send(player, pong);
+                    if (ping.roundTripMicros > 0) {
+                        roundTripMicros.push_back(ping.roundTripMicros);
+                    }
+                }
+                break;
+            }
+
+            case MessageType::LeaderboardData: {
+                LeaderboardData leaderboard;
+                WireReader body = messageBody(packet);
+                // A player who has finished a game has a rating, so it must be ranked
+                if (!(body >> leaderboard) || leaderboard.rank == 0 || leaderboard.around.empty()) {
+                    stats.errors++;
+                    break;
+                }
+                stats.leaderboards++;
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - player.leaderboardSentAt);
+                leaderboardMicros.push_back(static_cast<std::uint32_t>(std::min<long long>(elapsed.count(), UINT32_MAX)));
+                break;
+            }
+
+            case MessageType::ServerBusy: {
+                // A queued login carries on by itself; a refusal is followed by the server closing the socket
+                sf::Uint32 position = 0;
+                packet >> position;
+                if (position > 0) {
+                    stats.loginsQueued++;
+                } else {
+                    stats.turnedAway++;
+                }
+                break;
+            }
+
+            case MessageType::Error:
+                if (player.stage == PlayerStage::Watching) {
+                    stats.spectateRetries++; // Not in a game yet, or between games
+                    watchAgainLater(player);
+                    break;
+                }
+                stats.errors++;
+                if (player.stage == PlayerStage::SavingDeck) {
+                    // The server keeps the new deck for this session even when storing it failed
+                    requestMatch(player);
+                }
+                break;
+
+            default:
+                break; // Lobby data and waiting notices need no reply
+        }
+    }
+
+    // The starter cards rearranged so the deck editor's rules accept them: the starter victory piece
+    // in its slot and no card more than Deck::MAX_COPIES times in the main deck
+    static std::string buildStarterDeck() {
+        std::vector<std::unique_ptr<Card>> victoryCards = CardFactory::createStarterVictoryCards();
+        std::map<int, int> copies;
+        for (const auto& card : victoryCards) {
+            copies[card->getId()] = Deck::MAX_COPIES; // Victory pieces may not also sit in the main deck
+        }
+        std::vector<std::unique_ptr<Card>> mainCards;
+        for (auto& card : CardFactory::createStarterDeck()) {
+            if (copies[card->getId()]++ < Deck::MAX_COPIES) {
+                mainCards.push_back(std::move(card));
+            }
+        }
+        return Deck(std::move(mainCards), std::move(victoryCards)).serialize();
+    }
+
+    // Whose projection of the state the player is sent, for checking its hash
+    static PlayerSide viewerOf(const SimPlayer& player) {
+        return player.stage == PlayerStage::Watching ? SPECTATOR_VIEWER : player.side;
+    }
+
+    static bool hasVictoryPieces(const std::string& deckData) {
+        Deck deck;
+        if (!deck.deserialize(deckData)) {
+            return false;
+        }
+        for (std::size_t i = 0; i < Deck::VICTORY_SIZE; ++i) {
+            if (deck.getVictoryCard(i)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void requestMatch(SimPlayer& player) {
+        sf::Packet request;
+        request << MessageType::RequestMatchmaking;
+        player.stage = PlayerStage::Queued;
+        send(player, request);
+    }
+
+    void requestLeaderboard(SimPlayer& player) {
+        LeaderboardRequestData request;
+        request.top = 10;
+        request.around = 3;
+        std::array<char, 32> buffer;
+        WireWriter writer(buffer.data(), buffer.size());
+        writer << MessageType::LeaderboardRequest << request;
+        player.leaderboardSentAt = Clock::now();
+        send(player, wirePacket(writer));
+    }
+
+    void requestSpectate(SimPlayer& player) {
+        sf::Packet request;
+        request << MessageType::SpectateRequest << player.watchTarget;
+        player.stage = PlayerStage::Watching;
+        player.gameState = GameState();
+        send(player, request);
+    }
+
+    void watchAgainLater(SimPlayer& player) {
+        SimPlayer* target = &player;
+        reactor.timers().schedule(REQUEUE_DELAY, [this, target]() {
+            if (target->stage == PlayerStage::Watching) {
+                requestSpectate(*target);
+            }
+        });
+    }
+
+    template <typename Fill>
+    void sendAction(SimPlayer& player, MessageType type, Fill fill) {
+        std::array<char, 256> buffer;
+        WireWriter writer(buffer.data(), buffer.size());
+        writer << type;
+        fill(writer);
+        if (!writer) {
+            stats.errors++;
+            return;
+        }
+        player.awaitingUpdate = true;
+        player.actionSentAt = Clock::now();
+        stats.actions++;
+        send(player, wirePacket(writer));
+    }
+
+    // Act if it is this player's turn: a card play some of the time, otherwise a move, otherwise end the turn
+    void takeTurn(SimPlayer& player) {
+        const GameState& state = player.gameState;
+        if (player.stage != PlayerStage::InGame || player.awaitingUpdate ||
+            state.getActivePlayer() != player.side) {
+            return;
+        }
+        GamePhase phase = state.getGamePhase();
+        if (phase != GamePhase::PLAY && phase != GamePhase::MOVE) {
+            return;
+        }
+
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        if (chance(random) < options.cardPlayChance && tryCardPlay(player)) {
+            return;
+        }
+
+        std::vector<Move> moves = gameRules.getValidMovesForActivePlayer(state);
+        if (!moves.empty()) {
+            const Move& move = moves[std::uniform_int_distribution<std::size_t>(0, moves.size() - 1)(random)];
+            sendAction(player, MessageType::MoveToServer, [&move](WireWriter& writer) { writer << move; });
+            stats.moves++;
+            return;
+        }
+        if (tryCardPlay(player)) {
+            return;
+        }
+        sendAction(player, MessageType::EndTurn, [](WireWriter&) {});
+        stats.endTurns++;
+    }
+
+    bool tryCardPlay(SimPlayer& player) {
+        const GameState& state = player.gameState;
+        const Hand& hand = state.getHand(player.side);
+
+        std::vector<std::pair<int, Position>> plays;
+        for (std::size_t i = 0; i < hand.size(); ++i) {
+            if (!CardPlayValidator::validateCardPlay(state, player.side, i).isValid) {
+                continue;
+            }
+            const Card* card = hand.getCard(i);
+            std::vector<Position> targets;
+            if (auto pieceCard = dynamic_cast<const PieceCard*>(card)) {
+                targets = CardPlayValidator::getValidPlacements(state, player.side, pieceCard);
+            } else if (auto effectCard = dynamic_cast<const EffectCard*>(card)) {
+                targets = CardPlayValidator::getValidTargets(state, player.side, effectCard);
+            }
+            for (const Position& target : targets) {
+                plays.emplace_back(static_cast<int>(i), target);
+            }
+        }
+        if (plays.empty()) {
+            return false;
+        }
+
+        const auto& choice = plays[std::uniform_int_distribution<std::size_t>(0, plays.size() - 1)(random)];
+        CardPlayData play(choice.first, choice.second.x, choice.second.y);
+        sendAction(player, MessageType::CardPlayToServer, [&play](WireWriter& writer) { writer << play; });
+        stats.cardPlays++;
+        return true;
+    }
+};
+
+LoadOptions parseOptions(int argc, char* argv[]) {
+    LoadOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--host" && hasValue) {
+            options.host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            options.port = static_cast<unsigned short>(std::atoi(argv[++i]));
+        } else if (arg == "--players" && hasValue) {
+            options.players = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--connect-rate" && hasValue) {
+            options.connectRate = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--duration" && hasValue) {
+            options.duration = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--prefix" && hasValue) {
+            options.prefix = argv[++i];
+        } else if (arg == "--card-chance" && hasValue) {
+            options.cardPlayChance = std::clamp(std::atof(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--events") {
+            options.capabilities |= capabilityBit(Capability::GameEvents);
+        } else if (arg == "--full-state") {
+            options.capabilities &= ~(capabilityBit(Capability::StateDeltas) | capabilityBit(Capability::GameEvents));
+        } else if (arg == "--no-compression") {
+            options.capabilities &= ~capabilityBit(Capability::Compression);
+        } else if (arg == "--no-heartbeat") {
+            options.capabilities &= ~capabilityBit(Capability::Heartbeat);
+        } else if (arg == "--ignore-pings") {
+            options.ignorePings = true;
+        } else if (arg == "--legacy-login") {
+            options.legacyLogin = true;
+        } else if (arg == "--spectators" && hasValue) {
+            options.spectators = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--watch-targets" && hasValue) {
+            options.watchTargets = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--leaderboard") {
+            options.leaderboard = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--host ADDR] [--port N] [--players N] [--threads N]"
+                      << " [--connect-rate PER_SEC] [--duration SEC] [--prefix NAME] [--card-chance P] [--seed N]"
+                      << " [--events] [--full-state] [--no-compression] [--no-heartbeat] [--ignore-pings] [--legacy-login]"
+                      << " [--spectators N] [--watch-targets N] [--leaderboard]"
+                      << std::endl;
+            std::exit(arg == "--help" ? 0 : 1);
+        }
+    }
+    if (options.threads == 0) {
+        options.threads = static_cast<int>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 8u));
+    }
+    if (options.players == 0 && options.spectators == 0) {
+        options.players = 1;
+    }
+    // --players 0 with --prefix watches the players of another run
+    options.threads = std::max(1, std::min(options.threads, options.players + options.spectators));
+    if (options.players > 0) {
+        options.watchTargets = std::min(options.watchTargets, options.players);
+    }
+    if (options.prefix.empty()) {
+#if !defined(_WIN32)
+        options.prefix = "load" + std::to_string(::getpid()) + "_";
+#else
+        options.prefix = "load" + std::to_string(Clock::now().time_since_epoch().count() % 100000) + "_";
+#endif
+    }
+    if (options.seed == 0) {
+        options.seed = static_cast<unsigned>(Clock::now().time_since_epoch().count());
+    }
+    return options;
+}
+
+#if !defined(_WIN32)
+// Each simulated player holds a socket; the default soft limit is often 1024
+void raiseFileDescriptorLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+#endif
+
+std::uint64_t total(const std::vector<std::unique_ptr<LoadWorker>>& workers,
+                    std::atomic<std::uint64_t> LoadCounters::*counter) {
+    std::uint64_t sum = 0;
+    for (const auto& worker : workers) {
+        sum += (worker->counters().*counter).load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+double percentileMillis(std::vector<std::uint32_t>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    std::size_t rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    LoadOptions options = parseOptions(argc, argv);
+
+    // Simulated players deserialize the same GameState the client does
+    PieceDefinitionManager pieceDefinitions;
+    if (!pieceDefinitions.loadDefinitions("assets/data/cards.json")) {
+        std::cerr << "FATAL: Could not load piece definitions from assets/data/cards.json" << std::endl;
+        return -1;
+    }
+    options.definitionsHash = pieceDefinitions.getDefinitionsHash();
+    PieceFactory pieceFactory(pieceDefinitions);
+    Square::setGlobalPieceFactory(&pieceFactory);
+    CardFactory::initialize(); // Before worker threads can race on the lazy initialization
+
+#if !defined(_WIN32)
+    raiseFileDescriptorLimit();
+#endif
+
+    std::cout << "Driving " << options.players << " players against " << options.host << ":" << options.port
+              << " on " << options.threads << " threads for " << options.duration << "s"
+              << " (connect rate " << options.connectRate << "/s)";
+    if (options.spectators > 0) {
+        std::cout << ", with " << options.spectators << " spectators";
+    }
+    std::cout << std::endl;
+
+    std::vector<std::unique_ptr<LoadWorker>> workers;
+    std::vector<std::thread> threads;
+    int assigned = 0;
+    int spectatorsAssigned = 0;
+    for (int t = 0; t < options.threads; ++t) {
+        int count = options.players / options.threads + (t < options.players % options.threads ? 1 : 0);
+        int spectators = options.spectators / options.threads + (t < options.spectators % options.threads ? 1 : 0);
+        workers.push_back(std::make_unique<LoadWorker>(options, assigned, count, spectatorsAssigned, spectators,
+                                                       options.seed + t));
+        assigned += count;
+        spectatorsAssigned += spectators;
+    }
+    for (auto& worker : workers) {
+        threads.emplace_back([&worker]() { worker->run(); });
+    }
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + std::chrono::seconds(options.duration);
+    std::uint64_t lastActions = 0;
+    Clock::time_point lastReport = start;
+    while (Clock::now() < end) {
+        std::this_thread::sleep_for(std::min<Clock::duration>(REPORT_INTERVAL, end - Clock::now()));
+        Clock::time_point now = Clock::now();
+        std::uint64_t actions = total(workers, &LoadCounters::actions);
+        double interval = std::chrono::duration<double>(now - lastReport).count();
+        std::cout << "[" << std::fixed << std::setprecision(0)
+                  << std::chrono::duration<double>(now - start).count() << "s]"
+                  << " connected " << total(workers, &LoadCounters::connected)
+                  << " logins " << total(workers, &LoadCounters::logins)
+                  << " games " << total(workers, &LoadCounters::gamesStarted)
+                  << "/" << total(workers, &LoadCounters::gamesFinished)
+                  << " actions/s " << (interval > 0 ? (actions - lastActions) / interval : 0.0)
+                  << " drops " << total(workers, &LoadCounters::disconnects) << std::endl;
+        lastActions = actions;
+        lastReport = now;
+    }
+
+    for (auto& worker : workers) {
+        worker->stop();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<std::uint32_t> latencies;
+    std::vector<std::uint32_t> roundTrips;
+    std::vector<std::uint32_t> leaderboardTimes;
+    Clock::time_point firstConnect = Clock::time_point::max();
+    Clock::time_point lastConnect = Clock::time_point::min();
+    for (const auto& worker : workers) {
+        latencies.insert(latencies.end(), worker->latencySamples().begin(), worker->latencySamples().end());
+        roundTrips.insert(roundTrips.end(), worker->roundTripSamples().begin(), worker->roundTripSamples().end());
+        leaderboardTimes.insert(leaderboardTimes.end(), worker->leaderboardSamples().begin(),
+                                worker->leaderboardSamples().end());
+        if (worker->counters().connected.load() > 0) {
+            firstConnect = std::min(firstConnect, worker->firstConnectAt());
+            lastConnect = std::max(lastConnect, worker->lastConnectAt());
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::sort(roundTrips.begin(), roundTrips.end());
+    std::sort(leaderboardTimes.begin(), leaderboardTimes.end());
+
+    std::uint64_t connected = total(workers, &LoadCounters::connected);
+    double connectSpan = connected > 0 ? std::chrono::duration<double>(lastConnect - firstConnect).count() : 0.0;
+    std::uint64_t actions = total(workers, &LoadCounters::actions);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "==== Load test summary ====" << std::endl;
+    std::cout << "Connections:  " << connected << " of " << total(workers, &LoadCounters::connectAttempts)
+              << " (" << total(workers, &LoadCounters::connectFailures) << " failed, "
+              << total(workers, &LoadCounters::disconnects) << " dropped)" << std::endl;
+    std::cout << "Connect rate: " << (connectSpan > 0 ? connected / connectSpan : static_cast<double>(connected))
+              << " /s" << std::endl;
+    std::cout << "Logins:       " << total(workers, &LoadCounters::logins) << " ("
+              << total(workers, &LoadCounters::loginsQueued) << " queued, "
+              << total(workers, &LoadCounters::turnedAway) << " turned away)" << std::endl;
+    std::cout << "Games:        " << total(workers, &LoadCounters::gamesStarted) << " started, "
+              << total(workers, &LoadCounters::gamesFinished) << " finished" << std::endl;
+    std::cout << "Actions:      " << actions << " (" << total(workers, &LoadCounters::moves) << " moves, "
+              << total(workers, &LoadCounters::cardPlays) << " card plays, "
+              << total(workers, &LoadCounters::endTurns) << " end turns, "
+              << total(workers, &LoadCounters::rejections) << " rejected)" << std::endl;
+    std::cout << "Actions/sec:  " << actions / elapsed << std::endl;
+    std::cout << "Received:     " << total(workers, &LoadCounters::bytesReceived) / 1024 << " KiB ("
+              << total(workers, &LoadCounters::stateDeltas) << " state deltas, "
+              << total(workers, &LoadCounters::stateEvents) << " state events, "
+              << total(workers, &LoadCounters::resyncs) << " resyncs)" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Action -> GameStateUpdate latency (" << latencies.size() << " samples): p50 "
+              << percentileMillis(latencies, 0.50) << " ms, p99 " << percentileMillis(latencies, 0.99)
+              << " ms, p999 " << percentileMillis(latencies, 0.999) << " ms, max "
+              << (latencies.empty() ? 0.0 : latencies.back() / 1000.0) << " ms" << std::endl;
+    if (hasCapability(options.capabilities, Capability::Heartbeat) && !options.legacyLogin) {
+        std::cout << "Heartbeats:   " << total(workers, &LoadCounters::pings) << " pings"
+                  << (options.ignorePings ? " (ignored)" : "") << ", server-measured round trip p50 "
+                  << percentileMillis(roundTrips, 0.50) << " ms, p99 " << percentileMillis(roundTrips, 0.99)
+                  << " ms" << std::endl;
+    }
+    if (options.spectators > 0) {
+        std::cout << "Spectators:   " << options.spectators << " watching " << options.watchTargets << " players: "
+                  << total(workers, &LoadCounters::spectating) << " games joined, "
+                  << total(workers, &LoadCounters::spectatorUpdates) << " updates applied ("
+                  << total(workers, &LoadCounters::spectateRetries) << " retries)" << std::endl;
+    }
+    if (options.leaderboard) {
+        std::cout << "Leaderboard:  " << total(workers, &LoadCounters::leaderboards) << " lookups, p50 "
+                  << percentileMillis(leaderboardTimes, 0.50) << " ms, p99 " << percentileMillis(leaderboardTimes, 0.99)
+                  << " ms" << std::endl;
+    }
+    std::cout << "Errors:       " << total(workers, &LoadCounters::errors) << std::endl;
+    return 0;
+}
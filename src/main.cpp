@@ -11,9 +11,14 @@
 
 #include "GameBoard.h"
 #include "GameState.h"
+#include "GameStateDelta.h"
+#include "GameEvent.h"
 #include "Square.h"       // For Square::setGlobalPieceFactory
 #include "Move.h"      // For Move and its sf::Packet operators
 #include "NetworkProtocol.h" // For MessageType enum and operators
+#include "ProtocolHandshake.h" // For the ConnectionRequest sent before logging in
+#include "MessageCompression.h" // For expanding compressed messages from the server
+#include "Heartbeat.h"       // For answering the server's Pings
 #include "PlayerSide.h"  // For PlayerSide enum
 #include "InputManager.h" // New input manager
 #include "GraphicsManager.h" // New graphics manager
@@ -63,6 +68,9 @@ sf::Text localPlayerSteamText;
 // UI Element for Phase Information
 sf::Text phaseText;
 
+// UI Element for the round trip to the server, as the server measured it
+sf::Text roundTripText;
+
 // Global variables for game state
 GameState gameState;
 GameInitializer gameInitializer;
@@ -82,6 +90,10 @@ std::string gameStartP1Username, gameStartP2Username;
 int gameStartP1Rating = 0, gameStartP2Rating = 0;
 sf::Packet gameStartPacketData;
 
+// Sequence of the server snapshot gameState matches; GameStateDelta and GameEvent messages must build on it
+sf::Uint32 stateSequence = 0;
+bool stateResyncRequested = false; // RequestStateResync sent; updates are ignored until the full state arrives
+
 // Global variable to store current player's rating for menu display
 int myCurrentRating = 0;
 std::string myUsername = "";
@@ -95,6 +107,26 @@ sf::Text menuButtonText;
 bool returnToMenuRequested = false;
 std::string endScreenTitle = "";
 
+// Answer a Ping from the server; it carries the round trip the server measured, which is shown in game
+void answerServerPing(sf::TcpSocket& socket, const sf::Packet& ping) {
+    PingData data;
+    sf::Packet pong = answerPing(ping, data);
+    if (pong.getDataSize() == 0) {
+        return;
+    }
+    socket.send(pong);
+    if (data.roundTripMicros > 0) {
+        roundTripText.setString("Ping: " + std::to_string((data.roundTripMicros + 500) / 1000) + " ms");
+    }
+}
+
+// Ask the server for the full state again; updates are ignored until it arrives
+void requestStateResync(sf::TcpSocket& socket) {
+    sf::Packet resyncPacket;
+    resyncPacket << MessageType::RequestStateResync;
+    stateResyncRequested = socket.send(resyncPacket) == sf::Socket::Done;
+}
+
 // Win condition notification callback
 void onWinCondition(PlayerSide winner, const std::string& /*description*/) {
     showWinMessage = true;
@@ -566,7 +598,7 @@ void runDeckEditor(sf::RenderWindow& window, GraphicsManager& graphicsManager, s
         sf::Socket::Status status = socket.receive(receivedPacket);
         if (status == sf::Socket::Done) {
             MessageType messageType;
-            if (receivedPacket >> messageType) {
+            if (expandCompressed(receivedPacket) && receivedPacket >> messageType) {
                 switch (messageType) {
                     case MessageType::DeckSaved:
                         std::cout << "Deck save confirmed by server" << std::endl;
@@ -574,6 +606,9 @@ void runDeckEditor(sf::RenderWindow& window, GraphicsManager& graphicsManager, s
                         statusColor = sf::Color::Green;
                         statusClock.restart();
                         break;
+                    case MessageType::Ping:
+                        answerServerPing(socket, receivedPacket);
+                        break;
                     case MessageType::Error:
                         {
                             std::string errorMsg;
@@ -1139,8 +1174,16 @@ void runDeckEditor(sf::RenderWindow& window, GraphicsManager& graphicsManager, s
     }
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    // --spectate NAME: watch the game NAME is playing instead of opening the menu
+    std::string spectateTarget;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--spectate") {
+            spectateTarget = argv[i + 1];
+        }
+    }
+
     // Create the main window with a default size - GraphicsManager will handle scaling
     sf::RenderWindow window(sf::VideoMode(1280, 720), "Bayou Bonanza");
     window.setFramerateLimit(60);
@@ -1201,23 +1244,39 @@ int main()
     } else {
         std::cout << "Connected to server!" << std::endl;
         
-        // Send UserLogin message
+        // Handshake, then UserLogin straight after it: the server answers them in order, so
+        // there is no need to wait for ConnectionAccepted
+        ConnectionRequestData request;
+        request.definitionsHash = globalPieceDefManager.getDefinitionsHash();
+        request.capabilities = SUPPORTED_CAPABILITIES;
+        sf::Packet requestPacket;
+        requestPacket << MessageType::ConnectionRequest << request;
         sf::Packet loginPacket;
         loginPacket << MessageType::UserLogin << username;
-        if (socket.send(loginPacket) != sf::Socket::Done) {
+        if (socket.send(requestPacket) != sf::Socket::Done || socket.send(loginPacket) != sf::Socket::Done) {
             std::cerr << "Error: Failed to send login packet." << std::endl;
             uiMessage = "Failed to send login info.";
             // Consider closing socket or handling error more robustly
         } else {
             std::cout << "Login packet sent with username: " << username << std::endl;
             uiMessage = "Login sent! Waiting for assignment...";
+            if (!spectateTarget.empty()) {
+                // The game arrives as a GameStart, with both hands hidden
+                sf::Packet spectatePacket;
+                spectatePacket << MessageType::SpectateRequest << spectateTarget;
+                socket.send(spectatePacket);
+                std::cout << "Asked to watch " << spectateTarget << "'s game" << std::endl;
+            }
         }
     }
 
     // Check immediately for ongoing game messages before entering menu
     socket.setBlocking(false); // Keep non-blocking to avoid freezing
     sf::Clock resumeClock;
-    while (resumeClock.getElapsedTime().asSeconds() < 3.f && !gameStartReceived && window.isOpen()) {
+    bool loginQueued = false;  // Server is at capacity and our login is waiting its turn
+    bool loginRefused = false; // Turned away, or dropped while queued; uiMessage says which
+    while ((loginQueued || resumeClock.getElapsedTime().asSeconds() < 3.f) && !gameStartReceived && !loginRefused &&
+           window.isOpen()) {
         // Process window events to prevent freezing
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -1234,15 +1293,29 @@ int main()
         sf::Socket::Status status = socket.receive(receivedPacket);
         if (status == sf::Socket::Done) {
             MessageType messageType;
-            if (receivedPacket >> messageType) {
+            if (expandCompressed(receivedPacket) && receivedPacket >> messageType) {
                 switch (messageType) {
+                    case MessageType::ConnectionAccepted: {
+                        ConnectionAcceptedData accepted;
+                        if (receivedPacket >> accepted) {
+                            std::cout << "Server speaks protocol " << accepted.protocolVersion << ", capabilities 0x"
+                                      << std::hex << accepted.capabilities << std::dec << std::endl;
+                        }
+                        break;
+                    }
                     case MessageType::PlayerAssignment: {
                         uint8_t side_uint8;
                         if (receivedPacket >> side_uint8) {
                             myPlayerSide = static_cast<PlayerSide>(side_uint8);
                         }
+                        // Logged in: the collection and deck follow, and a game to resume within a few seconds
+                        loginQueued = false;
+                        resumeClock.restart();
                         break;
                     }
+                    case MessageType::Ping:
+                        answerServerPing(socket, receivedPacket);
+                        break;
                     case MessageType::CardCollectionData: {
                         std::string data;
                         if (receivedPacket >> data) {
@@ -1257,19 +1330,34 @@ int main()
                         }
                         break;
                     }
+                    case MessageType::ServerBusy: {
+                        sf::Uint32 position = 0;
+                        receivedPacket >> position;
+                        uiMessage = position > 0 ? "Server busy - in login queue at position " + std::to_string(position)
+                                                 : "Server is full. Please try again later.";
+                        loginQueued = position > 0; // Keep waiting until the login goes through
+                        loginRefused = position == 0;
+                        break;
+                    }
+                    case MessageType::Error: {
+                        // e.g. login refused because our piece definitions differ from the server's
+                        std::string errorMessage;
+                        if (receivedPacket >> errorMessage) {
+                            uiMessage = errorMessage;
+                            std::cerr << "Server error: " << errorMessage << std::endl;
+                        }
+                        break;
+                    }
                     case MessageType::GameStart:
                         {
-                            // Create a new packet with the GameStart message type and data
-                            gameStartPacketData.clear();
-                            gameStartPacketData << MessageType::GameStart;
-                            
-                            // Extract and re-add the data to the new packet
+                            // Keep the whole message to process once the game screen is up
                             std::string p1_username, p2_username;
                             int p1_rating, p2_rating;
                             GameState tempGameState;
-                            
-                            if (receivedPacket >> p1_username >> p1_rating >> p2_username >> p2_rating >> tempGameState) {
-                                gameStartPacketData << p1_username << p1_rating << p2_username << p2_rating << tempGameState;
+                            sf::Uint32 sequence = 0;
+                            WireReader body = messageBody(receivedPacket);
+                            if (body >> p1_username >> p1_rating >> p2_username >> p2_rating >> tempGameState >> sequence) {
+                                gameStartPacketData = receivedPacket;
                                 gameStartReceived = true;
                             }
                         }
@@ -1281,6 +1369,10 @@ int main()
         } else if (status == sf::Socket::NotReady) {
             // No data available, continue loop
         } else {
+            if (loginQueued) {
+                uiMessage = "Lost connection to the server while in the login queue.";
+                loginRefused = true;
+            }
             break; // Error or disconnection
         }
         
@@ -1290,7 +1382,7 @@ int main()
         
         sf::Text connectingText;
         connectingText.setFont(globalFont);
-        connectingText.setString("Connecting...");
+        connectingText.setString(loginQueued ? uiMessage : "Connecting...");
         connectingText.setCharacterSize(32);
         connectingText.setFillColor(sf::Color::White);
         
@@ -1305,6 +1397,12 @@ int main()
         sf::sleep(sf::milliseconds(16)); // ~60 FPS
     }
 
+    if (loginRefused) {
+        // No collection or deck and no connection to play on; say why and stop
+        showPlaceholderScreen(window, graphicsManager, uiMessage, globalFont);
+        return 0;
+    }
+
     // Show main menu only if no game to resume
     MainMenuOption menuChoice = MainMenuOption::NONE;
     if (!gameStartReceived) {
@@ -1353,6 +1451,11 @@ int main()
     phaseText.setFillColor(sf::Color::Yellow);
     phaseText.setPosition(10.f, 35.f); // Position below the main UI message
 
+    roundTripText.setFont(globalFont);
+    roundTripText.setCharacterSize(16);
+    roundTripText.setFillColor(sf::Color(200, 200, 200));
+    roundTripText.setPosition(GraphicsManager::BASE_WIDTH - 110.f, 10.f); // Top right corner
+
     // Initialize game state
     GameState gameState;
     
@@ -1375,9 +1478,14 @@ int main()
             // Deserialize the stored packet data
             std::string p1_username, p2_username;
             int p1_rating, p2_rating;
-            MessageType dummyType;  // Add this to skip the MessageType in the stored packet
+            WireReader gameStartBody = messageBody(gameStartPacketData); // Past the stored MessageType
             
-            if (gameStartPacketData >> dummyType >> p1_username >> p1_rating >> p2_username >> p2_rating >> gameState) {
+            if (gameStartBody >> p1_username >> p1_rating >> p2_username >> p2_rating) {
+                stateResyncRequested = false;
+                if (!readFullGameState(gameStartBody, gameState, stateSequence, myPlayerSide)) {
+                    std::cerr << "Starting state does not match the server's; requesting a resync." << std::endl;
+                    requestStateResync(socket);
+                }
                 gameHasStarted = true;
                 printBoardState(gameState, myPlayerSide); // Keep this for debugging
 
@@ -1462,7 +1570,7 @@ int main()
         if (status == sf::Socket::Done) {
             std::cout << "Received packet from server" << std::endl;
             MessageType messageType;
-            if (receivedPacket >> messageType) {
+            if (expandCompressed(receivedPacket) && receivedPacket >> messageType) {
                 std::cout << "Message type: " << static_cast<int>(messageType) << std::endl;
                 switch (messageType) {
                     case MessageType::PlayerAssignment:
@@ -1496,12 +1604,27 @@ int main()
                         uiMessage = "Waiting for opponent...";
                         std::cout << uiMessage << std::endl;
                         break;
+                    case MessageType::ServerBusy:
+                        {
+                            sf::Uint32 position = 0;
+                            receivedPacket >> position;
+                            uiMessage = position > 0 ? "Server busy - in login queue at position " + std::to_string(position)
+                                                     : "Server is full. Please try again later.";
+                            std::cout << uiMessage << std::endl;
+                        }
+                        break;
                     case MessageType::GameStart:
                         {
                             std::string p1_username, p2_username;
                             int p1_rating, p2_rating;
+                            WireReader body = messageBody(receivedPacket);
 
-                            if (receivedPacket >> p1_username >> p1_rating >> p2_username >> p2_rating >> gameState) {
+                            if (body >> p1_username >> p1_rating >> p2_username >> p2_rating) {
+                                stateResyncRequested = false;
+                                if (!readFullGameState(body, gameState, stateSequence, myPlayerSide)) {
+                                    std::cerr << "Starting state does not match the server's; requesting a resync." << std::endl;
+                                    requestStateResync(socket);
+                                }
                                 gameHasStarted = true;
                                 printBoardState(gameState, myPlayerSide); // Keep this for debugging
 
@@ -1558,8 +1681,32 @@ int main()
                         }
                         break;
                     case MessageType::GameStateUpdate:
+                    case MessageType::GameStateDelta:
+                    case MessageType::GameEvent:
                         if (gameHasStarted) {
-                            if (receivedPacket >> gameState) { // Deserialize the updated GameState
+                            bool stateUpdated = false;
+                            WireReader body = messageBody(receivedPacket);
+                            if (messageType == MessageType::GameStateUpdate) {
+                                stateUpdated = readFullGameState(body, gameState, stateSequence, myPlayerSide);
+                                if (stateUpdated) {
+                                    stateResyncRequested = false;
+                                } else if (!stateResyncRequested) {
+                                    // Mangled on the way; a state that fails to match in answer to a resync is not asked for again
+                                    std::cerr << "Full state does not match the server's; requesting a resync." << std::endl;
+                                    requestStateResync(socket);
+                                }
+                            } else if (!stateResyncRequested) {
+                                // Replay the action ourselves, or patch in the changes the server sent
+                                stateUpdated = messageType == MessageType::GameEvent
+                                    ? applyGameEvent(body, gameState, stateSequence, myPlayerSide)
+                                    : applyGameStateDelta(body, gameState, stateSequence, myPlayerSide);
+                                if (!stateUpdated) {
+                                    // Missed, mangled or drifted; our board no longer matches the server's
+                                    std::cerr << "State update does not apply to state " << stateSequence << "; requesting a resync." << std::endl;
+                                    requestStateResync(socket);
+                                }
+                            }
+                            if (stateUpdated) {
                                 // uiMessage = (myPlayerSide == gameState.getActivePlayer() ? "Your turn" : "Opponent's turn");
                                 std::cout << "GameState updated. Turn: " << gameState.getTurnNumber() << std::endl;
 
@@ -1575,9 +1722,12 @@ int main()
                                     std::string desc = gameOverDetector.getWinConditionDescription(gameState);
                                     onWinCondition(winner, desc);
                                 }
-                            } else { std::cerr << "Error deserializing GameStateUpdate." << std::endl; }
+                            } else if (messageType == MessageType::GameStateUpdate) { std::cerr << "Error deserializing GameStateUpdate, or its hash did not match." << std::endl; }
                         }
                         break;
+                    case MessageType::Ping:
+                        answerServerPing(socket, receivedPacket);
+                        break;
                     case MessageType::MoveRejected: // Optional
                         uiMessage = "Move rejected by server.";
                         std::cout << uiMessage << std::endl;
@@ -1662,6 +1812,7 @@ int main()
             window.draw(remotePlayerUsernameText);
             window.draw(remotePlayerRatingText);
             window.draw(localPlayerSteamText);
+            window.draw(roundTripText);
         }
 
         // --- Game Board Rendering ---
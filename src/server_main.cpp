@@ -1,17 +1,31 @@
 #include <SFML/Network.hpp>
 #include <iostream>
 #include <vector>
+#include <functional>
 #include <memory>
 #include <thread>
 #include <mutex>
 #include <chrono>
-#include <sqlite3.h> // Added for SQLite
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <optional>
 #include <algorithm> // Added for std::max
 #include <cmath>     // Added for std::pow in Elo calculation
+#include <string>
+#include <cstdlib>   // For parsing command-line options
+#if !defined(_WIN32)
+#include <sys/resource.h> // For raising the open file limit
+#include <sys/wait.h>     // For reaping server processes
+#include <unistd.h>       // For fork/exec of server processes
+#endif
 
 #include "GameState.h"      // For GameState and its sf::Packet operators
+#include "GameStateDelta.h" // For GameStateSnapshot and the GameStateDelta wire format
+#include "GameEvent.h"      // For GameEvent and the GameEvent wire format
 #include "Move.h"           // For Move and its sf::Packet operators
 #include "NetworkProtocol.h"  // For MessageType enum and operators
+#include "ProtocolHandshake.h" // For the ConnectionRequest version and capability negotiation
 #include "GameInitializer.h"  // For initializing the game state
 #include "PlayerSide.h"       // For PlayerSide enum (used in PlayerAssignment)
 #include "GameRules.h"        // For game logic
@@ -21,38 +35,132 @@
 #include "PieceDefinitionManager.h" // For PieceDefinitionManager
 #include "CardCollection.h"  // For Deck and CardCollection
 #include "CardFactory.h"     // For creating cards from IDs
+#include "NetSocket.h"       // For sockets exposing their native handle
+#include "Reactor.h"         // For the readiness-based event loop
+#include "WorkerPool.h"      // For the shared game-logic thread pool
+#include "SessionStrand.h"   // For serialized per-session execution
+#include "ServerTask.h"      // For coroutine-based connection flows
+#include "OutboundQueue.h"   // For buffered, coalesced socket writes
+#include "WireFormat.h"      // For encoding the per-action messages into pooled frames
+#include "MessageCompression.h" // For compressing large messages to clients that support it
+#include "Heartbeat.h"        // For Ping/Pong round trips and spotting dead connections
+#include "ShardedRegistry.h" // For lock-striped client and session lookup
+#include "SessionDirectory.h" // For session ownership and matchmaking across processes
+#include "DirectoryService.h" // For the supervisor's directory of server processes
+#include "AdmissionControl.h" // For connection, login and session caps under overload
+#include "PlayerDatabase.h"  // For pooled SQLite access to accounts, decks and ratings
+#include "DatabaseWriter.h"  // For batching database writes on their own thread
+#include "ProfileCache.h"    // For keeping recent players' profiles in memory
+#include "Leaderboard.h"     // For ranking players without querying the database
 
 using namespace BayouBonanza;
 
 const unsigned short PORT = 50000;
 const int REQUIRED_PLAYERS = 2;
 
+// Unsent bytes a client may fall behind by before it is treated as a stalled reader and dropped
+const std::size_t OUTBOUND_HIGH_WATER_BYTES = 256 * 1024;
+
+// Delay before a finished game is torn down, so its final state reaches both players first
+const std::chrono::milliseconds SESSION_TEARDOWN_DELAY(500);
+
+// Time a player has to finish a turn before it is ended for them
+const std::chrono::seconds TURN_TIME_LIMIT(120);
+
+// Time a new connection has to complete its login
+const std::chrono::seconds LOGIN_TIMEOUT(10);
+
+// Time a login may wait in the admission queue before it is dropped
+const std::chrono::minutes LOGIN_QUEUE_TIMEOUT(2);
+
+// Time without inbound traffic after which a logged-in connection is dropped
+const std::chrono::minutes IDLE_TIMEOUT(15);
+
+// Interval between Pings to clients with Capability::Heartbeat
+const std::chrono::seconds HEARTBEAT_INTERVAL(5);
+
+// Pings in a row a client may leave unanswered before its connection is treated as dead
+const sf::Uint32 HEARTBEAT_MISSES_ALLOWED = 3;
+
+// Time a game with no player connected is kept for a reconnect before it is closed
+const std::chrono::seconds ABANDONED_GAME_GRACE(30);
+
+// Interval between matchmaking batches
+const std::chrono::milliseconds MATCHMAKING_TICK(250);
+
+// Longest a spectator's updates wait to be written; updates in between share one write
+const std::chrono::milliseconds SPECTATOR_FLUSH_DELAY(50);
+
+// How this process was started: one standalone server, a supervisor, or one of its server processes
+struct ServerOptions {
+    int processes = 1;        // --processes N: server processes sharing the port
+    int workerIndex = -1;     // --worker K: set on processes started by the supervisor
+    std::string directoryPath = "/tmp/bayou_bonanza_" + std::to_string(PORT) + ".sock"; // --directory PATH
+    // --max-connections, --max-logins, --max-login-queue, --max-sessions; per server process
+    AdmissionControl::Limits admission;
+    bool loginLimitSet = false; // Without --max-logins, half the worker threads may load profiles
+};
+
 struct GameSession; // Forward declaration
 
 struct ClientConnection {
-    sf::TcpSocket socket;
+    std::uint64_t id = 0;  // Unique per accepted connection
+    NetSocket socket;
     PlayerSide playerSide; // Assign PlayerSide to each connection
     std::string username;  // Player's username
-    int rating = 0;        // Player's rating, default to 0
-    bool connected = false;
-    bool lookingForMatch = false; // Whether the player is actively looking for a match
+    std::atomic<int> rating{0}; // Player's rating; set at login on the reactor, after a game on its session strand
+    std::atomic<bool> connected{false}; // Read by session strands on worker threads
+    OutboundQueue outbound{OUTBOUND_HIGH_WATER_BYTES}; // Packets waiting for the socket to accept them
     CardCollection collection; // Player's owned cards
     Deck deck;                 // Player's current deck
     std::weak_ptr<GameSession> session; // Game this client is in
+    std::weak_ptr<GameSession> watching; // Game this client spectates (reactor thread only)
+    std::deque<std::unique_ptr<sf::Packet>> inbox;         // Received packets not yet taken by the connection flow
+    std::vector<std::unique_ptr<sf::Packet>> sparePackets; // Handled packets to receive into again (reactor thread only)
+    std::coroutine_handle<> reader;                        // Connection flow suspended waiting for inbox data
+    TimerWheel::Clock::time_point connectedAt;
+    TimerWheel::Clock::time_point lastActivity; // Last complete packet received
+    TimerWheel::TimerId idleTimer = 0;          // Reactor thread only
+    Heartbeat heartbeat;                        // Pings sent and round trip measured (reactor thread only)
+    TimerWheel::TimerId heartbeatTimer = 0;     // Next Ping, for clients with Capability::Heartbeat (reactor thread only)
+    bool loginAdmitted = false;                 // Given a login slot by admission control (reactor thread only)
+    CapabilitySet capabilities = 0;             // Agreed in the handshake, or implied by a UserLogin without one
 };
 
-// Global vector to store client connections (needs thread safety if accessed by multiple threads)
-std::vector<std::shared_ptr<ClientConnection>> clients;
-std::mutex clientsMutex; // To protect access to the clients vector
+using ClientHandle = std::shared_ptr<ClientConnection>;
+
+// Every open connection, keyed by connection id
+ShardedRegistry<std::uint64_t, ClientHandle> clientsById;
+// Logged-in connections, keyed by username
+ShardedRegistry<std::string, ClientHandle> clientsByName;
+std::atomic<std::uint64_t> nextConnectionId{1};
 
 struct GameSession {
     GameState gameState;
     std::unique_ptr<TurnManager> turnManager;
     std::shared_ptr<ClientConnection> player1;
     std::shared_ptr<ClientConnection> player2;
+    std::shared_ptr<SessionStrand> strand; // Every access to gameState/turnManager runs here
+    int turnClockTurn = 0;                 // Turn the running turn clock belongs to (strand only)
+    TimerWheel::TimerId turnTimer = 0;     // Pending turn time limit (reactor thread only)
+    std::string usernames[2];              // Seat owners; fixed for the session's lifetime
+    bool tornDown = false;                 // Reactor thread only
+    GameStateSnapshot lastSnapshot;        // State the players were last sent; deltas build on it (strand only)
+    std::uint64_t updateBytes = 0;         // Bytes of GameStateDelta and GameEvent sent to the players (strand only)
+    std::uint64_t fullStateBytes = 0;      // What the same updates would have cost as GameStateUpdate
+
+    // Spectators are fed from their own strand so that however many there are, the players' strand
+    // only hands each update over (see fanOutToSpectators)
+    std::shared_ptr<SessionStrand> spectatorStrand;
+    std::vector<std::shared_ptr<ClientConnection>> spectators; // Spectator strand only
+    std::shared_ptr<const GameStateSnapshot> sharedSnapshot;    // lastSnapshot as handed to the spectator strand (strand only)
+    std::shared_ptr<const GameStateSnapshot> spectatorSnapshot; // State spectators were last sent (spectator strand only)
+    std::atomic<std::size_t> spectatorCount{0};                // Joined and not yet dropped; updates skip the handover at 0
+    std::atomic<std::uint64_t> spectatorFrames{0};             // Updates queued to spectators
 };
-std::vector<std::shared_ptr<GameSession>> gameSessions;
-std::mutex gamesMutex;
+
+// Active games, registered under each participant's username so reconnects are O(1)
+ShardedRegistry<std::string, std::shared_ptr<GameSession>> sessionsByUsername;
 
 // Game logic components
 std::unique_ptr<GameInitializer> gameInitializer; // Will be initialized after PieceFactory setup
@@ -62,16 +170,176 @@ GameRules gameRules; // Game rules for move validation and processing
 PieceDefinitionManager globalPieceDefManager;
 std::unique_ptr<PieceFactory> globalPieceFactory;
 
-// Find an existing game session that involves the given username
-std::shared_ptr<GameSession> findGameSessionByUsername(const std::string& username) {
-    std::lock_guard<std::mutex> gamesLock(gamesMutex);
-    for (auto& session : gameSessions) {
-        if ((session->player1 && session->player1->username == username) ||
-            (session->player2 && session->player2->username == username)) {
-            return session;
+// Event loop owning every client socket and the listener
+Reactor reactor;
+
+// Buffers for the wire-body messages sent on every action; shared by the reactor and the session strands
+FramePool framePool;
+
+// Ratio and CPU time of compressing large messages, per type; reported every STATS_REPORT_INTERVAL
+CompressionStats compressionStats;
+// Pings, dropped connections and round trips; reported every STATS_REPORT_INTERVAL (reactor thread only)
+HeartbeatStats heartbeatStats;
+const std::chrono::seconds STATS_REPORT_INTERVAL(60);
+
+// Session ownership and matchmaking: in-process, or shared with sibling processes (reactor thread only)
+std::unique_ptr<SessionDirectory> directory;
+
+// Caps on connections, concurrent logins and running games; created in main() (reactor thread only)
+std::unique_ptr<AdmissionControl> admission;
+
+// Maximum packets handled per readiness notification so one chatty client cannot starve others
+const int MAX_PACKETS_PER_WAKEUP = 32;
+
+// Packets a client may have queued while its connection flow is busy (e.g. loading the profile)
+const std::size_t MAX_INBOX_PACKETS = 256;
+
+// Workers that execute game logic for all sessions; created in main()
+std::unique_ptr<WorkerPool> workerPool;
+
+// Accounts, decks and ratings; created in main() with a connection per worker, plus one for the writer
+std::unique_ptr<PlayerDatabase> playerDatabase;
+
+// Every database write goes through here, so no game or reactor thread waits on a commit
+std::unique_ptr<DatabaseWriter> databaseWriter;
+
+// Recent players' profiles; logins read through it and rating and deck changes are written back
+std::unique_ptr<ProfileCache> profileCache;
+const std::chrono::seconds PROFILE_FLUSH_INTERVAL(1); // Longest a change stays only in memory
+const char* const DATABASE_PATH = "bayou_bonanza.db";
+
+// Every player's rating, ranked; seeded from the database in main() and kept current as games end
+std::unique_ptr<Leaderboard> leaderboard;
+const sf::Uint32 MAX_LEADERBOARD_NEIGHBOURS = 10; // On each side of the requester
+const std::chrono::seconds LEADERBOARD_RELOAD_INTERVAL(30); // Server processes only, for their siblings' games
+
+void disconnectClient(const std::shared_ptr<ClientConnection>& client);
+
+// Write a client's queued packets; runs on the reactor thread
+void flushClient(const std::shared_ptr<ClientConnection>& client) {
+    if (!client->connected) {
+        return;
+    }
+    sf::SocketHandle handle = client->socket.nativeHandle();
+    switch (client->outbound.flush(handle)) {
+        case OutboundQueue::FlushResult::Drained:
+            reactor.modify(handle, Reactor::Readable);
+            break;
+        case OutboundQueue::FlushResult::WouldBlock:
+            reactor.modify(handle, Reactor::Readable | Reactor::Writable);
+            break;
+        case OutboundQueue::FlushResult::Error:
+            std::cerr << "Error writing to client " << client->username << "; disconnecting" << std::endl;
+            disconnectClient(client);
+            break;
+    }
+}
+
+// @p frame as it goes to clients with Capability::Compression: compressed if it is at least
+// COMPRESSION_THRESHOLD bytes long and gets smaller
+OutboundQueue::Frame compressFrame(const OutboundQueue::Frame& frame) {
+    const std::size_t size = frame->size() - FramePool::PREFIX_BYTES;
+    if (size < COMPRESSION_THRESHOLD) {
+        return frame;
+    }
+    const char* message = frame->data() + FramePool::PREFIX_BYTES;
+    auto start = std::chrono::steady_clock::now();
+    bool compressed = false;
+    OutboundQueue::Frame wrapped = framePool.build([&](WireWriter& writer) {
+        compressed = writeCompressed(writer, message, size);
+    });
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    if (!wrapped || !compressed) {
+        compressionStats.record(static_cast<MessageType>(message[0]), size, size, false, nanos.count());
+        return frame;
+    }
+    compressionStats.record(static_cast<MessageType>(message[0]), size, wrapped->size() - FramePool::PREFIX_BYTES,
+                            true, nanos.count());
+    return wrapped;
+}
+
+// Queue a frame exactly as it is; @p needsFlush is set when the queue was idle and the caller must
+// get flushClient() run for it. Safe to call from the reactor thread and from session strands.
+sf::Socket::Status queueFrame(const std::shared_ptr<ClientConnection>& client, const OutboundQueue::Frame& frame,
+                              bool& needsFlush) {
+    needsFlush = false;
+    switch (client->outbound.push(frame)) {
+        case OutboundQueue::PushResult::Queued:
+            return sf::Socket::Done;
+        case OutboundQueue::PushResult::ScheduleFlush:
+            needsFlush = true;
+            return sf::Socket::Done;
+        case OutboundQueue::PushResult::OverHighWater:
+            // Policy: a reader this far behind will not catch up, so drop it rather than buffer without bound
+            std::cerr << "Client " << client->username << " exceeded the " << OUTBOUND_HIGH_WATER_BYTES
+                      << " byte outbound limit; disconnecting" << std::endl;
+            reactor.post([client]() { disconnectClient(client); });
+            return sf::Socket::Disconnected;
+        case OutboundQueue::PushResult::Closed:
+        default:
+            return sf::Socket::Disconnected;
+    }
+}
+
+// Queue an encoded packet for a client, compressed if it agreed to that; safe to call from the reactor
+// thread and from session strands. Everything queued before the reactor gets to the flush goes out in one write.
+sf::Socket::Status sendFrame(const std::shared_ptr<ClientConnection>& client, const OutboundQueue::Frame& frame) {
+    bool needsFlush = false;
+    sf::Socket::Status status = queueFrame(
+        client, hasCapability(client->capabilities, Capability::Compression) ? compressFrame(frame) : frame, needsFlush);
+    if (needsFlush) {
+        reactor.post([client]() { flushClient(client); });
+    }
+    return status;
+}
+
+sf::Socket::Status sendPacket(const std::shared_ptr<ClientConnection>& client, const sf::Packet& packet) {
+    return sendFrame(client, OutboundQueue::makeFrame(packet));
+}
+
+// Encode a wire-body message straight into a pooled frame; @p write may run more than once
+template <typename Write>
+sf::Socket::Status sendMessage(const std::shared_ptr<ClientConnection>& client, Write&& write) {
+    OutboundQueue::Frame frame = framePool.build(write);
+    if (!frame) {
+        return sf::Socket::Error;
+    }
+    return sendFrame(client, frame);
+}
+
+// One message for any number of recipients: encoded on first use, compressed at most once, and
+// queued to every recipient as the same immutable buffer
+class SharedFrame {
+public:
+    using Encode = std::function<OutboundQueue::Frame()>;
+
+    explicit SharedFrame(Encode encode) : encode(std::move(encode)) {}
+
+    // The frame for @p client; nullptr if the message does not fit in a frame
+    const OutboundQueue::Frame& forClient(const ClientConnection& client) {
+        if (!encoded) {
+            plain = encode();
+            encoded = true;
+        }
+        if (!plain || !hasCapability(client.capabilities, Capability::Compression)) {
+            return plain;
+        }
+        if (!compressed) {
+            compressed = compressFrame(plain);
         }
+        return compressed;
     }
-    return nullptr;
+
+private:
+    Encode encode;
+    bool encoded = false;
+    OutboundQueue::Frame plain;
+    OutboundQueue::Frame compressed;
+};
+
+// Find an existing game session that involves the given username
+std::shared_ptr<GameSession> findGameSessionByUsername(const std::string& username) {
+    return sessionsByUsername.find(username);
 }
 
 // Helper function to find piece at position and reconstruct move
@@ -133,21 +401,126 @@ void printCardHands(const GameState& gameState) {
     std::cout << "=========================" << std::endl;
 }
 
-void broadcastGameState(std::shared_ptr<GameSession> session) {
+// Queue one update to every spectator of a session; runs on the spectator strand. Each form of the
+// update is encoded once and the same buffer goes to every queue. The queues that were idle are
+// flushed together after SPECTATOR_FLUSH_DELAY, so the reactor writes to each spectator at most
+// that often rather than once per action.
+void fanOutToSpectators(const std::shared_ptr<GameSession>& session,
+                        const std::shared_ptr<const GameStateSnapshot>& snapshot) {
+    SharedFrame delta([&]() {
+        return framePool.build([&](WireWriter& writer) {
+            writer << MessageType::GameStateDelta;
+            snapshot->writeDelta(writer, session->spectatorSnapshot ? *session->spectatorSnapshot : GameStateSnapshot(),
+                                 SPECTATOR_VIEWER);
+        });
+    });
+    SharedFrame full([&]() {
+        return framePool.build([&](WireWriter& writer) {
+            writer << MessageType::GameStateUpdate;
+            snapshot->writeFull(writer, SPECTATOR_VIEWER);
+        });
+    });
+
+    std::vector<std::shared_ptr<ClientConnection>> idle;
+    auto& spectators = session->spectators;
+    for (std::size_t i = 0; i < spectators.size();) {
+        const std::shared_ptr<ClientConnection>& spectator = spectators[i];
+        bool needsFlush = false;
+        if (spectator->connected) {
+            SharedFrame& update = hasCapability(spectator->capabilities, Capability::StateDeltas) ? delta : full;
+            const OutboundQueue::Frame& frame = update.forClient(*spectator);
+            if (!frame || queueFrame(spectator, frame, needsFlush) == sf::Socket::Done) {
+                if (needsFlush) {
+                    idle.push_back(spectator);
+                }
+                ++i;
+                continue;
+            }
+        }
+        // Gone, or too far behind to keep; order among spectators does not matter
+        spectators[i] = std::move(spectators.back());
+        spectators.pop_back();
+        session->spectatorCount--;
+    }
+    session->spectatorFrames += spectators.size();
+    session->spectatorSnapshot = snapshot;
+
+    if (!idle.empty()) {
+        reactor.post([idle = std::move(idle)]() {
+            reactor.timers().schedule(SPECTATOR_FLUSH_DELAY, [idle]() {
+                for (const auto& spectator : idle) {
+                    flushClient(spectator);
+                }
+            });
+        });
+    }
+}
+
+// The players' last snapshot for the spectator strand to read; copied at most once per update however
+// many spectators join (session strand only)
+std::shared_ptr<const GameStateSnapshot> shareLastSnapshot(GameSession& session) {
+    if (!session.sharedSnapshot || session.sharedSnapshot->sequence() != session.lastSnapshot.sequence()) {
+        session.sharedSnapshot = std::make_shared<const GameStateSnapshot>(session.lastSnapshot);
+    }
+    return session.sharedSnapshot;
+}
+
+// Send the players the state after an action, each in the cheapest form their client understands:
+// @p event to replay when there is one, else a delta, else the full state.
+void broadcastGameState(std::shared_ptr<GameSession> session, const GameEvent* event = nullptr) {
     if (!session) return;
-    sf::Packet updatePacket;
-    updatePacket << MessageType::GameStateUpdate << session->gameState;
+    // Encoded once; each player's delta reuses the board bytes and differs only in the hands
+    GameStateSnapshot snapshot(session->gameState, session->lastSnapshot.sequence() + 1);
 
     // Print card hands for debugging
     printCardHands(session->gameState);
 
-    for (auto& client : {session->player1, session->player2}) {
-        if (client && client->connected) {
-            if (client->socket.send(updatePacket) != sf::Socket::Done) {
-                std::cerr << "Error sending game state update to client "
-                          << client->socket.getRemoteAddress() << std::endl;
+    const std::pair<std::shared_ptr<ClientConnection>, PlayerSide> seats[] = {
+        {session->player1, PlayerSide::PLAYER_ONE}, {session->player2, PlayerSide::PLAYER_TWO}};
+    for (const auto& [client, side] : seats) {
+        if (!client || !client->connected) {
+            continue;
+        }
+        OutboundQueue::Frame frame;
+        StateUpdateMode mode = stateUpdateModeFor(client->capabilities, event != nullptr);
+        if (mode == StateUpdateMode::Events) {
+            // A few bytes to replay, with a periodic hash so a client that drifted asks for a resync
+            std::optional<sf::Uint64> stateHash;
+            if (snapshot.sequence() % GameEvent::STATE_HASH_INTERVAL == 0 || gameRules.isGameOver(session->gameState)) {
+                stateHash = session->gameState.hash(side);
             }
+            frame = framePool.build([&](WireWriter& writer) {
+                writer << MessageType::GameEvent;
+                event->write(writer, snapshot.sequence(), side, stateHash);
+            });
+        } else if (mode == StateUpdateMode::Deltas) {
+            // Only what changed since the last state the player was sent; the opponent's hand as a count
+            frame = framePool.build([&](WireWriter& writer) {
+                writer << MessageType::GameStateDelta;
+                snapshot.writeDelta(writer, session->lastSnapshot, side);
+            });
+        } else {
+            frame = framePool.build([&](WireWriter& writer) {
+                writer << MessageType::GameStateUpdate;
+                snapshot.writeFull(writer, side);
+            });
         }
+        if (!frame) {
+            continue;
+        }
+        session->updateBytes += frame->size() - FramePool::PREFIX_BYTES;
+        session->fullStateBytes += sizeof(sf::Uint8) + snapshot.fullSize(side);
+        if (sendFrame(client, frame) != sf::Socket::Done) {
+            std::cerr << "Error sending game state update to client "
+                      << client->socket.getRemoteAddress() << std::endl;
+        }
+    }
+    session->lastSnapshot = std::move(snapshot);
+    if (session->spectatorCount.load(std::memory_order_relaxed) > 0) {
+        // The players' part ends with one copy of the snapshot; encoding and queueing for spectators
+        // happens on their strand, however many there are
+        auto shared = shareLastSnapshot(*session);
+        session->spectatorStrand->post([session, shared]() { fanOutToSpectators(session, shared); });
     }
 }
 
@@ -157,7 +530,7 @@ void sendMoveRejection(std::shared_ptr<ClientConnection> client, const std::stri
     rejectPacket << MessageType::MoveRejected;
     // Note: Could add reason string if MessageType::MoveRejected supports it
     
-    if (client->socket.send(rejectPacket) != sf::Socket::Done) {
+    if (sendPacket(client, rejectPacket) != sf::Socket::Done) {
         std::cerr << "Error sending move rejection to client " 
                   << client->socket.getRemoteAddress() << std::endl;
     }
@@ -171,7 +544,7 @@ void sendCardPlayRejection(std::shared_ptr<ClientConnection> client, const std::
     rejectPacket << MessageType::CardPlayRejected;
     // Note: Could add reason string if MessageType::CardPlayRejected supports it
     
-    if (client->socket.send(rejectPacket) != sf::Socket::Done) {
+    if (sendPacket(client, rejectPacket) != sf::Socket::Done) {
         std::cerr << "Error sending card play rejection to client " 
                   << client->socket.getRemoteAddress() << std::endl;
     }
@@ -180,603 +553,1607 @@ void sendCardPlayRejection(std::shared_ptr<ClientConnection> client, const std::
               << ": " << reason << std::endl;
 }
 
-void tryStartMatchmaking() {
-    std::lock_guard<std::mutex> lock(clientsMutex);
-    
-    // Find two players who are looking for a match
-    std::vector<std::shared_ptr<ClientConnection>> matchmakers;
-    for (auto& client : clients) {
-        if (client->lookingForMatch && client->connected) {
-            matchmakers.push_back(client);
-            if (matchmakers.size() == 2) break;
-        }
+// Report how a finished session's strand behaved
+void logSessionStats(const GameSession& session) {
+    if (!session.strand) return;
+    SessionStrand::Stats stats = session.strand->stats();
+    double avgMicros = stats.tasksRun ? stats.totalRunNanos / 1000.0 / stats.tasksRun : 0.0;
+    std::cout << "Session " << (session.player1 ? session.player1->username : "?") << " vs "
+              << (session.player2 ? session.player2->username : "?") << ": "
+              << stats.tasksRun << " actions, avg " << avgMicros << "us, max "
+              << stats.maxRunNanos / 1000 << "us, max queue depth " << stats.maxQueueDepth
+              << ", state updates " << session.updateBytes << " bytes (" << session.fullStateBytes
+              << " as full snapshots), " << session.spectatorFrames << " spectator updates";
+    SessionStrand::Stats fanOut = session.spectatorStrand->stats();
+    if (session.spectatorFrames > 0) {
+        std::cout << " (fan-out avg " << fanOut.totalRunNanos / 1000.0 / fanOut.tasksRun << "us, max "
+                  << fanOut.maxRunNanos / 1000 << "us)";
     }
-    
-    if (matchmakers.size() == 2) {
-        std::cout << "Found two players looking for a match. Starting game..." << std::endl;
-        
-        // Assign player sides
-        matchmakers[0]->playerSide = PlayerSide::PLAYER_ONE;
-        matchmakers[1]->playerSide = PlayerSide::PLAYER_TWO;
-        
-        // Send PlayerAssignment messages to inform clients of their sides
-        sf::Packet assignment1;
-        assignment1 << MessageType::PlayerAssignment << matchmakers[0]->playerSide;
-        if (matchmakers[0]->socket.send(assignment1) != sf::Socket::Done) {
-            std::cerr << "Error sending PlayerAssignment to " << matchmakers[0]->username << std::endl;
-        } else {
-            std::cout << "PlayerAssignment sent to " << matchmakers[0]->username << " (PLAYER_ONE)" << std::endl;
-        }
-        
-        sf::Packet assignment2;
-        assignment2 << MessageType::PlayerAssignment << matchmakers[1]->playerSide;
-        if (matchmakers[1]->socket.send(assignment2) != sf::Socket::Done) {
-            std::cerr << "Error sending PlayerAssignment to " << matchmakers[1]->username << std::endl;
-        } else {
-            std::cout << "PlayerAssignment sent to " << matchmakers[1]->username << " (PLAYER_TWO)" << std::endl;
-        }
-        
-        // Clear their matchmaking flags
-        matchmakers[0]->lookingForMatch = false;
-        matchmakers[1]->lookingForMatch = false;
-        
-        // Create a new game session
-        auto session = std::make_shared<GameSession>();
-        gameInitializer->initializeNewGame(session->gameState, matchmakers[0]->deck, matchmakers[1]->deck);
-        session->turnManager = std::make_unique<TurnManager>(session->gameState, gameRules);
-        session->player1 = matchmakers[0];
-        session->player2 = matchmakers[1];
-
-        {
-            std::lock_guard<std::mutex> gamesLock(gamesMutex);
-            gameSessions.push_back(session);
+    std::cout << std::endl;
+}
+
+// Resend the last state the players were sent, so later deltas apply on top of it; runs on the session strand
+void sendFullState(const std::shared_ptr<ClientConnection>& client, const GameSession& session) {
+    sendMessage(client, [&](WireWriter& writer) {
+        writer << MessageType::GameStateUpdate;
+        session.lastSnapshot.writeFull(writer, client->playerSide);
+    });
+}
+
+// Drop a finished session; runs on the reactor thread once the teardown delay has passed
+void teardownSession(const std::shared_ptr<GameSession>& session) {
+    if (session->tornDown) {
+        return;
+    }
+    session->tornDown = true;
+    admission->sessionEnded();
+
+    for (const std::string& username : session->usernames) {
+        if (sessionsByUsername.eraseIfEqual(username, session)) {
+            directory->release(username);
         }
-        matchmakers[0]->session = session;
-        matchmakers[1]->session = session;
-
-        // Debug: Print board state after initialization
-
-        const GameBoard& board = session->gameState.getBoard();
-        for (int y = 0; y < GameBoard::BOARD_SIZE; y++) {
-            std::cout << y << " | ";
-            for (int x = 0; x < GameBoard::BOARD_SIZE; x++) {
-                const Square& square = board.getSquare(x, y);
-                char symbol = '.';
-                if (!square.isEmpty()) {
-                    Piece* piece = square.getPiece();
-                    std::string symbol_str = piece->getSymbol();
-                    symbol = symbol_str.empty() ? '.' : symbol_str[0];
-                    if (piece->getSide() == PlayerSide::PLAYER_TWO) {
-                        symbol = std::tolower(symbol);
-                    }
+    }
+    reactor.timers().cancel(session->turnTimer);
+    session->turnTimer = 0;
+
+    // Seats belong to the strand; read them there, then unlink the clients back on the reactor.
+    // Spectators are let go behind any join already passed on to their strand.
+    session->strand->post([session]() {
+        session->spectatorStrand->post([session]() {
+            session->spectatorCount -= session->spectators.size();
+            session->spectators.clear();
+        });
+        logSessionStats(*session);
+        auto player1 = session->player1;
+        auto player2 = session->player2;
+        reactor.post([session, player1, player2]() {
+            for (auto& player : {player1, player2}) {
+                if (player && player->session.lock() == session) {
+                    player->session.reset();
                 }
-                std::cout << symbol << ' ';
             }
-            std::cout << "|" << std::endl;
+        });
+    });
+}
+
+// Tear a finished game down after a short delay so clients won't auto-resume it; callable from any thread
+void scheduleSessionCleanup(const std::shared_ptr<GameSession>& session) {
+    reactor.post([session]() {
+        reactor.timers().cancel(session->turnTimer);
+        session->turnTimer = 0;
+        reactor.timers().schedule(SESSION_TEARDOWN_DELAY, [session]() {
+            teardownSession(session);
+        });
+    });
+}
+
+void onTurnTimeout(const std::shared_ptr<GameSession>& session, int turn);
+
+// Restart the turn clock whenever the turn has changed; runs on the session strand
+void updateTurnClock(const std::shared_ptr<GameSession>& session) {
+    if (gameRules.isGameOver(session->gameState)) {
+        return; // scheduleSessionCleanup stops the clock
+    }
+    int turn = session->gameState.getTurnNumber();
+    if (turn == session->turnClockTurn) {
+        return;
+    }
+    session->turnClockTurn = turn;
+    reactor.post([session, turn]() {
+        reactor.timers().cancel(session->turnTimer);
+        session->turnTimer = reactor.timers().schedule(TURN_TIME_LIMIT, [session, turn]() {
+            session->turnTimer = 0;
+            session->strand->post([session, turn]() {
+                onTurnTimeout(session, turn);
+            });
+        });
+    });
+}
+
+// Whether either seat's connection is still open; runs on the session strand
+bool anyPlayerConnected(const GameSession& session) {
+    for (auto& player : {session.player1, session.player2}) {
+        if (player && player->connected) {
+            return true;
         }
-        
-        // Print initial card hands
-        printCardHands(session->gameState);
-        
-        std::cout << "Game initialized. Broadcasting GameStart and initial state." << std::endl;
+    }
+    return false;
+}
 
-        // Prepare extended GameStart message data
-        std::string p1_username = matchmakers[0]->username;
-        int p1_rating = matchmakers[0]->rating;
-        std::string p2_username = matchmakers[1]->username;
-        int p2_rating = matchmakers[1]->rating;
+// Close a game once its players have all been gone for ABANDONED_GAME_GRACE, instead of
+// ending its turns until the turn clock notices; runs on the reactor thread
+void scheduleAbandonCheck(const std::shared_ptr<GameSession>& session) {
+    reactor.timers().schedule(ABANDONED_GAME_GRACE, [session]() {
+        if (session->tornDown) {
+            return;
+        }
+        session->strand->post([session]() {
+            if (gameRules.isGameOver(session->gameState) || anyPlayerConnected(*session)) {
+                return; // Already closing, or someone came back
+            }
+            std::cout << "No players connected for " << ABANDONED_GAME_GRACE.count() << "s; closing the game" << std::endl;
+            scheduleSessionCleanup(session);
+        });
+    });
+}
 
-        std::cout << "P1: " << p1_username << " (" << p1_rating << "), P2: " << p2_username << " (" << p2_rating << ")" << std::endl;
+// Continue a connection flow that is waiting for input or for the connection to close
+void resumeReader(ClientConnection& client);
 
-        // Send GameStart, usernames, ratings, and initial GameState to both players
-        sf::Packet gameStartPacket; // Create one packet for both
-        gameStartPacket << MessageType::GameStart
-                        << p1_username << p1_rating
-                        << p2_username << p2_rating
-                        << session->gameState;
+// Stop watching a client socket, close it and drop it from the connected list
+void disconnectClient(const std::shared_ptr<ClientConnection>& client) {
+    if (!client->connected) {
+        return;
+    }
+    client->connected = false;
+    reactor.timers().cancel(client->idleTimer);
+    client->idleTimer = 0;
+    reactor.timers().cancel(client->heartbeatTimer);
+    client->heartbeatTimer = 0;
+    client->outbound.close();
+    reactor.remove(client->socket.nativeHandle());
+    client->socket.disconnect();
+    client->inbox.clear();
+    client->sparePackets.clear();
+
+    clientsById.erase(client->id);
+    admission->connectionClosed();
+    directory->dequeue(client->id);
+    if (!client->username.empty()) {
+        // A newer login under the same name keeps its entry
+        clientsByName.eraseIfEqual(client->username, client);
+    }
+    std::cout << "Client removed. Current client count: " << clientsByName.size() << std::endl;
+    if (auto session = client->session.lock()) {
+        scheduleAbandonCheck(session);
+    }
+    resumeReader(*client); // Let a suspended connection flow observe the disconnect and finish
+}
 
-        if (matchmakers[0]->socket.send(gameStartPacket) != sf::Socket::Done) {
-            std::cerr << "Error sending GameStart packet to " << matchmakers[0]->username << std::endl;
+// Start a game between two players the matchmaker paired; runs on the reactor thread
+void startMatch(const ClientHandle& first, const ClientHandle& second) {
+    std::vector<std::shared_ptr<ClientConnection>> matchmakers{first, second};
+    std::cout << "Paired " << first->username << " (" << first->rating << ") with "
+          << second->username << " (" << second->rating << "). Starting game..." << std::endl;
+    
+    // Assign player sides
+    matchmakers[0]->playerSide = PlayerSide::PLAYER_ONE;
+    matchmakers[1]->playerSide = PlayerSide::PLAYER_TWO;
+    
+    // Send PlayerAssignment messages to inform clients of their sides
+    sf::Packet assignment1;
+    assignment1 << MessageType::PlayerAssignment << matchmakers[0]->playerSide;
+    if (sendPacket(matchmakers[0], assignment1) != sf::Socket::Done) {
+        std::cerr << "Error sending PlayerAssignment to " << matchmakers[0]->username << std::endl;
+    } else {
+        std::cout << "PlayerAssignment sent to " << matchmakers[0]->username << " (PLAYER_ONE)" << std::endl;
+    }
+    
+    sf::Packet assignment2;
+    assignment2 << MessageType::PlayerAssignment << matchmakers[1]->playerSide;
+    if (sendPacket(matchmakers[1], assignment2) != sf::Socket::Done) {
+        std::cerr << "Error sending PlayerAssignment to " << matchmakers[1]->username << std::endl;
+    } else {
+        std::cout << "PlayerAssignment sent to " << matchmakers[1]->username << " (PLAYER_TWO)" << std::endl;
+    }
+    
+    // Create a new game session
+    auto session = std::make_shared<GameSession>();
+    gameInitializer->initializeNewGame(session->gameState, matchmakers[0]->deck, matchmakers[1]->deck);
+    session->turnManager = std::make_unique<TurnManager>(session->gameState, gameRules);
+    session->player1 = matchmakers[0];
+    session->player2 = matchmakers[1];
+    session->strand = SessionStrand::create(*workerPool);
+    session->spectatorStrand = SessionStrand::create(*workerPool);
+    session->strand->post([session]() { updateTurnClock(session); });
+
+    session->usernames[0] = matchmakers[0]->username;
+    session->usernames[1] = matchmakers[1]->username;
+    sessionsByUsername.insert(session->usernames[0], session);
+    sessionsByUsername.insert(session->usernames[1], session);
+    directory->claim(session->usernames[0]); // Reconnects to any process are routed here
+    directory->claim(session->usernames[1]);
+    matchmakers[0]->session = session;
+    matchmakers[1]->session = session;
+
+    // Debug: Print board state after initialization
+
+    const GameBoard& board = session->gameState.getBoard();
+    for (int y = 0; y < GameBoard::BOARD_SIZE; y++) {
+        std::cout << y << " | ";
+        for (int x = 0; x < GameBoard::BOARD_SIZE; x++) {
+            const Square& square = board.getSquare(x, y);
+            char symbol = '.';
+            if (!square.isEmpty()) {
+                Piece* piece = square.getPiece();
+                std::string symbol_str = piece->getSymbol();
+                symbol = symbol_str.empty() ? '.' : symbol_str[0];
+                if (piece->getSide() == PlayerSide::PLAYER_TWO) {
+                    symbol = std::tolower(symbol);
+                }
+            }
+            std::cout << symbol << ' ';
+        }
+        std::cout << "|" << std::endl;
+    }
+    
+    // Print initial card hands
+    printCardHands(session->gameState);
+    
+    std::cout << "Game initialized. Broadcasting GameStart and initial state." << std::endl;
+
+    // Prepare extended GameStart message data
+    std::string p1_username = matchmakers[0]->username;
+    int p1_rating = matchmakers[0]->rating;
+    std::string p2_username = matchmakers[1]->username;
+    int p2_rating = matchmakers[1]->rating;
+
+    std::cout << "P1: " << p1_username << " (" << p1_rating << "), P2: " << p2_username << " (" << p2_rating << ")" << std::endl;
+
+    // Send GameStart, usernames, ratings, and each player's view of the initial GameState
+    session->lastSnapshot = GameStateSnapshot(session->gameState, 1);
+    for (const auto& player : matchmakers) {
+        sf::Socket::Status sent = sendMessage(player, [&](WireWriter& writer) {
+            writer << MessageType::GameStart
+                   << p1_username << p1_rating
+                   << p2_username << p2_rating;
+            session->lastSnapshot.writeFull(writer, player->playerSide);
+        });
+
+        if (sent != sf::Socket::Done) {
+            std::cerr << "Error sending GameStart packet to " << player->username << std::endl;
         } else {
-            std::cout << "GameStart packet sent to " << matchmakers[0]->username << std::endl;
+            std::cout << "GameStart packet sent to " << player->username << std::endl;
         }
+    }
+}
 
-        if (matchmakers[1]->socket.send(gameStartPacket) != sf::Socket::Done) {
-            std::cerr << "Error sending GameStart packet to " << matchmakers[1]->username << std::endl;
-        } else {
-            std::cout << "GameStart packet sent to " << matchmakers[1]->username << std::endl;
+// Whether a connection can still be seated in a new game
+bool readyForMatch(const ClientHandle& client) {
+    return client && client->connected && !client->session.lock();
+}
+
+// The directory paired two players connected to this process; runs on the reactor thread
+void onMatchFound(SessionDirectory::TicketId firstId, SessionDirectory::TicketId secondId) {
+    ClientHandle first = clientsById.find(firstId);
+    ClientHandle second = clientsById.find(secondId);
+    bool firstReady = readyForMatch(first);
+    bool secondReady = readyForMatch(second);
+    if (firstReady && secondReady) {
+        if (admission->tryStartSession()) {
+            startMatch(first, second);
+            return;
         }
+        // At the session cap: both keep waiting and are paired again once a game ends
+        std::cout << "Session limit reached; deferring " << first->username << " vs " << second->username << std::endl;
+    }
+    // Put a survivor back in the queue
+    if (firstReady) {
+        directory->enqueue(firstId, first->rating);
+    }
+    if (secondReady) {
+        directory->enqueue(secondId, second->rating);
     }
 }
 
-void handle_client(std::shared_ptr<ClientConnection> client) {
-    std::cout << "Thread started for client: " << client->socket.getRemoteAddress() 
-              << ":" << client->socket.getRemotePort() << std::endl;
-    client->connected = true;
+// Validate and apply a move; runs on the session strand
+void applyMoveToSession(const std::shared_ptr<ClientConnection>& client,
+                        const std::shared_ptr<GameSession>& session,
+                        const Move& clientMove) {
+    // Reconstruct the move with the actual piece reference
+    Move completeMove = reconstructMoveWithPiece(clientMove, session->gameState);
+    
+    if (!completeMove.getPiece()) {
+        sendMoveRejection(client, "No piece at source position");
+        return;
+    }
+    
+    // Verify the move is from the correct player
+    if (completeMove.getPiece()->getSide() != client->playerSide) {
+        sendMoveRejection(client, "Cannot move opponent's piece");
+        return;
+    }
+    
+    // Verify it's the client's turn
+    if (client->playerSide != session->gameState.getActivePlayer()) {
+        sendMoveRejection(client, "Not your turn");
+        return;
+    }
 
-    sf::Socket::Status status;
-    while (client->connected) {
-        sf::Packet packet;
-        status = client->socket.receive(packet);
 
-        if (status == sf::Socket::Done) {
-            // Received data from client
-            MessageType messageType;
-            if (!(packet >> messageType)) {
-                std::cerr << "Error deserializing message type from " 
-                          << client->socket.getRemoteAddress() << std::endl;
-                continue; // Try to receive next packet
-            }
-            std::cout << "Received message type: " << static_cast<int>(messageType) 
-                      << " from " << client->socket.getRemoteAddress() << std::endl;
+    // Process the move using TurnManager
+    if (session->turnManager) {
+        bool moveProcessed = false;
+        std::string resultMessage;
 
-            if (messageType == MessageType::MoveToServer) {
-                auto session = client->session.lock();
-                if (!session) {
-                    sendMoveRejection(client, "Not in a game");
-                    continue;
-                }
-                Move clientMove;
-                if (packet >> clientMove) { // Deserialize the rest of the packet as Move
-                    std::cout << "Move received: "
-                              << clientMove.getFrom().x << "," << clientMove.getFrom().y
-                              << " -> "
-                              << clientMove.getTo().x << "," << clientMove.getTo().y << std::endl;
-
-                    // Reconstruct the move with the actual piece reference
-                    Move completeMove = reconstructMoveWithPiece(clientMove, session->gameState);
-                    
-                    if (!completeMove.getPiece()) {
-                        sendMoveRejection(client, "No piece at source position");
-                        continue;
-                    }
-                    
-                    // Verify the move is from the correct player
-                    if (completeMove.getPiece()->getSide() != client->playerSide) {
-                        sendMoveRejection(client, "Cannot move opponent's piece");
-                        continue;
-                    }
-                    
-                    // Verify it's the client's turn
-                    if (client->playerSide != session->gameState.getActivePlayer()) {
-                        sendMoveRejection(client, "Not your turn");
-                        continue;
-                    }
+        GameEvent event = GameEvent::move(session->gameState, completeMove.getFrom(), completeMove.getTo());
+        session->turnManager->processMoveAction(completeMove, [&](const ActionResult& result) {
+            moveProcessed = true;
+            resultMessage = result.message;
 
+            if (result.success) {
+                std::cout << "Move processed successfully: " << result.message << std::endl;
 
-                    // Process the move using TurnManager
-                    if (session->turnManager) {
-                        bool moveProcessed = false;
-                        std::string resultMessage;
-
-                        session->turnManager->processMoveAction(completeMove, [&](const ActionResult& result) {
-                            moveProcessed = true;
-                            resultMessage = result.message;
-
-                            if (result.success) {
-                                std::cout << "Move processed successfully: " << result.message << std::endl;
-
-                                // Broadcast updated game state to all clients
-                                broadcastGameState(session);
-
-                                // Check for game over and update ratings
-                                if (gameRules.isGameOver(session->gameState)) {
-                                    std::cout << "Game Over detected." << std::endl;
-
-                                    // Schedule session cleanup to prevent reconnection to finished games
-                                    {
-                                        auto session_to_cleanup = session;
-                                        std::thread([session_to_cleanup]() {
-                                            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                                            {
-                                                std::lock_guard<std::mutex> lock(gamesMutex);
-                                                gameSessions.erase(std::remove_if(gameSessions.begin(), gameSessions.end(),
-                                                    [&](const std::shared_ptr<GameSession>& s){ return s.get() == session_to_cleanup.get(); }),
-                                                    gameSessions.end());
-                                            }
-                                            if (session_to_cleanup->player1) session_to_cleanup->player1->session.reset();
-                                            if (session_to_cleanup->player2) session_to_cleanup->player2->session.reset();
-                                        }).detach();
-                                    }
-
-                                    PlayerSide winner = PlayerSide::NEUTRAL; // Default to draw
-                                    if (gameRules.hasPlayerWon(session->gameState, PlayerSide::PLAYER_ONE)) {
-                                        winner = PlayerSide::PLAYER_ONE;
-                                    } else if (gameRules.hasPlayerWon(session->gameState, PlayerSide::PLAYER_TWO)) {
-                                        winner = PlayerSide::PLAYER_TWO;
-                                    }
-
-                                    auto player1_conn = session->player1;
-                                    auto player2_conn = session->player2;
-
-                                    if (!player1_conn || !player2_conn) {
-                                        std::cerr << "Error: Could not find player connections for rating update." << std::endl;
-                                    } else {
-                                        int p1_old_rating = player1_conn->rating;
-                                        int p2_old_rating = player2_conn->rating;
-
-                                        // Elo rating calculation with +1000 adjustment
-                                        int p1_rating_adjusted = p1_old_rating + 1000;
-                                        int p2_rating_adjusted = p2_old_rating + 1000;
-
-                                        // Calculate expected scores
-                                        double expected_p1 = 1.0 / (1.0 + std::pow(10.0, (p2_rating_adjusted - p1_rating_adjusted) / 400.0));
-                                        double expected_p2 = 1.0 / (1.0 + std::pow(10.0, (p1_rating_adjusted - p2_rating_adjusted) / 400.0));
-
-                                        // K-factor for rating changes
-                                        const int K_FACTOR = 32;
-
-                                        // Calculate new adjusted ratings based on game outcome
-                                        int p1_new_rating_adjusted, p2_new_rating_adjusted;
-                                        if (winner == PlayerSide::PLAYER_ONE) {
-                                            // Player 1 wins
-                                            p1_new_rating_adjusted = p1_rating_adjusted + static_cast<int>(K_FACTOR * (1 - expected_p1));
-                                            p2_new_rating_adjusted = p2_rating_adjusted + static_cast<int>(K_FACTOR * (0 - expected_p2));
-                                            std::cout << "Player 1 (" << player1_conn->username << ") wins." << std::endl;
-                                        } else if (winner == PlayerSide::PLAYER_TWO) {
-                                            // Player 2 wins
-                                            p1_new_rating_adjusted = p1_rating_adjusted + static_cast<int>(K_FACTOR * (0 - expected_p1));
-                                            p2_new_rating_adjusted = p2_rating_adjusted + static_cast<int>(K_FACTOR * (1 - expected_p2));
-                                            std::cout << "Player 2 (" << player2_conn->username << ") wins." << std::endl;
-                                        } else {
-                                            // Draw
-                                            p1_new_rating_adjusted = p1_rating_adjusted + static_cast<int>(K_FACTOR * (0.5 - expected_p1));
-                                            p2_new_rating_adjusted = p2_rating_adjusted + static_cast<int>(K_FACTOR * (0.5 - expected_p2));
-                                            std::cout << "Game is a draw." << std::endl;
-                                        }
-
-                                        // Subtract 1000 adjustment and clamp to 0 minimum
-                                        int p1_new_rating = std::max(0, p1_new_rating_adjusted - 1000);
-                                        int p2_new_rating = std::max(0, p2_new_rating_adjusted - 1000);
-
-                                        sqlite3* db;
-                                        if (sqlite3_open("bayou_bonanza.db", &db) == SQLITE_OK) {
-                                            const char* sql_update = "UPDATE users SET rating = ? WHERE username = ?;";
-                                            sqlite3_stmt* stmt_update;
-
-                                            if (sqlite3_prepare_v2(db, sql_update, -1, &stmt_update, 0) == SQLITE_OK) {
-                                                sqlite3_bind_int(stmt_update, 1, p1_new_rating);
-                                                sqlite3_bind_text(stmt_update, 2, player1_conn->username.c_str(), -1, SQLITE_STATIC);
-                                                if (sqlite3_step(stmt_update) != SQLITE_DONE) {
-                                                     std::cerr << "Error updating rating for " << player1_conn->username << ": " << sqlite3_errmsg(db) << std::endl;
-                                                }
-                                                sqlite3_finalize(stmt_update);
-                                                player1_conn->rating = p1_new_rating;
-                                            } else {
-                                                std::cerr << "Failed to prepare update statement for " << player1_conn->username << ": " << sqlite3_errmsg(db) << std::endl;
-                                            }
-
-                                            if (sqlite3_prepare_v2(db, sql_update, -1, &stmt_update, 0) == SQLITE_OK) {
-                                                sqlite3_bind_int(stmt_update, 1, p2_new_rating);
-                                                sqlite3_bind_text(stmt_update, 2, player2_conn->username.c_str(), -1, SQLITE_STATIC);
-                                                if (sqlite3_step(stmt_update) != SQLITE_DONE) {
-                                                    std::cerr << "Error updating rating for " << player2_conn->username << ": " << sqlite3_errmsg(db) << std::endl;
-                                                }
-                                                sqlite3_finalize(stmt_update);
-                                                player2_conn->rating = p2_new_rating;
-                                            } else {
-                                                 std::cerr << "Failed to prepare update statement for " << player2_conn->username << ": " << sqlite3_errmsg(db) << std::endl;
-                                            }
-                                            sqlite3_close(db);
-                                        } else {
-                                            std::cerr << "Failed to open database for rating update" << std::endl;
-                                        }
-                                    }
-                                }
-                            } else {
-                                std::cout << "Move failed: " << result.message << std::endl;
-                                sendMoveRejection(client, result.message);
-                            }
-                        });
-                    } else {
-                        sendMoveRejection(client, "Game not properly initialized");
-                    }
-                } else {
-                    std::cerr << "Error deserializing move data from " 
-                              << client->socket.getRemoteAddress() << std::endl;
-                }
-            } else if (messageType == MessageType::CardPlayToServer) {
-                CardPlayData cardPlayData;
-                if (packet >> cardPlayData) {
-                    std::cout << "Card play received: card " << cardPlayData.cardIndex 
-                              << " at (" << cardPlayData.targetX << ", " << cardPlayData.targetY 
-                              << ") from " << client->socket.getRemoteAddress() << std::endl;
-                    
-                    auto session = client->session.lock();
-                    if (!session) {
-                        sendCardPlayRejection(client, "Not in a game");
-                        continue;
-                    }
-                    
-                    // Verify it's the client's turn
-                    if (client->playerSide != session->gameState.getActivePlayer()) {
-                        sendCardPlayRejection(client, "Not your turn");
-                        continue;
+                // Broadcast updated game state to all clients
+                event.recordDraws(session->gameState);
+                broadcastGameState(session, &event);
+
+                // Check for game over and update ratings
+                if (gameRules.isGameOver(session->gameState)) {
+                    std::cout << "Game Over detected." << std::endl;
+
+                    // Schedule session cleanup to prevent reconnection to finished games
+                    scheduleSessionCleanup(session);
+
+                    PlayerSide winner = PlayerSide::NEUTRAL; // Default to draw
+                    if (gameRules.hasPlayerWon(session->gameState, PlayerSide::PLAYER_ONE)) {
+                        winner = PlayerSide::PLAYER_ONE;
+                    } else if (gameRules.hasPlayerWon(session->gameState, PlayerSide::PLAYER_TWO)) {
+                        winner = PlayerSide::PLAYER_TWO;
                     }
-                    
-                    // Process the card play using TurnManager
-                    if (session->turnManager) {
-                        Position targetPosition(cardPlayData.targetX, cardPlayData.targetY);
-                        bool cardPlayProcessed = false;
-                        std::string resultMessage;
-                        
-                        session->turnManager->processPlayCardAction(cardPlayData.cardIndex, targetPosition,
-                            [&](const ActionResult& result) {
-                                cardPlayProcessed = true;
-                                resultMessage = result.message;
-                                
-                                if (result.success) {
-                                    std::cout << "Card play processed successfully: " << result.message << std::endl;
-                                    // Broadcast updated game state to all clients
-                                    broadcastGameState(session);
-                                    
-                                    // Check for game over (same logic as move handling)
-                                    if (gameRules.isGameOver(session->gameState)) {
-                                        std::cout << "Game Over detected after card play." << std::endl;
-                                        // Cleanup finished session so clients won't auto-resume
-                                        {
-                                            auto session_to_cleanup = session;
-                                            std::thread([session_to_cleanup]() {
-                                                std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                                                {
-                                                    std::lock_guard<std::mutex> lock(gamesMutex);
-                                                    gameSessions.erase(std::remove_if(gameSessions.begin(), gameSessions.end(),
-                                                        [&](const std::shared_ptr<GameSession>& s){ return s.get() == session_to_cleanup.get(); }),
-                                                        gameSessions.end());
-                                                }
-                                                if (session_to_cleanup->player1) session_to_cleanup->player1->session.reset();
-                                                if (session_to_cleanup->player2) session_to_cleanup->player2->session.reset();
-                                            }).detach();
-                                        }
-                                    }
-                                } else {
-                                    std::cout << "Card play failed: " << result.message << std::endl;
-                                    sendCardPlayRejection(client, result.message);
-                                }
-                            });
-                        
-                        // If no callback was called (shouldn't happen), handle as error
-                        if (!cardPlayProcessed) {
-                            sendCardPlayRejection(client, "Card play processing failed");
-                        }
+
+                    auto player1_conn = session->player1;
+                    auto player2_conn = session->player2;
+
+                    if (!player1_conn || !player2_conn) {
+                        std::cerr << "Error: Could not find player connections for rating update." << std::endl;
                     } else {
-                        sendCardPlayRejection(client, "Game not properly initialized");
-                    }
-                } else {
-                    std::cerr << "Error deserializing card play data from " 
-                              << client->socket.getRemoteAddress() << std::endl;
-                }
-            } else if (messageType == MessageType::SaveDeck) {
-                std::string deckStr;
-                if (packet >> deckStr) {
-                    Deck newDeck;
-                    if (newDeck.deserialize(deckStr)) {
-                        std::cout << "Deck deserialized successfully. Size: " << newDeck.size() << " cards" << std::endl;
-                        if (newDeck.isValidForEditing()) {
-                            std::cout << "Deck validation passed for editing" << std::endl;
-                            client->deck = std::move(newDeck);
-                            bool saveSuccessful = false;
-
-                        sqlite3* db;
-                        if (sqlite3_open("bayou_bonanza.db", &db) == SQLITE_OK) {
-                            const char* sql_upd = "REPLACE INTO decks (username, deck) VALUES (?, ?);";
-                            sqlite3_stmt* stmt;
-                            if (sqlite3_prepare_v2(db, sql_upd, -1, &stmt, 0) == SQLITE_OK) {
-                                sqlite3_bind_text(stmt, 1, client->username.c_str(), -1, SQLITE_STATIC);
-                                sqlite3_bind_text(stmt, 2, deckStr.c_str(), -1, SQLITE_STATIC);
-                                if (sqlite3_step(stmt) == SQLITE_DONE) {
-                                    saveSuccessful = true;
-                                    std::cout << "Deck saved successfully for user: " << client->username << std::endl;
-                                } else {
-                                    std::cerr << "Failed to save deck for user: " << client->username 
-                                              << " - " << sqlite3_errmsg(db) << std::endl;
-                                }
-                                sqlite3_finalize(stmt);
-                            } else {
-                                std::cerr << "Failed to prepare deck save statement: " << sqlite3_errmsg(db) << std::endl;
-                            }
-                            sqlite3_close(db);
+                        int p1_old_rating = player1_conn->rating;
+                        int p2_old_rating = player2_conn->rating;
+
+                        // Elo rating calculation with +1000 adjustment
+                        int p1_rating_adjusted = p1_old_rating + 1000;
+                        int p2_rating_adjusted = p2_old_rating + 1000;
+
+                        // Calculate expected scores
+                        double expected_p1 = 1.0 / (1.0 + std::pow(10.0, (p2_rating_adjusted - p1_rating_adjusted) / 400.0));
+                        double expected_p2 = 1.0 / (1.0 + std::pow(10.0, (p1_rating_adjusted - p2_rating_adjusted) / 400.0));
+
+                        // K-factor for rating changes
+                        const int K_FACTOR = 32;
+
+                        // Calculate new adjusted ratings based on game outcome
+                        int p1_new_rating_adjusted, p2_new_rating_adjusted;
+                        if (winner == PlayerSide::PLAYER_ONE) {
+                            // Player 1 wins
+                            p1_new_rating_adjusted = p1_rating_adjusted + static_cast<int>(K_FACTOR * (1 - expected_p1));
+                            p2_new_rating_adjusted = p2_rating_adjusted + static_cast<int>(K_FACTOR * (0 - expected_p2));
+                            std::cout << "Player 1 (" << player1_conn->username << ") wins." << std::endl;
+                        } else if (winner == PlayerSide::PLAYER_TWO) {
+                            // Player 2 wins
+                            p1_new_rating_adjusted = p1_rating_adjusted + static_cast<int>(K_FACTOR * (0 - expected_p1));
+                            p2_new_rating_adjusted = p2_rating_adjusted + static_cast<int>(K_FACTOR * (1 - expected_p2));
+                            std::cout << "Player 2 (" << player2_conn->username << ") wins." << std::endl;
                         } else {
-                            std::cerr << "Failed to open database for deck save" << std::endl;
+                            // Draw
+                            p1_new_rating_adjusted = p1_rating_adjusted + static_cast<int>(K_FACTOR * (0.5 - expected_p1));
+                            p2_new_rating_adjusted = p2_rating_adjusted + static_cast<int>(K_FACTOR * (0.5 - expected_p2));
+                            std::cout << "Game is a draw." << std::endl;
                         }
 
-                        // Send confirmation message back to client
-                        sf::Packet confirmationPacket;
-                        if (saveSuccessful) {
-                            confirmationPacket << MessageType::DeckSaved;
-                            std::cout << "Sending deck save confirmation to " << client->username << std::endl;
-                        } else {
-                            confirmationPacket << MessageType::Error << std::string("Failed to save deck to database");
-                            std::cout << "Sending deck save error to " << client->username << std::endl;
-                        }
-                            client->socket.send(confirmationPacket);
-                        } else {
-                            // Validation failed
-                            sf::Packet errorPacket;
-                            errorPacket << MessageType::Error << std::string("Deck validation failed - too many copies of a card");
-                            client->socket.send(errorPacket);
-                            std::cerr << "Deck validation failed for " << client->username << " - too many copies" << std::endl;
-                        }
-                    } else {
-                        // Deserialization failed
-                        sf::Packet errorPacket;
-                        errorPacket << MessageType::Error << std::string("Failed to deserialize deck data");
-                        client->socket.send(errorPacket);
-                        std::cerr << "Failed to deserialize deck data from " << client->username << std::endl;
+                        // Subtract 1000 adjustment and clamp to 0 minimum
+                        int p1_new_rating = std::max(0, p1_new_rating_adjusted - 1000);
+                        int p2_new_rating = std::max(0, p2_new_rating_adjusted - 1000);
+
+                        // Written back from the profile cache, so the game does not wait on disk
+                        player1_conn->rating = p1_new_rating;
+                        player2_conn->rating = p2_new_rating;
+                        profileCache->setRatings({{player1_conn->username, p1_new_rating},
+                                                  {player2_conn->username, p2_new_rating}});
+                        leaderboard->set({{player1_conn->username, p1_new_rating},
+                                          {player2_conn->username, p2_new_rating}});
                     }
-                } else {
-                    // Failed to deserialize deck string
-                    sf::Packet errorPacket;
-                    errorPacket << MessageType::Error << std::string("Failed to parse deck data");
-                    client->socket.send(errorPacket);
-                    std::cerr << "Failed to parse deck data from " << client->username << std::endl;
-                }
-            } else if (messageType == MessageType::EndTurn) {
-                std::cout << "End turn received from " << client->socket.getRemoteAddress() << std::endl;
-                
-                // Verify it's the client's turn
-                auto session = client->session.lock();
-                if (!session) {
-                    std::cout << "EndTurn rejected: not in game" << std::endl;
-                    continue;
-                }
-                if (client->playerSide != session->gameState.getActivePlayer()) {
-                    std::cout << "EndTurn rejected: Not your turn" << std::endl;
-                    continue;
                 }
+            } else {
+                std::cout << "Move failed: " << result.message << std::endl;
+                sendMoveRejection(client, result.message);
+            }
+        });
+    } else {
+        sendMoveRejection(client, "Game not properly initialized");
+    }
+}
 
-                // Process the phase advance using TurnManager
-                if (session->turnManager) {
-                    bool phaseAdvanced = false;
-                    std::string resultMessage;
-
-                    session->turnManager->nextPhase([&](const ActionResult& result) {
-                        phaseAdvanced = true;
-                        resultMessage = result.message;
-                        
-                        if (result.success) {
-                            std::cout << "Phase advanced successfully: " << result.message << std::endl;
-                            // Broadcast updated game state to all clients
-                            broadcastGameState(session);
-                            // If the phase advance resulted in game over, cleanup session
-                            if (gameRules.isGameOver(session->gameState)) {
-                                std::cout << "Game Over detected after phase advance." << std::endl;
-                                auto session_to_cleanup = session;
-                                std::thread([session_to_cleanup]() {
-                                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                                    {
-                                        std::lock_guard<std::mutex> lock(gamesMutex);
-                                        gameSessions.erase(std::remove_if(gameSessions.begin(), gameSessions.end(),
-                                            [&](const std::shared_ptr<GameSession>& s){ return s.get() == session_to_cleanup.get(); }),
-                                            gameSessions.end());
-                                    }
-                                    if (session_to_cleanup->player1) session_to_cleanup->player1->session.reset();
-                                    if (session_to_cleanup->player2) session_to_cleanup->player2->session.reset();
-                                }).detach();
-                            }
-                        } else {
-                            std::cout << "Phase advance failed: " << result.message << std::endl;
-                        }
-                    });
+void handleMoveToServer(const std::shared_ptr<ClientConnection>& client, WireReader& body) {
+    auto session = client->session.lock();
+    if (!session) {
+        sendMoveRejection(client, "Not in a game");
+        return;
+    }
+    Move clientMove;
+    if (body >> clientMove) { // Deserialize the rest of the packet as Move
+        std::cout << "Move received: "
+                  << clientMove.getFrom().x << "," << clientMove.getFrom().y
+                  << " -> "
+                  << clientMove.getTo().x << "," << clientMove.getTo().y << std::endl;
+
+        // Game state is owned by the session strand; validate and apply there
+        session->strand->post([client, session, clientMove]() {
+            applyMoveToSession(client, session, clientMove);
+            updateTurnClock(session);
+        });
+    } else {
+        std::cerr << "Error deserializing move data from " 
+                  << client->socket.getRemoteAddress() << std::endl;
+    }
+}
+
+// Validate and apply a card play; runs on the session strand
+void applyCardPlayToSession(const std::shared_ptr<ClientConnection>& client,
+                            const std::shared_ptr<GameSession>& session,
+                            const CardPlayData& cardPlayData) {
+    // Verify it's the client's turn
+    if (client->playerSide != session->gameState.getActivePlayer()) {
+        sendCardPlayRejection(client, "Not your turn");
+        return;
+    }
+    
+    // Process the card play using TurnManager
+    if (session->turnManager) {
+        Position targetPosition(cardPlayData.targetX, cardPlayData.targetY);
+        bool cardPlayProcessed = false;
+        std::string resultMessage;
+        
+        GameEvent event = GameEvent::playCard(session->gameState, cardPlayData.cardIndex, targetPosition);
+        session->turnManager->processPlayCardAction(cardPlayData.cardIndex, targetPosition,
+            [&](const ActionResult& result) {
+                cardPlayProcessed = true;
+                resultMessage = result.message;
+                
+                if (result.success) {
+                    std::cout << "Card play processed successfully: " << result.message << std::endl;
+                    // Broadcast updated game state to all clients
+                    event.recordDraws(session->gameState);
+                    broadcastGameState(session, &event);
                     
-                    // If no callback was called (shouldn't happen), handle as error
-                    if (!phaseAdvanced) {
-                        std::cout << "Phase advance processing failed" << std::endl;
+                    // Check for game over (same logic as move handling)
+                    if (gameRules.isGameOver(session->gameState)) {
+                        std::cout << "Game Over detected after card play." << std::endl;
+                        // Cleanup finished session so clients won't auto-resume
+                        scheduleSessionCleanup(session);
                     }
                 } else {
-                    std::cout << "Game not properly initialized for phase advance" << std::endl;
+                    std::cout << "Card play failed: " << result.message << std::endl;
+                    sendCardPlayRejection(client, result.message);
                 }
-            } else if (messageType == MessageType::RequestMatchmaking) {
-                std::cout << "Matchmaking request received from " << client->username << std::endl;
-                client->lookingForMatch = true;
-                
-                // Send WaitingForOpponent message to the client
-                sf::Packet waitingPacket;
-                waitingPacket << MessageType::WaitingForOpponent;
-                client->socket.send(waitingPacket);
-                
-                // Try to start matchmaking
-                tryStartMatchmaking();
+            });
+        
+        // If no callback was called (shouldn't happen), handle as error
+        if (!cardPlayProcessed) {
+            sendCardPlayRejection(client, "Card play processing failed");
+        }
+    } else {
+        sendCardPlayRejection(client, "Game not properly initialized");
+    }
+}
+
+void handleCardPlayToServer(const std::shared_ptr<ClientConnection>& client, WireReader& body) {
+    CardPlayData cardPlayData;
+    if (body >> cardPlayData) {
+        std::cout << "Card play received: card " << cardPlayData.cardIndex 
+                  << " at (" << cardPlayData.targetX << ", " << cardPlayData.targetY 
+                  << ") from " << client->socket.getRemoteAddress() << std::endl;
+        
+        auto session = client->session.lock();
+        if (!session) {
+            sendCardPlayRejection(client, "Not in a game");
+            return;
+        }
+        
+        // Game state is owned by the session strand; validate and apply there
+        session->strand->post([client, session, cardPlayData]() {
+            applyCardPlayToSession(client, session, cardPlayData);
+            updateTurnClock(session);
+        });
+    } else {
+        std::cerr << "Error deserializing card play data from " 
+                  << client->socket.getRemoteAddress() << std::endl;
+    }
+}
+
+void handleSaveDeck(const std::shared_ptr<ClientConnection>& client, sf::Packet& packet) {
+    std::string deckStr;
+    if (packet >> deckStr) {
+        Deck newDeck;
+        if (newDeck.deserialize(deckStr)) {
+            std::cout << "Deck deserialized successfully. Size: " << newDeck.size() << " cards" << std::endl;
+            if (newDeck.isValidForEditing()) {
+                std::cout << "Deck validation passed for editing" << std::endl;
+                client->deck = std::move(newDeck);
+                // The cached profile is what the next login sees; it reaches the database with the next flush
+                profileCache->setDeck(client->username, client->deck);
+                std::cout << "Deck saved successfully for user: " << client->username << std::endl;
+                sf::Packet confirmationPacket;
+                confirmationPacket << MessageType::DeckSaved;
+                sendPacket(client, confirmationPacket);
             } else {
-                // Handle other message types or log unexpected ones
-                std::cout << "Received unhandled message type: " << static_cast<int>(messageType) 
-                          << " from " << client->socket.getRemoteAddress() << std::endl;
+                // Validation failed
+                sf::Packet errorPacket;
+                errorPacket << MessageType::Error << std::string("Deck validation failed - too many copies of a card");
+                sendPacket(client, errorPacket);
+                std::cerr << "Deck validation failed for " << client->username << " - too many copies" << std::endl;
             }
+        } else {
+            // Deserialization failed
+            sf::Packet errorPacket;
+            errorPacket << MessageType::Error << std::string("Failed to deserialize deck data");
+            sendPacket(client, errorPacket);
+            std::cerr << "Failed to deserialize deck data from " << client->username << std::endl;
+        }
+    } else {
+        // Failed to deserialize deck string
+        sf::Packet errorPacket;
+        errorPacket << MessageType::Error << std::string("Failed to parse deck data");
+        sendPacket(client, errorPacket);
+        std::cerr << "Failed to parse deck data from " << client->username << std::endl;
+    }
+}
 
-        } else if (status == sf::Socket::NotReady) {
-            // No data received, non-blocking socket, this is normal
-        } else if (status == sf::Socket::Disconnected) {
-            std::cout << "Client disconnected: " << client->socket.getRemoteAddress() << std::endl;
-            client->connected = false;
-            // Handle disconnection: remove client, notify other player, etc.
+// Advance the phase for the active player; runs on the session strand
+void applyEndTurnToSession(const std::shared_ptr<ClientConnection>& client,
+                           const std::shared_ptr<GameSession>& session) {
+    if (client->playerSide != session->gameState.getActivePlayer()) {
+        std::cout << "EndTurn rejected: Not your turn" << std::endl;
+        return;
+    }
+
+    // Process the phase advance using TurnManager
+    if (session->turnManager) {
+        bool phaseAdvanced = false;
+        std::string resultMessage;
+
+        GameEvent event = GameEvent::nextPhase(session->gameState);
+        session->turnManager->nextPhase([&](const ActionResult& result) {
+            phaseAdvanced = true;
+            resultMessage = result.message;
+            
+            if (result.success) {
+                std::cout << "Phase advanced successfully: " << result.message << std::endl;
+                // Broadcast updated game state to all clients
+                event.recordDraws(session->gameState);
+                broadcastGameState(session, &event);
+                // If the phase advance resulted in game over, cleanup session
+                if (gameRules.isGameOver(session->gameState)) {
+                    std::cout << "Game Over detected after phase advance." << std::endl;
+                    scheduleSessionCleanup(session);
+                }
+            } else {
+                std::cout << "Phase advance failed: " << result.message << std::endl;
+            }
+        });
+        
+        // If no callback was called (shouldn't happen), handle as error
+        if (!phaseAdvanced) {
+            std::cout << "Phase advance processing failed" << std::endl;
+        }
+    } else {
+        std::cout << "Game not properly initialized for phase advance" << std::endl;
+    }
+}
+
+// End a turn the active player let run out; runs on the session strand
+void onTurnTimeout(const std::shared_ptr<GameSession>& session, int turn) {
+    if (gameRules.isGameOver(session->gameState) || session->gameState.getTurnNumber() != turn) {
+        return; // The player acted in time; this timer is stale
+    }
+    if (!anyPlayerConnected(*session)) {
+        // Both players are gone; free the game instead of ending its turns forever
+        std::cout << "Turn " << turn << " ran out of time with no players connected; closing the game" << std::endl;
+        scheduleSessionCleanup(session);
+        return;
+    }
+    std::cout << "Turn " << turn << " ran out of time; ending it" << std::endl;
+
+    if (session->turnManager) {
+        GameEvent event = GameEvent::endTurn(session->gameState);
+        session->turnManager->endCurrentTurn([&](const ActionResult& result) {
+            std::cout << result.message << std::endl;
+        });
+        event.recordDraws(session->gameState);
+        broadcastGameState(session, &event);
+        if (gameRules.isGameOver(session->gameState)) {
+            scheduleSessionCleanup(session);
+        }
+    }
+    updateTurnClock(session);
+}
+
+void handleEndTurn(const std::shared_ptr<ClientConnection>& client) {
+    std::cout << "End turn received from " << client->socket.getRemoteAddress() << std::endl;
+    
+    auto session = client->session.lock();
+    if (!session) {
+        std::cout << "EndTurn rejected: not in game" << std::endl;
+        return;
+    }
+    // Game state is owned by the session strand; validate and apply there
+    session->strand->post([client, session]() {
+        applyEndTurnToSession(client, session);
+        updateTurnClock(session);
+    });
+}
+
+void handleRequestStateResync(const std::shared_ptr<ClientConnection>& client) {
+    auto session = client->session.lock();
+    if (!session) {
+        if (auto watched = client->watching.lock()) {
+            watched->spectatorStrand->post([client, watched]() {
+                if (watched->spectatorSnapshot) {
+                    sendMessage(client, [&](WireWriter& writer) {
+                        writer << MessageType::GameStateUpdate;
+                        watched->spectatorSnapshot->writeFull(writer, SPECTATOR_VIEWER);
+                    });
+                }
+            });
+        }
+        return;
+    }
+    std::cout << "State resync requested by " << client->username << std::endl;
+    session->strand->post([client, session]() {
+        sendFullState(client, *session);
+    });
+}
+
+// Stop sending a client the game it watches; runs on the reactor thread. Like a join, the removal
+// passes through the session strand so it cannot overtake the join it undoes.
+void stopWatching(const std::shared_ptr<ClientConnection>& client) {
+    auto session = client->watching.lock();
+    client->watching.reset();
+    if (!session) {
+        return;
+    }
+    session->strand->post([client, session]() {
+        session->spectatorStrand->post([client, session]() {
+            auto& spectators = session->spectators;
+            auto found = std::find(spectators.begin(), spectators.end(), client);
+            if (found != spectators.end()) {
+                *found = std::move(spectators.back());
+                spectators.pop_back();
+                session->spectatorCount--;
+            }
+        });
+    });
+}
+
+// Start a client watching the game a player is in. It gets a GameStart with the state the players were
+// last sent, seen with both hands hidden, and then every update; runs on the reactor thread.
+void handleSpectateRequest(const std::shared_ptr<ClientConnection>& client, sf::Packet& packet) {
+    std::string target;
+    if (!(packet >> target)) {
+        std::cerr << "Error deserializing spectate request from " << client->username << std::endl;
+        return;
+    }
+    auto session = findGameSessionByUsername(target);
+    if (!session || session->tornDown || client->session.lock()) {
+        // Only games hosted by this server process can be watched
+        sf::Packet errorPacket;
+        errorPacket << MessageType::Error
+                    << (session ? std::string("Cannot watch a game while playing one") : "No game to watch for " + target);
+        sendPacket(client, errorPacket);
+        return;
+    }
+    stopWatching(client);
+    client->watching = session;
+    std::cout << client->username << " is watching " << target << "'s game" << std::endl;
+
+    // Counted before the join is queued, so every update after the start snapshot reaches the spectator strand
+    session->spectatorCount++;
+    session->strand->post([client, session]() {
+        auto start = shareLastSnapshot(*session);
+        std::string names[2] = {session->player1->username, session->player2->username};
+        int ratings[2] = {session->player1->rating, session->player2->rating};
+        session->spectatorStrand->post([client, session, start, names, ratings]() {
+            sendMessage(client, [&](WireWriter& writer) {
+                writer << MessageType::GameStart << names[0] << ratings[0] << names[1] << ratings[1];
+                start->writeFull(writer, SPECTATOR_VIEWER);
+            });
+            session->spectatorSnapshot = start;
+            session->spectators.push_back(client);
+        });
+    });
+}
+
+void handleRequestMatchmaking(const std::shared_ptr<ClientConnection>& client) {
+    std::cout << "Matchmaking request received from " << client->username << std::endl;
+    stopWatching(client);
+    directory->enqueue(client->id, client->rating);
+    
+    // Send WaitingForOpponent message to the client; the next matchmaking tick pairs them
+    sf::Packet waitingPacket;
+    waitingPacket << MessageType::WaitingForOpponent;
+    sendPacket(client, waitingPacket);
+}
+
+// Send the side assignment, card collection and deck that follow a successful login
+void sendLoginData(const std::shared_ptr<ClientConnection>& client) {
+    // Send PlayerAssignment
+    sf::Packet assignmentPacket;
+    assignmentPacket << MessageType::PlayerAssignment << client->playerSide;
+    sendPacket(client, assignmentPacket);
+
+    // Send player collection and deck
+    sf::Packet collectionPacket;
+    collectionPacket << MessageType::CardCollectionData << client->collection.serialize();
+    sendPacket(client, collectionPacket);
+
+    sf::Packet deckPacket;
+    deckPacket << MessageType::DeckData << client->deck.serialize();
+    sendPacket(client, deckPacket);
+}
+
+// Swap a reconnecting client into its seat and resend the game; runs on the session strand
+void resumeSession(const std::shared_ptr<ClientConnection>& new_client_conn,
+                   const std::shared_ptr<GameSession>& session) {
+    if (gameRules.isGameOver(session->gameState)) {
+        // Game ended while the player was away; treat this as a fresh login
+        sendLoginData(new_client_conn);
+        return;
+    }
+
+    if (session->player1 && session->player1->username == new_client_conn->username) {
+        session->player1 = new_client_conn;
+        new_client_conn->playerSide = PlayerSide::PLAYER_ONE;
+    } else if (session->player2 && session->player2->username == new_client_conn->username) {
+        session->player2 = new_client_conn;
+        new_client_conn->playerSide = PlayerSide::PLAYER_TWO;
+    }
+
+    sendLoginData(new_client_conn);
+
+    // Send current game state as GameStart packet (acts as resume)
+    std::string p1_username = session->player1->username;
+    int p1_rating = session->player1->rating;
+    std::string p2_username = session->player2->username;
+    int p2_rating = session->player2->rating;
+    sendMessage(new_client_conn, [&](WireWriter& writer) {
+        writer << MessageType::GameStart << p1_username << p1_rating
+               << p2_username << p2_rating;
+        session->lastSnapshot.writeFull(writer, new_client_conn->playerSide);
+    });
+}
+
+// Send a client the best players and its own neighbourhood on the board; runs on the reactor thread.
+// The top list comes from the shared snapshot, so a flood of requests costs no sorting.
+void handleLeaderboardRequest(const std::shared_ptr<ClientConnection>& client, sf::Packet& packet) {
+    LeaderboardRequestData request;
+    WireReader body = messageBody(packet);
+    if (!(body >> request)) {
+        std::cerr << "Error deserializing leaderboard request from " << client->username << std::endl;
+        return;
+    }
+    std::shared_ptr<const Leaderboard::Snapshot> top = leaderboard->top();
+    sf::Uint32 topCount = static_cast<sf::Uint32>(std::min<std::size_t>(request.top, top->entries.size()));
+    sf::Uint32 totalPlayers = static_cast<sf::Uint32>(leaderboard->size());
+    sf::Uint32 rank = static_cast<sf::Uint32>(leaderboard->rank(client->username));
+    std::vector<LeaderboardEntry> around;
+    if (request.around > 0) {
+        around = leaderboard->around(client->username, std::min(request.around, MAX_LEADERBOARD_NEIGHBOURS));
+    }
+    // Laid out as LeaderboardData, with the top entries written straight from the snapshot
+    sendMessage(client, [&](WireWriter& writer) {
+        writer << MessageType::LeaderboardData << totalPlayers << topCount;
+        for (sf::Uint32 i = 0; i < topCount; ++i) {
+            writer << top->entries[i];
+        }
+        writer << rank;
+        writeLeaderboardEntries(writer, around);
+    });
+}
+
+// Route one complete packet to its MessageType handler
+void dispatchMessage(const std::shared_ptr<ClientConnection>& client, sf::Packet& packet) {
+    MessageType messageType;
+    if (!(packet >> messageType)) {
+        std::cerr << "Error deserializing message type from " 
+                  << client->socket.getRemoteAddress() << std::endl;
+        return;
+    }
+    std::cout << "Received message type: " << static_cast<int>(messageType) 
+              << " from " << client->socket.getRemoteAddress() << std::endl;
+
+    switch (messageType) {
+        case MessageType::MoveToServer: {
+            WireReader body = messageBody(packet);
+            handleMoveToServer(client, body);
             break;
-        } else if (status == sf::Socket::Error) {
-            std::cerr << "Network error receiving from client: " 
-                      << client->socket.getRemoteAddress() << std::endl;
-            client->connected = false;
-            // Handle error
+        }
+        case MessageType::CardPlayToServer: {
+            WireReader body = messageBody(packet);
+            handleCardPlayToServer(client, body);
             break;
         }
-        // Add a small sleep to prevent busy-waiting if not using selectors
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        case MessageType::SaveDeck:
+            handleSaveDeck(client, packet);
+            break;
+        case MessageType::EndTurn:
+            handleEndTurn(client);
+            break;
+        case MessageType::RequestMatchmaking:
+            handleRequestMatchmaking(client);
+            break;
+        case MessageType::RequestStateResync:
+            handleRequestStateResync(client);
+            break;
+        case MessageType::SpectateRequest:
+            handleSpectateRequest(client, packet);
+            break;
+        case MessageType::LeaderboardRequest:
+            handleLeaderboardRequest(client, packet);
+            break;
+        default:
+            // Handle other message types or log unexpected ones
+            std::cout << "Received unhandled message type: " << static_cast<int>(messageType) 
+                      << " from " << client->socket.getRemoteAddress() << std::endl;
+            break;
     }
+}
 
-    // Cleanup client connection
-    {
-        std::lock_guard<std::mutex> lock(clientsMutex);
-        clients.erase(std::remove_if(clients.begin(), clients.end(), [&](const std::shared_ptr<ClientConnection>& c){
-            return c.get() == client.get();
-        }), clients.end());
-        std::cout << "Client removed. Current client count: " << clients.size() << std::endl;
-    }
-}
-
-void initialize_database() {
-    sqlite3* db;
-    char* err_msg = 0;
-    // Use path relative to project root since working directory is now set to base directory
-    std::string db_path = "bayou_bonanza.db"; // Database in project root
-    int rc = sqlite3_open(db_path.c_str(), &db);
-
-    if (rc) {
-        std::cerr << "Can't open database: " << sqlite3_errmsg(db) << std::endl;
-        // Though sqlite3_open() documentation says it always returns a DB handle,
-        // it's good practice to close if it's not NULL, especially if other parts of the code
-        // might try to use it. If sqlite3_open fails, db might be NULL or garbage,
-        // sqlite3_close(NULL) is a no-op and safe.
-        if (db) {
-            sqlite3_close(db);
-        }
-        // It might be better to exit or throw an exception here if the DB is critical
-        return; 
+// What a first login is given: no rating and the starter cards as both collection and deck
+const PlayerDatabase::NewUser& newUserDefaults() {
+    static const PlayerDatabase::NewUser defaults = []() {
+        PlayerDatabase::NewUser user;
+        user.collection = CardCollection(CardFactory::createStarterDeck()).pack();
+        user.deck = Deck(CardFactory::createStarterDeck()).pack();
+        return user;
+    }();
+    return defaults;
+}
+
+// Load a user's profile through the cache; may block on SQLite, so it runs on the worker pool
+std::optional<ProfileCache::Profile> loadPlayerProfile(const std::string& username) {
+    std::optional<ProfileCache::Profile> profile = profileCache->load(username, newUserDefaults());
+    if (profile) {
+        std::cout << "User " << username << " loaded with rating " << profile->rating << std::endl;
     } else {
-        std::cout << "Opened database successfully at: " << db_path << std::endl;
+        std::cerr << "Could not load the profile of " << username << std::endl;
     }
+    return profile;
+}
 
-    const char* sql_create_users =
-        "CREATE TABLE IF NOT EXISTS users ("
-        "username TEXT PRIMARY KEY NOT NULL,"
-        "rating INTEGER NOT NULL DEFAULT 0"
-        ");";
+// Register a logged-in client and either seat it back in its game or send the lobby data
+void completeLogin(const std::shared_ptr<ClientConnection>& new_client_conn) {
+    // Check for existing game session for this user
+    auto existingSession = findGameSessionByUsername(new_client_conn->username);
+    if (existingSession) {
+        std::cout << "Reconnecting user " << new_client_conn->username << " to ongoing game" << std::endl;
+        new_client_conn->playerSide = PlayerSide::NEUTRAL;
+        new_client_conn->session = existingSession;
+        // The player slots and game state belong to the session strand
+        existingSession->strand->post([new_client_conn, existingSession]() {
+            resumeSession(new_client_conn, existingSession);
+        });
+
+        clientsByName.insert(new_client_conn->username, new_client_conn);
+        return; // Skip normal post-login flow
+    }
 
-    const char* sql_create_collections =
-        "CREATE TABLE IF NOT EXISTS collections ("
-        "username TEXT PRIMARY KEY NOT NULL,"
-        "cards TEXT"
-        ");";
+    // Assign default PlayerSide until matchmaking
+    new_client_conn->playerSide = PlayerSide::NEUTRAL;
+    clientsByName.insert(new_client_conn->username, new_client_conn);
+    size_t clientCount = clientsByName.size();
+    
+    std::string sideStr = "Neutral";
+    if (new_client_conn->playerSide == PlayerSide::PLAYER_ONE) sideStr = "One";
+    else if (new_client_conn->playerSide == PlayerSide::PLAYER_TWO) sideStr = "Two";
+    std::cout << "User '" << new_client_conn->username << "' (Rating: " << new_client_conn->rating
+              << ") connected as Player " << sideStr
+              << " from " << new_client_conn->socket.getRemoteAddress() << std::endl;
+    std::cout << "Current players connected: " << clientCount << std::endl;
+    
+    sendLoginData(new_client_conn);
+
+    // Don't automatically start games - wait for explicit matchmaking requests
+    std::cout << "Player connected. Total players: " << clientCount << std::endl;
+}
 
-    const char* sql_create_decks =
-        "CREATE TABLE IF NOT EXISTS decks ("
-        "username TEXT PRIMARY KEY NOT NULL,"
-        "deck TEXT"
-        ");";
+// Awaitable that yields the next packet received on a connection
+// (false once the connection has closed)
+struct NextPacket {
+    std::shared_ptr<ClientConnection> client;
+    std::unique_ptr<sf::Packet>& out;
 
-    rc = sqlite3_exec(db, sql_create_users, 0, 0, &err_msg);
-    
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << err_msg << std::endl;
-        sqlite3_free(err_msg); // Free error message
+    bool await_ready() const noexcept {
+        return !client->inbox.empty() || !client->connected;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        client->reader = handle;
+    }
+    bool await_resume() {
+        if (!client->connected || client->inbox.empty()) {
+            return false;
+        }
+        // The packet handled last is received into again rather than freed
+        if (out && client->sparePackets.size() < MAX_INBOX_PACKETS) {
+            client->sparePackets.push_back(std::move(out));
+        }
+        out = std::move(client->inbox.front());
+        client->inbox.pop_front();
+        return true;
+    }
+};
+
+NextPacket nextPacket(const std::shared_ptr<ClientConnection>& client, std::unique_ptr<sf::Packet>& out) {
+    return NextPacket{client, out};
+}
+
+// Continue a connection flow that is waiting for input or for the connection to close
+void resumeReader(ClientConnection& client) {
+    if (client.reader) {
+        std::coroutine_handle<> reader = std::exchange(client.reader, nullptr);
+        reader.resume();
+    }
+}
+
+// Awaitable that asks the directory which process hosts a user's game
+struct OwnerLookup {
+    std::string username;
+    int owner = -1;
+    bool answered = false;
+    std::coroutine_handle<> waiter;
+
+    explicit OwnerLookup(std::string username) : username(std::move(username)) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        directory->lookupOwner(username, [this](int result) {
+            owner = result;
+            answered = true;
+            if (waiter) {
+                std::exchange(waiter, nullptr).resume();
+            }
+        });
+        if (answered) {
+            return false; // Answered synchronously; carry on without suspending
+        }
+        waiter = handle;
+        return true;
+    }
+    int await_resume() const noexcept {
+        return owner;
+    }
+};
+
+// Finish the move of a player who was paired with someone waiting in this process
+void joinMigratedMatch(const std::shared_ptr<ClientConnection>& client, SessionDirectory::TicketId peerId) {
+    client->playerSide = PlayerSide::NEUTRAL;
+    clientsByName.insert(client->username, client);
+
+    ClientHandle peer = clientsById.find(peerId);
+    if (readyForMatch(peer)) {
+        if (admission->tryStartSession()) {
+            startMatch(peer, client);
+            return;
+        }
+        directory->enqueue(peer->id, peer->rating); // At the session cap; both wait for the next pairing
+    }
+    // Otherwise the opponent left while the connection was in transit
+    directory->enqueue(client->id, client->rating);
+}
+
+// Tell a client the server is at capacity: its login waits at `position`, or is turned away when 0
+void sendServerBusy(const std::shared_ptr<ClientConnection>& client, std::size_t position) {
+    sf::Packet busyPacket;
+    busyPacket << MessageType::ServerBusy << static_cast<sf::Uint32>(position);
+    sendPacket(client, busyPacket);
+}
+
+// Seat logins that admission control moved out of its queue, waking their connection flows
+void admitQueuedLogins(std::vector<AdmissionControl::Id> admitted) {
+    while (!admitted.empty()) {
+        AdmissionControl::Id id = admitted.back();
+        admitted.pop_back();
+        ClientHandle client = clientsById.find(id);
+        if (!client || !client->connected) {
+            // Gone without giving its slot back; pass the slot on
+            std::vector<AdmissionControl::Id> more = admission->finishLogin(id);
+            admitted.insert(admitted.end(), more.begin(), more.end());
+            continue;
+        }
+        client->loginAdmitted = true;
+        client->connectedAt = TimerWheel::Clock::now(); // The login timeout restarts for the profile load
+        resumeReader(*client);
+    }
+}
+
+// A connection flow's place in the login queue or its login slot; given back once the profile
+// has loaded, or when the flow ends early
+class LoginSlot {
+public:
+    explicit LoginSlot(std::shared_ptr<ClientConnection> client) : client(std::move(client)), held(false) {}
+    ~LoginSlot() { release(); }
+
+    LoginSlot(const LoginSlot&) = delete;
+    LoginSlot& operator=(const LoginSlot&) = delete;
+
+    AdmissionControl::LoginDecision request(AdmissionControl::Priority priority) {
+        AdmissionControl::LoginDecision decision = admission->requestLogin(client->id, priority);
+        held = decision != AdmissionControl::LoginDecision::Rejected;
+        client->loginAdmitted = decision == AdmissionControl::LoginDecision::Admitted;
+        return decision;
+    }
+
+    void release() {
+        if (held) {
+            held = false;
+            admitQueuedLogins(admission->finishLogin(client->id));
+        }
+    }
+
+private:
+    std::shared_ptr<ClientConnection> client;
+    bool held;
+};
+
+// Awaitable that waits until a queued login is given a slot (false once the connection has closed)
+struct LoginTurn {
+    std::shared_ptr<ClientConnection> client;
+
+    bool await_ready() const noexcept {
+        return client->loginAdmitted || !client->connected;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        client->reader = handle; // Packets that arrive meanwhile also wake it; it just waits again
+    }
+    bool await_resume() const noexcept {
+        return client->connected;
+    }
+};
+
+// Ping a client, or drop it once HEARTBEAT_MISSES_ALLOWED Pings in a row went unanswered: a
+// half-open connection never reads or closes, so nothing else would notice it before IDLE_TIMEOUT.
+// Runs on the reactor thread.
+void sendHeartbeat(const std::shared_ptr<ClientConnection>& client) {
+    client->heartbeatTimer = 0;
+    if (!client->connected) {
+        return;
+    }
+    if (client->heartbeat.unanswered() >= HEARTBEAT_MISSES_ALLOWED) {
+        heartbeatStats.connectionReaped();
+        std::cout << "No answer to " << client->heartbeat.unanswered() << " pings from "
+                  << (client->username.empty() ? client->socket.getRemoteAddress().toString() : client->username)
+                  << "; disconnecting" << std::endl;
+        disconnectClient(client);
+        return;
+    }
+    PingData ping = client->heartbeat.ping(TimerWheel::Clock::now());
+    sendMessage(client, [&](WireWriter& writer) {
+        writer << MessageType::Ping << ping;
+    });
+    heartbeatStats.pingSent();
+    client->heartbeatTimer = reactor.timers().schedule(
+        std::chrono::duration_cast<std::chrono::milliseconds>(HEARTBEAT_INTERVAL),
+        [client]() { sendHeartbeat(client); });
+}
+
+// Start pinging a client that agreed to Capability::Heartbeat; runs on the reactor thread
+void startHeartbeat(const std::shared_ptr<ClientConnection>& client) {
+    if (!hasCapability(client->capabilities, Capability::Heartbeat) || client->heartbeatTimer != 0) {
+        return;
+    }
+    // Spread by connection id so a burst of logins does not ping in lockstep
+    auto firstPing = std::chrono::duration_cast<std::chrono::milliseconds>(HEARTBEAT_INTERVAL) +
+                     std::chrono::milliseconds(client->id % 1000);
+    client->heartbeatTimer = reactor.timers().schedule(firstPing, [client]() { sendHeartbeat(client); });
+}
+
+// Answer a Ping or take a Pong as soon as it is received, ahead of whatever the connection flow
+// is waiting for; false for any other message. Runs on the reactor thread.
+bool handleKeepAlive(const std::shared_ptr<ClientConnection>& client, const sf::Packet& packet) {
+    if (packet.getDataSize() == 0) {
+        return false;
+    }
+    MessageType messageType = static_cast<MessageType>(*static_cast<const char*>(packet.getData()));
+    WireReader body = messageBody(packet);
+    if (messageType == MessageType::Ping) {
+        PingData ping;
+        if (body >> ping) {
+            sendMessage(client, [&](WireWriter& writer) {
+                writer << MessageType::Pong << PongData{ping.sequence};
+            });
+        }
+        return true;
+    }
+    if (messageType == MessageType::Pong) {
+        PongData pong;
+        if ((body >> pong) && client->heartbeat.pong(pong.sequence, TimerWheel::Clock::now())) {
+            heartbeatStats.recordRoundTrip(client->heartbeat.lastRoundTrip());
+        }
+        return true;
+    }
+    return false;
+}
+
+// Tell a client why it cannot log in, then close the connection
+void refuseLogin(const std::shared_ptr<ClientConnection>& client, const std::string& reason) {
+    sf::Packet errorPacket;
+    errorPacket << MessageType::Error << reason;
+    sendPacket(client, errorPacket);
+    flushClient(client);
+    disconnectClient(client);
+}
+
+// Agree a protocol version and capabilities with a client; false if it was refused and disconnected
+bool acceptConnectionRequest(const std::shared_ptr<ClientConnection>& client, sf::Packet& packet) {
+    ConnectionRequestData request;
+    if (!(packet >> request)) {
+        std::cerr << "Malformed ConnectionRequest from " << client->socket.getRemoteAddress() << std::endl;
+        disconnectClient(client);
+        return false;
+    }
+    HandshakeResult result = negotiateConnection(request, globalPieceDefManager.getDefinitionsHash());
+    if (!result.accepted) {
+        std::cout << "Connection refused for " << client->socket.getRemoteAddress() << " (protocol "
+                  << request.protocolVersion << "): " << result.refusal << std::endl;
+        refuseLogin(client, result.refusal);
+        return false;
+    }
+    client->capabilities = result.reply.capabilities;
+    sf::Packet reply;
+    reply << MessageType::ConnectionAccepted << result.reply;
+    sendPacket(client, reply);
+    startHeartbeat(client); // Covers the login queue too: a client that vanishes there frees its place
+    return true;
+}
+
+// Lifetime of one connection: handshake, login, profile load, lobby data, then game messages.
+// Every step yields to the reactor instead of blocking it. A connection handed over
+// by another server process arrives already logged in as `adoptedUsername`, its handshake done.
+ServerTask runClientConnection(std::shared_ptr<ClientConnection> client, std::string adoptedUsername = {},
+                               SessionDirectory::TicketId matchPeer = 0) {
+    std::unique_ptr<sf::Packet> received;
+    std::string username = adoptedUsername;
+    if (username.empty()) {
+        if (!co_await nextPacket(client, received)) {
+            co_return;
+        }
+        MessageType messageType;
+        bool typeRead = static_cast<bool>(*received >> messageType);
+
+        // Clients from before the handshake open with their UserLogin
+        bool handshakeDone = typeRead && messageType == MessageType::ConnectionRequest;
+        if (handshakeDone) {
+            if (!acceptConnectionRequest(client, *received) || !co_await nextPacket(client, received)) {
+                co_return;
+            }
+            typeRead = static_cast<bool>(*received >> messageType);
+        }
+        sf::Packet& packet = *received;
+
+        if (!typeRead || messageType != MessageType::UserLogin) {
+            std::cerr << "Login failed: Did not receive UserLogin message type from "
+                      << client->socket.getRemoteAddress() << std::endl;
+            disconnectClient(client);
+            co_return;
+        }
+
+        if (!(packet >> username) || username.empty()) {
+            std::cerr << "Failed to deserialize username or username empty." << std::endl;
+            std::cout << "Login failed for client " << client->socket.getRemoteAddress() << ". Disconnecting." << std::endl;
+            disconnectClient(client);
+            co_return;
+        }
+
+        if (!handshakeDone) {
+            // The login carries what the handshake would have: the definitions hash, then optionally
+            // a StateUpdateMode (older clients stop after the hash)
+            ConnectionRequestData request;
+            request.protocolVersion = MIN_PROTOCOL_VERSION;
+            sf::Uint8 updateMode = static_cast<sf::Uint8>(StateUpdateMode::Deltas);
+            packet >> request.definitionsHash >> updateMode;
+            request.capabilities = legacyLoginCapabilities(static_cast<StateUpdateMode>(updateMode));
+            HandshakeResult result = negotiateConnection(request, globalPieceDefManager.getDefinitionsHash());
+            if (!result.accepted) {
+                std::cout << "Login refused for " << username << ": " << result.refusal << std::endl;
+                refuseLogin(client, result.refusal);
+                co_return;
+            }
+            client->capabilities = result.reply.capabilities;
+        }
+
+        // A game in progress lives in exactly one process; send the player back to it
+        OwnerLookup ownerLookup(username);
+        int owner = co_await ownerLookup;
+        if (!client->connected) {
+            co_return;
+        }
+        if (owner >= 0 && owner != directory->self() &&
+            directory->handoff(client->socket.nativeHandle(), owner, username, 0, 0, client->capabilities)) {
+            std::cout << "Routing " << username << " to server process " << owner << std::endl;
+            disconnectClient(client); // Closes only this process's copy of the socket
+            co_return;
+        }
+    }
+
+    // A profile still cached costs no I/O, so it needs neither a login slot nor a worker
+    std::optional<ProfileCache::Profile> profile = profileCache->find(username);
+    if (!profile) {
+        // Profile loads are what a login costs; only a few run at once so a login storm cannot
+        // take the worker pool from games in progress. Returning players go to the front.
+        bool returning = !adoptedUsername.empty() || findGameSessionByUsername(username) != nullptr;
+        LoginSlot loginSlot(client);
+        switch (loginSlot.request(returning ? AdmissionControl::Priority::Reconnect : AdmissionControl::Priority::NewLogin)) {
+            case AdmissionControl::LoginDecision::Admitted:
+                break;
+            case AdmissionControl::LoginDecision::Queued:
+                std::cout << "Server busy; " << username << " queued at position "
+                          << admission->queuePosition(client->id) << std::endl;
+                sendServerBusy(client, admission->queuePosition(client->id));
+                while (!client->loginAdmitted) {
+                    LoginTurn turn{client};
+                    if (!co_await turn) {
+                        co_return; // Left while queued
+                    }
+                }
+                break;
+            case AdmissionControl::LoginDecision::Rejected:
+                std::cout << "Server busy; turning away " << username << std::endl;
+                sendServerBusy(client, 0);
+                flushClient(client);
+                disconnectClient(client);
+                co_return;
+        }
+
+        // Blocking SQLite work happens on a worker; the reactor keeps serving other sockets
+        auto profileLoad = offload(*workerPool, reactor, [username]() {
+            return loadPlayerProfile(username);
+        });
+        profile = co_await profileLoad;
+        loginSlot.release();
+        if (!client->connected) {
+            co_return; // Gave up while the profile was loading
+        }
+    }
+    if (!profile) {
+        std::cout << "Login failed for client " << client->socket.getRemoteAddress() << ". Disconnecting." << std::endl;
+        disconnectClient(client);
+        co_return;
+    }
+
+    client->rating = profile->rating;
+    leaderboard->set(username, profile->rating); // A first login joins the board
+    client->collection = std::move(profile->collection);
+    client->deck = std::move(profile->deck);
+    client->username = username;
+    if (matchPeer != 0) {
+        joinMigratedMatch(client, matchPeer);
     } else {
-        std::cout << "Table 'users' created successfully or already exists" << std::endl;
+        completeLogin(client);
+    }
+
+    while (co_await nextPacket(client, received)) {
+        dispatchMessage(client, *received);
+    }
+}
+
+// Drop connections that never log in or have gone quiet; runs on the reactor thread
+void checkIdle(const std::shared_ptr<ClientConnection>& client) {
+    client->idleTimer = 0;
+    if (!client->connected) {
+        return;
+    }
+
+    auto now = TimerWheel::Clock::now();
+    bool loggedIn = !client->username.empty();
+    if (loggedIn && !client->watching.expired()) {
+        client->lastActivity = now; // Spectators only listen; watching a live game counts as activity
+    }
+    auto since = loggedIn ? client->lastActivity : client->connectedAt;
+    auto limit = loggedIn ? std::chrono::duration_cast<std::chrono::milliseconds>(IDLE_TIMEOUT)
+               : admission->isQueued(client->id) ? std::chrono::duration_cast<std::chrono::milliseconds>(LOGIN_QUEUE_TIMEOUT)
+                                                 : std::chrono::duration_cast<std::chrono::milliseconds>(LOGIN_TIMEOUT);
+    auto quiet = std::chrono::duration_cast<std::chrono::milliseconds>(now - since);
+
+    if (quiet >= limit) {
+        std::cout << (loggedIn ? "Idle timeout for " : "Login timeout for ")
+                  << client->socket.getRemoteAddress() << "; disconnecting" << std::endl;
+        disconnectClient(client);
+        return;
+    }
+    // Activity since the timer was set: re-arm for the remainder rather than per packet
+    client->idleTimer = reactor.timers().schedule(limit - quiet, [client]() { checkIdle(client); });
+}
+
+// Queue the complete packets that are ready on a client socket for its connection flow
+void onClientReadable(const std::shared_ptr<ClientConnection>& client) {
+    for (int i = 0; i < MAX_PACKETS_PER_WAKEUP && client->connected; ++i) {
+        // sf::Packet::clear() keeps its buffer, so a recycled packet receives without allocating
+        std::unique_ptr<sf::Packet> packet;
+        if (client->sparePackets.empty()) {
+            packet = std::make_unique<sf::Packet>();
+        } else {
+            packet = std::move(client->sparePackets.back());
+            client->sparePackets.pop_back();
+        }
+        sf::Socket::Status status = client->socket.receive(*packet);
+
+        if (status == sf::Socket::Done) {
+            if (handleKeepAlive(client, *packet)) {
+                client->sparePackets.push_back(std::move(packet)); // Keep-alives alone do not hold off IDLE_TIMEOUT
+                continue;
+            }
+            client->lastActivity = TimerWheel::Clock::now();
+            if (client->inbox.size() >= MAX_INBOX_PACKETS) {
+                std::cerr << "Client " << client->socket.getRemoteAddress()
+                          << " flooded its inbox; disconnecting" << std::endl;
+                disconnectClient(client);
+                return;
+            }
+            client->inbox.push_back(std::move(packet));
+            resumeReader(*client);
+        } else if (status == sf::Socket::NotReady) {
+            client->sparePackets.push_back(std::move(packet));
+            return; // Partial packet is buffered by SFML; wait for the next notification
+        } else {
+            if (status == sf::Socket::Disconnected) {
+                std::cout << "Client disconnected: " << client->socket.getRemoteAddress() << std::endl;
+            } else {
+                std::cerr << "Network error receiving from client: " 
+                          << client->socket.getRemoteAddress() << std::endl;
+            }
+            disconnectClient(client);
+            return;
+        }
     }
+}
 
-    rc = sqlite3_exec(db, sql_create_collections, 0, 0, &err_msg);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << err_msg << std::endl;
-        sqlite3_free(err_msg);
+// Give a freshly connected socket an id, reactor registration and login timer
+bool registerConnection(const std::shared_ptr<ClientConnection>& new_client_conn) {
+    new_client_conn->id = nextConnectionId.fetch_add(1, std::memory_order_relaxed);
+    new_client_conn->socket.setBlocking(false);
+    new_client_conn->connected = true;
+    new_client_conn->connectedAt = new_client_conn->lastActivity = TimerWheel::Clock::now();
+
+    // The reactor callback keeps the connection alive until disconnectClient removes it
+    sf::SocketHandle handle = new_client_conn->socket.nativeHandle();
+    if (!reactor.add(handle, Reactor::Readable, [new_client_conn](unsigned events) {
+            if (events & Reactor::Writable) {
+                flushClient(new_client_conn);
+            }
+            if (events & Reactor::Readable) {
+                onClientReadable(new_client_conn);
+            }
+        })) {
+        new_client_conn->socket.disconnect();
+        admission->connectionClosed();
+        return false;
     }
+    clientsById.insert(new_client_conn->id, new_client_conn);
+    std::cout << "Accepted connection from " << new_client_conn->socket.getRemoteAddress()
+              << " (" << reactor.size() - 1 << " open connections)" << std::endl;
+
+    new_client_conn->idleTimer = reactor.timers().schedule(
+        std::chrono::duration_cast<std::chrono::milliseconds>(LOGIN_TIMEOUT),
+        [new_client_conn]() { checkIdle(new_client_conn); });
+    return true;
+}
+
+// Accept every pending connection and hand it to the reactor
+void onListenerReadable(NetListener& listener) {
+    while (true) {
+        auto new_client_conn = std::make_shared<ClientConnection>();
+        if (listener.accept(new_client_conn->socket) != sf::Socket::Done) {
+            return;
+        }
+        if (!admission->tryAdmitConnection()) {
+            // Over the connection cap: say so and close before the socket costs anything more
+            sf::Packet busyPacket;
+            busyPacket << MessageType::ServerBusy << sf::Uint32(0);
+            new_client_conn->socket.setBlocking(false);
+            new_client_conn->socket.send(busyPacket);
+            new_client_conn->socket.disconnect();
+            std::cout << "Connection limit of " << admission->limits().maxConnections << " reached; shed "
+                      << admission->stats().connectionsShed << " connections so far" << std::endl;
+            continue;
+        }
+        if (!registerConnection(new_client_conn)) {
+            continue;
+        }
+        // Suspends straight away until the login packet arrives
+        runClientConnection(new_client_conn);
+    }
+}
+
+// Serve a connection another server process handed over; runs on the reactor thread
+void onConnectionAdopted(int fd, const std::string& username, SessionDirectory::TicketId peer,
+                         CapabilitySet capabilities) {
+    auto new_client_conn = std::make_shared<ClientConnection>();
+    new_client_conn->socket.adopt(fd);
+    new_client_conn->capabilities = capabilities;
+    admission->connectionOpened(); // Already accepted by a sibling process; never shed
+    if (!registerConnection(new_client_conn)) {
+        return;
+    }
+    std::cout << "Took over connection for " << username << " from another server process" << std::endl;
+    startHeartbeat(new_client_conn);
+    runClientConnection(new_client_conn, username, peer);
+}
+
+// Move a queued player to the process hosting their opponent; runs on the reactor thread
+void onMigrateRequested(SessionDirectory::TicketId ticket, int target, SessionDirectory::TicketId peer, int peerRating) {
+    ClientHandle client = clientsById.find(ticket);
+    if (!readyForMatch(client)) {
+        directory->migrationFailed(target, peer, peerRating);
+        return;
+    }
+    if (!directory->handoff(client->socket.nativeHandle(), target, client->username, peer, peerRating,
+                            client->capabilities)) {
+        directory->migrationFailed(target, peer, peerRating);
+        directory->enqueue(client->id, client->rating);
+        return;
+    }
+    std::cout << "Moving " << client->username << " to server process " << target << " for a match" << std::endl;
+    disconnectClient(client); // Closes only this process's copy of the socket
+}
+
+// Print the compression and heartbeat totals so far, then again every STATS_REPORT_INTERVAL (reactor thread only)
+void scheduleStatsReport() {
+    reactor.timers().schedule(STATS_REPORT_INTERVAL, []() {
+        compressionStats.report(std::cout); // Prints nothing until a large message has been sent
+        if (heartbeatStats.pingsSent() > 0) {
+            heartbeatStats.report(std::cout);
+        }
+        if (databaseWriter->stats().groups > 0) {
+            databaseWriter->report(std::cout);
+        }
+        profileCache->report(std::cout);
+        leaderboard->report(std::cout);
+        scheduleStatsReport();
+    });
+}
+
+// Hand changed profiles to the database writer every PROFILE_FLUSH_INTERVAL
+void scheduleProfileFlush() {
+    reactor.timers().schedule(PROFILE_FLUSH_INTERVAL, []() {
+        profileCache->flush();
+        scheduleProfileFlush();
+    });
+}
 
-    rc = sqlite3_exec(db, sql_create_decks, 0, 0, &err_msg);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << err_msg << std::endl;
-        sqlite3_free(err_msg);
+// Re-read the board from the database every LEADERBOARD_RELOAD_INTERVAL, picking up the ratings
+// sibling server processes stored; the read runs on a worker, off the reactor thread. Ratings set
+// before it are flushed and the read waits until the writer has stored them; reset() keeps any
+// set after it began over what the read saw
+void scheduleLeaderboardReload() {
+    reactor.timers().schedule(LEADERBOARD_RELOAD_INTERVAL, []() {
+        std::uint64_t since = leaderboard->version();
+        profileCache->flush();
+        databaseWriter->whenWritten([since]() {
+            workerPool->submit([since]() {
+                if (auto ratings = playerDatabase->readRatings()) {
+                    leaderboard->reset(*ratings, since);
+                }
+            });
+        });
+        scheduleLeaderboardReload();
+    });
+}
+
+#if !defined(_WIN32)
+// Each connection is one descriptor; lift the soft limit so the server can hold 10k+ clients
+void raiseFileDescriptorLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        if (setrlimit(RLIMIT_NOFILE, &limit) == 0) {
+            std::cout << "Raised open file limit to " << limit.rlim_cur << std::endl;
+        }
     }
+}
+#endif
+
+// Read --processes, --worker, --directory and the admission limits; unknown arguments are ignored
+ServerOptions parseOptions(int argc, char* argv[]) {
+    ServerOptions options;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string name = argv[i];
+        if (name == "--processes") {
+            options.processes = std::max(1, std::atoi(argv[++i]));
+        } else if (name == "--worker") {
+            options.workerIndex = std::atoi(argv[++i]);
+        } else if (name == "--directory") {
+            options.directoryPath = argv[++i];
+        } else if (name == "--max-connections") {
+            options.admission.maxConnections = std::strtoul(argv[++i], nullptr, 10);
+        } else if (name == "--max-logins") {
+            options.admission.maxLoginsInFlight = std::strtoul(argv[++i], nullptr, 10);
+            options.loginLimitSet = true;
+        } else if (name == "--max-login-queue") {
+            options.admission.maxQueuedLogins = std::strtoul(argv[++i], nullptr, 10);
+        } else if (name == "--max-sessions") {
+            options.admission.maxSessions = std::strtoul(argv[++i], nullptr, 10);
+        }
+    }
+    return options;
+}
 
-    sqlite3_close(db);
+#if !defined(_WIN32)
+// Start one server process that shares the port and reports to the directory at `path`.
+// It receives the supervisor's own arguments too, so limits such as --max-sessions apply per process.
+pid_t spawnServerProcess(const char* program, int index, const std::string& path,
+                         const std::vector<std::string>& forwarded) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        std::vector<std::string> args(forwarded);
+        args.insert(args.end(), {"--worker", std::to_string(index), "--directory", path});
+        std::vector<char*> argv{const_cast<char*>(program)};
+        for (std::string& arg : args) {
+            argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+        execvp(program, argv.data());
+        std::cerr << "Error: Could not start server process " << index << std::endl;
+        _exit(1);
+    }
+    return pid;
 }
 
-int main() {
-    initialize_database(); // Initialize the database at the start
+// Supervisor: host the directory service and run `processes` server processes on the shared port
+int runSupervisor(const ServerOptions& options, const char* program, const std::vector<std::string>& forwarded) {
+    {
+        // Once, before the server processes open it concurrently; packing stored cards needs their definitions
+        if (!globalPieceDefManager.loadDefinitions("assets/data/cards.json")) {
+            std::cerr << "FATAL: Could not load piece definitions from assets/data/cards.json" << std::endl;
+            return -1;
+        }
+        CardFactory::initialize();
+        PlayerDatabase::Options schemaOnly;
+        schemaOnly.path = DATABASE_PATH;
+        schemaOnly.maxConnections = 1;
+        if (!PlayerDatabase(schemaOnly).initializeSchema()) {
+            std::cerr << "Error: Could not set up the database at " << DATABASE_PATH << std::endl;
+            return 1;
+        }
+    }
+
+    if (!reactor.isValid()) {
+        std::cerr << "Error: Could not create event loop" << std::endl;
+        return 1;
+    }
+    DirectoryService service(reactor, Matchmaker::Config{}, MATCHMAKING_TICK);
+    if (!service.listen(options.directoryPath)) {
+        std::cerr << "Error: Could not open directory socket " << options.directoryPath << std::endl;
+        return 1;
+    }
+    std::cout << "Directory listening on " << options.directoryPath << "; starting "
+              << options.processes << " server processes on port " << PORT << std::endl;
+
+    for (int i = 0; i < options.processes; ++i) {
+        if (spawnServerProcess(program, i, options.directoryPath, forwarded) < 0) {
+            std::cerr << "Error: Could not fork server process " << i << std::endl;
+        }
+    }
+
+    // Reap exited server processes; the directory drops their state when their socket closes
+    std::function<void()> reap = [&reap]() {
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            std::cerr << "Server process " << pid << " exited" << std::endl;
+        }
+        reactor.timers().schedule(std::chrono::seconds(1), reap);
+    };
+    reactor.timers().schedule(std::chrono::seconds(1), reap);
+
+    reactor.run();
+    return 0;
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    ServerOptions options = parseOptions(argc, argv);
+#if !defined(_WIN32)
+    if (options.processes > 1 && options.workerIndex < 0) {
+        return runSupervisor(options, argc > 0 ? argv[0] : "bayou_server",
+                             std::vector<std::string>(argv + std::min(argc, 1), argv + argc));
+    }
+#else
+    if (options.processes > 1) {
+        std::cerr << "Multiple server processes are not supported on this platform; running one" << std::endl;
+    }
+#endif
+    bool sharedPort = options.workerIndex >= 0;
 
     // Initialize global PieceFactory for piece creation (needed for card play)
     if (!globalPieceDefManager.loadDefinitions("assets/data/cards.json")) {
@@ -791,245 +2168,105 @@ int main() {
     // Initialize the GameInitializer with the loaded PieceDefinitionManager and PieceFactory
     gameInitializer = std::make_unique<GameInitializer>(globalPieceDefManager, *globalPieceFactory);
 
-    sf::TcpListener listener;
+    // Card definitions are lazily built on first use; do it now, before worker threads can race on it
+    CardFactory::initialize();
+    if (sharedPort) {
+        // Sibling processes share the cores
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        workerPool = std::make_unique<WorkerPool>(std::max<std::size_t>(1, cores / static_cast<unsigned>(options.processes)));
+    } else {
+        workerPool = std::make_unique<WorkerPool>();
+    }
+    std::cout << "Game logic running on " << workerPool->threadCount() << " worker threads" << std::endl;
+
+    PlayerDatabase::Options databaseOptions;
+    databaseOptions.path = DATABASE_PATH;
+    databaseOptions.maxConnections = workerPool->threadCount() + 1; // Profile reads, plus the writer
+    playerDatabase = std::make_unique<PlayerDatabase>(databaseOptions);
+    if (!sharedPort && !playerDatabase->initializeSchema()) {
+        std::cerr << "Error: Could not set up the database at " << DATABASE_PATH << std::endl;
+        return 1;
+    }
+    databaseWriter = std::make_unique<DatabaseWriter>(*playerDatabase);
+    ProfileCache::Options cacheOptions;
+    if (sharedPort) {
+        cacheOptions.capacity = 0; // Sibling processes write the same rows; a cached copy could go stale
+    }
+    profileCache = std::make_unique<ProfileCache>(*playerDatabase, *databaseWriter, cacheOptions);
 
-    // Bind the listener to a port
-    if (listener.listen(PORT) != sf::Socket::Done) {
-        std::cerr << "Error: Could not bind listener to port " << PORT << std::endl;
+    leaderboard = std::make_unique<Leaderboard>();
+    std::optional<std::vector<PlayerDatabase::RatingUpdate>> ratings = playerDatabase->readRatings();
+    if (!ratings) {
+        std::cerr << "Error: Could not read ratings for the leaderboard from " << DATABASE_PATH << std::endl;
         return 1;
     }
-    std::cout << "Server listening on port " << PORT << "..." << std::endl;
-    std::cout << "Waiting for " << REQUIRED_PLAYERS << " players to connect..." << std::endl;
+    leaderboard->set(*ratings);
+    std::cout << "Leaderboard ranks " << leaderboard->size() << " players" << std::endl;
 
-    listener.setBlocking(false); // Use non-blocking to allow checking for game start condition
-
-    std::vector<std::thread> client_threads;
-
-    while (true) { // Main server loop
-        std::shared_ptr<ClientConnection> new_client_conn = std::make_shared<ClientConnection>();
-
-        if (listener.accept(new_client_conn->socket) == sf::Socket::Done) {
-            std::lock_guard<std::mutex> lock(clientsMutex); // Protect clients vector
-            {
-                // Handle UserLogin
-                new_client_conn->socket.setBlocking(true);
-                sf::Packet loginPacket;
-                std::string received_username;
-                bool login_successful = false;
-
-                if (new_client_conn->socket.receive(loginPacket) == sf::Socket::Done) {
-                    MessageType msg_type;
-                    if (loginPacket >> msg_type && msg_type == MessageType::UserLogin) {
-                        if (loginPacket >> received_username && !received_username.empty()) {
-                            sqlite3* db;
-                            int rc_db = sqlite3_open("bayou_bonanza.db", &db);
-                            if (rc_db) {
-                                std::cerr << "Can't open database: " << sqlite3_errmsg(db) << std::endl;
-                                if(db) sqlite3_close(db);
-                                // Optionally, reject connection or use default rating
-                            } else {
-                                std::cout << "Database opened for user: " << received_username << std::endl;
-                                const char* sql_select = "SELECT rating FROM users WHERE username = ?;";
-                                sqlite3_stmt* stmt_select;
-                                if (sqlite3_prepare_v2(db, sql_select, -1, &stmt_select, 0) == SQLITE_OK) {
-                                    sqlite3_bind_text(stmt_select, 1, received_username.c_str(), -1, SQLITE_STATIC);
-                                    int rc_step = sqlite3_step(stmt_select);
-                                    if (rc_step == SQLITE_ROW) {
-                                        new_client_conn->rating = sqlite3_column_int(stmt_select, 0);
-                                        std::cout << "User " << received_username << " found with rating " << new_client_conn->rating << std::endl;
-                                    } else if (rc_step == SQLITE_DONE) {
-                                        // User not found, insert new user
-                                        const char* sql_insert = "INSERT INTO users (username, rating) VALUES (?, ?);";
-                                        sqlite3_stmt* stmt_insert;
-                                        if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt_insert, 0) == SQLITE_OK) {
-                                            sqlite3_bind_text(stmt_insert, 1, received_username.c_str(), -1, SQLITE_STATIC);
-                                            sqlite3_bind_int(stmt_insert, 2, 0); // Default rating
-                                            if (sqlite3_step(stmt_insert) == SQLITE_DONE) {
-                                                new_client_conn->rating = 0;
-                                                std::cout << "New user " << received_username << " inserted with default rating 1000." << std::endl;
-                                            } else {
-                                                std::cerr << "SQL error inserting user: " << sqlite3_errmsg(db) << std::endl;
-                                            }
-                                            sqlite3_finalize(stmt_insert);
-                                        } else {
-                                            std::cerr << "Failed to prepare insert statement: " << sqlite3_errmsg(db) << std::endl;
-                                        }
-                                    } else {
-                                        std::cerr << "SQL error selecting user: " << sqlite3_errmsg(db) << std::endl;
-                                    }
-                                    sqlite3_finalize(stmt_select);
-                                } else {
-                                    std::cerr << "Failed to prepare select statement: " << sqlite3_errmsg(db) << std::endl;
-                                }
-                                // Load or create card collection and deck
-                                const char* sql_select_collection = "SELECT cards FROM collections WHERE username = ?;";
-                                const char* sql_insert_collection = "INSERT INTO collections (username, cards) VALUES (?, ?);";
-                                const char* sql_select_deck = "SELECT deck FROM decks WHERE username = ?;";
-                                const char* sql_insert_deck = "INSERT INTO decks (username, deck) VALUES (?, ?);";
-
-                                std::string collectionStr;
-                                std::string deckStr;
-
-                                sqlite3_stmt* stmt_coll;
-                                if (sqlite3_prepare_v2(db, sql_select_collection, -1, &stmt_coll, 0) == SQLITE_OK) {
-                                    sqlite3_bind_text(stmt_coll, 1, received_username.c_str(), -1, SQLITE_STATIC);
-                                    if (sqlite3_step(stmt_coll) == SQLITE_ROW) {
-                                        const unsigned char* text = sqlite3_column_text(stmt_coll, 0);
-                                        if (text) collectionStr = reinterpret_cast<const char*>(text);
-                                    }
-                                    sqlite3_finalize(stmt_coll);
-                                }
-
-                                if (collectionStr.empty()) {
-                                    auto starter = CardFactory::createStarterDeck();
-                                    CardCollection cc(std::move(starter));
-                                    collectionStr = cc.serialize();
-                                    sqlite3_stmt* stmt_ins;
-                                    if (sqlite3_prepare_v2(db, sql_insert_collection, -1, &stmt_ins, 0) == SQLITE_OK) {
-                                        sqlite3_bind_text(stmt_ins, 1, received_username.c_str(), -1, SQLITE_STATIC);
-                                        sqlite3_bind_text(stmt_ins, 2, collectionStr.c_str(), -1, SQLITE_STATIC);
-                                        sqlite3_step(stmt_ins);
-                                        sqlite3_finalize(stmt_ins);
-                                    }
-                                }
-
-                                sqlite3_stmt* stmt_deck;
-                                if (sqlite3_prepare_v2(db, sql_select_deck, -1, &stmt_deck, 0) == SQLITE_OK) {
-                                    sqlite3_bind_text(stmt_deck, 1, received_username.c_str(), -1, SQLITE_STATIC);
-                                    if (sqlite3_step(stmt_deck) == SQLITE_ROW) {
-                                        const unsigned char* text = sqlite3_column_text(stmt_deck, 0);
-                                        if (text) deckStr = reinterpret_cast<const char*>(text);
-                                    }
-                                    sqlite3_finalize(stmt_deck);
-                                }
-
-                                if (deckStr.empty()) {
-                                    auto starter = CardFactory::createStarterDeck();
-                                    Deck d(std::move(starter));
-                                    deckStr = d.serialize();
-                                    sqlite3_stmt* stmt_ins;
-                                    if (sqlite3_prepare_v2(db, sql_insert_deck, -1, &stmt_ins, 0) == SQLITE_OK) {
-                                        sqlite3_bind_text(stmt_ins, 1, received_username.c_str(), -1, SQLITE_STATIC);
-                                        sqlite3_bind_text(stmt_ins, 2, deckStr.c_str(), -1, SQLITE_STATIC);
-                                        sqlite3_step(stmt_ins);
-                                        sqlite3_finalize(stmt_ins);
-                                    }
-                                }
-
-                                new_client_conn->collection.deserialize(collectionStr);
-                                new_client_conn->deck.deserialize(deckStr);
-
-                                sqlite3_close(db);
-                                new_client_conn->username = received_username;
-                                login_successful = true;
-
-                                // Check for existing game session for this user
-                                auto existingSession = findGameSessionByUsername(new_client_conn->username);
-                                if (existingSession && !gameRules.isGameOver(existingSession->gameState)) {
-                                    std::cout << "Reconnecting user " << new_client_conn->username << " to ongoing game" << std::endl;
-                                    if (existingSession->player1 && existingSession->player1->username == new_client_conn->username) {
-                                        existingSession->player1 = new_client_conn;
-                                        new_client_conn->playerSide = PlayerSide::PLAYER_ONE;
-                                    } else if (existingSession->player2 && existingSession->player2->username == new_client_conn->username) {
-                                        existingSession->player2 = new_client_conn;
-                                        new_client_conn->playerSide = PlayerSide::PLAYER_TWO;
-                                    }
-                                    new_client_conn->session = existingSession;
-
-                                    new_client_conn->socket.setBlocking(false);
-
-                                    // Send PlayerAssignment
-                                    sf::Packet assignmentPacket;
-                                    assignmentPacket << MessageType::PlayerAssignment << new_client_conn->playerSide;
-                                    new_client_conn->socket.send(assignmentPacket);
-
-                                    // Send collection and deck
-                                    sf::Packet collectionPacket;
-                                    collectionPacket << MessageType::CardCollectionData << new_client_conn->collection.serialize();
-                                    new_client_conn->socket.send(collectionPacket);
-
-                                    sf::Packet deckPacket;
-                                    deckPacket << MessageType::DeckData << new_client_conn->deck.serialize();
-                                    new_client_conn->socket.send(deckPacket);
-
-                                    // Send current game state as GameStart packet (acts as resume)
-                                    sf::Packet gameStartPacket;
-                                    std::string p1_username = existingSession->player1->username;
-                                    int p1_rating = existingSession->player1->rating;
-                                    std::string p2_username = existingSession->player2->username;
-                                    int p2_rating = existingSession->player2->rating;
-                                    gameStartPacket << MessageType::GameStart << p1_username << p1_rating
-                                                    << p2_username << p2_rating << existingSession->gameState;
-                                    new_client_conn->socket.send(gameStartPacket);
-
-                                    clients.push_back(new_client_conn);
-                                    client_threads.emplace_back(handle_client, new_client_conn);
-                                    continue; // Skip normal post-login flow
-                                }
-                            }
-                        } else {
-                             std::cerr << "Failed to deserialize username or username empty." << std::endl;
-                        }
-                    } else {
-                        std::cerr << "Login failed: Did not receive UserLogin message type or failed to deserialize type." << std::endl;
-                    }
-                } else {
-                    std::cerr << "Failed to receive login packet from " << new_client_conn->socket.getRemoteAddress() << std::endl;
-                }
-                
-                new_client_conn->socket.setBlocking(false); // Set back to non-blocking for game loop
+    if (!options.loginLimitSet) {
+        options.admission.maxLoginsInFlight = std::max<std::size_t>(1, workerPool->threadCount() / 2);
+    }
+    admission = std::make_unique<AdmissionControl>(options.admission);
+    std::cout << "Admitting up to " << options.admission.maxConnections << " connections, "
+              << options.admission.maxLoginsInFlight << " concurrent logins (" << options.admission.maxQueuedLogins
+              << " queued) and " << options.admission.maxSessions << " games" << std::endl;
 
-                if (!login_successful) {
-                    std::cout << "Login failed for client " << new_client_conn->socket.getRemoteAddress() << ". Disconnecting." << std::endl;
-                    new_client_conn->socket.disconnect(); // Disconnect if login failed
-                    continue; // Skip adding to clients list and further processing
-                }
+#if !defined(_WIN32)
+    raiseFileDescriptorLimit();
+#endif
 
-                // Assign default PlayerSide until matchmaking
-                new_client_conn->playerSide = PlayerSide::NEUTRAL;
-                clients.push_back(new_client_conn);
-                
-                std::string sideStr = "Neutral";
-                if (new_client_conn->playerSide == PlayerSide::PLAYER_ONE) sideStr = "One";
-                else if (new_client_conn->playerSide == PlayerSide::PLAYER_TWO) sideStr = "Two";
-                std::cout << "User '" << new_client_conn->username << "' (Rating: " << new_client_conn->rating
-                          << ") connected as Player " << sideStr
-                          << " from " << new_client_conn->socket.getRemoteAddress() << std::endl;
-                std::cout << "Current players connected: " << clients.size() << std::endl;
-                
-                // Send PlayerAssignment
-                sf::Packet assignmentPacket;
-                assignmentPacket << MessageType::PlayerAssignment << new_client_conn->playerSide;
-                new_client_conn->socket.send(assignmentPacket);
-
-                // Send player collection and deck
-                sf::Packet collectionPacket;
-                collectionPacket << MessageType::CardCollectionData << new_client_conn->collection.serialize();
-                new_client_conn->socket.send(collectionPacket);
-
-                sf::Packet deckPacket;
-                deckPacket << MessageType::DeckData << new_client_conn->deck.serialize();
-                new_client_conn->socket.send(deckPacket);
-
-                // Don't automatically start games - wait for explicit matchmaking requests
-                std::cout << "Player connected. Total players: " << clients.size() << std::endl;
-                
-                // Start thread for each client to handle their messages
-                client_threads.emplace_back(handle_client, new_client_conn);
+    if (!reactor.isValid()) {
+        std::cerr << "Error: Could not create event loop" << std::endl;
+        return 1;
+    }
 
-            }
+#if !defined(_WIN32)
+    if (sharedPort) {
+        // A server process dies with its supervisor
+        directory = RemoteDirectory::connect(reactor, options.directoryPath, options.workerIndex,
+                                             []() { reactor.stop(); });
+        if (!directory) {
+            std::cerr << "Error: Could not reach directory at " << options.directoryPath << std::endl;
+            return 1;
         }
+    } else
+#endif
+    {
+        auto local = std::make_unique<LocalDirectory>(reactor, Matchmaker::Config{}, MATCHMAKING_TICK);
+        local->start();
+        directory = std::move(local);
+    }
+    directory->setHandlers({onMatchFound, onMigrateRequested, onConnectionAdopted});
 
-        // Add a small sleep to prevent busy-waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    NetListener listener;
+
+    // Bind the listener to a port; server processes share it and the kernel spreads connections
+    sf::Socket::Status listenStatus = sharedPort ? listener.listenShared(PORT) : listener.listen(PORT);
+    if (listenStatus != sf::Socket::Done) {
+        std::cerr << "Error: Could not bind listener to port " << PORT << std::endl;
+        return 1;
     }
+    std::cout << "Server" << (sharedPort ? " process " + std::to_string(options.workerIndex) : std::string())
+              << " listening on port " << PORT << "..." << std::endl;
+    std::cout << "Waiting for " << REQUIRED_PLAYERS << " players to connect..." << std::endl;
 
-    // Wait for all client threads to finish (this won't be reached in the current design)
-    for (auto& thread : client_threads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+    listener.setBlocking(false); // Accept is driven by readiness notifications
+
+    reactor.add(listener.nativeHandle(), Reactor::Readable, [&listener](unsigned) {
+        onListenerReadable(listener);
+    });
+
+    scheduleStatsReport();
+    scheduleProfileFlush();
+    if (sharedPort) {
+        scheduleLeaderboardReload();
     }
 
+    // Main server loop: sleeps in the kernel until a socket has work to do
+    reactor.run();
+
+    profileCache->flush();
+    databaseWriter->shutdown(); // Store what is still queued
+
     return 0;
 }
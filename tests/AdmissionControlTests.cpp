@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AdmissionControl.h"
+
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+
+AdmissionControl::Limits smallLimits() {
+    AdmissionControl::Limits limits;
+    limits.maxConnections = 3;
+    limits.maxLoginsInFlight = 2;
+    limits.maxQueuedLogins = 2;
+    limits.maxSessions = 1;
+    return limits;
+}
+
+} // namespace
+
+TEST_CASE("AdmissionControl sheds connections and games over their caps") {
+    AdmissionControl admission(smallLimits());
+
+    REQUIRE(admission.tryAdmitConnection());
+    REQUIRE(admission.tryAdmitConnection());
+    REQUIRE(admission.tryAdmitConnection());
+    REQUIRE_FALSE(admission.tryAdmitConnection());
+    admission.connectionOpened(); // Handed-over connections are always taken
+    REQUIRE(admission.connections() == 4);
+    admission.connectionClosed();
+    admission.connectionClosed();
+    REQUIRE(admission.tryAdmitConnection());
+    REQUIRE(admission.stats().connectionsShed == 1);
+
+    REQUIRE(admission.tryStartSession());
+    REQUIRE_FALSE(admission.tryStartSession());
+    admission.sessionEnded();
+    REQUIRE(admission.tryStartSession());
+    REQUIRE(admission.stats().sessionsDeferred == 1);
+}
+
+TEST_CASE("AdmissionControl queues excess logins and serves reconnects first") {
+    using Decision = AdmissionControl::LoginDecision;
+    using Priority = AdmissionControl::Priority;
+    AdmissionControl admission(smallLimits());
+
+    REQUIRE(admission.requestLogin(1, Priority::NewLogin) == Decision::Admitted);
+    REQUIRE(admission.requestLogin(2, Priority::NewLogin) == Decision::Admitted);
+    REQUIRE(admission.requestLogin(3, Priority::NewLogin) == Decision::Queued);
+    REQUIRE(admission.requestLogin(4, Priority::NewLogin) == Decision::Queued);
+    REQUIRE(admission.requestLogin(5, Priority::NewLogin) == Decision::Rejected);
+    // Reconnects are never refused and go ahead of new logins
+    REQUIRE(admission.requestLogin(6, Priority::Reconnect) == Decision::Queued);
+    REQUIRE(admission.queuePosition(6) == 1);
+    REQUIRE(admission.queuePosition(3) == 2);
+    REQUIRE(admission.queuePosition(4) == 3);
+
+    REQUIRE(admission.finishLogin(1) == std::vector<AdmissionControl::Id>{6});
+    REQUIRE(admission.queuePosition(3) == 1);
+
+    // A queued login that gives up leaves without being admitted
+    REQUIRE(admission.finishLogin(3).empty());
+    REQUIRE_FALSE(admission.isQueued(3));
+    REQUIRE(admission.queuePosition(4) == 1);
+
+    REQUIRE(admission.finishLogin(2) == std::vector<AdmissionControl::Id>{4});
+    REQUIRE(admission.queuedLogins() == 0);
+    REQUIRE(admission.loginsInFlight() == 2);
+
+    REQUIRE(admission.finishLogin(6).empty());
+    REQUIRE(admission.finishLogin(4).empty());
+    REQUIRE(admission.loginsInFlight() == 0);
+    REQUIRE(admission.requestLogin(7, Priority::NewLogin) == Decision::Admitted);
+
+    REQUIRE(admission.stats().loginsQueued == 3);
+    REQUIRE(admission.stats().reconnectsQueued == 1);
+    REQUIRE(admission.stats().loginsRejected == 1);
+    REQUIRE(admission.stats().maxLoginQueue == 3);
+}
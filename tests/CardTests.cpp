@@ -17,6 +17,8 @@
 #include <iostream>
 #include <typeinfo>
 #include <map>
+#include <chrono>
+#include <string>
 
 using namespace BayouBonanza;
 
@@ -359,6 +361,91 @@ TEST_CASE_METHOD(CardTestFixture, "CardCollection Functionality", "[card][collec
     }
 }
 
+TEST_CASE("CardCollection and Deck pack into compact storage", "[card][collection]") {
+    std::vector<std::unique_ptr<Card>> starter = CardFactory::createStarterDeck();
+    REQUIRE_FALSE(starter.empty());
+    int firstId = starter.front()->getId();
+    int lastId = starter.back()->getId();
+
+    SECTION("A collection keeps its card counts") {
+        CardCollection collection(CardFactory::createStarterDeck());
+        for (int i = 0; i < 300; ++i) {
+            collection.addCard(CardFactory::createCard(i % 2 ? firstId : lastId));
+        }
+        std::string packed = collection.pack();
+        REQUIRE(packed.size() == 3 + 4 * collection.getCardCounts().size()); // Format, entries, (ID, count) each
+        REQUIRE(packed.size() < collection.serialize().size());
+
+        CardCollection unpacked;
+        REQUIRE(unpacked.unpack(packed));
+        REQUIRE(unpacked.size() == collection.size());
+        REQUIRE(unpacked.getCardCounts() == collection.getCardCounts());
+    }
+
+    SECTION("A deck keeps its order and victory slots") {
+        Deck deck;
+        // Serialized with no victory cards it ends in "|"; add an empty slot and one card
+        REQUIRE(deck.deserialize(Deck(CardFactory::createStarterDeck()).serialize() + "0," + std::to_string(firstId)));
+        REQUIRE(deck.victoryCount() == 1); // Filled slots
+        REQUIRE(deck.getVictoryCard(1) != nullptr);
+
+        Deck unpacked;
+        REQUIRE(unpacked.unpack(deck.pack()));
+        REQUIRE(unpacked.serialize() == deck.serialize());
+        REQUIRE(unpacked.getVictoryCard(0) == nullptr);
+        REQUIRE(unpacked.getVictoryCard(1)->getId() == firstId);
+    }
+
+    SECTION("Truncated or unknown data is refused") {
+        std::string packed = CardCollection(CardFactory::createStarterDeck()).pack();
+        CardCollection collection;
+        REQUIRE_FALSE(collection.unpack(packed.substr(0, packed.size() - 1)));
+        REQUIRE(collection.empty());
+        REQUIRE_FALSE(collection.unpack(std::string("\x02\x00\x00", 3))); // Unknown format
+        REQUIRE_FALSE(collection.unpack(packed + "x"));                      // Trailing bytes
+        Deck deck;
+        REQUIRE_FALSE(deck.unpack(packed)); // A collection lacks the victory slots
+    }
+}
+
+// Time to load a 10k-card collection, as a long-time player's might be: stored text against the packed form.
+// Run with: BayouBonanzaTests "[performance]"
+TEST_CASE("CardCollection deserialize and unpack time", "[.][card][collection][performance]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int ROUNDS = 200;
+    std::vector<std::unique_ptr<Card>> starter = CardFactory::createStarterDeck();
+    REQUIRE_FALSE(starter.empty());
+    CardCollection large;
+    for (int i = 0; i < 10000; ++i) {
+        large.addCard(starter[i % starter.size()]->clone());
+    }
+    const std::string text = large.serialize();
+    const std::string packed = large.pack();
+
+    auto microsPerRound = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / ROUNDS;
+    };
+
+    CardCollection fromText;
+    auto start = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        fromText.deserialize(text);
+    }
+    double deserializeTime = microsPerRound(start);
+
+    CardCollection fromPacked;
+    start = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        fromPacked.unpack(packed);
+    }
+    double unpackTime = microsPerRound(start);
+
+    REQUIRE(fromText.getCardCounts() == large.getCardCounts());
+    REQUIRE(fromPacked.getCardCounts() == large.getCardCounts());
+    std::cout << "deserialize(): " << text.size() << " bytes, " << deserializeTime << " us\n"
+              << "unpack(): " << packed.size() << " bytes, " << unpackTime << " us" << std::endl;
+}
+
 TEST_CASE_METHOD(CardTestFixture, "CardPlayValidator Functionality", "[card][validator]") {
     
     SECTION("Basic Card Play Validation") {
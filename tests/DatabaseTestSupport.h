@@ -0,0 +1,34 @@
+#pragma once
+
+#include "PlayerDatabase.h"
+
+#include <cstddef>
+#include <cstdio> // For remove()
+#include <string>
+#include <utility>
+
+// Shared by the tests that open a PlayerDatabase on a file of their own
+
+// Removes a test database and the WAL files SQLite keeps beside it
+inline void removeTestDatabase(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+}
+
+inline BayouBonanza::PlayerDatabase::Options testOptions(const std::string& path, std::size_t maxConnections = 2) {
+    BayouBonanza::PlayerDatabase::Options options;
+    options.path = path;
+    options.maxConnections = maxConnections;
+    return options;
+}
+
+// What a user starts with on first load; tests that unpack the cards pass packed ones
+inline BayouBonanza::PlayerDatabase::NewUser starter(std::string collection = "1:2;2:1",
+                                                     std::string deck = "Starter:1:1;2:1") {
+    BayouBonanza::PlayerDatabase::NewUser defaults;
+    defaults.rating = 1000;
+    defaults.collection = std::move(collection);
+    defaults.deck = std::move(deck);
+    return defaults;
+}
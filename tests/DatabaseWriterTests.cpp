@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include "DatabaseWriter.h"
+#include "DatabaseTestSupport.h"
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+
+const char* TEST_DB_NAME = "test_database_writer.db";
+
+} // namespace
+
+TEST_CASE("DatabaseWriter commits queued writes together, in order", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+
+        DatabaseWriter::Options options;
+        options.maxBatch = 8;
+        options.maxDelay = std::chrono::milliseconds(50);
+        DatabaseWriter writer(database, options);
+
+        // Twenty writes submitted at once fill batches rather than waiting out the delay one by one
+        const int USERS = 10;
+        std::vector<std::promise<bool>> outcomes(2 * USERS);
+        for (int i = 0; i < USERS; ++i) {
+            std::string name = "user" + std::to_string(i);
+            writer.submit({PlayerDatabase::createUser(name, starter())},
+                          [&outcomes, i](bool stored) { outcomes[2 * i].set_value(stored); });
+            writer.submit({PlayerDatabase::ratingSet(name, 100 + i), PlayerDatabase::deckSave(name, "Mine:3:1")},
+                          [&outcomes, i](bool stored) { outcomes[2 * i + 1].set_value(stored); });
+        }
+        for (auto& outcome : outcomes) {
+            REQUIRE(outcome.get_future().get());
+        }
+
+        DatabaseWriter::Stats stats = writer.stats();
+        REQUIRE(stats.groups == 2 * USERS);
+        REQUIRE(stats.failed == 0);
+        REQUIRE(stats.batches >= 3); // No more than maxBatch at a time
+        REQUIRE(stats.batches < stats.groups);
+        REQUIRE(stats.largestBatch <= 8);
+
+        auto user = database.readUser("user7", starter());
+        REQUIRE(user);
+        REQUIRE(user->rating == 107);
+        REQUIRE(user->deck == "Mine:3:1");
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("DatabaseWriter reports failed writes and stores the rest on shutdown", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+
+        DatabaseWriter::Options options;
+        options.maxDelay = std::chrono::seconds(10); // Only shutdown sends these
+        DatabaseWriter writer(database, options);
+
+        std::vector<bool> outcomes;
+        writer.submit({PlayerDatabase::createUser("dave", starter())},
+                      [&outcomes](bool stored) { outcomes.push_back(stored); });
+        writer.submit({PlayerDatabase::ratingSet("nobody", 50)},
+                      [&outcomes](bool stored) { outcomes.push_back(stored); });
+        writer.shutdown();
+
+        REQUIRE(outcomes == std::vector<bool>{true, false});
+        REQUIRE(writer.stats().failed == 1);
+        REQUIRE(writer.stats().batches == 1);
+
+        // Once stopped, writes are refused rather than lost quietly
+        bool refused = false;
+        writer.submit({PlayerDatabase::deckSave("dave", "Late:1:1")}, [&refused](bool stored) { refused = !stored; });
+        REQUIRE(refused);
+        REQUIRE(database.readUser("dave", starter())->deck == "Starter:1:1;2:1");
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("DatabaseWriter calls whenWritten() waiters after the writes before them", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+
+        DatabaseWriter::Options options;
+        options.maxBatch = 2;
+        options.maxDelay = std::chrono::milliseconds(20);
+        DatabaseWriter writer(database, options);
+
+        // Nothing outstanding: called at once, on this thread
+        bool idle = false;
+        writer.whenWritten([&idle]() { idle = true; });
+        REQUIRE(idle);
+
+        std::vector<std::string> order;
+        std::mutex orderMutex;
+        auto note = [&order, &orderMutex](const std::string& what) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(what);
+        };
+        writer.submit({PlayerDatabase::createUser("erin", starter())}, [&note](bool) { note("create"); });
+        writer.submit({PlayerDatabase::ratingSet("erin", 321)}, [&note](bool) { note("rating"); });
+        writer.submit({PlayerDatabase::deckSave("erin", "Late:1:1")}, [&note](bool) { note("deck"); });
+        std::promise<int> seen;
+        writer.whenWritten([&]() {
+            note("barrier");
+            seen.set_value(database.readUser("erin", starter())->rating);
+        });
+        REQUIRE(seen.get_future().get() == 321);
+        writer.shutdown();
+
+        REQUIRE(order == std::vector<std::string>{"create", "rating", "deck", "barrier"});
+        REQUIRE(writer.stats().groups == 3); // The barrier wrote nothing
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
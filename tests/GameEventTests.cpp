@@ -0,0 +1,203 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GameEvent.h"
+#include "GameStateDelta.h"
+#include "GameTestSupport.h"
+
+#include <iostream>
+#include <optional>
+#include <random>
+
+using namespace BayouBonanza;
+
+namespace {
+
+// Take one random legal action for the active player and return it as the server would send it
+GameEvent playRandomEvent(GameState& state, GameRules& rules, TurnManager& turns, std::mt19937& random) {
+    GameEvent event;
+    playRandomAction(state, rules, turns, random, [&](const RandomAction& action) {
+        switch (action.kind) {
+            case RandomAction::Kind::PlayCard:
+                event = GameEvent::playCard(state, action.cardIndex, action.target);
+                break;
+            case RandomAction::Kind::Move:
+                event = GameEvent::move(state, action.move.getFrom(), action.move.getTo());
+                break;
+            case RandomAction::Kind::NextPhase:
+                event = GameEvent::nextPhase(state);
+                break;
+        }
+    });
+    event.recordDraws(state);
+    return event;
+}
+
+struct ReplayedGame {
+    int events = 0;
+    std::size_t eventBytes = 0;  // GameEvent messages sent to both players
+    std::size_t deltaBytes = 0;  // GameStateDelta messages for the same updates
+    bool clientsMatched = true;
+};
+
+// Self-play one game, sending every action as a GameEvent to each player's copy of the state
+ReplayedGame replayGame(GameInitializer& initializer, unsigned seed, int maxActions) {
+    GameState serverState;
+    initializer.initializeNewGame(serverState);
+    GameRules rules;
+    TurnManager turns(serverState, rules);
+    std::mt19937 random(seed);
+
+    const PlayerSide sides[] = {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO};
+    GameStateSnapshot sent(serverState, 1);
+    GameState clientStates[2];
+    sf::Uint32 clientSequences[2] = {0, 0};
+    for (int seat = 0; seat < 2; ++seat) {
+        WireBuffer start;
+        sent.writeFull(start.writer, sides[seat]);
+        WireReader reader = start.reader();
+        reader >> clientStates[seat] >> clientSequences[seat];
+    }
+
+    ReplayedGame game;
+    for (int action = 0; action < maxActions && !rules.isGameOver(serverState); ++action) {
+        GameEvent event = playRandomEvent(serverState, rules, turns, random);
+
+        GameStateSnapshot snapshot(serverState, sent.sequence() + 1);
+        game.events++;
+        for (int seat = 0; seat < 2; ++seat) {
+            // Counted as the server sends it, but hashed every time so a divergence fails where it happens
+            WireBuffer sentEvent;
+            bool hashed = snapshot.sequence() % GameEvent::STATE_HASH_INTERVAL == 0;
+            event.write(sentEvent.writer, snapshot.sequence(), sides[seat],
+                        hashed ? std::optional<sf::Uint64>(serverState.hash(sides[seat])) : std::nullopt);
+            game.eventBytes += sizeof(sf::Uint8) + sentEvent.writer.getDataSize();
+
+            WireBuffer checkedEvent;
+            event.write(checkedEvent.writer, snapshot.sequence(), sides[seat], serverState.hash(sides[seat]));
+
+            WireBuffer delta;
+            snapshot.writeDelta(delta.writer, sent, sides[seat]);
+            game.deltaBytes += sizeof(sf::Uint8) + delta.writer.getDataSize();
+
+            WireReader reader = checkedEvent.reader();
+            if (!applyGameEvent(reader, clientStates[seat], clientSequences[seat], sides[seat])) {
+                game.clientsMatched = false;
+            }
+        }
+        sent = std::move(snapshot);
+        if (!game.clientsMatched) {
+            break;
+        }
+    }
+    return game;
+}
+
+} // namespace
+
+TEST_CASE_METHOD(GameTestFixture, "GameEvent replays keep each player's state equal to the server's", "[event]") {
+    for (unsigned seed : {1u, 2u, 3u}) {
+        ReplayedGame game = replayGame(initializer, seed, 300);
+        REQUIRE(game.events > 0);
+        REQUIRE(game.clientsMatched);
+        REQUIRE(game.eventBytes < game.deltaBytes);
+    }
+}
+
+TEST_CASE_METHOD(GameTestFixture, "GameEvent shows drawn cards only to their owner", "[event]") {
+    GameState state;
+    initializer.initializeNewGame(state);
+    GameRules rules;
+    TurnManager turns(state, rules);
+
+    // Discard a card so the next player's turn start has room to draw
+    PlayerSide next = state.getActivePlayer() == PlayerSide::PLAYER_ONE ? PlayerSide::PLAYER_TWO
+                                                                        : PlayerSide::PLAYER_ONE;
+    state.getHand(next).removeCardAt(0);
+    GameEvent event = GameEvent::nextPhase(state);
+    turns.nextPhase();
+    event.recordDraws(state);
+    REQUIRE(event.getDrawnCards(next).size() == 1);
+    REQUIRE(event.getDrawnCards(next)[0] == state.getHand(next).getCardIds().back());
+
+    PlayerSide opponent = next == PlayerSide::PLAYER_ONE ? PlayerSide::PLAYER_TWO : PlayerSide::PLAYER_ONE;
+    WireBuffer owner;
+    WireBuffer other;
+    event.write(owner.writer, 2, next);
+    event.write(other.writer, 2, opponent);
+    // The owner gets the card's ID, the opponent only the count
+    REQUIRE(owner.writer.getDataSize() == other.writer.getDataSize() + sizeof(sf::Uint16));
+
+    GameEvent received;
+    sf::Uint32 sequence = 0;
+    std::optional<sf::Uint64> stateHash;
+    WireReader ownerReader = owner.reader();
+    REQUIRE(GameEvent::read(ownerReader, received, sequence, stateHash, next));
+    REQUIRE(sequence == 2);
+    REQUIRE_FALSE(stateHash);
+    REQUIRE(received.getType() == GameEvent::Type::NextPhase);
+    REQUIRE(received.getDrawnCards(next) == event.getDrawnCards(next));
+}
+
+TEST_CASE_METHOD(GameTestFixture, "GameEvent is refused out of order or against a drifted state", "[event]") {
+    GameState server;
+    initializer.initializeNewGame(server);
+    GameRules rules;
+    TurnManager turns(server, rules);
+    PlayerSide viewer = PlayerSide::PLAYER_ONE;
+
+    GameState client;
+    WireBuffer start;
+    GameStateSnapshot(server, 1).writeFull(start.writer, viewer);
+    sf::Uint32 clientSequence = 0;
+    WireReader startReader = start.reader();
+    REQUIRE((startReader >> client >> clientSequence));
+
+    GameEvent event = GameEvent::nextPhase(server);
+    turns.nextPhase();
+    event.recordDraws(server);
+
+    SECTION("An event for another sequence leaves the state alone") {
+        WireBuffer sent;
+        event.write(sent.writer, 5, viewer);
+        int turnBefore = client.getTurnNumber();
+        WireReader reader = sent.reader();
+        REQUIRE_FALSE(applyGameEvent(reader, client, clientSequence, viewer));
+        REQUIRE(clientSequence == 1);
+        REQUIRE(client.getTurnNumber() == turnBefore);
+    }
+
+    SECTION("A state hash that differs asks for a resync") {
+        client.setSteam(PlayerSide::PLAYER_TWO, client.getSteam(PlayerSide::PLAYER_TWO) + 3);
+        WireBuffer sent;
+        event.write(sent.writer, 2, viewer, server.hash(viewer));
+        WireReader reader = sent.reader();
+        REQUIRE_FALSE(applyGameEvent(reader, client, clientSequence, viewer));
+        REQUIRE(clientSequence == 1);
+    }
+
+    SECTION("A matching state hash is accepted") {
+        WireBuffer sent;
+        event.write(sent.writer, 2, viewer, server.hash(viewer));
+        WireReader reader = sent.reader();
+        REQUIRE(applyGameEvent(reader, client, clientSequence, viewer));
+        REQUIRE(clientSequence == 2);
+    }
+}
+
+// Bytes per update and player: GameEvent against the GameStateDelta for the same update.
+// Run with: BayouBonanzaTests "[performance]"
+TEST_CASE_METHOD(GameTestFixture, "GameEvent bytes per action", "[.][event][performance]") {
+    constexpr int GAMES = 50;
+    ReplayedGame total;
+    for (unsigned seed = 1; seed <= GAMES; ++seed) {
+        ReplayedGame game = replayGame(initializer, seed, 1000);
+        REQUIRE(game.clientsMatched);
+        total.events += game.events;
+        total.eventBytes += game.eventBytes;
+        total.deltaBytes += game.deltaBytes;
+    }
+
+    REQUIRE(total.events > 0);
+    double messages = 2.0 * total.events;
+    std::cout << GAMES << " games, " << total.events << " actions: delta " << total.deltaBytes / messages
+              << " bytes/update, event " << total.eventBytes / messages << " bytes/action" << std::endl;
+}
@@ -0,0 +1,271 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GameStateDelta.h"
+#include "GameTestSupport.h"
+
+#include <cstring>
+#include <iostream>
+#include <random>
+
+using namespace BayouBonanza;
+
+namespace {
+
+bool sameBytes(const WireWriter& a, const WireWriter& b) {
+    return a.getDataSize() == b.getDataSize() &&
+           std::memcmp(a.getData(), b.getData(), a.getDataSize()) == 0;
+}
+
+// Whether two snapshots project the same bytes for a viewer
+bool sameProjection(const GameStateSnapshot& a, const GameStateSnapshot& b, PlayerSide viewer) {
+    WireBuffer first;
+    WireBuffer second;
+    a.writeFull(first.writer, viewer);
+    b.writeFull(second.writer, viewer);
+    return sameBytes(first.writer, second.writer);
+}
+
+struct PlayedGame {
+    int updates = 0;             // Server-side updates; each is sent to both players
+    std::size_t fullBytes = 0;   // Both hands in full for both players, as before projections
+    std::size_t projectedBytes = 0;
+    std::size_t deltaBytes = 0;
+    bool clientsMatched = true;
+    bool opponentHandsHidden = true;
+};
+
+// Self-play one game, sending every update as a delta to each player's copy of the state
+PlayedGame playGame(GameInitializer& initializer, unsigned seed, int maxActions) {
+    GameState serverState;
+    initializer.initializeNewGame(serverState);
+    GameRules rules;
+    TurnManager turns(serverState, rules);
+    std::mt19937 random(seed);
+
+    const PlayerSide sides[] = {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO};
+    GameStateSnapshot sent(serverState, 1);
+    GameState clientStates[2];
+    sf::Uint32 clientSequences[2] = {0, 0};
+    for (int seat = 0; seat < 2; ++seat) {
+        WireBuffer start;
+        sent.writeFull(start.writer, sides[seat]);
+        WireReader reader = start.reader();
+        readFullGameState(reader, clientStates[seat], clientSequences[seat], sides[seat]);
+    }
+
+    PlayedGame game;
+    for (int action = 0; action < maxActions && !rules.isGameOver(serverState); ++action) {
+        playRandomAction(serverState, rules, turns, random);
+
+        GameStateSnapshot snapshot(serverState, sent.sequence() + 1);
+        game.updates++;
+        for (int seat = 0; seat < 2; ++seat) {
+            WireBuffer delta;
+            snapshot.writeDelta(delta.writer, sent, sides[seat]);
+            game.deltaBytes += delta.writer.getDataSize();
+            game.projectedBytes += snapshot.fullSize(sides[seat]);
+            game.fullBytes += snapshot.fullSize();
+
+            GameState& client = clientStates[seat];
+            WireReader deltaReader = delta.reader();
+            if (!applyGameStateDelta(deltaReader, client, clientSequences[seat], sides[seat]) ||
+                !sameProjection(GameStateSnapshot(client, clientSequences[seat]), snapshot, sides[seat])) {
+                game.clientsMatched = false;
+            }
+            const Hand& opponentHand = client.getHand(seat == 0 ? PlayerSide::PLAYER_TWO : PlayerSide::PLAYER_ONE);
+            const Hand& serverHand = serverState.getHand(seat == 0 ? PlayerSide::PLAYER_TWO : PlayerSide::PLAYER_ONE);
+            if (opponentHand.size() != 0 || opponentHand.getHiddenCount() != serverHand.size()) {
+                game.opponentHandsHidden = false;
+            }
+        }
+        sent = std::move(snapshot);
+        if (!game.clientsMatched) {
+            break;
+        }
+    }
+    return game;
+}
+
+} // namespace
+
+TEST_CASE_METHOD(GameTestFixture, "GameStateSnapshot encodes what the GameState operator writes", "[delta]") {
+    GameState state;
+    initializer.initializeNewGame(state);
+
+    WireBuffer plain;
+    plain.writer << state << sf::Uint32(7);
+    plain.writer.writeFixed64(state.hash());
+    GameStateSnapshot snapshot(state, 7);
+    WireBuffer full;
+    snapshot.writeFull(full.writer);
+    REQUIRE(snapshot.fullSize() == full.writer.getDataSize());
+    REQUIRE(sameBytes(full.writer, plain.writer));
+
+    // A full snapshot reads back with the plain operator plus its sequence, and matches its hash
+    GameState received;
+    sf::Uint32 sequence = 0;
+    WireReader fullReader = full.reader();
+    REQUIRE(readFullGameState(fullReader, received, sequence));
+    REQUIRE(fullReader.endOfData());
+    REQUIRE(sequence == 7);
+    REQUIRE(sameProjection(GameStateSnapshot(received, 7), snapshot, PlayerSide::NEUTRAL));
+
+    // A player's projection carries only the count of the opponent's hand
+    WireBuffer projected;
+    snapshot.writeFull(projected.writer, PlayerSide::PLAYER_TWO);
+    REQUIRE(snapshot.fullSize(PlayerSide::PLAYER_TWO) == projected.writer.getDataSize());
+    REQUIRE(projected.writer.getDataSize() < full.writer.getDataSize());
+    GameState playerTwoView;
+    WireReader projectedReader = projected.reader();
+    REQUIRE(readFullGameState(projectedReader, playerTwoView, sequence, PlayerSide::PLAYER_TWO));
+    const Hand& hidden = playerTwoView.getHand(PlayerSide::PLAYER_ONE);
+    REQUIRE(hidden.size() == 0);
+    REQUIRE(hidden.getHiddenCount() == state.getHand(PlayerSide::PLAYER_ONE).size());
+    REQUIRE(playerTwoView.getHand(PlayerSide::PLAYER_TWO).getCardIds() ==
+            state.getHand(PlayerSide::PLAYER_TWO).getCardIds());
+
+    // Nothing changed: no squares, no scalars, no hands
+    WireBuffer delta;
+    REQUIRE(GameStateSnapshot(state, 8).writeDelta(delta.writer, snapshot) == 0);
+    REQUIRE(delta.writer.getDataSize() ==
+            WireWriter::varUintSize(7) + WireWriter::varUintSize(8) + 2 * sizeof(sf::Uint8) + sizeof(sf::Uint64));
+}
+
+TEST_CASE_METHOD(GameTestFixture, "GameStateDelta keeps a client in step with the server", "[delta]") {
+    SECTION("Deltas over self-played games reproduce each player's view byte for byte") {
+        for (unsigned seed : {1u, 2u, 3u}) {
+            PlayedGame game = playGame(initializer, seed, 300);
+            REQUIRE(game.updates > 0);
+            REQUIRE(game.clientsMatched);
+            REQUIRE(game.opponentHandsHidden);
+            REQUIRE(game.deltaBytes < game.projectedBytes);
+        }
+    }
+
+    SECTION("A delta against another base is refused and leaves the state alone") {
+        GameState state;
+        initializer.initializeNewGame(state);
+        GameStateSnapshot base(state, 1);
+        state.setSteam(PlayerSide::PLAYER_ONE, state.getSteam(PlayerSide::PLAYER_ONE) + 5);
+        WireBuffer delta;
+        REQUIRE(GameStateSnapshot(state, 2).writeDelta(delta.writer, base) == 1);
+
+        GameState client;
+        initializer.initializeNewGame(client);
+        sf::Uint32 clientSequence = 4;
+        int steamBefore = client.getSteam(PlayerSide::PLAYER_ONE);
+        WireReader reader = delta.reader();
+        REQUIRE_FALSE(applyGameStateDelta(reader, client, clientSequence));
+        REQUIRE(clientSequence == 4);
+        REQUIRE(client.getSteam(PlayerSide::PLAYER_ONE) == steamBefore);
+    }
+}
+
+TEST_CASE_METHOD(GameTestFixture, "The state hash catches a client that drifted from the server", "[delta]") {
+    GameState serverState;
+    initializer.initializeNewGame(serverState);
+    GameStateSnapshot sent(serverState, 1);
+    WireBuffer start;
+    sent.writeFull(start.writer, PlayerSide::PLAYER_ONE);
+    GameState client;
+    sf::Uint32 sequence = 0;
+    WireReader startReader = start.reader();
+    REQUIRE(readFullGameState(startReader, client, sequence, PlayerSide::PLAYER_ONE));
+    REQUIRE(sequence == 1);
+
+    SECTION("A corrupted square the next delta leaves alone") {
+        Piece* piece = nullptr;
+        for (int i = 0; i < GameStateSnapshot::SQUARE_COUNT && !piece; ++i) {
+            piece = client.getBoard().getSquare(i % GameBoard::BOARD_SIZE, i / GameBoard::BOARD_SIZE).getPiece();
+        }
+        REQUIRE(piece);
+        piece->takeDamage(1);
+
+        // Only the steam changes, so the delta carries the scalars and no squares
+        serverState.setSteam(PlayerSide::PLAYER_ONE, serverState.getSteam(PlayerSide::PLAYER_ONE) + 3);
+        GameStateSnapshot next(serverState, 2);
+        WireBuffer delta;
+        REQUIRE(next.writeDelta(delta.writer, sent, PlayerSide::PLAYER_ONE) == 1);
+        WireReader reader = delta.reader();
+        REQUIRE_FALSE(applyGameStateDelta(reader, client, sequence, PlayerSide::PLAYER_ONE));
+        REQUIRE(sequence == 1); // Not advanced, so the caller asks for a resync
+
+        // The full state the resync brings puts the client back in step
+        WireBuffer resync;
+        next.writeFull(resync.writer, PlayerSide::PLAYER_ONE);
+        WireReader resyncReader = resync.reader();
+        REQUIRE(readFullGameState(resyncReader, client, sequence, PlayerSide::PLAYER_ONE));
+        REQUIRE(sequence == 2);
+        REQUIRE(client.hash(PlayerSide::PLAYER_ONE) == serverState.hash(PlayerSide::PLAYER_ONE));
+    }
+
+    SECTION("A full state that reads but does not match its hash") {
+        WireBuffer mangled;
+        sent.writeFull(mangled.writer, PlayerSide::PLAYER_ONE);
+        mangled.bytes[mangled.writer.getDataSize() - 1] ^= 0x01;
+        WireReader reader = mangled.reader();
+        GameState received;
+        sf::Uint32 receivedSequence = 0;
+        REQUIRE_FALSE(readFullGameState(reader, received, receivedSequence, PlayerSide::PLAYER_ONE));
+        REQUIRE(receivedSequence == 0);
+    }
+}
+
+TEST_CASE_METHOD(GameTestFixture, "A spectator sees both hands as counts and follows by deltas", "[delta]") {
+    GameState serverState;
+    initializer.initializeNewGame(serverState);
+    GameRules rules;
+    TurnManager turns(serverState, rules);
+    std::mt19937 random(11);
+
+    GameStateSnapshot sent(serverState, 1);
+    WireBuffer start;
+    sent.writeFull(start.writer, SPECTATOR_VIEWER);
+    REQUIRE(start.writer.getDataSize() == sent.fullSize(SPECTATOR_VIEWER));
+    REQUIRE(start.writer.getDataSize() < sent.fullSize(PlayerSide::PLAYER_ONE));
+    GameState spectator;
+    sf::Uint32 sequence = 0;
+    WireReader startReader = start.reader();
+    REQUIRE(readFullGameState(startReader, spectator, sequence, SPECTATOR_VIEWER));
+
+    for (int action = 0; action < 200 && !rules.isGameOver(serverState); ++action) {
+        playRandomAction(serverState, rules, turns, random);
+        GameStateSnapshot snapshot(serverState, sent.sequence() + 1);
+        WireBuffer delta;
+        snapshot.writeDelta(delta.writer, sent, SPECTATOR_VIEWER);
+        WireReader reader = delta.reader();
+        REQUIRE(applyGameStateDelta(reader, spectator, sequence, SPECTATOR_VIEWER));
+        REQUIRE(sameProjection(GameStateSnapshot(spectator, sequence), snapshot, SPECTATOR_VIEWER));
+        for (PlayerSide side : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+            REQUIRE(spectator.getHand(side).size() == 0);
+            REQUIRE(spectator.getHand(side).getHiddenCount() == serverState.getHand(side).size());
+        }
+        REQUIRE(spectator.hash(SPECTATOR_VIEWER) == serverState.hash(SPECTATOR_VIEWER));
+        sent = std::move(snapshot);
+    }
+}
+
+// Bytes per update and player on seeded self-played games: full state with both hands,
+// each player's projection, and the GameStateDelta actually sent.
+// Run with: BayouBonanzaTests "[performance]"
+TEST_CASE_METHOD(GameTestFixture, "GameStateDelta bytes per turn", "[.][delta][performance]") {
+    constexpr int GAMES = 50;
+    PlayedGame total;
+    for (unsigned seed = 1; seed <= GAMES; ++seed) {
+        PlayedGame game = playGame(initializer, seed, 1000);
+        REQUIRE(game.clientsMatched);
+        total.updates += game.updates;
+        total.fullBytes += game.fullBytes;
+        total.projectedBytes += game.projectedBytes;
+        total.deltaBytes += game.deltaBytes;
+    }
+
+    REQUIRE(total.updates > 0);
+    double messages = 2.0 * total.updates;
+    double fullPerUpdate = total.fullBytes / messages;
+    double projectedPerUpdate = total.projectedBytes / messages;
+    double deltaPerUpdate = total.deltaBytes / messages;
+    std::cout << GAMES << " games, " << total.updates << " updates: full snapshot "
+              << fullPerUpdate << " bytes/update, projected " << projectedPerUpdate
+              << " bytes/update, delta " << deltaPerUpdate << " bytes/update ("
+              << fullPerUpdate / deltaPerUpdate << "x smaller than full)" << std::endl;
+}
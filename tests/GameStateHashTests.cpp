@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GameState.h"
+#include "GameStateDelta.h"
+#include "GameTestSupport.h"
+
+#include <random>
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+
+// Rebuilt from its bytes, so the board hash is accumulated from scratch
+GameState copyOf(const GameState& state) {
+    sf::Packet packet;
+    packet << state;
+    GameState copy;
+    packet >> copy;
+    return copy;
+}
+
+GameState projectionFor(const GameState& state, PlayerSide viewer) {
+    std::vector<char> bytes(16384);
+    WireWriter writer(bytes.data(), bytes.size());
+    GameStateSnapshot(state, 1).writeFull(writer, viewer);
+    WireReader reader(bytes.data(), writer.getDataSize());
+    GameState projection;
+    sf::Uint32 sequence;
+    reader >> projection >> sequence;
+    return projection;
+}
+
+Position firstPiece(GameState& state) {
+    for (int y = 0; y < GameBoard::BOARD_SIZE; ++y) {
+        for (int x = 0; x < GameBoard::BOARD_SIZE; ++x) {
+            if (!state.getBoard().getSquare(x, y).isEmpty()) {
+                return Position(x, y);
+            }
+        }
+    }
+    return Position(-1, -1);
+}
+
+} // namespace
+
+TEST_CASE_METHOD(GameTestFixture, "GameState hash kept up to date matches one computed from scratch", "[hash]") {
+    for (unsigned seed : {1u, 2u, 3u}) {
+        GameState state;
+        initializer.initializeNewGame(state);
+        GameRules rules;
+        TurnManager turns(state, rules);
+        std::mt19937 random(seed);
+
+        for (int action = 0; action < 300 && !rules.isGameOver(state); ++action) {
+            playRandomAction(state, rules, turns, random);
+            REQUIRE(state.hash() == copyOf(state).hash());
+            for (PlayerSide viewer : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+                REQUIRE(state.hash(viewer) == projectionFor(state, viewer).hash(viewer));
+            }
+        }
+    }
+}
+
+TEST_CASE_METHOD(GameTestFixture, "GameState hash follows every part of the state", "[hash]") {
+    GameState state;
+    initializer.initializeNewGame(state);
+    const std::uint64_t start = state.hash();
+
+    SECTION("Steam") {
+        int steam = state.getSteam(PlayerSide::PLAYER_ONE);
+        state.setSteam(PlayerSide::PLAYER_ONE, steam + 1);
+        REQUIRE(state.hash() != start);
+        state.setSteam(PlayerSide::PLAYER_ONE, steam);
+        REQUIRE(state.hash() == start);
+    }
+
+    SECTION("A piece moving and coming back") {
+        Position at = firstPiece(state);
+        REQUIRE(at.x >= 0);
+        Position next(at.x + 1, at.y);
+        Square& from = state.getBoard().getSquare(at.x, at.y);
+        Square& to = state.getBoard().getSquare(next.x, next.y);
+        REQUIRE(to.isEmpty());
+        to.setPiece(from.extractPiece());
+        to.getPiece()->setPosition(next);
+        REQUIRE(state.hash() != start);
+        from.setPiece(to.extractPiece());
+        from.getPiece()->setPosition(at);
+        REQUIRE(state.hash() == start);
+    }
+
+    SECTION("A piece's health") {
+        Position at = firstPiece(state);
+        REQUIRE(at.x >= 0);
+        Piece* piece = state.getBoard().getSquare(at.x, at.y).getPiece();
+        int health = piece->getHealth();
+        piece->takeDamage(1);
+        REQUIRE(state.hash() != start);
+        piece->setHealth(health);
+        REQUIRE(state.hash() == start);
+    }
+
+    SECTION("Square control") {
+        Square& square = state.getBoard().getSquare(3, 3);
+        PlayerSide controller = square.getControlledBy();
+        square.setControlledBy(controller == PlayerSide::PLAYER_ONE ? PlayerSide::PLAYER_TWO : PlayerSide::PLAYER_ONE);
+        REQUIRE(state.hash() != start);
+        square.setControlledBy(controller);
+        REQUIRE(state.hash() == start);
+    }
+
+    SECTION("The opponent's hand counts only by its size") {
+        Hand& hand = state.getHand(PlayerSide::PLAYER_TWO);
+        REQUIRE(hand.size() >= 2);
+        const std::uint64_t seenByOne = state.hash(PlayerSide::PLAYER_ONE);
+        const std::uint64_t seenByTwo = state.hash(PlayerSide::PLAYER_TWO);
+        std::vector<int> ids = hand.getCardIds();
+        hand.addCard(hand.removeCardAt(0));
+        bool orderChanges = hand.getCardIds() != ids;
+        REQUIRE(state.hash(PlayerSide::PLAYER_ONE) == seenByOne);
+        REQUIRE((state.hash(PlayerSide::PLAYER_TWO) != seenByTwo) == orderChanges);
+
+        hand.removeCardAt(0);
+        REQUIRE(state.hash(PlayerSide::PLAYER_ONE) != seenByOne);
+    }
+}
+
+TEST_CASE_METHOD(GameTestFixture, "GameState hash survives moving the state", "[hash]") {
+    GameState state;
+    initializer.initializeNewGame(state);
+    const std::uint64_t before = state.hash();
+
+    GameState moved(std::move(state));
+    REQUIRE(moved.hash() == before);
+    REQUIRE(moved.hash() == copyOf(moved).hash());
+
+    state = GameState();
+    REQUIRE(state.hash() == GameState().hash());
+    state = std::move(moved);
+    REQUIRE(state.hash() == before);
+}
+
+TEST_CASE_METHOD(GameTestFixture, "An opponent's hidden hand survives copying and moving", "[hash]") {
+    GameState state;
+    initializer.initializeNewGame(state);
+    GameState view = projectionFor(state, PlayerSide::PLAYER_TWO);
+    const Hand& hidden = view.getHand(PlayerSide::PLAYER_ONE);
+    const std::size_t count = hidden.getHiddenCount();
+    REQUIRE(count == state.getHand(PlayerSide::PLAYER_ONE).size());
+    REQUIRE(count > 0);
+    const std::uint64_t before = view.hash(PlayerSide::PLAYER_TWO);
+
+    // Through the CardCollection operations too, as the hand is a CardCollection underneath
+    Hand copied(hidden);
+    REQUIRE(copied.getHiddenCount() == count);
+    Hand assigned;
+    static_cast<CardCollection&>(assigned) = hidden;
+    REQUIRE(assigned.getHiddenCount() == count);
+    Hand moved;
+    static_cast<CardCollection&>(moved) = std::move(assigned);
+    REQUIRE(moved.getHiddenCount() == count);
+    REQUIRE(assigned.getHiddenCount() == 0);
+
+    GameState movedView(std::move(view));
+    REQUIRE(movedView.getHand(PlayerSide::PLAYER_ONE).getHiddenCount() == count);
+    REQUIRE(movedView.hash(PlayerSide::PLAYER_TWO) == before);
+
+    // Assigning a fresh state leaves no stale count behind
+    view = std::move(movedView);
+    REQUIRE(view.hash(PlayerSide::PLAYER_TWO) == before);
+    view = GameState();
+    REQUIRE(view.getHand(PlayerSide::PLAYER_ONE).getHiddenCount() == 0);
+    REQUIRE(view.hash(PlayerSide::PLAYER_TWO) == GameState().hash(PlayerSide::PLAYER_TWO));
+}
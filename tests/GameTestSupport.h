@@ -0,0 +1,152 @@
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+#include "GameState.h"
+#include "GameRules.h"
+#include "GameInitializer.h"
+#include "TurnManager.h"
+#include "CardPlayValidator.h"
+#include "PieceCard.h"
+#include "EffectCard.h"
+#include "PieceDefinitionManager.h"
+#include "PieceFactory.h"
+#include "Square.h"
+#include "Move.h"
+#include "WireFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Shared by the tests that play whole games and send them over the wire
+
+// Loads the piece definitions and installs a global factory, since reading a GameState or
+// replaying a card play creates pieces through Square's factory
+struct GameTestFixture {
+    BayouBonanza::PieceDefinitionManager pieceDefManager;
+    std::unique_ptr<BayouBonanza::PieceFactory> factory;
+    BayouBonanza::GameInitializer initializer;
+
+    GameTestFixture() {
+        bool loaded = pieceDefManager.loadDefinitions("assets/data/cards.json");
+        if (!loaded) {
+            loaded = pieceDefManager.loadDefinitions("../../assets/data/cards.json");
+        }
+        REQUIRE(loaded);
+        factory = std::make_unique<BayouBonanza::PieceFactory>(pieceDefManager);
+        BayouBonanza::Square::setGlobalPieceFactory(factory.get());
+    }
+};
+
+// Room for any one message in these tests; used in place, never copied
+struct WireBuffer {
+    std::array<char, 16384> bytes;
+    BayouBonanza::WireWriter writer{bytes.data(), bytes.size()};
+
+    BayouBonanza::WireReader reader() const { return BayouBonanza::WireReader(bytes.data(), writer.getDataSize()); }
+};
+
+// Deal both opening hands again from decks shuffled by @p random. initializeNewGame() shuffles
+// from std::random_device, so only tests that redeal this way play the same games for a seed.
+inline void redealOpeningHands(BayouBonanza::GameState& state, std::mt19937& random) {
+    using namespace BayouBonanza;
+    for (PlayerSide side : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+        std::vector<std::unique_ptr<Card>> cards;
+        for (CardCollection* from : {static_cast<CardCollection*>(&state.getHand(side)),
+                                     static_cast<CardCollection*>(&state.getDeck(side))}) {
+            while (!from->empty()) {
+                cards.push_back(from->removeCardAt(from->size() - 1));
+            }
+        }
+        // Put them in ID order first, so the shuffle starts from the same deck every time
+        std::stable_sort(cards.begin(), cards.end(),
+                         [](const auto& a, const auto& b) { return a->getId() < b->getId(); });
+        std::shuffle(cards.begin(), cards.end(), random);
+        Deck& deck = state.getDeck(side);
+        for (auto& card : cards) {
+            deck.addCard(std::move(card));
+        }
+        for (std::size_t i = 0; i < Hand::MAX_HAND_SIZE; ++i) {
+            state.drawCard(side);
+        }
+    }
+}
+
+// The action playRandomAction chose; only the fields for its kind are set
+struct RandomAction {
+    enum class Kind { PlayCard, Move, NextPhase };
+
+    Kind kind = Kind::NextPhase;
+    int cardIndex = -1;
+    Position target;
+    BayouBonanza::Move move;
+};
+
+using RandomActionHook = std::function<void(const RandomAction&)>;
+
+// Take one random legal action for the active player: a card some of the time, else a move, else next phase.
+// beforeAction sees each action just before it is applied. A card play the validator allows can still fail
+// (e.g. healing an unhurt piece); a move or phase change is taken instead, and beforeAction sees that too.
+inline RandomAction playRandomAction(BayouBonanza::GameState& state, BayouBonanza::GameRules& rules,
+                                     BayouBonanza::TurnManager& turns, std::mt19937& random,
+                                     const RandomActionHook& beforeAction = nullptr) {
+    using namespace BayouBonanza;
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    PlayerSide side = state.getActivePlayer();
+    RandomAction action;
+
+    if (chance(random) < 0.3) {
+        const Hand& hand = state.getHand(side);
+        std::vector<std::pair<int, Position>> plays;
+        for (std::size_t i = 0; i < hand.size(); ++i) {
+            if (!CardPlayValidator::validateCardPlay(state, side, i).isValid) {
+                continue;
+            }
+            std::vector<Position> targets;
+            if (auto pieceCard = dynamic_cast<const PieceCard*>(hand.getCard(i))) {
+                targets = CardPlayValidator::getValidPlacements(state, side, pieceCard);
+            } else if (auto effectCard = dynamic_cast<const EffectCard*>(hand.getCard(i))) {
+                targets = CardPlayValidator::getValidTargets(state, side, effectCard);
+            }
+            for (const Position& target : targets) {
+                plays.emplace_back(static_cast<int>(i), target);
+            }
+        }
+        if (!plays.empty()) {
+            const auto& play = plays[std::uniform_int_distribution<std::size_t>(0, plays.size() - 1)(random)];
+            action.kind = RandomAction::Kind::PlayCard;
+            action.cardIndex = play.first;
+            action.target = play.second;
+            if (beforeAction) {
+                beforeAction(action);
+            }
+            bool played = false;
+            turns.processPlayCardAction(action.cardIndex, action.target,
+                                        [&played](const ActionResult& result) { played = result.success; });
+            if (played) {
+                return action;
+            }
+            action = RandomAction();
+        }
+    }
+
+    std::vector<Move> moves = rules.getValidMovesForActivePlayer(state);
+    if (!moves.empty() && chance(random) < 0.9) {
+        action.kind = RandomAction::Kind::Move;
+        action.move = moves[std::uniform_int_distribution<std::size_t>(0, moves.size() - 1)(random)];
+        if (beforeAction) {
+            beforeAction(action);
+        }
+        turns.processMoveAction(action.move);
+        return action;
+    }
+    if (beforeAction) {
+        beforeAction(action);
+    }
+    turns.nextPhase();
+    return action;
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Heartbeat.h"
+#include <vector>
+
+using namespace BayouBonanza;
+using namespace std::chrono_literals;
+
+TEST_CASE("Heartbeat measures the round trip of answered pings", "[heartbeat]") {
+    Heartbeat heartbeat;
+    Heartbeat::Clock::time_point start{};
+
+    PingData first = heartbeat.ping(start);
+    REQUIRE(first.sequence == 1);
+    REQUIRE(first.roundTripMicros == 0);
+    REQUIRE(heartbeat.unanswered() == 1);
+
+    REQUIRE(heartbeat.pong(first.sequence, start + 40ms));
+    REQUIRE(heartbeat.unanswered() == 0);
+    REQUIRE(heartbeat.roundTrip() == 40ms);
+
+    // Later samples move the estimate an eighth of the way
+    PingData second = heartbeat.ping(start + 5s);
+    REQUIRE(second.roundTripMicros == 40000);
+    REQUIRE(heartbeat.pong(second.sequence, start + 5s + 120ms));
+    REQUIRE(heartbeat.lastRoundTrip() == 120ms);
+    REQUIRE(heartbeat.roundTrip() == 50ms);
+
+    SECTION("Repeated and unknown pongs are ignored") {
+        REQUIRE_FALSE(heartbeat.pong(second.sequence, start + 6s));
+        REQUIRE_FALSE(heartbeat.pong(second.sequence + 1, start + 6s));
+        REQUIRE(heartbeat.roundTrip() == 50ms);
+    }
+}
+
+TEST_CASE("Heartbeat counts pings since the newest one answered", "[heartbeat]") {
+    Heartbeat heartbeat;
+    Heartbeat::Clock::time_point start{};
+
+    std::vector<PingData> pings;
+    for (int i = 0; i < 3; ++i) {
+        pings.push_back(heartbeat.ping(start + i * 5s));
+    }
+    REQUIRE(heartbeat.unanswered() == 3);
+
+    SECTION("A late answer still proves the peer is there") {
+        REQUIRE(heartbeat.pong(pings[1].sequence, start + 11s));
+        REQUIRE(heartbeat.unanswered() == 1);
+        REQUIRE(heartbeat.lastRoundTrip() == 6s);
+        REQUIRE_FALSE(heartbeat.pong(pings[0].sequence, start + 11s)); // Older than one already answered
+    }
+
+    SECTION("Pings too old to be tracked are not matched") {
+        for (std::size_t i = 0; i < Heartbeat::TRACKED_PINGS; ++i) {
+            heartbeat.ping(start + 20s);
+        }
+        REQUIRE_FALSE(heartbeat.pong(pings[0].sequence, start + 21s));
+        REQUIRE(heartbeat.unanswered() == 3 + Heartbeat::TRACKED_PINGS);
+    }
+}
+
+TEST_CASE("A ping is answered with a pong of the same sequence", "[heartbeat]") {
+    std::array<char, 32> buffer;
+    WireWriter writer(buffer.data(), buffer.size());
+    writer << MessageType::Ping << PingData{7, 2500};
+    REQUIRE(writer);
+
+    PingData received;
+    sf::Packet pong = answerPing(wirePacket(writer), received);
+    REQUIRE(received.sequence == 7);
+    REQUIRE(received.roundTripMicros == 2500);
+
+    MessageType type;
+    REQUIRE((pong >> type));
+    REQUIRE(type == MessageType::Pong);
+    PongData answer;
+    WireReader body = messageBody(pong);
+    REQUIRE((body >> answer));
+    REQUIRE(answer.sequence == 7);
+
+    sf::Packet truncated;
+    truncated << MessageType::Ping;
+    REQUIRE(answerPing(truncated, received).getDataSize() == 0);
+}
+
+TEST_CASE("Heartbeat stats report round trip percentiles", "[heartbeat]") {
+    HeartbeatStats stats;
+    REQUIRE(stats.percentile(0.5) == 0us);
+
+    for (int i = 1; i <= 100; ++i) {
+        stats.pingSent();
+        stats.recordRoundTrip(std::chrono::milliseconds(i));
+    }
+    stats.connectionReaped();
+    REQUIRE(stats.pingsSent() == 100);
+    REQUIRE(stats.pongsReceived() == 100);
+    REQUIRE(stats.connectionsReaped() == 1);
+
+    // Buckets are an eighth of a power of two wide
+    auto p50 = stats.percentile(0.50);
+    REQUIRE(p50 >= 50ms);
+    REQUIRE(p50 <= 57ms);
+    auto p99 = stats.percentile(0.99);
+    REQUIRE(p99 >= 99ms);
+    REQUIRE(p99 <= 100ms); // Never past the largest recorded
+    REQUIRE(stats.percentile(0.0) < 2ms);
+}
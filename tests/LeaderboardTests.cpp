@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Leaderboard.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+
+std::vector<std::string> usernames(const std::vector<LeaderboardEntry>& entries) {
+    std::vector<std::string> names;
+    for (const LeaderboardEntry& entry : entries) {
+        names.push_back(entry.username);
+    }
+    return names;
+}
+
+} // namespace
+
+TEST_CASE("Leaderboard ranks by rating, ties by username", "[leaderboard]") {
+    Leaderboard board;
+    board.set({{"erin", 1100}, {"bob", 1200}, {"dave", 1100}, {"carol", 900}});
+
+    REQUIRE(board.size() == 4);
+    REQUIRE(board.rank("bob") == 1);
+    REQUIRE(board.rank("dave") == 2);
+    REQUIRE(board.rank("erin") == 3);
+    REQUIRE(board.rank("carol") == 4);
+    REQUIRE(board.rank("nobody") == 0);
+
+    auto top = board.top();
+    REQUIRE(usernames(top->entries) == std::vector<std::string>{"bob", "dave", "erin", "carol"});
+    REQUIRE(top->entries[3].rank == 4);
+    REQUIRE(top->entries[3].rating == 900);
+
+    SECTION("A new rating moves the player") {
+        board.set("carol", 1150);
+        REQUIRE(board.size() == 4);
+        REQUIRE(board.rank("carol") == 2);
+        REQUIRE(board.rank("erin") == 4);
+    }
+
+    SECTION("Neighbours stop at either end of the board") {
+        REQUIRE(usernames(board.around("dave", 1)) == std::vector<std::string>{"bob", "dave", "erin"});
+        REQUIRE(usernames(board.around("bob", 2)) == std::vector<std::string>{"bob", "dave", "erin"});
+        REQUIRE(usernames(board.around("carol", 0)) == std::vector<std::string>{"carol"});
+        REQUIRE(board.around("nobody", 3).empty());
+    }
+}
+
+TEST_CASE("Leaderboard snapshots are shared and never change", "[leaderboard]") {
+    Leaderboard::Options options;
+    options.topSize = 2;
+    Leaderboard board(options);
+    board.set({{"ann", 1300}, {"ben", 1200}, {"cat", 1100}});
+
+    auto first = board.top();
+    REQUIRE(usernames(first->entries) == std::vector<std::string>{"ann", "ben"});
+    REQUIRE(board.top() == first);
+
+    // Below the top: the same snapshot goes on being served
+    board.set("cat", 1000);
+    board.set("dan", 900);
+    REQUIRE(board.top() == first);
+
+    board.set("dan", 1250);
+    auto second = board.top();
+    REQUIRE(second != first);
+    REQUIRE(usernames(second->entries) == std::vector<std::string>{"ann", "dan"});
+    REQUIRE(usernames(first->entries) == std::vector<std::string>{"ann", "ben"});
+    REQUIRE(board.stats().snapshotsBuilt == 2);
+}
+
+TEST_CASE("Leaderboard agrees with sorting after many random changes", "[leaderboard]") {
+    Leaderboard board;
+    std::vector<std::pair<std::string, int>> players;
+    std::mt19937 random(7);
+    for (int i = 0; i < 500; ++i) {
+        players.emplace_back("player" + std::to_string(i), 1000);
+    }
+    for (int change = 0; change < 3000; ++change) {
+        auto& player = players[random() % players.size()];
+        player.second = static_cast<int>(random() % 400) + 800;
+        board.set(player.first, player.second);
+    }
+    board.reset({}, board.version()); // Emptied, then rebuilt from the final ratings
+    REQUIRE(board.size() == 0);
+    std::vector<PlayerDatabase::RatingUpdate> ratings;
+    for (const auto& player : players) {
+        ratings.push_back({player.first, player.second});
+    }
+    board.reset(ratings, board.version());
+
+    std::sort(players.begin(), players.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    REQUIRE(board.size() == players.size());
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        REQUIRE(board.rank(players[i].first) == i + 1);
+    }
+    auto top = board.top();
+    REQUIRE(top->entries.size() == 100);
+    REQUIRE(top->entries[99].username == players[99].first);
+}
+
+TEST_CASE("Leaderboard reset keeps ratings set while the read was in flight", "[leaderboard]") {
+    Leaderboard board;
+    board.set({{"ann", 1000}, {"ben", 1100}, {"cat", 1200}});
+    std::uint64_t since = board.version();
+
+    // The game ends after the read began: the read has ann's old rating and no dan at all
+    board.set("ann", 1300);
+    board.set("dan", 900);
+    board.reset({{"ann", 1000}, {"ben", 1150}, {"cat", 1200}, {"eve", 1250}}, since);
+
+    REQUIRE(board.size() == 5);
+    REQUIRE(usernames(board.top()->entries) == std::vector<std::string>{"ann", "eve", "cat", "ben", "dan"});
+
+    SECTION("A later reset takes the database's ratings again") {
+        board.reset({{"ann", 1000}, {"ben", 1150}}, board.version());
+        REQUIRE(usernames(board.top()->entries) == std::vector<std::string>{"ben", "ann"});
+    }
+}
+
+TEST_CASE("Leaderboard reset takes the database's ratings for players loaded by an earlier reset",
+          "[leaderboard]") {
+    Leaderboard board;
+    board.set("ann", 1000);
+    board.set("ben", 1100);
+    // More rows than version(), as at startup: none of them may count as set after a later read began
+    board.reset({{"ann", 1000}, {"ben", 1100}, {"cat", 1200}, {"dan", 1300}, {"eve", 1400}}, board.version());
+    REQUIRE(board.size() == 5);
+
+    board.reset({{"ann", 1500}, {"ben", 900}, {"cat", 1250}, {"dan", 800}, {"eve", 1000}}, board.version());
+    REQUIRE(usernames(board.top()->entries) == std::vector<std::string>{"ann", "cat", "eve", "ben", "dan"});
+    REQUIRE(board.top()->entries[0].rating == 1500);
+    REQUIRE(board.top()->entries[4].rating == 800);
+}
+
+TEST_CASE("LeaderboardData round-trips through the wire format", "[leaderboard]") {
+    LeaderboardData data;
+    data.totalPlayers = 1234;
+    data.top = {{1, "bob", 1500}, {2, "ann", 1400}};
+    data.rank = 700;
+    data.around = {{699, "cat", 1001}, {700, "dan", 1000}, {701, "eve", 1000}};
+
+    std::array<char, 512> bytes;
+    WireWriter writer(bytes.data(), bytes.size());
+    writer << data;
+    REQUIRE(writer);
+    WireReader reader(writer.getData(), writer.getDataSize());
+    LeaderboardData read;
+    REQUIRE(reader >> read);
+    REQUIRE(reader.endOfData());
+    REQUIRE(read.totalPlayers == 1234);
+    REQUIRE(usernames(read.top) == std::vector<std::string>{"bob", "ann"});
+    REQUIRE(read.rank == 700);
+    REQUIRE(usernames(read.around) == std::vector<std::string>{"cat", "dan", "eve"});
+    REQUIRE(read.around[0].rating == 1001);
+
+    SECTION("A truncated body fails rather than reading past the end") {
+        WireReader truncated(writer.getData(), writer.getDataSize() - 2);
+        REQUIRE_FALSE(truncated >> read);
+    }
+}
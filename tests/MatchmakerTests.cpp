@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Matchmaker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace BayouBonanza;
+using namespace std::chrono_literals;
+
+TEST_CASE("Matchmaker pairs close ratings and leaves distant ones queued") {
+    Matchmaker matchmaker;
+    auto now = Matchmaker::Clock::now();
+
+    REQUIRE(matchmaker.enqueue(1, 1000, now));
+    REQUIRE(matchmaker.enqueue(2, 1600, now));
+    REQUIRE(matchmaker.enqueue(3, 1030, now));
+    REQUIRE_FALSE(matchmaker.enqueue(1, 1000, now)); // Already queued
+    REQUIRE(matchmaker.size() == 3);
+
+    auto pairings = matchmaker.pairBatch(now);
+    REQUIRE(pairings.size() == 1);
+    REQUIRE(pairings[0].first == 1);
+    REQUIRE(pairings[0].second == 3);
+    REQUIRE(matchmaker.size() == 1);
+    REQUIRE(matchmaker.contains(2));
+}
+
+TEST_CASE("Matchmaker widens the rating window the longer a player waits") {
+    Matchmaker::Config config;
+    config.initialWindow = 50;
+    config.windowGrowthPerSecond = 100;
+    config.maxWindow = 300;
+    Matchmaker matchmaker(config);
+    auto start = Matchmaker::Clock::now();
+
+    REQUIRE(matchmaker.windowFor(0s) == 50);
+    REQUIRE(matchmaker.windowFor(2s) == 250);
+    REQUIRE(matchmaker.windowFor(1h) == 300);
+
+    matchmaker.enqueue(1, 1000, start);
+    matchmaker.enqueue(2, 1200, start + 1s);
+    REQUIRE(matchmaker.pairBatch(start + 1s).empty());
+
+    // The first player's window has grown to 250 and now reaches the second
+    auto pairings = matchmaker.pairBatch(start + 2s);
+    REQUIRE(pairings.size() == 1);
+    REQUIRE(pairings[0].first == 1);
+    REQUIRE(pairings[0].firstWait == 2s);
+    REQUIRE(pairings[0].secondWait == 1s);
+}
+
+TEST_CASE("Matchmaker prefers the longest-waiting opponent among equal ratings") {
+    Matchmaker matchmaker;
+    auto now = Matchmaker::Clock::now();
+    for (Matchmaker::TicketId id = 1; id <= 4; ++id) {
+        matchmaker.enqueue(id, 1500, now);
+    }
+    REQUIRE(matchmaker.remove(2));
+    REQUIRE_FALSE(matchmaker.remove(2));
+
+    auto pairings = matchmaker.pairBatch(now);
+    REQUIRE(pairings.size() == 1);
+    REQUIRE(pairings[0].first == 1);
+    REQUIRE(pairings[0].second == 3);
+    REQUIRE(matchmaker.contains(4));
+}
+
+// Synthetic load: keep 50k players queued, pair in batches every 250 ms of
+// simulated time, and report pairing throughput and p99 wait.
+// Run with: BayouBonanzaServerTests "[performance]"
+TEST_CASE("Matchmaker throughput at 50k queued players", "[.][matchmaking][performance]") {
+    constexpr std::size_t QUEUED_PLAYERS = 50000;
+    constexpr int TICKS = 40;
+    const auto tickInterval = 250ms;
+
+    Matchmaker matchmaker;
+    std::mt19937 rng(42);
+    std::normal_distribution<double> ratings(1200.0, 250.0);
+
+    auto simulated = Matchmaker::Clock::time_point{};
+    Matchmaker::TicketId nextId = 1;
+    std::vector<std::chrono::milliseconds> waits;
+    std::chrono::nanoseconds pairingTime{0};
+    std::size_t pairs = 0;
+
+    for (int tick = 0; tick < TICKS; ++tick) {
+        // Top the queue back up, as if new players arrived during the tick
+        while (matchmaker.size() < QUEUED_PLAYERS) {
+            int rating = std::max(0, static_cast<int>(ratings(rng)));
+            matchmaker.enqueue(nextId++, rating, simulated);
+        }
+        simulated += tickInterval;
+
+        auto begin = std::chrono::steady_clock::now();
+        auto batch = matchmaker.pairBatch(simulated);
+        pairingTime += std::chrono::steady_clock::now() - begin;
+
+        pairs += batch.size();
+        for (const auto& pairing : batch) {
+            waits.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(pairing.firstWait));
+            waits.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(pairing.secondWait));
+        }
+    }
+
+    REQUIRE(pairs > 0);
+    std::sort(waits.begin(), waits.end());
+    auto p99 = waits[waits.size() * 99 / 100];
+    double seconds = std::chrono::duration<double>(pairingTime).count();
+
+    std::cout << "Matchmaker: " << pairs << " pairings in " << seconds * 1000.0 << " ms of batch time ("
+              << static_cast<long long>(pairs / std::max(seconds, 1e-9)) << " pairings/s), p99 queue wait "
+              << p99.count() << " ms, " << matchmaker.size() << " still queued" << std::endl;
+}
@@ -0,0 +1,373 @@
+#include <catch2/catch_test_macros.hpp>
+#include "MessageCompression.h"
+#include "NetworkProtocol.h"
+#include "GameStateDelta.h"
+#include "GameTestSupport.h"
+#include "CardCollection.h"
+#include "CardFactory.h"
+#include <lzb/lzb.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+
+// The large messages the server sends, as it encodes them, grouped by type
+struct SampleMessages {
+    std::map<MessageType, std::vector<std::string>> byType;
+
+    void add(MessageType type, std::string message) { byType[type].push_back(std::move(message)); }
+};
+
+template <typename Write>
+std::string wireMessage(Write write) {
+    std::vector<char> buffer(64 * 1024);
+    WireWriter writer(buffer.data(), buffer.size());
+    write(writer);
+    return std::string(writer.getData(), writer.getDataSize());
+}
+
+std::string packetMessage(const sf::Packet& packet) {
+    return std::string(static_cast<const char*>(packet.getData()), packet.getDataSize());
+}
+
+// GameStart and GameStateUpdate from self-played games, CardCollectionData and DeckData for
+// accounts that have collected some cards beyond the starter set
+SampleMessages sampleMessages(GameInitializer& initializer, unsigned firstSeed, int games) {
+    SampleMessages samples;
+    std::vector<int> cardIds;
+    for (const auto& [id, definition] : CardFactory::getCardDefinitions()) {
+        cardIds.push_back(id);
+    }
+
+    for (unsigned seed = firstSeed; seed < firstSeed + games; ++seed) {
+        std::mt19937 random(seed);
+        GameState state;
+        initializer.initializeNewGame(state);
+        redealOpeningHands(state, random); // The trained dictionary must come out the same every run
+        GameRules rules;
+        TurnManager turns(state, rules);
+
+        const std::string names[] = {"player" + std::to_string(seed), "bayou_" + std::to_string(seed * 7919 % 10000)};
+        const int ratings[] = {1000 + static_cast<int>(seed % 400), 1200 - static_cast<int>(seed % 300)};
+        GameStateSnapshot start(state, 1);
+        for (PlayerSide side : {PlayerSide::PLAYER_ONE, PlayerSide::PLAYER_TWO}) {
+            samples.add(MessageType::GameStart, wireMessage([&](WireWriter& writer) {
+                writer << MessageType::GameStart << names[0] << ratings[0] << names[1] << ratings[1];
+                start.writeFull(writer, side);
+            }));
+        }
+
+        for (int action = 1; action <= 200 && !rules.isGameOver(state); ++action) {
+            playRandomAction(state, rules, turns, random);
+            if (action % 25 == 0) {
+                GameStateSnapshot snapshot(state, static_cast<sf::Uint32>(action + 1));
+                samples.add(MessageType::GameStateUpdate, wireMessage([&](WireWriter& writer) {
+                    writer << MessageType::GameStateUpdate;
+                    snapshot.writeFull(writer, state.getActivePlayer());
+                }));
+            }
+        }
+
+        // The starter cards, then whatever the account has collected since
+        std::vector<int> collected;
+        for (const auto& card : CardFactory::createStarterDeck()) {
+            collected.push_back(card->getId());
+        }
+        int extra = std::uniform_int_distribution<int>(0, 80)(random);
+        for (int i = 0; i < extra && !cardIds.empty(); ++i) {
+            collected.push_back(cardIds[std::uniform_int_distribution<std::size_t>(0, cardIds.size() - 1)(random)]);
+        }
+        sf::Packet collectionPacket;
+        collectionPacket << MessageType::CardCollectionData
+                         << CardCollection(CardFactory::createCustomDeck(collected)).serialize();
+        samples.add(MessageType::CardCollectionData, packetMessage(collectionPacket));
+
+        std::vector<int> deckIds(collected.begin(), collected.begin() + std::min<std::size_t>(collected.size(), 20));
+        std::shuffle(deckIds.begin(), deckIds.end(), random);
+        sf::Packet deckPacket;
+        deckPacket << MessageType::DeckData
+                   << Deck(CardFactory::createCustomDeck(deckIds), CardFactory::createStarterVictoryCards()).serialize();
+        samples.add(MessageType::DeckData, packetMessage(deckPacket));
+    }
+    return samples;
+}
+
+// Greedy dictionary training in the style of zstd's COVER: repeatedly take the sample segment whose
+// k-grams occur in the most samples, then stop counting those k-grams. The best segment goes last,
+// where offsets from the message are shortest.
+std::string trainDictionary(const SampleMessages& samples, std::size_t dictionarySize) {
+    constexpr std::size_t K = 6;
+    constexpr std::size_t SEGMENT = 48;
+    std::vector<const std::string*> all;
+    for (const auto& [type, messages] : samples.byType) {
+        for (const std::string& message : messages) {
+            all.push_back(&message);
+        }
+    }
+
+    // How many samples each k-gram appears in
+    std::unordered_map<std::string, int> frequency;
+    for (const std::string* message : all) {
+        std::unordered_map<std::string, bool> seen;
+        for (std::size_t i = 0; i + K <= message->size(); ++i) {
+            std::string gram = message->substr(i, K);
+            if (!seen[gram]) {
+                seen[gram] = true;
+                frequency[gram]++;
+            }
+        }
+    }
+
+    std::vector<std::string> chosen;
+    std::size_t total = 0;
+    while (total + SEGMENT <= dictionarySize) {
+        long bestScore = 0;
+        const std::string* bestMessage = nullptr;
+        std::size_t bestStart = 0;
+        for (const std::string* message : all) {
+            for (std::size_t start = 0; start + SEGMENT <= message->size(); start += 2) {
+                long score = 0;
+                std::unordered_map<std::string, bool> counted;
+                for (std::size_t i = start; i + K <= start + SEGMENT; ++i) {
+                    std::string gram = message->substr(i, K);
+                    if (!counted[gram]) {
+                        counted[gram] = true;
+                        auto it = frequency.find(gram);
+                        score += it == frequency.end() || it->second < 2 ? 0 : it->second;
+                    }
+                }
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestMessage = message;
+                    bestStart = start;
+                }
+            }
+        }
+        if (!bestMessage) {
+            break;
+        }
+        chosen.push_back(bestMessage->substr(bestStart, SEGMENT));
+        for (std::size_t i = bestStart; i + K <= bestStart + SEGMENT; ++i) {
+            frequency[bestMessage->substr(i, K)] = 0;
+        }
+        total += SEGMENT;
+    }
+
+    std::string dictionary;
+    for (auto it = chosen.rbegin(); it != chosen.rend(); ++it) {
+        dictionary += *it;
+    }
+    return dictionary;
+}
+
+// Compress and expand @p message the way the server and client do
+bool roundTrip(const std::string& message, std::size_t& sentBytes) {
+    std::vector<char> buffer(message.size() + 64);
+    WireWriter writer(buffer.data(), buffer.size());
+    writeCompressed(writer, message.data(), message.size());
+    sentBytes = writer.getDataSize();
+    sf::Packet received = wirePacket(writer);
+    return writer && expandCompressed(received) && packetMessage(received) == message;
+}
+
+} // namespace
+
+TEST_CASE("lzb blocks round trip with and without a dictionary", "[compression]") {
+    const std::string dictionary = "the bayou is wide and the gator is hungry";
+    const std::string inputs[] = {
+        "",
+        "abc",
+        std::string(1000, 'a'),                                   // A match that overlaps its own output
+        "the gator is hungry, the gator is hungry, the bayou is wide", // Matches into the dictionary
+        "1,1,2,3,5,8,13,21,34,55,89,144,233,377,610,987,1597,2584,4181,6765"};
+
+    for (bool useDictionary : {false, true}) {
+        std::size_t prefix = useDictionary ? dictionary.size() : 0;
+        for (const std::string& input : inputs) {
+            std::string window = dictionary.substr(0, prefix) + input;
+            std::vector<char> block(lzb::compressBound(input.size()));
+            std::size_t blockSize = lzb::compress(window.data(), prefix, input.size(), block.data(), block.size());
+            REQUIRE(blockSize > 0);
+
+            std::string output = dictionary.substr(0, prefix) + std::string(input.size(), '\0');
+            REQUIRE(lzb::decompress(block.data(), blockSize, output.data(), prefix, input.size()));
+            REQUIRE(output.substr(prefix) == input);
+        }
+    }
+
+    // The dictionary is what lets a short message compress at all
+    std::string message = "the gator is hungry and the bayou is wide";
+    std::string window = dictionary + message;
+    std::vector<char> block(lzb::compressBound(message.size()));
+    std::size_t withDictionary = lzb::compress(window.data(), dictionary.size(), message.size(), block.data(), block.size());
+    std::size_t without = lzb::compress(message.data(), 0, message.size(), block.data(), block.size());
+    REQUIRE(withDictionary < without);
+}
+
+TEST_CASE("lzb rejects blocks that would write outside the output", "[compression]") {
+    std::string input(200, 'x');
+    std::vector<char> block(lzb::compressBound(input.size()));
+    std::size_t blockSize = lzb::compress(input.data(), 0, input.size(), block.data(), block.size());
+    REQUIRE(blockSize > 0);
+    std::string output(input.size() + 16, '\0');
+
+    // Too short an output, a truncated block, and an offset reaching before the window
+    REQUIRE_FALSE(lzb::decompress(block.data(), blockSize, output.data(), 0, input.size() - 1));
+    REQUIRE_FALSE(lzb::decompress(block.data(), blockSize - 1, output.data(), 0, input.size()));
+    const char badOffset[] = {0x10, 'x', 0x20, 0x00};
+    REQUIRE_FALSE(lzb::decompress(badOffset, sizeof(badOffset), output.data(), 0, 10));
+
+    // Too small an output buffer makes compress give up rather than overrun
+    REQUIRE(lzb::compress(input.data(), 0, input.size(), block.data(), 2) == 0);
+}
+
+TEST_CASE_METHOD(GameTestFixture, "Large messages compress and expand back to the same bytes", "[compression]") {
+    SampleMessages samples = sampleMessages(initializer, 500, 4);
+    for (const auto& [type, messages] : samples.byType) {
+        for (const std::string& message : messages) {
+            std::size_t sent = 0;
+            REQUIRE(roundTrip(message, sent));
+            REQUIRE(sent <= message.size());
+            if (type != MessageType::DeckData) {
+                REQUIRE(sent < message.size());
+            }
+        }
+    }
+}
+
+TEST_CASE("Messages that would not shrink are sent as they are", "[compression]") {
+    std::mt19937 random(3);
+    std::string noise(300, '\0');
+    for (char& byte : noise) {
+        byte = static_cast<char>(std::uniform_int_distribution<int>(0, 255)(random));
+    }
+    noise[0] = static_cast<char>(MessageType::CardCollectionData);
+
+    std::vector<char> buffer(512);
+    WireWriter writer(buffer.data(), buffer.size());
+    REQUIRE_FALSE(writeCompressed(writer, noise.data(), noise.size()));
+    REQUIRE(std::string(writer.getData(), writer.getDataSize()) == noise);
+
+    // An uncompressed packet comes out of expandCompressed untouched
+    sf::Packet packet = wirePacket(writer);
+    REQUIRE(expandCompressed(packet));
+    REQUIRE(packetMessage(packet) == noise);
+}
+
+TEST_CASE("Malformed compressed messages are refused", "[compression]") {
+    std::string message(400, 'z');
+    message[0] = static_cast<char>(MessageType::GameStateUpdate);
+    std::vector<char> buffer(512);
+    WireWriter writer(buffer.data(), buffer.size());
+    REQUIRE(writeCompressed(writer, message.data(), message.size()));
+
+    SECTION("Truncated") {
+        sf::Packet packet;
+        packet.append(writer.getData(), writer.getDataSize() - 1);
+        REQUIRE_FALSE(expandCompressed(packet));
+    }
+
+    SECTION("Claiming more than the size limit") {
+        std::vector<char> header(16);
+        WireWriter forged(header.data(), header.size());
+        forged << MessageType::Compressed;
+        forged.writeVarUint(MAX_EXPANDED_BYTES + 1);
+        sf::Packet packet = wirePacket(forged);
+        packet.append(writer.getData() + 3, writer.getDataSize() - 3);
+        REQUIRE_FALSE(expandCompressed(packet));
+    }
+
+    SECTION("Wrapping another compressed message") {
+        std::string wrapped(writer.getData(), writer.getDataSize());
+        wrapped.resize(300, 'q');
+        std::vector<char> outer(512);
+        WireWriter outerWriter(outer.data(), outer.size());
+        std::vector<char> block(lzb::compressBound(wrapped.size()));
+        std::string window = std::string(compressionDictionary()) + wrapped;
+        std::size_t blockSize = lzb::compress(window.data(), compressionDictionary().size(), wrapped.size(),
+                                              block.data(), block.size());
+        outerWriter << MessageType::Compressed;
+        outerWriter.writeVarUint(wrapped.size());
+        outerWriter.append(block.data(), blockSize);
+        sf::Packet packet = wirePacket(outerWriter);
+        REQUIRE_FALSE(expandCompressed(packet));
+    }
+}
+
+TEST_CASE("CompressionStats adds up per message type", "[compression]") {
+    CompressionStats stats;
+    stats.record(MessageType::GameStart, 600, 200, true, 3000);
+    stats.record(MessageType::GameStart, 400, 400, false, 1000);
+    stats.record(MessageType::DeckData, 250, 100, true, 500);
+
+    CompressionStats::Totals start = stats.totals(MessageType::GameStart);
+    REQUIRE(start.messages == 2);
+    REQUIRE(start.compressed == 1);
+    REQUIRE(start.bytesIn == 1000);
+    REQUIRE(start.bytesOut == 600);
+    REQUIRE(start.nanos == 4000);
+    REQUIRE(stats.totals(MessageType::GameEvent).messages == 0);
+}
+
+// Ratio and CPU time per message type on games the dictionary was not trained on.
+// Run with: BayouBonanzaTests "[performance]"
+TEST_CASE_METHOD(GameTestFixture, "Compression ratio and time per message type", "[.][compression][performance]") {
+    using Clock = std::chrono::steady_clock;
+    SampleMessages samples = sampleMessages(initializer, 1001, 50);
+
+    for (const auto& [type, messages] : samples.byType) {
+        std::size_t original = 0;
+        std::size_t sent = 0;
+        std::size_t withoutDictionary = 0;
+        std::uint64_t compressNanos = 0;
+        std::uint64_t expandNanos = 0;
+        for (const std::string& message : messages) {
+            std::vector<char> buffer(message.size() + 64);
+            WireWriter writer(buffer.data(), buffer.size());
+            auto start = Clock::now();
+            writeCompressed(writer, message.data(), message.size());
+            compressNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+            sf::Packet packet = wirePacket(writer);
+            start = Clock::now();
+            REQUIRE(expandCompressed(packet));
+            expandNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            REQUIRE(packetMessage(packet) == message);
+
+            std::vector<char> block(lzb::compressBound(message.size()));
+            withoutDictionary += std::min(message.size(),
+                                          lzb::compress(message.data(), 0, message.size(), block.data(), block.size()));
+            original += message.size();
+            sent += writer.getDataSize();
+        }
+        double count = static_cast<double>(messages.size());
+        std::printf("%-20s %4zu messages, %6.1f bytes avg: ratio %.2f (%.2f without dictionary), "
+                    "compress %.1f us, expand %.1f us\n",
+                    messageTypeName(type), messages.size(),
+                    original / count, static_cast<double>(original) / sent,
+                    static_cast<double>(original) / withoutDictionary, compressNanos / count / 1000.0,
+                    expandNanos / count / 1000.0);
+    }
+}
+
+// Retrains the built-in dictionary and prints it in the layout of src/CompressionDictionary.cpp.
+// Changing the dictionary breaks older clients: give the new one its own Capability bit.
+// Run with: BayouBonanzaTests "[dictionary]"
+TEST_CASE_METHOD(GameTestFixture, "Train the compression dictionary", "[.][compression][dictionary]") {
+    std::string dictionary = trainDictionary(sampleMessages(initializer, 1, 40), 4096);
+    REQUIRE(!dictionary.empty());
+    for (std::size_t i = 0; i < dictionary.size(); ++i) {
+        std::printf("%s0x%02x,%s", i % 16 == 0 ? "    " : "", static_cast<unsigned char>(dictionary[i]),
+                    i % 16 == 15 || i + 1 == dictionary.size() ? "\n" : " ");
+    }
+}
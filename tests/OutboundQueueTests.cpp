@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+#include "OutboundQueue.h"
+
+#include <SFML/Network/Packet.hpp>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace BayouBonanza;
+
+TEST_CASE("OutboundQueue frames match the sf::Packet wire format") {
+    sf::Packet packet;
+    packet << sf::Uint8(7) << std::string("hi");
+    OutboundQueue::Frame frame = OutboundQueue::makeFrame(packet);
+
+    REQUIRE(frame->size() == 4 + packet.getDataSize());
+    REQUIRE((*frame)[0] == 0);
+    REQUIRE((*frame)[1] == 0);
+    REQUIRE((*frame)[2] == 0);
+    REQUIRE(static_cast<unsigned char>((*frame)[3]) == packet.getDataSize());
+    REQUIRE((*frame)[4] == 7);
+}
+
+TEST_CASE("OutboundQueue asks for one flush per batch and enforces the high-water mark") {
+    OutboundQueue queue(100);
+    auto frame = std::make_shared<const OutboundQueue::Bytes>(40, 'x');
+
+    REQUIRE(queue.push(frame) == OutboundQueue::PushResult::ScheduleFlush);
+    REQUIRE(queue.push(frame) == OutboundQueue::PushResult::Queued);
+    REQUIRE(queue.push(frame) == OutboundQueue::PushResult::OverHighWater);
+    REQUIRE(queue.stats().queuedBytes == 80);
+
+    queue.close();
+    REQUIRE(queue.push(frame) == OutboundQueue::PushResult::Closed);
+    REQUIRE(queue.stats().queuedBytes == 0);
+}
+
+TEST_CASE("FramePool frames carry the length prefix and reuse released buffers") {
+    FramePool pool(64);
+    OutboundQueue::Frame first = pool.build([](WireWriter& writer) { writer << sf::Uint8(7) << std::string("hi"); });
+    REQUIRE(first);
+    REQUIRE(first->size() == FramePool::PREFIX_BYTES + 4);
+    REQUIRE(static_cast<unsigned char>((*first)[3]) == 4);
+    REQUIRE((*first)[4] == 7);
+    REQUIRE((*first)[5] == 2);
+
+    // Still queued somewhere: the next frame needs its own buffer
+    OutboundQueue::Frame second = pool.build([](WireWriter& writer) { writer << sf::Uint8(8); });
+    REQUIRE(pool.stats().pooledBuffers == 2);
+    REQUIRE(pool.stats().buffersReused == 0);
+
+    first.reset();
+    OutboundQueue::Frame third = pool.build([](WireWriter& writer) { writer << sf::Uint8(9); });
+    REQUIRE(pool.stats().pooledBuffers == 2);
+    REQUIRE(pool.stats().buffersReused == 1);
+    REQUIRE(third->size() == FramePool::PREFIX_BYTES + 1);
+    REQUIRE((*third)[4] == 9);
+}
+
+TEST_CASE("FramePool grows a buffer for a large message and gives up past the frame limit") {
+    FramePool pool(64);
+    const std::string text(1000, 'z');
+    OutboundQueue::Frame frame = pool.build([&text](WireWriter& writer) { writer << text; });
+    REQUIRE(frame);
+    REQUIRE(frame->size() == FramePool::PREFIX_BYTES + WireWriter::varUintSize(text.size()) + text.size());
+    REQUIRE(std::string(frame->data() + frame->size() - text.size(), text.size()) == text);
+
+    // Released, the grown buffer is reused for a small frame, sized to that frame alone
+    frame.reset();
+    OutboundQueue::Frame small = pool.build([](WireWriter& writer) { writer << sf::Uint8(1); });
+    REQUIRE(small->size() == FramePool::PREFIX_BYTES + 1);
+    REQUIRE(small->capacity() >= text.size());
+
+    const std::string huge(FramePool::MAX_FRAME_BYTES, 'z');
+    REQUIRE_FALSE(pool.build([&huge](WireWriter& writer) { writer << huge; }));
+}
+
+TEST_CASE("FramePool frees a released buffer that grew past its limit") {
+    FramePool pool(64, 4096, 256);
+    const std::string text(1000, 'z');
+    OutboundQueue::Frame large = pool.build([&text](WireWriter& writer) { writer << text; });
+    REQUIRE(large);
+    REQUIRE(pool.stats().pooledBuffers == 1);
+
+    large.reset();
+    REQUIRE(pool.stats().pooledBuffers == 0);
+    const std::uint64_t reused = pool.stats().buffersReused; // Counts the retries while it grew
+    OutboundQueue::Frame small = pool.build([](WireWriter& writer) { writer << sf::Uint8(1); });
+    REQUIRE(pool.stats().buffersReused == reused);
+    REQUIRE(small->capacity() < text.size());
+}
+
+TEST_CASE("FramePool frames may outlive their pool") {
+    OutboundQueue::Frame frame;
+    {
+        FramePool pool(64, 1);
+        frame = pool.build([](WireWriter& writer) { writer << sf::Uint8(5); });
+        // Past maxBuffers a frame is allocated on its own and never returns to the pool
+        OutboundQueue::Frame unpooled = pool.build([](WireWriter& writer) { writer << sf::Uint8(6); });
+        REQUIRE(pool.stats().pooledBuffers == 1);
+    }
+    REQUIRE((*frame)[4] == 5);
+    frame.reset(); // Goes back to a free list nobody else holds any more
+}
+
+#if !defined(_WIN32)
+TEST_CASE("OutboundQueue coalesces queued frames into one write and resumes after a full buffer") {
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    SECTION("Small messages go out together") {
+        OutboundQueue queue(1 << 20);
+        for (int i = 0; i < 5; ++i) {
+            sf::Packet packet;
+            packet << sf::Uint8(i);
+            queue.push(OutboundQueue::makeFrame(packet));
+        }
+        REQUIRE(queue.flush(fds[0]) == OutboundQueue::FlushResult::Drained);
+        REQUIRE(queue.stats().writeCalls == 1);
+        REQUIRE(queue.stats().bytesWritten == 5 * 5);
+
+        char received[25];
+        REQUIRE(::read(fds[1], received, sizeof(received)) == 25);
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(received[i * 5 + 4] == i);
+        }
+    }
+
+    SECTION("A stalled reader leaves the rest queued") {
+        OutboundQueue queue(64 << 20);
+        auto big = std::make_shared<const OutboundQueue::Bytes>(1 << 20, 'y');
+        for (int i = 0; i < 16; ++i) {
+            queue.push(big);
+        }
+        REQUIRE(queue.flush(fds[0]) == OutboundQueue::FlushResult::WouldBlock);
+        std::size_t left = queue.stats().queuedBytes;
+        REQUIRE(left > 0);
+        REQUIRE(left < (16u << 20));
+        // A push while waiting for writability must not request another flush
+        REQUIRE(queue.push(big) == OutboundQueue::PushResult::Queued);
+
+        std::vector<char> sink(1 << 16);
+        std::size_t total = 0;
+        while (queue.stats().queuedBytes > 0) {
+            ssize_t n = ::read(fds[1], sink.data(), sink.size());
+            REQUIRE(n > 0);
+            total += static_cast<std::size_t>(n);
+            queue.flush(fds[0]);
+        }
+        while (total < (17u << 20)) {
+            ssize_t n = ::read(fds[1], sink.data(), sink.size());
+            REQUIRE(n > 0);
+            total += static_cast<std::size_t>(n);
+        }
+        REQUIRE(total == (17u << 20));
+    }
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+#endif
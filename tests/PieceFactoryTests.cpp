@@ -116,3 +116,33 @@ TEST_CASE("PieceFactory functionality", "[piecefactory]") {
         REQUIRE(invalidPiece == nullptr);
     }
 }
+
+TEST_CASE("Piece types get compact IDs that agree across loads", "[piecefactory]") {
+    PieceDefinitionManager first;
+    PieceDefinitionManager second;
+    for (PieceDefinitionManager* pdm : {&first, &second}) {
+        if (!pdm->loadDefinitions("assets/data/cards.json")) {
+            pdm->loadDefinitions("../../assets/data/cards.json");
+        }
+    }
+    REQUIRE(first.getPieceTypeCount() > 0);
+    REQUIRE(first.getDefinitionsHash() != 0);
+    REQUIRE(first.getDefinitionsHash() == second.getDefinitionsHash());
+
+    PieceFactory factory(first);
+    for (const std::string& typeName : first.getAllPieceTypeNames()) {
+        PieceTypeId typeId = first.getPieceTypeId(typeName);
+        REQUIRE(typeId < first.getPieceTypeCount());
+        REQUIRE(second.getPieceTypeId(typeName) == typeId);
+        REQUIRE(first.getPieceStats(typeId) == first.getPieceStats(typeName));
+
+        auto piece = factory.createPiece(typeId, PlayerSide::PLAYER_TWO);
+        REQUIRE(piece != nullptr);
+        REQUIRE(piece->getTypeName() == typeName);
+        REQUIRE(piece->getTypeId() == typeId);
+    }
+
+    REQUIRE(first.getPieceTypeId("InvalidPiece") == INVALID_PIECE_TYPE_ID);
+    REQUIRE(first.getPieceStats(INVALID_PIECE_TYPE_ID) == nullptr);
+    REQUIRE(factory.createPiece(INVALID_PIECE_TYPE_ID, PlayerSide::PLAYER_ONE) == nullptr);
+}
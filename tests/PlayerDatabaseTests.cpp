@@ -0,0 +1,205 @@
+#include <catch2/catch_test_macros.hpp>
+#include "PlayerDatabase.h"
+#include "DatabaseTestSupport.h"
+#include "CardCollection.h"
+#include "CardFactory.h"
+
+#include <sqlite3.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+
+const char* TEST_DB_NAME = "test_player_database.db";
+
+} // namespace
+
+TEST_CASE("PlayerDatabase creates users on first load and reads them back", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME, 1));
+        REQUIRE(database.initializeSchema());
+
+        auto created = database.loadUser("alice", starter());
+        REQUIRE(created);
+        REQUIRE(created->created);
+        REQUIRE(created->rating == 1000);
+        REQUIRE(created->collection == "1:2;2:1");
+        REQUIRE(created->deck == "Starter:1:1;2:1");
+
+        REQUIRE(database.saveDeck("alice", "Aggro:3:1"));
+        REQUIRE(database.loadUser("bob", starter()));
+        REQUIRE(database.updateRatings({{"alice", 1016}, {"bob", 984}}));
+
+        auto alice = database.loadUser("alice", starter());
+        REQUIRE(alice);
+        REQUIRE_FALSE(alice->created);
+        REQUIRE(alice->rating == 1016);
+        REQUIRE(alice->deck == "Aggro:3:1");
+        REQUIRE(database.loadUser("bob", starter())->rating == 984);
+
+        auto ratings = database.readRatings();
+        REQUIRE(ratings);
+        REQUIRE(ratings->size() == 2);
+        REQUIRE((*ratings)[0].username == "alice");
+        REQUIRE((*ratings)[1].rating == 984);
+
+        // One connection, and each statement compiled once on it
+        PlayerDatabase::Stats stats = database.stats();
+        REQUIRE(stats.connectionsOpened == 1);
+        REQUIRE(stats.statementsReused > 0);
+    }
+
+    SECTION("The data survives reopening the database") {
+        PlayerDatabase reopened(testOptions(TEST_DB_NAME, 1));
+        REQUIRE(reopened.initializeSchema());
+        auto alice = reopened.loadUser("alice", starter());
+        REQUIRE(alice);
+        REQUIRE_FALSE(alice->created);
+        REQUIRE(alice->rating == 1016);
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("PlayerDatabase shares a bounded pool between threads", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME, 2));
+        REQUIRE(database.initializeSchema());
+
+        const int THREADS = 6;
+        const int LOADS = 40;
+        std::vector<int> failures(THREADS, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&database, &failures, t] {
+                for (int i = 0; i < LOADS; ++i) {
+                    std::string name = "player" + std::to_string((t * LOADS + i) % 25);
+                    if (!database.loadUser(name, starter()) || !database.saveDeck(name, "Deck:" + std::to_string(i))) {
+                        ++failures[t];
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (int failed : failures) {
+            REQUIRE(failed == 0);
+        }
+        REQUIRE(database.stats().connectionsOpened <= 2);
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("PlayerDatabase stores each group of a batch all or none", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME, 1));
+        REQUIRE(database.initializeSchema());
+
+        std::vector<PlayerDatabase::WriteGroup> batch;
+        batch.push_back({PlayerDatabase::createUser("carol", starter())});
+        // Rating a user who does not exist fails, and takes carol's new rating with it
+        batch.push_back({PlayerDatabase::ratingSet("carol", 1200), PlayerDatabase::ratingSet("nobody", 800)});
+        batch.push_back({PlayerDatabase::deckSave("carol", "Control:4:1")});
+
+        std::vector<bool> stored = database.applyWrites(batch);
+        REQUIRE(stored == std::vector<bool>{true, false, true});
+
+        auto carol = database.readUser("carol", starter());
+        REQUIRE(carol);
+        REQUIRE_FALSE(carol->created);
+        REQUIRE(carol->rating == 1000);
+        REQUIRE(carol->deck == "Control:4:1");
+        REQUIRE(carol->collection == "1:2;2:1");
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("PlayerDatabase packs the card tables of an older database in place", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    CardCollection collection(CardFactory::createStarterDeck());
+    Deck deck(CardFactory::createStarterDeck());
+    {
+        // A database as version 1 left it: collections and decks as comma-separated text
+        sqlite3* db = nullptr;
+        REQUIRE(sqlite3_open(TEST_DB_NAME, &db) == SQLITE_OK);
+        std::string legacy =
+            "CREATE TABLE users (username TEXT PRIMARY KEY NOT NULL, rating INTEGER NOT NULL DEFAULT 0);"
+            "CREATE TABLE collections (username TEXT PRIMARY KEY NOT NULL, cards TEXT);"
+            "CREATE TABLE decks (username TEXT PRIMARY KEY NOT NULL, deck TEXT);"
+            "INSERT INTO users VALUES ('ivan', 1234), ('judy', 900);"
+            "INSERT INTO collections VALUES ('ivan', '" + collection.serialize() + "'), ('judy', 'not,cards');"
+            "INSERT INTO decks VALUES ('ivan', '" + deck.serialize() + "'), ('judy', '" + deck.serialize() + "');";
+        REQUIRE(sqlite3_exec(db, legacy.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+        sqlite3_close(db);
+    }
+    {
+        // Judy's collection does not parse, as with a missing cards.json or a retired card: keep everything as it was
+        PlayerDatabase database(testOptions(TEST_DB_NAME, 1));
+        REQUIRE_FALSE(database.initializeSchema());
+    }
+    {
+        sqlite3* db = nullptr;
+        REQUIRE(sqlite3_open(TEST_DB_NAME, &db) == SQLITE_OK);
+        sqlite3_stmt* version = nullptr;
+        REQUIRE(sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &version, nullptr) == SQLITE_OK);
+        REQUIRE(sqlite3_step(version) == SQLITE_ROW);
+        REQUIRE(sqlite3_column_int(version, 0) == 1);
+        sqlite3_finalize(version);
+        std::string fix = "UPDATE collections SET cards = '" + collection.serialize() + "' WHERE username = 'judy';";
+        REQUIRE(sqlite3_exec(db, fix.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+        sqlite3_close(db);
+    }
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME, 1));
+        REQUIRE(database.initializeSchema());
+        REQUIRE(database.initializeSchema()); // Already current: nothing to do
+
+        auto ivan = database.readUser("ivan", starter());
+        REQUIRE(ivan);
+        REQUIRE_FALSE(ivan->created);
+        REQUIRE(ivan->rating == 1234);
+        CardCollection ivanCollection;
+        REQUIRE(ivanCollection.unpack(ivan->collection));
+        REQUIRE(ivanCollection.getCardCounts() == collection.getCardCounts());
+        Deck ivanDeck;
+        REQUIRE(ivanDeck.unpack(ivan->deck));
+        REQUIRE(ivanDeck.serialize() == deck.serialize());
+
+        auto judy = database.readUser("judy", starter());
+        REQUIRE(judy);
+        REQUIRE_FALSE(judy->created);
+        REQUIRE(judy->rating == 900);
+        CardCollection judyCollection;
+        REQUIRE(judyCollection.unpack(judy->collection));
+        REQUIRE(judyCollection.getCardCounts() == collection.getCardCounts());
+    }
+    {
+        sqlite3* db = nullptr;
+        REQUIRE(sqlite3_open(TEST_DB_NAME, &db) == SQLITE_OK);
+        sqlite3_stmt* version = nullptr;
+        REQUIRE(sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &version, nullptr) == SQLITE_OK);
+        REQUIRE(sqlite3_step(version) == SQLITE_ROW);
+        REQUIRE(sqlite3_column_int(version, 0) == PlayerDatabase::SCHEMA_VERSION);
+        sqlite3_finalize(version);
+        // The text tables are set aside, not dropped
+        REQUIRE(sqlite3_exec(db, "SELECT username, cards FROM collections_v1; SELECT username, deck FROM decks_v1;",
+                             nullptr, nullptr, nullptr) == SQLITE_OK);
+        // Ratings are read in leaderboard order from the index, not sorted
+        sqlite3_stmt* plan = nullptr;
+        REQUIRE(sqlite3_prepare_v2(db, "EXPLAIN QUERY PLAN SELECT username, rating FROM users ORDER BY rating DESC, username;",
+                                   -1, &plan, nullptr) == SQLITE_OK);
+        REQUIRE(sqlite3_step(plan) == SQLITE_ROW);
+        std::string detail = reinterpret_cast<const char*>(sqlite3_column_text(plan, 3));
+        REQUIRE(detail.find("users_by_rating") != std::string::npos);
+        sqlite3_finalize(plan);
+        sqlite3_close(db);
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ProfileCache.h"
+#include "DatabaseTestSupport.h"
+#include "CardFactory.h"
+
+#include <string>
+
+using namespace BayouBonanza;
+
+namespace {
+
+const char* TEST_DB_NAME = "test_profile_cache.db";
+
+// ProfileCache unpacks what it loads, so new users start with packed cards
+PlayerDatabase::NewUser packedStarter() {
+    return starter(CardCollection(CardFactory::createStarterDeck()).pack(),
+                   Deck(CardFactory::createStarterDeck()).pack());
+}
+
+DatabaseWriter::Options quickWrites() {
+    DatabaseWriter::Options options;
+    options.maxDelay = std::chrono::milliseconds(1);
+    return options;
+}
+
+} // namespace
+
+TEST_CASE("ProfileCache serves repeat logins from memory", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+        DatabaseWriter writer(database, quickWrites());
+        ProfileCache cache(database, writer);
+
+        REQUIRE_FALSE(cache.find("erin"));
+        auto first = cache.load("erin", packedStarter());
+        REQUIRE(first);
+        REQUIRE(first->rating == 1000);
+        REQUIRE(first->deck.size() == Deck(CardFactory::createStarterDeck()).size());
+
+        auto again = cache.find("erin");
+        REQUIRE(again);
+        REQUIRE(again->deck.serialize() == first->deck.serialize());
+        REQUIRE(cache.load("erin", packedStarter()));
+
+        ProfileCache::Stats stats = cache.stats();
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.hits == 2);
+        REQUIRE(stats.size == 1);
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("ProfileCache loads the defaults in place of cards that do not unpack", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+        REQUIRE(database.loadUser("ivan", packedStarter()));
+        REQUIRE(database.saveDeck("ivan", "not a packed deck"));
+
+        DatabaseWriter writer(database, quickWrites());
+        ProfileCache cache(database, writer);
+        auto ivan = cache.load("ivan", packedStarter());
+        REQUIRE(ivan);
+        REQUIRE(ivan->deck.size() == Deck(CardFactory::createStarterDeck()).size());
+        REQUIRE(ivan->collection.getCardCounts() == CardCollection(CardFactory::createStarterDeck()).getCardCounts());
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("ProfileCache writes changes back on flush and on eviction", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+        DatabaseWriter writer(database, quickWrites());
+        ProfileCache::Options options;
+        options.capacity = 2;
+        ProfileCache cache(database, writer, options);
+
+        REQUIRE(cache.load("frank", packedStarter()));
+        REQUIRE(cache.load("grace", packedStarter()));
+        cache.setRatings({{"frank", 1030}, {"grace", 970}});
+        REQUIRE(cache.find("frank")->rating == 1030);
+        REQUIRE(cache.stats().dirty == 2);
+
+        SECTION("Flushing stores every dirty profile") {
+            REQUIRE(cache.flush() == 2);
+            REQUIRE(cache.stats().dirty == 0);
+            writer.shutdown();
+            REQUIRE(database.readUser("frank", packedStarter())->rating == 1030);
+            REQUIRE(database.readUser("grace", packedStarter())->rating == 970);
+        }
+
+        SECTION("An evicted change is read back, never the stale row") {
+            // frank was touched last by find(); loading a third user evicts grace, dirty
+            REQUIRE(cache.load("heidi", packedStarter()));
+            REQUIRE(cache.stats().evictions == 1);
+            REQUIRE_FALSE(cache.find("grace"));
+            auto grace = cache.load("grace", packedStarter());
+            REQUIRE(grace);
+            REQUIRE(grace->rating == 970);
+        }
+
+        SECTION("Profiles that are not cached are written through") {
+            Deck deck(CardFactory::createStarterDeck());
+            REQUIRE(cache.load("heidi", packedStarter())); // Evicts grace
+            cache.setDeck("grace", deck);
+            cache.setRatings({{"grace", 999}});
+            writer.shutdown();
+            REQUIRE(database.readUser("grace", packedStarter())->rating == 999);
+            REQUIRE(cache.stats().failedWrites == 0);
+        }
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
+
+TEST_CASE("ProfileCache drops a new profile it could not store", "[database]") {
+    removeTestDatabase(TEST_DB_NAME);
+    {
+        PlayerDatabase database(testOptions(TEST_DB_NAME));
+        REQUIRE(database.initializeSchema());
+        DatabaseWriter writer(database, quickWrites());
+        ProfileCache cache(database, writer);
+        writer.shutdown(); // Refuses the first login's create
+
+        REQUIRE(cache.load("judy", packedStarter()));
+        REQUIRE(cache.stats().failedWrites == 1);
+        REQUIRE_FALSE(cache.find("judy"));
+
+        // Nothing is left to retry against the missing row
+        cache.setDeck("judy", Deck(CardFactory::createStarterDeck()));
+        REQUIRE(cache.flush() == 0);
+        REQUIRE(cache.stats().dirty == 0);
+    }
+    removeTestDatabase(TEST_DB_NAME);
+}
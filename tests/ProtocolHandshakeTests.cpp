@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ProtocolHandshake.h"
+
+using namespace BayouBonanza;
+
+namespace {
+
+const sf::Uint32 SERVER_HASH = 0x1234ABCD;
+
+ConnectionRequestData currentClient(CapabilitySet capabilities = SUPPORTED_CAPABILITIES) {
+    ConnectionRequestData request;
+    request.definitionsHash = SERVER_HASH;
+    request.capabilities = capabilities;
+    return request;
+}
+
+} // namespace
+
+TEST_CASE("Handshake agrees on the capabilities both sides have", "[handshake]") {
+    HandshakeResult result = negotiateConnection(currentClient(), SERVER_HASH);
+    REQUIRE(result.accepted);
+    REQUIRE(result.reply.protocolVersion == PROTOCOL_VERSION);
+    REQUIRE(result.reply.capabilities == SUPPORTED_CAPABILITIES);
+
+    SECTION("The server can hold a capability back") {
+        result = negotiateConnection(currentClient(), SERVER_HASH, capabilityBit(Capability::StateDeltas));
+        REQUIRE(result.reply.capabilities == capabilityBit(Capability::StateDeltas));
+    }
+
+    SECTION("Bits from a newer client are dropped") {
+        result = negotiateConnection(currentClient(SUPPORTED_CAPABILITIES | (1u << 31)), SERVER_HASH);
+        REQUIRE(result.reply.capabilities == SUPPORTED_CAPABILITIES);
+    }
+
+    SECTION("A newer client is answered in the server's version") {
+        ConnectionRequestData request = currentClient();
+        request.protocolVersion = PROTOCOL_VERSION + 1;
+        result = negotiateConnection(request, SERVER_HASH);
+        REQUIRE(result.accepted);
+        REQUIRE(result.reply.protocolVersion == PROTOCOL_VERSION);
+    }
+}
+
+TEST_CASE("Handshake refuses clients the server cannot talk to", "[handshake]") {
+    SECTION("Different piece definitions") {
+        HandshakeResult result = negotiateConnection(currentClient(), SERVER_HASH + 1);
+        REQUIRE_FALSE(result.accepted);
+        REQUIRE_FALSE(result.refusal.empty());
+    }
+
+    SECTION("A protocol older than the server still serves") {
+        ConnectionRequestData request = currentClient();
+        request.protocolVersion = MIN_PROTOCOL_VERSION - 1;
+        HandshakeResult result = negotiateConnection(request, SERVER_HASH);
+        REQUIRE_FALSE(result.accepted);
+        REQUIRE_FALSE(result.refusal.empty());
+    }
+}
+
+TEST_CASE("State updates use the cheapest form the client understands", "[handshake]") {
+    const CapabilitySet deltas = capabilityBit(Capability::StateDeltas);
+    const CapabilitySet events = capabilityBit(Capability::GameEvents);
+
+    REQUIRE(stateUpdateModeFor(deltas | events) == StateUpdateMode::Events);
+    REQUIRE(stateUpdateModeFor(deltas | events, false) == StateUpdateMode::Deltas);
+    REQUIRE(stateUpdateModeFor(deltas) == StateUpdateMode::Deltas);
+    REQUIRE(stateUpdateModeFor(events, false) == StateUpdateMode::FullState);
+    REQUIRE(stateUpdateModeFor(0) == StateUpdateMode::FullState);
+
+    // Logins without a handshake always got deltas, and events when they asked
+    REQUIRE(legacyLoginCapabilities(StateUpdateMode::Deltas) == deltas);
+    REQUIRE(legacyLoginCapabilities(StateUpdateMode::Events) == (deltas | events));
+}
+
+TEST_CASE("Handshake messages round trip and tolerate fields appended later", "[handshake]") {
+    sf::Packet packet;
+    packet << currentClient() << sf::Uint8(42);
+    ConnectionRequestData request;
+    REQUIRE((packet >> request));
+    REQUIRE(request.protocolVersion == PROTOCOL_VERSION);
+    REQUIRE(request.definitionsHash == SERVER_HASH);
+    REQUIRE(request.capabilities == SUPPORTED_CAPABILITIES);
+
+    ConnectionAcceptedData sent;
+    sent.capabilities = capabilityBit(Capability::StateDeltas);
+    sf::Packet reply;
+    reply << sent;
+    ConnectionAcceptedData received;
+    REQUIRE((reply >> received));
+    REQUIRE(received.protocolVersion == sent.protocolVersion);
+    REQUIRE(received.capabilities == sent.capabilities);
+
+    sf::Packet truncated;
+    truncated << PROTOCOL_VERSION;
+    REQUIRE_FALSE((truncated >> request));
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Reactor.h"
+#include "NetSocket.h"
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace BayouBonanza;
+
+TEST_CASE("Reactor wakes from an unbounded wait when work is posted") {
+    Reactor reactor;
+    REQUIRE(reactor.isValid());
+    // Nothing else scheduled, so run() sleeps until woken; this only ends a test that failed to wake it
+    reactor.timers().schedule(std::chrono::seconds(5), [&] { reactor.stop(); });
+
+    std::thread loop([&] { reactor.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Let the loop block
+
+    std::promise<std::chrono::steady_clock::time_point> ran;
+    auto posted = std::chrono::steady_clock::now();
+    reactor.post([&] { ran.set_value(std::chrono::steady_clock::now()); });
+    auto ranAt = ran.get_future();
+    bool woke = ranAt.wait_for(std::chrono::seconds(2)) == std::future_status::ready;
+    reactor.stop();
+    loop.join();
+
+    REQUIRE(woke);
+    // Far below any polling interval a missing wake handle would fall back to
+    REQUIRE(ranAt.get() - posted < std::chrono::milliseconds(5));
+}
+
+TEST_CASE("Reactor dispatches readiness to the handler of a registered socket") {
+    Reactor reactor;
+    REQUIRE(reactor.isValid());
+
+    NetListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+    NetSocket client;
+    REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+    NetSocket server;
+    REQUIRE(listener.accept(server) == sf::Socket::Done);
+    server.setBlocking(false);
+
+    unsigned seen = 0;
+    int calls = 0;
+    REQUIRE(reactor.add(server.nativeHandle(), Reactor::Readable, [&](unsigned events) {
+        seen = events;
+        ++calls;
+    }));
+    REQUIRE(reactor.size() == 1);
+
+    SECTION("Only the events asked for are reported") {
+        REQUIRE(reactor.runOnce(0) == 0); // Nothing to read yet
+
+        char byte = 'x';
+        REQUIRE(client.send(&byte, 1) == sf::Socket::Done);
+        REQUIRE(reactor.runOnce(1000) == 1);
+        REQUIRE((seen & Reactor::Readable) != 0);
+        REQUIRE((seen & Reactor::Writable) == 0);
+
+        char received = 0;
+        std::size_t count = 0;
+        REQUIRE(server.receive(&received, 1, count) == sf::Socket::Done);
+        REQUIRE(received == 'x');
+
+        REQUIRE(reactor.modify(server.nativeHandle(), Reactor::Writable));
+        REQUIRE(reactor.runOnce(1000) == 1);
+        REQUIRE(seen == Reactor::Writable);
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("A removed socket is no longer dispatched") {
+        char byte = 'y';
+        REQUIRE(client.send(&byte, 1) == sf::Socket::Done);
+        reactor.remove(server.nativeHandle());
+        REQUIRE(reactor.size() == 0);
+        REQUIRE(reactor.runOnce(50) == 0);
+        REQUIRE(calls == 0);
+    }
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ServerTask.h"
+#include "Reactor.h"
+#include "WorkerPool.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+using namespace BayouBonanza;
+
+namespace {
+    ServerTask loadThenRecord(WorkerPool& pool, Reactor& reactor,
+                              std::thread::id& resumedOn, std::string& result, bool& finished) {
+        auto work = offload(pool, reactor, []() {
+            return std::string("profile");
+        });
+        result = co_await work;
+        resumedOn = std::this_thread::get_id();
+        finished = true;
+        reactor.stop();
+    }
+}
+
+TEST_CASE("Reactor runs tasks posted from other threads on the loop thread") {
+    Reactor reactor;
+    REQUIRE(reactor.isValid());
+
+    std::thread::id ranOn;
+    std::thread poster([&] {
+        reactor.post([&] {
+            ranOn = std::this_thread::get_id();
+            reactor.stop();
+        });
+    });
+    reactor.run();
+    poster.join();
+
+    REQUIRE(ranOn == std::this_thread::get_id());
+}
+
+TEST_CASE("Offloaded work resumes the coroutine on the reactor thread") {
+    Reactor reactor;
+    WorkerPool pool(2);
+
+    std::thread::id resumedOn;
+    std::string result;
+    bool finished = false;
+
+    loadThenRecord(pool, reactor, resumedOn, result, finished);
+    REQUIRE_FALSE(finished); // Suspended until the reactor delivers the result
+
+    reactor.run();
+
+    REQUIRE(finished);
+    REQUIRE(result == "profile");
+    REQUIRE(resumedOn == std::this_thread::get_id());
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include "SessionDirectory.h"
+#include "Reactor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include "DirectoryService.h"
+#include "UnixChannel.h"
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace BayouBonanza;
+using namespace std::chrono_literals;
+
+TEST_CASE("LocalDirectory pairs queued players on its tick") {
+    Reactor reactor;
+    LocalDirectory directory(reactor, Matchmaker::Config{}, 10ms);
+
+    std::vector<SessionDirectory::TicketId> matched;
+    SessionDirectory::Handlers handlers;
+    handlers.match = [&](SessionDirectory::TicketId first, SessionDirectory::TicketId second) {
+        matched = {first, second};
+        reactor.stop();
+    };
+    directory.setHandlers(handlers);
+
+    int owner = 99;
+    directory.lookupOwner("alice", [&](int result) { owner = result; });
+    REQUIRE(owner == -1); // Answered immediately; nothing lives elsewhere
+
+    directory.enqueue(1, 1000);
+    directory.enqueue(2, 1010);
+    directory.enqueue(3, 1020);
+    directory.dequeue(3);
+    directory.start();
+    reactor.timers().schedule(5000ms, [&] { reactor.stop(); });
+    reactor.run();
+
+    REQUIRE(matched == std::vector<SessionDirectory::TicketId>{1, 2});
+}
+
+#if !defined(_WIN32)
+TEST_CASE("UnixChannel delivers frames and passes descriptors") {
+    int channelFds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, channelFds) == 0);
+    UnixChannel sender(channelFds[0]);
+    UnixChannel receiver(channelFds[1]);
+
+    int passed[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, passed) == 0);
+
+    sf::Packet first;
+    first << std::string("hello") << sf::Int32(42);
+    sf::Packet second;
+    second << std::string("socket");
+    REQUIRE(sender.send(first));
+    REQUIRE(sender.send(second, passed[0]));
+    ::close(passed[0]);
+
+    sf::Packet packet;
+    std::string text;
+    sf::Int32 number = 0;
+    REQUIRE(receiver.receive(packet) == UnixChannel::ReadResult::Message);
+    REQUIRE((packet >> text >> number));
+    REQUIRE(text == "hello");
+    REQUIRE(number == 42);
+
+    REQUIRE(receiver.receive(packet) == UnixChannel::ReadResult::Message);
+    REQUIRE((packet >> text));
+    REQUIRE(text == "socket");
+    int received = receiver.takeDescriptor();
+    REQUIRE(received >= 0);
+    REQUIRE(receiver.takeDescriptor() == -1);
+    REQUIRE(receiver.receive(packet) == UnixChannel::ReadResult::WouldBlock);
+
+    // The received descriptor is the same connection
+    REQUIRE(::write(received, "x", 1) == 1);
+    char byte = 0;
+    REQUIRE(::read(passed[1], &byte, 1) == 1);
+    REQUIRE(byte == 'x');
+    ::close(received);
+    ::close(passed[1]);
+}
+
+TEST_CASE("DirectoryService routes lookups and migrates cross-process pairings") {
+    Reactor reactor;
+    std::string path = "/tmp/bayou_directory_test_" + std::to_string(::getpid()) + ".sock";
+    DirectoryService service(reactor, Matchmaker::Config{}, 10ms);
+    REQUIRE(service.listen(path));
+
+    auto process0 = RemoteDirectory::connect(reactor, path, 0, nullptr);
+    auto process1 = RemoteDirectory::connect(reactor, path, 1, nullptr);
+    REQUIRE(process0);
+    REQUIRE(process1);
+
+    int passed[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, passed) == 0);
+
+    int owner = -2;
+    bool migrated = false;
+    std::string adoptedName;
+    SessionDirectory::TicketId adoptedPeer = 0;
+    sf::Uint32 adoptedCapabilities = 0;
+    int adoptedFd = -1;
+
+    SessionDirectory::Handlers handlers0;
+    handlers0.adopt = [&](int fd, const std::string& username, SessionDirectory::TicketId peer,
+                          sf::Uint32 capabilities) {
+        adoptedFd = fd;
+        adoptedName = username;
+        adoptedPeer = peer;
+        adoptedCapabilities = capabilities;
+        reactor.stop();
+    };
+    process0->setHandlers(handlers0);
+
+    SessionDirectory::Handlers handlers1;
+    handlers1.migrate = [&](SessionDirectory::TicketId ticket, int target, SessionDirectory::TicketId peer, int peerRating) {
+        // The later arrival moves to the process where its opponent waits
+        migrated = ticket == 7 && target == 0 && peer == 5 && peerRating == 1000;
+        process1->handoff(passed[0], target, "bob", peer, peerRating, 0x3);
+        ::close(passed[0]);
+    };
+    process1->setHandlers(handlers1);
+
+    process0->claim("alice");
+    process1->lookupOwner("alice", [&](int result) { owner = result; });
+    process0->enqueue(5, 1000);
+    process1->enqueue(7, 1010);
+
+    reactor.timers().schedule(5000ms, [&] { reactor.stop(); });
+    reactor.run();
+
+    REQUIRE(owner == 0);
+    REQUIRE(migrated);
+    REQUIRE(adoptedName == "bob");
+    REQUIRE(adoptedPeer == 5);
+    REQUIRE(adoptedCapabilities == 0x3);
+    REQUIRE(adoptedFd >= 0);
+    REQUIRE(::write(adoptedFd, "y", 1) == 1);
+    char byte = 0;
+    REQUIRE(::read(passed[1], &byte, 1) == 1);
+    REQUIRE(byte == 'y');
+
+    ::close(adoptedFd);
+    ::close(passed[1]);
+    process0.reset();
+    process1.reset();
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("DirectoryService queues the waiting peer again when a handoff fails") {
+    Reactor reactor;
+    std::string path = "/tmp/bayou_directory_fail_test_" + std::to_string(::getpid()) + ".sock";
+    DirectoryService service(reactor, Matchmaker::Config{}, 10ms);
+    REQUIRE(service.listen(path));
+
+    auto process0 = RemoteDirectory::connect(reactor, path, 0, nullptr);
+    auto process1 = RemoteDirectory::connect(reactor, path, 1, nullptr);
+    REQUIRE(process0);
+    REQUIRE(process1);
+
+    bool adopted = false;
+    std::vector<SessionDirectory::TicketId> matched;
+    SessionDirectory::Handlers handlers0;
+    handlers0.adopt = [&](int fd, const std::string&, SessionDirectory::TicketId, sf::Uint32) {
+        adopted = true;
+        ::close(fd);
+    };
+    handlers0.match = [&](SessionDirectory::TicketId first, SessionDirectory::TicketId second) {
+        matched = {std::min(first, second), std::max(first, second)};
+        reactor.stop();
+    };
+    process0->setHandlers(handlers0);
+
+    SessionDirectory::Handlers handlers1;
+    handlers1.migrate = [&](SessionDirectory::TicketId, int target, SessionDirectory::TicketId peer, int peerRating) {
+        // The socket never arrives, as when the source lost it or the directory could not pass it on
+        process1->handoff(-1, target, "bob", peer, peerRating, 0);
+        process0->enqueue(9, 1005);
+    };
+    process1->setHandlers(handlers1);
+
+    process0->enqueue(5, 1000);
+    process1->enqueue(7, 1010);
+
+    reactor.timers().schedule(5000ms, [&] { reactor.stop(); });
+    reactor.run();
+
+    REQUIRE_FALSE(adopted);
+    REQUIRE(matched == std::vector<SessionDirectory::TicketId>{5, 9});
+
+    process0.reset();
+    process1.reset();
+    ::unlink(path.c_str());
+}
+#endif
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include "WorkerPool.h"
+#include "SessionStrand.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace BayouBonanza;
+
+namespace {
+    // Spin until the predicate holds or a generous deadline passes
+    template <typename Pred>
+    bool waitFor(Pred pred) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+TEST_CASE("WorkerPool runs every submitted task") {
+    WorkerPool pool(4);
+    REQUIRE(pool.threadCount() == 4);
+
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&counter] { counter++; });
+    }
+    REQUIRE(waitFor([&] { return counter.load() == 1000; }));
+
+    pool.shutdown();
+    WorkerPool::Stats stats = pool.stats();
+    REQUIRE(stats.executed == 1000);
+    REQUIRE(stats.pending == 0);
+}
+
+TEST_CASE("SessionStrand runs tasks in posting order, one at a time") {
+    WorkerPool pool(4);
+    auto strand = SessionStrand::create(pool);
+
+    std::vector<int> order;
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    std::atomic<bool> outsideStrand{false};
+    std::atomic<int> done{0};
+
+    const int TASKS = 500;
+    for (int i = 0; i < TASKS; ++i) {
+        strand->post([&, i] {
+            if (running.fetch_add(1) != 0) overlapped = true;
+            if (!strand->isCurrent()) outsideStrand = true;
+            order.push_back(i); // Unsynchronized on purpose: the strand is the lock
+            running.fetch_sub(1);
+            done++;
+        });
+    }
+    REQUIRE(waitFor([&] { return done.load() == TASKS; }));
+
+    REQUIRE_FALSE(overlapped);
+    REQUIRE_FALSE(outsideStrand);
+    REQUIRE(order.size() == TASKS);
+    for (int i = 0; i < TASKS; ++i) {
+        REQUIRE(order[i] == i);
+    }
+    REQUIRE_FALSE(strand->isCurrent());
+
+    SessionStrand::Stats stats = strand->stats();
+    REQUIRE(stats.tasksRun == TASKS);
+    REQUIRE(stats.queueDepth == 0);
+    REQUIRE(stats.maxQueueDepth >= 1);
+}
+
+TEST_CASE("Separate strands make progress in parallel") {
+    WorkerPool pool(2);
+    auto first = SessionStrand::create(pool);
+    auto second = SessionStrand::create(pool);
+
+    // Each strand blocks until it sees the other running, which only works if they overlap
+    std::atomic<bool> firstStarted{false};
+    std::atomic<bool> secondStarted{false};
+    std::atomic<int> overlapped{0};
+    std::atomic<int> finished{0};
+
+    first->post([&] {
+        firstStarted = true;
+        if (waitFor([&] { return secondStarted.load(); })) overlapped++;
+        finished++;
+    });
+    second->post([&] {
+        secondStarted = true;
+        if (waitFor([&] { return firstStarted.load(); })) overlapped++;
+        finished++;
+    });
+
+    REQUIRE(waitFor([&] { return finished.load() == 2; }));
+    REQUIRE(overlapped.load() == 2);
+}
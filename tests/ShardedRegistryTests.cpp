@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ShardedRegistry.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BayouBonanza;
+
+TEST_CASE("ShardedRegistry inserts, replaces, finds and erases") {
+    ShardedRegistry<std::string, std::shared_ptr<int>> registry;
+    auto first = std::make_shared<int>(1);
+    auto second = std::make_shared<int>(2);
+
+    REQUIRE(registry.insert("alice", first));
+    REQUIRE(registry.find("alice") == first);
+    REQUIRE(registry.find("bob") == nullptr);
+
+    REQUIRE_FALSE(registry.insert("alice", second)); // Replaced, not added
+    REQUIRE(registry.find("alice") == second);
+    REQUIRE(registry.size() == 1);
+
+    REQUIRE(registry.erase("alice"));
+    REQUIRE_FALSE(registry.erase("alice"));
+    REQUIRE(registry.size() == 0);
+}
+
+TEST_CASE("ShardedRegistry eraseIfEqual leaves a newer entry in place") {
+    ShardedRegistry<std::string, std::shared_ptr<int>> registry;
+    auto stale = std::make_shared<int>(1);
+    auto fresh = std::make_shared<int>(2);
+
+    registry.insert("alice", stale);
+    registry.insert("alice", fresh); // Same user logged in again
+
+    REQUIRE_FALSE(registry.eraseIfEqual("alice", stale));
+    REQUIRE(registry.find("alice") == fresh);
+    REQUIRE(registry.eraseIfEqual("alice", fresh));
+    REQUIRE(registry.size() == 0);
+}
+
+TEST_CASE("ShardedRegistry forEach visits every entry and can stop early") {
+    ShardedRegistry<int, int, 4> registry;
+    for (int i = 0; i < 100; ++i) {
+        registry.insert(i, i * 2);
+    }
+
+    int visited = 0;
+    long sum = 0;
+    registry.forEach([&](const int& key, const int& value) {
+        ++visited;
+        sum += value - key;
+        return true;
+    });
+    REQUIRE(visited == 100);
+    REQUIRE(sum == 4950);
+
+    visited = 0;
+    registry.forEach([&](const int&, const int&) { return ++visited < 3; });
+    REQUIRE(visited == 3);
+}
+
+TEST_CASE("ShardedRegistry stays consistent under concurrent writers") {
+    ShardedRegistry<std::uint64_t, std::uint64_t> registry;
+    constexpr int THREADS = 8;
+    constexpr std::uint64_t PER_THREAD = 5000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&registry, t] {
+            std::uint64_t base = static_cast<std::uint64_t>(t) * PER_THREAD;
+            for (std::uint64_t i = 0; i < PER_THREAD; ++i) {
+                registry.insert(base + i, base + i);
+            }
+            // Remove every other key again
+            for (std::uint64_t i = 0; i < PER_THREAD; i += 2) {
+                registry.erase(base + i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(registry.size() == THREADS * PER_THREAD / 2);
+    REQUIRE(registry.find(1) == 1);
+    REQUIRE(registry.find(2) == 0);
+}
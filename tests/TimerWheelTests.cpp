@@ -0,0 +1,101 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TimerWheel.h"
+#include "Reactor.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace BayouBonanza;
+using namespace std::chrono_literals;
+
+TEST_CASE("TimerWheel fires timers in expiry order, including across cascades") {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(10ms, start);
+
+    std::vector<int> fired;
+    // Spread over the root level and the first two coarser levels
+    wheel.schedule(50ms, [&] { fired.push_back(1); });
+    wheel.schedule(3000ms, [&] { fired.push_back(2); });
+    wheel.schedule(200000ms, [&] { fired.push_back(3); });
+    wheel.schedule(20ms, [&] { fired.push_back(0); });
+    REQUIRE(wheel.size() == 4);
+
+    wheel.advance(start + 10ms);
+    REQUIRE(fired.empty());
+
+    wheel.advance(start + 60ms);
+    REQUIRE(fired == std::vector<int>{0, 1});
+
+    wheel.advance(start + 2990ms);
+    REQUIRE(fired.size() == 2);
+    wheel.advance(start + 3010ms);
+    REQUIRE(fired == std::vector<int>{0, 1, 2});
+
+    wheel.advance(start + 199000ms);
+    REQUIRE(fired.size() == 3);
+    wheel.advance(start + 200100ms);
+    REQUIRE(fired == std::vector<int>{0, 1, 2, 3});
+    REQUIRE(wheel.size() == 0);
+}
+
+TEST_CASE("TimerWheel cancel stops pending timers and rejects stale handles") {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(10ms, start);
+
+    int fired = 0;
+    auto keep = wheel.schedule(100ms, [&] { fired++; });
+    auto drop = wheel.schedule(100ms, [&] { fired += 100; });
+    REQUIRE(wheel.cancel(drop));
+    REQUIRE_FALSE(wheel.cancel(drop));
+
+    wheel.advance(start + 200ms);
+    REQUIRE(fired == 1);
+    REQUIRE_FALSE(wheel.cancel(keep)); // Already fired
+
+    // A recycled slab entry must not be cancellable through the old handle
+    auto reused = wheel.schedule(100ms, [&] { fired++; });
+    REQUIRE_FALSE(wheel.cancel(keep));
+    REQUIRE(wheel.cancel(reused));
+    REQUIRE_FALSE(wheel.cancel(0));
+}
+
+TEST_CASE("TimerWheel callbacks may schedule and cancel other timers") {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(10ms, start);
+
+    int fired = 0;
+    TimerWheel::TimerId sibling = 0;
+    wheel.schedule(30ms, [&] {
+        fired++;
+        wheel.cancel(sibling);                       // Due in the same tick
+        wheel.schedule(10ms, [&] { fired += 10; });  // Re-arm from inside a callback
+    });
+    sibling = wheel.schedule(30ms, [&] { fired += 100; });
+
+    wheel.advance(start + 40ms);
+    REQUIRE(fired == 1);
+    wheel.advance(start + 100ms);
+    REQUIRE(fired == 11);
+}
+
+TEST_CASE("TimerWheel reports how long its owner may sleep") {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(10ms, start);
+    REQUIRE(wheel.millisecondsUntilNextEvent(start) == -1);
+
+    wheel.schedule(50ms, [] {});
+    int wait = wheel.millisecondsUntilNextEvent(start + 1ms);
+    REQUIRE(wait >= 0);
+    REQUIRE(wait <= 50);
+}
+
+TEST_CASE("Reactor fires timers without any socket activity") {
+    Reactor reactor;
+    bool fired = false;
+    reactor.timers().schedule(20ms, [&] {
+        fired = true;
+        reactor.stop();
+    });
+    reactor.run();
+    REQUIRE(fired);
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include "WireFormat.h"
+#include "GameState.h"
+#include "GameTestSupport.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace BayouBonanza;
+
+TEST_CASE("WireWriter varints round trip and stay short for small values", "[wire]") {
+    std::array<char, 256> buffer;
+    WireWriter writer(buffer.data(), buffer.size());
+
+    const sf::Uint32 unsignedValues[] = {0, 1, 127, 128, 16383, 16384, std::numeric_limits<sf::Uint32>::max()};
+    const sf::Int32 signedValues[] = {0, -1, 1, -64, 63, -65, std::numeric_limits<sf::Int32>::min(),
+                                      std::numeric_limits<sf::Int32>::max()};
+    const sf::Uint64 wide = std::numeric_limits<sf::Uint64>::max();
+    const sf::Int64 wideNegative = std::numeric_limits<sf::Int64>::min();
+    for (sf::Uint32 value : unsignedValues) {
+        writer << value;
+    }
+    for (sf::Int32 value : signedValues) {
+        writer << value;
+    }
+    writer << wide << wideNegative;
+    REQUIRE(writer);
+
+    WireReader reader(buffer.data(), writer.getDataSize());
+    for (sf::Uint32 expected : unsignedValues) {
+        sf::Uint32 value = 0;
+        REQUIRE((reader >> value));
+        REQUIRE(value == expected);
+    }
+    for (sf::Int32 expected : signedValues) {
+        sf::Int32 value = 0;
+        REQUIRE((reader >> value));
+        REQUIRE(value == expected);
+    }
+    sf::Uint64 wideRead = 0;
+    sf::Int64 wideNegativeRead = 0;
+    REQUIRE((reader >> wideRead >> wideNegativeRead));
+    REQUIRE(wideRead == wide);
+    REQUIRE(wideNegativeRead == wideNegative);
+    REQUIRE(reader.endOfData());
+
+    REQUIRE(WireWriter::varUintSize(127) == 1);
+    REQUIRE(WireWriter::varUintSize(128) == 2);
+    REQUIRE(WireWriter::varUintSize(std::numeric_limits<std::uint64_t>::max()) == 10);
+
+    // Small negatives zigzag into one byte
+    writer.clear();
+    writer << sf::Int32(-1) << sf::Int32(-64);
+    REQUIRE(writer.getDataSize() == 2);
+}
+
+TEST_CASE("WireWriter and WireReader fail instead of overrunning", "[wire]") {
+    SECTION("A write that does not fit fails the writer and every later write") {
+        std::array<char, 4> buffer;
+        WireWriter writer(buffer.data(), buffer.size());
+        writer << sf::Uint16(1);
+        REQUIRE(writer);
+        writer << std::string("too long");
+        REQUIRE_FALSE(writer);
+        writer << sf::Uint8(1);
+        REQUIRE_FALSE(writer);
+        REQUIRE(writer.getDataSize() <= buffer.size());
+
+        writer.clear();
+        writer << sf::Uint8(1);
+        REQUIRE(writer);
+    }
+
+    SECTION("A truncated message fails the reader") {
+        std::array<char, 16> buffer;
+        WireWriter writer(buffer.data(), buffer.size());
+        writer << std::string("abcdef");
+        WireReader reader(buffer.data(), writer.getDataSize() - 1);
+        std::string value;
+        REQUIRE_FALSE((reader >> value));
+        sf::Uint8 next = 0;
+        REQUIRE_FALSE((reader >> next));
+    }
+
+    SECTION("A varint longer than ten bytes is malformed") {
+        std::array<char, 12> buffer;
+        buffer.fill(static_cast<char>(0x80));
+        WireReader reader(buffer.data(), buffer.size());
+        sf::Uint64 value = 0;
+        REQUIRE_FALSE((reader >> value));
+    }
+}
+
+TEST_CASE("WireReader reads strings in place", "[wire]") {
+    std::array<char, 32> buffer;
+    WireWriter writer(buffer.data(), buffer.size());
+    writer << std::string_view("bayou") << 2.5f << -0.25;
+
+    WireReader reader(buffer.data(), writer.getDataSize());
+    std::string_view name;
+    float floatValue = 0;
+    double doubleValue = 0;
+    REQUIRE((reader >> name >> floatValue >> doubleValue));
+    REQUIRE(name == "bayou");
+    REQUIRE(name.data() == buffer.data() + 1);
+    REQUIRE(floatValue == 2.5f);
+    REQUIRE(doubleValue == -0.25);
+}
+
+TEST_CASE_METHOD(GameTestFixture, "GameState round trips through the wire format", "[wire]") {
+    GameState state;
+    initializer.initializeNewGame(state);
+
+    std::vector<char> bytes(16384);
+    WireWriter writer(bytes.data(), bytes.size());
+    writer << state;
+    REQUIRE(writer);
+
+    sf::Packet packet;
+    packet << state;
+    REQUIRE(writer.getDataSize() < packet.getDataSize());
+
+    WireReader reader(bytes.data(), writer.getDataSize());
+    GameState received;
+    REQUIRE((reader >> received));
+    REQUIRE(reader.endOfData());
+    REQUIRE(received.hash() == state.hash());
+}
+
+// Nanoseconds to serialize and deserialize the opening GameState: sf::Packet against the wire format.
+// Run with: BayouBonanzaTests "[performance]"
+TEST_CASE_METHOD(GameTestFixture, "GameState serialize and deserialize time", "[.][wire][performance]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int ROUNDS = 20000;
+    GameState state;
+    initializer.initializeNewGame(state);
+
+    auto nanosPerRound = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ROUNDS;
+    };
+
+    sf::Packet packet;
+    auto start = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        packet.clear();
+        packet << state;
+    }
+    double packetWrite = nanosPerRound(start);
+    GameState packetCopy;
+    start = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        sf::Packet received = packet;
+        received >> packetCopy;
+    }
+    double packetRead = nanosPerRound(start);
+
+    std::vector<char> bytes(16384);
+    WireWriter writer(bytes.data(), bytes.size());
+    start = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        writer.clear();
+        writer << state;
+    }
+    double wireWrite = nanosPerRound(start);
+    GameState wireCopy;
+    start = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        WireReader reader(bytes.data(), writer.getDataSize());
+        reader >> wireCopy;
+    }
+    double wireRead = nanosPerRound(start);
+
+    REQUIRE(packetCopy.hash() == state.hash());
+    REQUIRE(wireCopy.hash() == state.hash());
+    std::cout << "sf::Packet: " << packet.getDataSize() << " bytes, write " << packetWrite << " ns, read "
+              << packetRead << " ns (including the packet copy)\n"
+              << "WireWriter: " << writer.getDataSize() << " bytes, write " << wireWrite << " ns, read "
+              << wireRead << " ns" << std::endl;
+}